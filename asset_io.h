@@ -0,0 +1,574 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tasks.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define MID_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Выравнивание для O_DIRECT: адрес, смещение и длина кратны сектору
+const size_t IO_ALIGNMENT = 4096;
+
+struct StagingSpan
+{
+    char* data = nullptr;
+    size_t size = 0;
+    uint32_t firstBlock = 0;
+    uint32_t blockCount = 0;
+
+    explicit operator bool() const { return data != nullptr; }
+};
+
+// Промежуточная память для чтения с диска и загрузки на GPU.
+// Выделение блоками по 64 КиБ, освобождать можно в любом порядке.
+// Может обернуть уже отображённую память (например, PBO).
+class StagingArena
+{
+public:
+    static const size_t BLOCK_BYTES = 64 * 1024;
+
+    explicit StagingArena(size_t bytes)
+        : capacity((bytes + BLOCK_BYTES - 1) / BLOCK_BYTES * BLOCK_BYTES),
+          owned(true)
+    {
+        memory = (char*)::operator new(capacity, std::align_val_t(IO_ALIGNMENT));
+        used.assign(capacity / BLOCK_BYTES, 0);
+    }
+
+    StagingArena(void* mapped, size_t bytes)
+        : memory((char*)mapped),
+          capacity(bytes / BLOCK_BYTES * BLOCK_BYTES),
+          owned(false)
+    {
+        used.assign(capacity / BLOCK_BYTES, 0);
+    }
+
+    ~StagingArena()
+    {
+        if (owned)
+            ::operator delete(memory, std::align_val_t(IO_ALIGNMENT));
+    }
+
+    StagingArena(const StagingArena&) = delete;
+    StagingArena& operator=(const StagingArena&) = delete;
+
+    // Пустой span, если свободного непрерывного участка нет
+    StagingSpan allocate(size_t bytes)
+    {
+        uint32_t need = (uint32_t)((bytes + BLOCK_BYTES - 1) / BLOCK_BYTES);
+        if (need == 0)
+            need = 1;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        uint32_t run = 0;
+        for (uint32_t i = 0; i < (uint32_t)used.size(); ++i)
+        {
+            run = used[i] ? 0 : run + 1;
+            if (run == need)
+            {
+                uint32_t first = i + 1 - need;
+                for (uint32_t k = first; k <= i; ++k)
+                    used[k] = 1;
+                bytesInUse += (size_t)need * BLOCK_BYTES;
+                return { memory + (size_t)first * BLOCK_BYTES, bytes, first, need };
+            }
+        }
+        return {};
+    }
+
+    void release(const StagingSpan& span)
+    {
+        if (!span)
+            return;
+        std::lock_guard<std::mutex> lock(mutex);
+        for (uint32_t k = span.firstBlock; k < span.firstBlock + span.blockCount; ++k)
+            used[k] = 0;
+        bytesInUse -= (size_t)span.blockCount * BLOCK_BYTES;
+    }
+
+    char* data() const { return memory; }
+    size_t size() const { return capacity; }
+    size_t inUse() const { return bytesInUse; }
+
+    bool contains(const void* p, size_t n) const
+    {
+        const char* c = (const char*)p;
+        return c >= memory && c + n <= memory + capacity;
+    }
+
+private:
+    char* memory = nullptr;
+    size_t capacity = 0;
+    bool owned = false;
+
+    std::mutex mutex;
+    std::vector<uint8_t> used;
+    size_t bytesInUse = 0;
+};
+
+struct AssetFile
+{
+    int fd = -1;       // обычный дескриптор
+    int directFd = -1; // O_DIRECT, если файловая система его поддерживает
+    uint64_t size = 0;
+
+    explicit operator bool() const { return fd >= 0; }
+};
+
+// Асинхронное чтение ассетов. На Linux — io_uring: запросы копятся в очереди
+// и уходят пачкой одним io_uring_enter с отдельного IO-потока; чтение в
+// зарегистрированную staging-память идёт через READ_FIXED. Без io_uring —
+// отдельный маленький пул с pread, чтобы блокирующее чтение не занимало
+// вычислительный пул. Корутины продолжаются на основном пуле, так что
+// вызывающий поток (в том числе рендер) сам системных вызовов не делает.
+class AssetIO
+{
+public:
+    explicit AssetIO(ThreadPool& pool, std::vector<StagingArena*> registered = {}, unsigned queueDepth = 256)
+        : pool(pool), staging(std::move(registered))
+    {
+#ifdef MID_HAS_IO_URING
+        if (setupRing(queueDepth))
+        {
+            ioThread = std::thread([this] { ringLoop(); });
+            return;
+        }
+#else
+        (void)queueDepth;
+#endif
+        fallback = std::make_unique<ThreadPool>(4);
+    }
+
+    ~AssetIO()
+    {
+#ifdef MID_HAS_IO_URING
+        if (ringFd >= 0)
+        {
+            stopping = true;
+            wakeIoThread();
+            ioThread.join();
+            teardownRing();
+        }
+#endif
+    }
+
+    AssetIO(const AssetIO&) = delete;
+    AssetIO& operator=(const AssetIO&) = delete;
+
+    bool usesIoUring() const { return ringFd >= 0; }
+
+    AssetFile open(const std::string& path)
+    {
+        AssetFile f;
+#if defined(_WIN32)
+        f.fd = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+        f.fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#ifdef O_DIRECT
+        if (f.fd >= 0)
+            f.directFd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+#endif
+#endif
+        if (f.fd < 0)
+        {
+            std::cerr << "Failed to open " << path << "\n";
+            return f;
+        }
+
+#if defined(_WIN32)
+        struct _stat64 st;
+        if (_fstat64(f.fd, &st) == 0)
+            f.size = (uint64_t)st.st_size;
+#else
+        struct stat st;
+        if (fstat(f.fd, &st) == 0)
+            f.size = (uint64_t)st.st_size;
+#endif
+        return f;
+    }
+
+    void close(AssetFile& f)
+    {
+#if defined(_WIN32)
+        if (f.fd >= 0) _close(f.fd);
+#else
+        if (f.fd >= 0) ::close(f.fd);
+        if (f.directFd >= 0) ::close(f.directFd);
+#endif
+        f = AssetFile();
+    }
+
+    // co_await io.read(file, offset, size, dst) -> число прочитанных байт или -errno.
+    // Продолжение — на основном пуле.
+    auto read(const AssetFile& file, uint64_t offset, size_t size, void* dst)
+    {
+        struct Awaiter
+        {
+            AssetIO* io;
+            Request request;
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> h)
+            {
+                request.waiter = h;
+                io->submit(&request);
+            }
+
+            int64_t await_resume() const noexcept { return request.result; }
+        };
+
+        Request r;
+        r.offset = offset;
+        r.size = size;
+        r.dst = dst;
+        r.bufIndex = registeredIndex(dst, size);
+
+        bool aligned = file.directFd >= 0
+            && offset % IO_ALIGNMENT == 0
+            && size % IO_ALIGNMENT == 0
+            && (uintptr_t)dst % IO_ALIGNMENT == 0;
+        r.fd = aligned ? file.directFd : file.fd;
+
+        return Awaiter{ this, r };
+    }
+
+    // Прочитать весь файл в staging-память. Пустой span — ошибка или нет места.
+    Task<StagingSpan> readFile(const std::string& path, StagingArena& arena)
+    {
+        AssetFile f = open(path);
+        if (!f)
+            co_return StagingSpan();
+
+        uint64_t padded = (f.size + IO_ALIGNMENT - 1) / IO_ALIGNMENT * IO_ALIGNMENT;
+        StagingSpan span = arena.allocate((size_t)padded);
+        if (!span)
+        {
+            close(f);
+            co_return span;
+        }
+
+        int64_t got = co_await read(f, 0, (size_t)padded, span.data);
+        uint64_t size = f.size; // close() обнуляет f
+        close(f);
+
+        if (got < (int64_t)size)
+        {
+            std::cerr << "Failed to read " << path << "\n";
+            arena.release(span);
+            co_return StagingSpan();
+        }
+        span.size = (size_t)size;
+        co_return span;
+    }
+
+private:
+    struct Request
+    {
+        int fd = -1;
+        uint64_t offset = 0;
+        size_t size = 0;
+        void* dst = nullptr;
+        int bufIndex = -1;
+        int64_t result = 0;
+        std::coroutine_handle<> waiter;
+    };
+
+    int registeredIndex(const void* dst, size_t size) const
+    {
+        if (ringFd < 0)
+            return -1;
+        for (size_t i = 0; i < staging.size(); ++i)
+            if (staging[i]->contains(dst, size))
+                return (int)i;
+        return -1;
+    }
+
+    void complete(Request* r)
+    {
+        std::coroutine_handle<> h = r->waiter;
+        pool.submit([h] { h.resume(); });
+    }
+
+    static int64_t preadAll(int fd, void* dst, size_t size, uint64_t offset)
+    {
+        size_t done = 0;
+        while (done < size)
+        {
+#if defined(_WIN32)
+            // pread на Windows нет; позиционирование под общим замком
+            static std::mutex seekMutex;
+            std::lock_guard<std::mutex> lock(seekMutex);
+            if (_lseeki64(fd, (long long)(offset + done), SEEK_SET) < 0)
+                return -errno;
+            int n = _read(fd, (char*)dst + done, (unsigned)std::min<size_t>(size - done, 1u << 30));
+#else
+            ssize_t n = ::pread(fd, (char*)dst + done, size - done, (off_t)(offset + done));
+            if (n < 0 && errno == EINTR)
+                continue;
+#endif
+            if (n < 0)
+                return -errno;
+            if (n == 0)
+                break;
+            done += (size_t)n;
+        }
+        return (int64_t)done;
+    }
+
+    void submit(Request* r)
+    {
+        if (fallback)
+        {
+            fallback->submit([this, r]
+            {
+                r->result = preadAll(r->fd, r->dst, r->size, r->offset);
+                complete(r);
+            });
+            return;
+        }
+
+#ifdef MID_HAS_IO_URING
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            queued.push_back(r);
+        }
+        if (ioSleeping.load())
+            wakeIoThread();
+#endif
+    }
+
+#ifdef MID_HAS_IO_URING
+    bool setupRing(unsigned entries)
+    {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        int fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+        if (fd < 0)
+            return false;
+
+        size_t sqBytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        size_t cqBytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single)
+            sqBytes = cqBytes = std::max(sqBytes, cqBytes);
+
+        void* sq = mmap(nullptr, sqBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        void* cq = single ? sq
+            : mmap(nullptr, cqBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        void* sqe = mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sq == MAP_FAILED || cq == MAP_FAILED || sqe == MAP_FAILED)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        ringFd = fd;
+        sqMap = sq; sqMapSize = sqBytes;
+        cqMap = cq; cqMapSize = single ? 0 : cqBytes;
+        sqes = (io_uring_sqe*)sqe; sqeCount = params.sq_entries;
+
+        char* s = (char*)sq;
+        sqHead = (unsigned*)(s + params.sq_off.head);
+        sqTail = (unsigned*)(s + params.sq_off.tail);
+        sqMask = *(unsigned*)(s + params.sq_off.ring_mask);
+        sqArray = (unsigned*)(s + params.sq_off.array);
+
+        char* c = (char*)cq;
+        cqHead = (unsigned*)(c + params.cq_off.head);
+        cqTail = (unsigned*)(c + params.cq_off.tail);
+        cqMask = *(unsigned*)(c + params.cq_off.ring_mask);
+        cqes = (io_uring_cqe*)(c + params.cq_off.cqes);
+
+        // Staging-память регистрируется один раз: ядро не пинит страницы на каждый запрос
+        if (!staging.empty())
+        {
+            std::vector<iovec> iov;
+            for (StagingArena* a : staging)
+                iov.push_back({ a->data(), a->size() });
+            if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_BUFFERS, iov.data(), (unsigned)iov.size()) < 0)
+                staging.clear();
+        }
+
+        wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        completionFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (completionFd >= 0)
+            syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_EVENTFD, &completionFd, 1);
+        return true;
+    }
+
+    void teardownRing()
+    {
+        munmap(sqes, sqeCount * sizeof(io_uring_sqe));
+        if (cqMapSize)
+            munmap(cqMap, cqMapSize);
+        munmap(sqMap, sqMapSize);
+        ::close(ringFd);
+        ::close(wakeFd);
+        ::close(completionFd);
+        ringFd = -1;
+    }
+
+    void wakeIoThread()
+    {
+        uint64_t one = 1;
+        ssize_t n = ::write(wakeFd, &one, sizeof(one));
+        (void)n;
+    }
+
+    static void drainEventFd(int fd)
+    {
+        uint64_t v;
+        while (::read(fd, &v, sizeof(v)) > 0) {}
+    }
+
+    void ringLoop()
+    {
+        std::vector<Request*> batch;
+        unsigned inFlight = 0;
+        unsigned unsubmitted = 0;
+
+        while (!stopping || inFlight > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                batch.insert(batch.end(), queued.begin(), queued.end());
+                queued.clear();
+            }
+
+            // Вся пачка — одним системным вызовом
+            unsigned tail = *sqTail;
+            unsigned toSubmit = 0;
+            size_t taken = 0;
+            while (taken < batch.size() && inFlight + toSubmit < sqeCount)
+            {
+                Request* r = batch[taken++];
+                unsigned index = tail & sqMask;
+                io_uring_sqe& e = sqes[index];
+                std::memset(&e, 0, sizeof(e));
+                e.opcode = r->bufIndex >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ;
+                e.fd = r->fd;
+                e.off = r->offset;
+                e.addr = (uint64_t)(uintptr_t)r->dst;
+                e.len = (unsigned)r->size;
+                e.buf_index = (uint16_t)(r->bufIndex >= 0 ? r->bufIndex : 0);
+                e.user_data = (uint64_t)(uintptr_t)r;
+                sqArray[index] = index;
+                ++tail;
+                ++toSubmit;
+            }
+            batch.erase(batch.begin(), batch.begin() + (std::ptrdiff_t)taken);
+
+            if (toSubmit > 0)
+            {
+                __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+                unsubmitted += toSubmit;
+                inFlight += toSubmit;
+            }
+
+            if (unsubmitted > 0)
+            {
+                int submitted = (int)syscall(__NR_io_uring_enter, ringFd, unsubmitted, 0, 0, nullptr, 0);
+                if (submitted > 0)
+                    unsubmitted -= (unsigned)submitted;
+                else if (submitted < 0 && errno != EAGAIN && errno != EBUSY && errno != EINTR)
+                    std::cerr << "io_uring_enter failed: " << std::strerror(errno) << "\n";
+            }
+
+            unsigned head = *cqHead;
+            while (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE))
+            {
+                io_uring_cqe& c = cqes[head & cqMask];
+                Request* r = (Request*)(uintptr_t)c.user_data;
+                r->result = c.res;
+                if (c.res > 0 && (size_t)c.res < r->size && r->bufIndex < 0 && r->fd >= 0)
+                {
+                    // Короткое чтение посреди файла — дочитываем синхронно здесь же
+                    int64_t rest = preadAll(r->fd, (char*)r->dst + c.res, r->size - (size_t)c.res, r->offset + (uint64_t)c.res);
+                    if (rest > 0)
+                        r->result += rest;
+                }
+                complete(r);
+                ++head;
+                --inFlight;
+            }
+            __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+            if (!batch.empty() || unsubmitted > 0)
+                continue;
+
+            // Спим до новой заявки или завершения чтения
+            ioSleeping = true;
+            bool empty;
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                empty = queued.empty();
+            }
+            if (empty && !stopping && head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE))
+            {
+                pollfd fds[2] = { { wakeFd, POLLIN, 0 }, { completionFd, POLLIN, 0 } };
+                ::poll(fds, 2, inFlight > 0 ? 10 : 100);
+            }
+            ioSleeping = false;
+            drainEventFd(wakeFd);
+            drainEventFd(completionFd);
+        }
+    }
+
+    std::thread ioThread;
+    std::mutex queueMutex;
+    std::vector<Request*> queued;
+    std::atomic<bool> ioSleeping{ false };
+    std::atomic<bool> stopping{ false };
+
+    void* sqMap = nullptr;
+    size_t sqMapSize = 0;
+    void* cqMap = nullptr;
+    size_t cqMapSize = 0;
+    io_uring_sqe* sqes = nullptr;
+    unsigned sqeCount = 0;
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+    int wakeFd = -1;
+    int completionFd = -1;
+#endif
+
+    ThreadPool& pool;
+    std::vector<StagingArena*> staging;
+    std::unique_ptr<ThreadPool> fallback;
+    int ringFd = -1;
+};
@@ -0,0 +1,859 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MID_BC_SSE2 1
+#endif
+
+#include "tasks.h"
+#include "textures.h"
+
+// Качество сжатия: FAST — ось по двум итерациям и без уточнения (для
+// потоковой генерации), NORMAL — главная ось и одно уточнение МНК,
+// HIGH — несколько уточнений и перебор соседних квантованных концов
+enum BCQuality
+{
+    BC_FAST,
+    BC_NORMAL,
+    BC_HIGH
+};
+
+namespace bc
+{
+    constexpr float BIG = 1e30f;
+
+    // Блок 4x4 поканально (SoA) — SIMD обрабатывает по четыре пикселя
+    struct Block
+    {
+        alignas(16) float ch[4][16];
+    };
+
+#ifdef MID_BC_SSE2
+    inline float hsum(__m128 v)
+    {
+        __m128 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+        return _mm_cvtss_f32(s);
+    }
+#endif
+
+    // Ближайший цвет палитры для каждого пикселя; возвращает суммарную ошибку
+    inline float selectIndices(const Block& b, int channels, const float (*palette)[4], int count, uint8_t* indices)
+    {
+#ifdef MID_BC_SSE2
+        __m128 total = _mm_setzero_ps();
+        for (int g = 0; g < 16; g += 4)
+        {
+            __m128 best = _mm_set1_ps(BIG);
+            __m128i bestIndex = _mm_setzero_si128();
+            for (int k = 0; k < count; ++k)
+            {
+                __m128 d = _mm_setzero_ps();
+                for (int c = 0; c < channels; ++c)
+                {
+                    __m128 diff = _mm_sub_ps(_mm_load_ps(b.ch[c] + g), _mm_set1_ps(palette[k][c]));
+                    d = _mm_add_ps(d, _mm_mul_ps(diff, diff));
+                }
+                __m128i closer = _mm_castps_si128(_mm_cmplt_ps(d, best));
+                best = _mm_min_ps(d, best);
+                bestIndex = _mm_or_si128(_mm_andnot_si128(closer, bestIndex),
+                                         _mm_and_si128(closer, _mm_set1_epi32(k)));
+            }
+            total = _mm_add_ps(total, best);
+
+            alignas(16) int32_t idx[4];
+            _mm_store_si128((__m128i*)idx, bestIndex);
+            for (int i = 0; i < 4; ++i)
+                indices[g + i] = (uint8_t)idx[i];
+        }
+        return hsum(total);
+#else
+        float total = 0.0f;
+        for (int i = 0; i < 16; ++i)
+        {
+            float best = BIG;
+            for (int k = 0; k < count; ++k)
+            {
+                float d = 0.0f;
+                for (int c = 0; c < channels; ++c)
+                {
+                    float diff = b.ch[c][i] - palette[k][c];
+                    d += diff * diff;
+                }
+                if (d < best)
+                {
+                    best = d;
+                    indices[i] = (uint8_t)k;
+                }
+            }
+            total += best;
+        }
+        return total;
+#endif
+    }
+
+    // Среднее и главная ось разброса цветов (степенной метод по ковариации)
+    inline void principalAxis(const Block& b, int channels, int iterations, float mean[4], float axis[4])
+    {
+        float lo[4] = { 0, 0, 0, 0 }, hi[4] = { 0, 0, 0, 0 };
+        for (int c = 0; c < channels; ++c)
+        {
+#ifdef MID_BC_SSE2
+            __m128 sum = _mm_setzero_ps();
+            __m128 mn = _mm_set1_ps(BIG), mx = _mm_set1_ps(-BIG);
+            for (int g = 0; g < 16; g += 4)
+            {
+                __m128 v = _mm_load_ps(b.ch[c] + g);
+                sum = _mm_add_ps(sum, v);
+                mn = _mm_min_ps(mn, v);
+                mx = _mm_max_ps(mx, v);
+            }
+            mean[c] = hsum(sum) / 16.0f;
+            alignas(16) float m[4], n[4];
+            _mm_store_ps(m, mn);
+            _mm_store_ps(n, mx);
+            lo[c] = std::min(std::min(m[0], m[1]), std::min(m[2], m[3]));
+            hi[c] = std::max(std::max(n[0], n[1]), std::max(n[2], n[3]));
+#else
+            float sum = 0.0f;
+            lo[c] = BIG;
+            hi[c] = -BIG;
+            for (int i = 0; i < 16; ++i)
+            {
+                sum += b.ch[c][i];
+                lo[c] = std::min(lo[c], b.ch[c][i]);
+                hi[c] = std::max(hi[c], b.ch[c][i]);
+            }
+            mean[c] = sum / 16.0f;
+#endif
+        }
+
+        float cov[4][4] = {};
+        for (int c = 0; c < channels; ++c)
+            for (int d = c; d < channels; ++d)
+            {
+#ifdef MID_BC_SSE2
+                __m128 mc = _mm_set1_ps(mean[c]), md = _mm_set1_ps(mean[d]);
+                __m128 sum = _mm_setzero_ps();
+                for (int g = 0; g < 16; g += 4)
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(b.ch[c] + g), mc),
+                                                     _mm_sub_ps(_mm_load_ps(b.ch[d] + g), md)));
+                cov[c][d] = cov[d][c] = hsum(sum);
+#else
+                float sum = 0.0f;
+                for (int i = 0; i < 16; ++i)
+                    sum += (b.ch[c][i] - mean[c]) * (b.ch[d][i] - mean[d]);
+                cov[c][d] = cov[d][c] = sum;
+#endif
+            }
+
+        // Старт — диагональ габаритов со знаками по ковариации с первым каналом
+        float len = 0.0f;
+        for (int c = 0; c < channels; ++c)
+        {
+            axis[c] = (hi[c] - lo[c]) * (c > 0 && cov[0][c] < 0.0f ? -1.0f : 1.0f);
+            len += axis[c] * axis[c];
+        }
+        for (int it = 0; it < iterations && len > 1e-8f; ++it)
+        {
+            float next[4] = {};
+            for (int c = 0; c < channels; ++c)
+                for (int d = 0; d < channels; ++d)
+                    next[c] += cov[c][d] * axis[d];
+            float n = 0.0f;
+            for (int c = 0; c < channels; ++c)
+                n += next[c] * next[c];
+            if (n < 1e-8f)
+                break;
+            float inv = 1.0f / std::sqrt(n);
+            for (int c = 0; c < channels; ++c)
+                axis[c] = next[c] * inv;
+            len = 1.0f;
+        }
+
+        if (len < 1e-8f)
+        {
+            for (int c = 0; c < channels; ++c)
+                axis[c] = 1.0f;
+            len = (float)channels;
+        }
+        float inv = 1.0f / std::sqrt(len);
+        for (int c = 0; c < channels; ++c)
+            axis[c] *= inv;
+    }
+
+    // Концы отрезка: проекции крайних пикселей на ось
+    inline void axisEndpoints(const Block& b, int channels, const float mean[4], const float axis[4],
+                              float e0[4], float e1[4])
+    {
+#ifdef MID_BC_SSE2
+        __m128 mn = _mm_set1_ps(BIG), mx = _mm_set1_ps(-BIG);
+        for (int g = 0; g < 16; g += 4)
+        {
+            __m128 t = _mm_setzero_ps();
+            for (int c = 0; c < channels; ++c)
+                t = _mm_add_ps(t, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(b.ch[c] + g), _mm_set1_ps(mean[c])),
+                                             _mm_set1_ps(axis[c])));
+            mn = _mm_min_ps(mn, t);
+            mx = _mm_max_ps(mx, t);
+        }
+        alignas(16) float m[4], n[4];
+        _mm_store_ps(m, mn);
+        _mm_store_ps(n, mx);
+        float lo = std::min(std::min(m[0], m[1]), std::min(m[2], m[3]));
+        float hi = std::max(std::max(n[0], n[1]), std::max(n[2], n[3]));
+#else
+        float lo = BIG, hi = -BIG;
+        for (int i = 0; i < 16; ++i)
+        {
+            float t = 0.0f;
+            for (int c = 0; c < channels; ++c)
+                t += (b.ch[c][i] - mean[c]) * axis[c];
+            lo = std::min(lo, t);
+            hi = std::max(hi, t);
+        }
+#endif
+        for (int c = 0; c < channels; ++c)
+        {
+            e0[c] = std::clamp(mean[c] + axis[c] * hi, 0.0f, 255.0f);
+            e1[c] = std::clamp(mean[c] + axis[c] * lo, 0.0f, 255.0f);
+        }
+    }
+
+    // Концы по МНК для известных весов пикселей (0 — e0, 1 — e1); mask — кого учитывать
+    inline bool leastSquares(const Block& b, int channels, const float* w, const bool* mask,
+                             float e0[4], float e1[4])
+    {
+        float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+        float x0[4] = {}, x1[4] = {};
+        for (int i = 0; i < 16; ++i)
+        {
+            if (mask && !mask[i])
+                continue;
+            float a = 1.0f - w[i], bw = w[i];
+            aa += a * a;
+            ab += a * bw;
+            bb += bw * bw;
+            for (int c = 0; c < channels; ++c)
+            {
+                x0[c] += a * b.ch[c][i];
+                x1[c] += bw * b.ch[c][i];
+            }
+        }
+        float det = aa * bb - ab * ab;
+        if (std::fabs(det) < 1e-6f)
+            return false;
+        float inv = 1.0f / det;
+        for (int c = 0; c < channels; ++c)
+        {
+            e0[c] = std::clamp((bb * x0[c] - ab * x1[c]) * inv, 0.0f, 255.0f);
+            e1[c] = std::clamp((aa * x1[c] - ab * x0[c]) * inv, 0.0f, 255.0f);
+        }
+        return true;
+    }
+
+    // --- BC1 / цветовая часть BC3 ---
+
+    inline uint16_t pack565(const float c[3])
+    {
+        int r = (int)std::lround(c[0] * 31.0f / 255.0f);
+        int g = (int)std::lround(c[1] * 63.0f / 255.0f);
+        int b = (int)std::lround(c[2] * 31.0f / 255.0f);
+        return (uint16_t)(std::clamp(r, 0, 31) << 11 | std::clamp(g, 0, 63) << 5 | std::clamp(b, 0, 31));
+    }
+
+    inline void unpack565(uint16_t v, float out[4])
+    {
+        int r = v >> 11, g = (v >> 5) & 63, b = v & 31;
+        out[0] = (float)(r << 3 | r >> 2);
+        out[1] = (float)(g << 2 | g >> 4);
+        out[2] = (float)(b << 3 | b >> 2);
+        out[3] = 255.0f;
+    }
+
+    struct ColorFit
+    {
+        uint16_t c0 = 0, c1 = 0;
+        uint8_t indices[16] = {};
+        float error = BIG;
+    };
+
+    // threeColor — режим BC1 с прозрачным четвёртым цветом
+    inline float evalColor(const Block& b, uint16_t c0, uint16_t c1, bool threeColor, uint8_t* indices)
+    {
+        float p[4][4];
+        unpack565(c0, p[0]);
+        unpack565(c1, p[1]);
+        for (int c = 0; c < 3; ++c)
+        {
+            if (threeColor)
+            {
+                p[2][c] = (p[0][c] + p[1][c]) * 0.5f;
+            }
+            else
+            {
+                p[2][c] = (2.0f * p[0][c] + p[1][c]) / 3.0f;
+                p[3][c] = (p[0][c] + 2.0f * p[1][c]) / 3.0f;
+            }
+        }
+        return selectIndices(b, 3, p, threeColor ? 3 : 4, indices);
+    }
+
+    inline void tryColor(const Block& b, uint16_t c0, uint16_t c1, bool threeColor, ColorFit& best)
+    {
+        ColorFit fit;
+        fit.c0 = c0;
+        fit.c1 = c1;
+        fit.error = evalColor(b, c0, c1, threeColor, fit.indices);
+        if (fit.error < best.error)
+            best = fit;
+    }
+
+    inline void encodeColor(const Block& b, BCQuality quality, const bool* opaque, uint8_t out[8])
+    {
+        bool threeColor = opaque != nullptr;
+        float mean[4], axis[4], e0[4], e1[4];
+        principalAxis(b, 3, quality == BC_FAST ? 2 : 6, mean, axis);
+        axisEndpoints(b, 3, mean, axis, e0, e1);
+
+        ColorFit best;
+        tryColor(b, pack565(e0), pack565(e1), threeColor, best);
+
+        static const float weights4[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+        static const float weights3[4] = { 0.0f, 1.0f, 0.5f, 0.0f };
+        int refines = quality == BC_FAST ? 0 : quality == BC_NORMAL ? 1 : 4;
+        for (int it = 0; it < refines; ++it)
+        {
+            float w[16];
+            for (int i = 0; i < 16; ++i)
+                w[i] = (threeColor ? weights3 : weights4)[best.indices[i]];
+            if (!leastSquares(b, 3, w, opaque, e0, e1))
+                break;
+            float before = best.error;
+            tryColor(b, pack565(e0), pack565(e1), threeColor, best);
+            if (best.error >= before)
+                break;
+        }
+
+        if (quality == BC_HIGH)
+        {
+            // Соседние значения 565 по каждому каналу каждого конца
+            static const uint16_t steps[3] = { 1 << 11, 1 << 5, 1 };
+            static const uint16_t masks[3] = { 31 << 11, 63 << 5, 31 };
+            for (int end = 0; end < 2; ++end)
+                for (int c = 0; c < 3; ++c)
+                    for (int dir = -1; dir <= 1; dir += 2)
+                    {
+                        uint16_t v = end == 0 ? best.c0 : best.c1;
+                        int field = v & masks[c];
+                        int moved = field + dir * steps[c];
+                        if (moved < 0 || moved > masks[c])
+                            continue;
+                        uint16_t candidate = (uint16_t)((v & ~masks[c]) | moved);
+                        if (end == 0)
+                            tryColor(b, candidate, best.c1, threeColor, best);
+                        else
+                            tryColor(b, best.c0, candidate, threeColor, best);
+                    }
+        }
+
+        // Порядок концов задаёт режим: c0 > c1 — четыре цвета, иначе три
+        uint16_t c0 = best.c0, c1 = best.c1;
+        uint8_t idx[16];
+        std::memcpy(idx, best.indices, 16);
+        if (c0 == c1)
+        {
+            std::memset(idx, 0, 16);
+        }
+        else if ((c0 < c1) != threeColor)
+        {
+            std::swap(c0, c1);
+            static const uint8_t swap4[4] = { 1, 0, 3, 2 };
+            static const uint8_t swap3[4] = { 1, 0, 2, 3 };
+            for (int i = 0; i < 16; ++i)
+                idx[i] = (threeColor ? swap3 : swap4)[idx[i]];
+        }
+
+        uint32_t bits = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            uint32_t index = (opaque && !opaque[i]) ? 3u : idx[i];
+            bits |= index << (2 * i);
+        }
+        std::memcpy(out, &c0, 2);
+        std::memcpy(out + 2, &c1, 2);
+        std::memcpy(out + 4, &bits, 4);
+    }
+
+    // --- BC4: один канал, восемь уровней между двумя концами ---
+
+    inline float evalSingle(const Block& b, int e0, int e1, uint8_t* indices)
+    {
+        float p[8][4];
+        p[0][0] = (float)e0;
+        p[1][0] = (float)e1;
+        for (int i = 2; i < 8; ++i)
+            p[i][0] = ((8 - i) * (float)e0 + (i - 1) * (float)e1) / 7.0f;
+        return selectIndices(b, 1, p, e0 == e1 ? 1 : 8, indices);
+    }
+
+    // Канал берётся из b.ch[0]
+    inline void encodeSingle(const Block& b, BCQuality quality, uint8_t out[8])
+    {
+        float lo = BIG, hi = -BIG;
+        for (int i = 0; i < 16; ++i)
+        {
+            lo = std::min(lo, b.ch[0][i]);
+            hi = std::max(hi, b.ch[0][i]);
+        }
+        int hiI = (int)std::lround(hi), loI = (int)std::lround(lo);
+
+        int e0 = hiI, e1 = loI;
+        uint8_t best[16];
+        float bestError = evalSingle(b, e0, e1, best);
+
+        // Сжатие концов внутрь часто выигрывает: крайние пиксели редки
+        int insets = quality == BC_FAST ? 0 : quality == BC_NORMAL ? 1 : 4;
+        int step = std::max(1, (hiI - loI) / 32);
+        uint8_t idx[16];
+        for (int a = 0; a <= insets; ++a)
+            for (int c = 0; c <= insets; ++c)
+            {
+                int h = hiI - a * step, l = loI + c * step;
+                if ((a == 0 && c == 0) || h <= l)
+                    continue;
+                float error = evalSingle(b, h, l, idx);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    e0 = h;
+                    e1 = l;
+                    std::memcpy(best, idx, 16);
+                }
+            }
+
+        out[0] = (uint8_t)e0;
+        out[1] = (uint8_t)e1;
+        uint64_t bits = 0;
+        for (int i = 0; i < 16; ++i)
+            bits |= (uint64_t)(e0 == e1 ? 0 : best[i]) << (3 * i);
+        for (int i = 0; i < 6; ++i)
+            out[2 + i] = (uint8_t)(bits >> (8 * i));
+    }
+
+    // --- BC7, режим 6: RGBA, одна область, 7 бит + p-бит на конец, 4-битные индексы ---
+
+    static const int BC7_WEIGHTS4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    struct Mode6Fit
+    {
+        int q0[4] = {}, q1[4] = {};
+        int p0 = 0, p1 = 0;
+        uint8_t indices[16] = {};
+        float error = BIG;
+    };
+
+    inline void quantize7p(const float e[4], int p, int q[4])
+    {
+        for (int c = 0; c < 4; ++c)
+            q[c] = std::clamp((int)std::lround((e[c] - (float)p) * 0.5f), 0, 127);
+    }
+
+    inline float quantizeError(const float e[4], const int q[4], int p)
+    {
+        float err = 0.0f;
+        for (int c = 0; c < 4; ++c)
+        {
+            float d = (float)(q[c] * 2 + p) - e[c];
+            err += d * d;
+        }
+        return err;
+    }
+
+    inline float evalMode6(const Block& b, const int q0[4], int p0, const int q1[4], int p1, uint8_t* indices)
+    {
+        float p[16][4];
+        for (int c = 0; c < 4; ++c)
+        {
+            int v0 = q0[c] * 2 + p0, v1 = q1[c] * 2 + p1;
+            for (int k = 0; k < 16; ++k)
+                p[k][c] = (float)(((64 - BC7_WEIGHTS4[k]) * v0 + BC7_WEIGHTS4[k] * v1 + 32) >> 6);
+        }
+        return selectIndices(b, 4, p, 16, indices);
+    }
+
+    // Квантовать концы (p-бит каждого — по меньшей ошибке) и оценить
+    inline void tryMode6(const Block& b, const float e0[4], const float e1[4], bool allParity, Mode6Fit& best)
+    {
+        int q[2][2][4];
+        float err[2][2];
+        for (int p = 0; p < 2; ++p)
+        {
+            quantize7p(e0, p, q[0][p]);
+            quantize7p(e1, p, q[1][p]);
+            err[0][p] = quantizeError(e0, q[0][p], p);
+            err[1][p] = quantizeError(e1, q[1][p], p);
+        }
+
+        for (int p0 = 0; p0 < 2; ++p0)
+            for (int p1 = 0; p1 < 2; ++p1)
+            {
+                if (!allParity && (p0 != (err[0][1] < err[0][0]) || p1 != (err[1][1] < err[1][0])))
+                    continue;
+                Mode6Fit fit;
+                std::copy(q[0][p0], q[0][p0] + 4, fit.q0);
+                std::copy(q[1][p1], q[1][p1] + 4, fit.q1);
+                fit.p0 = p0;
+                fit.p1 = p1;
+                fit.error = evalMode6(b, fit.q0, p0, fit.q1, p1, fit.indices);
+                if (fit.error < best.error)
+                    best = fit;
+            }
+    }
+
+    struct BitWriter
+    {
+        uint8_t* out;
+        int pos = 0;
+
+        void write(uint32_t value, int bits)
+        {
+            for (int i = 0; i < bits; ++i, ++pos)
+                if (value >> i & 1)
+                    out[pos >> 3] |= (uint8_t)(1 << (pos & 7));
+        }
+    };
+
+    // Режим 6: один отрезок в RGBA
+    inline Mode6Fit fitMode6(const Block& b, BCQuality quality)
+    {
+        float mean[4], axis[4], e0[4], e1[4];
+        principalAxis(b, 4, quality == BC_FAST ? 2 : 6, mean, axis);
+        axisEndpoints(b, 4, mean, axis, e0, e1);
+
+        Mode6Fit best;
+        tryMode6(b, e0, e1, quality == BC_HIGH, best);
+
+        int refines = quality == BC_FAST ? 0 : quality == BC_NORMAL ? 1 : 3;
+        for (int it = 0; it < refines; ++it)
+        {
+            float w[16];
+            for (int i = 0; i < 16; ++i)
+                w[i] = BC7_WEIGHTS4[best.indices[i]] / 64.0f;
+            if (!leastSquares(b, 4, w, nullptr, e0, e1))
+                break;
+            float before = best.error;
+            tryMode6(b, e0, e1, quality == BC_HIGH, best);
+            if (best.error >= before)
+                break;
+        }
+        return best;
+    }
+
+    // --- BC7, режим 5: RGB 7 бит и альфа 8 бит с отдельными 2-битными индексами ---
+
+    static const int BC7_WEIGHTS2[4] = { 0, 21, 43, 64 };
+
+    struct Mode5Fit
+    {
+        int c0[3] = {}, c1[3] = {};
+        int a0 = 0, a1 = 0;
+        uint8_t colorIndices[16] = {};
+        uint8_t alphaIndices[16] = {};
+        float colorError = BIG, alphaError = BIG;
+    };
+
+    inline void tryMode5Color(const Block& b, const float e0[3], const float e1[3], Mode5Fit& best)
+    {
+        int q0[3], q1[3];
+        float p[4][4];
+        for (int c = 0; c < 3; ++c)
+        {
+            q0[c] = std::clamp((int)std::lround(e0[c] * 127.0f / 255.0f), 0, 127);
+            q1[c] = std::clamp((int)std::lround(e1[c] * 127.0f / 255.0f), 0, 127);
+            int v0 = q0[c] << 1 | q0[c] >> 6, v1 = q1[c] << 1 | q1[c] >> 6;
+            for (int k = 0; k < 4; ++k)
+                p[k][c] = (float)(((64 - BC7_WEIGHTS2[k]) * v0 + BC7_WEIGHTS2[k] * v1 + 32) >> 6);
+        }
+        uint8_t idx[16];
+        float error = selectIndices(b, 3, p, 4, idx);
+        if (error < best.colorError)
+        {
+            best.colorError = error;
+            std::copy(q0, q0 + 3, best.c0);
+            std::copy(q1, q1 + 3, best.c1);
+            std::memcpy(best.colorIndices, idx, 16);
+        }
+    }
+
+    inline float evalMode5Alpha(const Block& alpha, int a0, int a1, uint8_t* indices)
+    {
+        float p[4][4];
+        for (int k = 0; k < 4; ++k)
+            p[k][0] = (float)(((64 - BC7_WEIGHTS2[k]) * a0 + BC7_WEIGHTS2[k] * a1 + 32) >> 6);
+        return selectIndices(alpha, 1, p, 4, indices);
+    }
+
+    inline Mode5Fit fitMode5(const Block& b, BCQuality quality)
+    {
+        Mode5Fit best;
+        float mean[4], axis[4], e0[4], e1[4];
+        principalAxis(b, 3, quality == BC_FAST ? 2 : 6, mean, axis);
+        axisEndpoints(b, 3, mean, axis, e0, e1);
+        tryMode5Color(b, e0, e1, best);
+
+        int refines = quality == BC_FAST ? 0 : quality == BC_NORMAL ? 1 : 3;
+        for (int it = 0; it < refines; ++it)
+        {
+            float w[16];
+            for (int i = 0; i < 16; ++i)
+                w[i] = BC7_WEIGHTS2[best.colorIndices[i]] / 64.0f;
+            if (!leastSquares(b, 3, w, nullptr, e0, e1))
+                break;
+            float before = best.colorError;
+            tryMode5Color(b, e0, e1, best);
+            if (best.colorError >= before)
+                break;
+        }
+
+        Block alpha;
+        std::memcpy(alpha.ch[0], b.ch[3], sizeof(alpha.ch[0]));
+        float lo = *std::min_element(alpha.ch[0], alpha.ch[0] + 16);
+        float hi = *std::max_element(alpha.ch[0], alpha.ch[0] + 16);
+        int insets = quality == BC_FAST ? 0 : quality == BC_NORMAL ? 1 : 3;
+        int step = std::max(1, (int)(hi - lo) / 16);
+        uint8_t idx[16];
+        for (int i = 0; i <= insets; ++i)
+            for (int j = 0; j <= insets; ++j)
+            {
+                int a0 = (int)lo + i * step, a1 = (int)hi - j * step;
+                if (a0 > a1)
+                    continue;
+                float error = evalMode5Alpha(alpha, a0, a1, idx);
+                if (error < best.alphaError)
+                {
+                    best.alphaError = error;
+                    best.a0 = a0;
+                    best.a1 = a1;
+                    std::memcpy(best.alphaIndices, idx, 16);
+                }
+            }
+        return best;
+    }
+
+    inline void writeMode6(Mode6Fit best, uint8_t out[16])
+    {
+        // Старший бит индекса первого пикселя неявно ноль
+        if (best.indices[0] >= 8)
+        {
+            std::swap(best.q0, best.q1);
+            std::swap(best.p0, best.p1);
+            for (uint8_t& i : best.indices)
+                i = (uint8_t)(15 - i);
+        }
+
+        std::memset(out, 0, 16);
+        BitWriter w{ out };
+        w.write(1u << 6, 7);
+        for (int c = 0; c < 4; ++c)
+        {
+            w.write((uint32_t)best.q0[c], 7);
+            w.write((uint32_t)best.q1[c], 7);
+        }
+        w.write((uint32_t)best.p0, 1);
+        w.write((uint32_t)best.p1, 1);
+        w.write(best.indices[0], 3);
+        for (int i = 1; i < 16; ++i)
+            w.write(best.indices[i], 4);
+    }
+
+    inline void writeMode5(Mode5Fit best, uint8_t out[16])
+    {
+        if (best.colorIndices[0] >= 2)
+        {
+            std::swap(best.c0, best.c1);
+            for (uint8_t& i : best.colorIndices)
+                i = (uint8_t)(3 - i);
+        }
+        if (best.alphaIndices[0] >= 2)
+        {
+            std::swap(best.a0, best.a1);
+            for (uint8_t& i : best.alphaIndices)
+                i = (uint8_t)(3 - i);
+        }
+
+        std::memset(out, 0, 16);
+        BitWriter w{ out };
+        w.write(1u << 5, 6);
+        w.write(0, 2);   // без перестановки каналов
+        for (int c = 0; c < 3; ++c)
+        {
+            w.write((uint32_t)best.c0[c], 7);
+            w.write((uint32_t)best.c1[c], 7);
+        }
+        w.write((uint32_t)best.a0, 8);
+        w.write((uint32_t)best.a1, 8);
+        w.write(best.colorIndices[0], 1);
+        for (int i = 1; i < 16; ++i)
+            w.write(best.colorIndices[i], 2);
+        w.write(best.alphaIndices[0], 1);
+        for (int i = 1; i < 16; ++i)
+            w.write(best.alphaIndices[i], 2);
+    }
+
+    // Непрозрачные блоки — режим 6; с переменной альфой он же или режим 5,
+    // если альфа не лежит на одном отрезке с цветом
+    inline void encodeBC7(const Block& b, BCQuality quality, uint8_t out[16])
+    {
+        Mode6Fit m6 = fitMode6(b, quality);
+
+        float lo = *std::min_element(b.ch[3], b.ch[3] + 16);
+        float hi = *std::max_element(b.ch[3], b.ch[3] + 16);
+        if (hi > lo)
+        {
+            Mode5Fit m5 = fitMode5(b, quality);
+            if (m5.colorError + m5.alphaError < m6.error)
+            {
+                writeMode5(m5, out);
+                return;
+            }
+        }
+        writeMode6(m6, out);
+    }
+
+    // Блок из RGBA8 с повтором краевых пикселей для неполных блоков
+    inline void loadBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t bx, uint32_t by, Block& b)
+    {
+        for (uint32_t y = 0; y < 4; ++y)
+            for (uint32_t x = 0; x < 4; ++x)
+            {
+                uint32_t px = std::min(bx * 4 + x, width - 1);
+                uint32_t py = std::min(by * 4 + y, height - 1);
+                const uint8_t* p = rgba + ((size_t)py * width + px) * 4;
+                for (int c = 0; c < 4; ++c)
+                    b.ch[c][y * 4 + x] = (float)p[c];
+            }
+    }
+
+    inline void encodeBlock(TextureFormat format, BCQuality quality, Block& b, uint8_t* out)
+    {
+        switch (format)
+        {
+        case TEX_BC1:
+        case TEX_BC1_SRGB:
+        {
+            // Прозрачные пиксели (alpha < 128) — в цвет 3 режима трёх цветов
+            bool opaque[16];
+            bool anyTransparent = false;
+            for (int i = 0; i < 16; ++i)
+            {
+                opaque[i] = b.ch[3][i] >= 128.0f;
+                anyTransparent |= !opaque[i];
+            }
+            encodeColor(b, quality, anyTransparent ? opaque : nullptr, out);
+            break;
+        }
+        case TEX_BC3:
+        case TEX_BC3_SRGB:
+        {
+            Block alpha;
+            std::memcpy(alpha.ch[0], b.ch[3], sizeof(alpha.ch[0]));
+            encodeSingle(alpha, quality, out);
+            encodeColor(b, quality, nullptr, out + 8);
+            break;
+        }
+        case TEX_BC4:
+            encodeSingle(b, quality, out);
+            break;
+        case TEX_BC5:
+        {
+            encodeSingle(b, quality, out);
+            Block green;
+            std::memcpy(green.ch[0], b.ch[1], sizeof(green.ch[0]));
+            encodeSingle(green, quality, out + 8);
+            break;
+        }
+        case TEX_BC7:
+        case TEX_BC7_SRGB:
+            encodeBC7(b, quality, out);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+// Сжать RGBA8-картинку в блочный формат. Строки блоков делятся между
+// потоками пула; вызывающий поток тоже работает. RGBA8 копируется как есть.
+inline std::vector<char> compressImage(ThreadPool& pool, TextureFormat format, const uint8_t* rgba,
+                                       uint32_t width, uint32_t height, BCQuality quality)
+{
+    std::vector<char> out(levelBytes(format, width, height));
+    if (!formatInfo(format).compressed)
+    {
+        std::memcpy(out.data(), rgba, out.size());
+        return out;
+    }
+
+    uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    uint32_t blockBytes = formatInfo(format).blockBytes;
+    size_t grain = std::max<size_t>(1, 64 / blocksX);
+    pool.parallelFor(blocksY, grain, [&](size_t begin, size_t end)
+    {
+        bc::Block b;
+        for (size_t by = begin; by < end; ++by)
+            for (uint32_t bx = 0; bx < blocksX; ++bx)
+            {
+                bc::loadBlock(rgba, width, height, bx, (uint32_t)by, b);
+                bc::encodeBlock(format, quality, b,
+                                (uint8_t*)out.data() + ((size_t)by * blocksX + bx) * blockBytes);
+            }
+    });
+    return out;
+}
+
+// Мипы усреднением 2x2 и сжатие каждого. Результат — мипы подряд в порядке
+// levels (крупный первым), как ждёт TextureManager::create()
+inline std::vector<char> compressTexture(ThreadPool& pool, TextureFormat format, const uint8_t* rgba,
+                                         uint32_t width, uint32_t height, BCQuality quality, TextureInfo& info)
+{
+    info = TextureInfo();
+    info.format = format;
+    info.width = width;
+    info.height = height;
+
+    std::vector<char> data;
+    std::vector<uint8_t> level(rgba, rgba + (size_t)width * height * 4), next;
+    uint32_t w = width, h = height;
+    for (;;)
+    {
+        std::vector<char> packed = compressImage(pool, format, level.data(), w, h, quality);
+        info.levels.push_back({ (uint64_t)data.size(), (uint64_t)packed.size() });
+        data.insert(data.end(), packed.begin(), packed.end());
+        if (w == 1 && h == 1)
+            break;
+
+        uint32_t nw = std::max(w / 2, 1u), nh = std::max(h / 2, 1u);
+        next.resize((size_t)nw * nh * 4);
+        for (uint32_t y = 0; y < nh; ++y)
+            for (uint32_t x = 0; x < nw; ++x)
+                for (int c = 0; c < 4; ++c)
+                {
+                    uint32_t x0 = std::min(x * 2, w - 1), x1 = std::min(x * 2 + 1, w - 1);
+                    uint32_t y0 = std::min(y * 2, h - 1), y1 = std::min(y * 2 + 1, h - 1);
+                    int sum = level[((size_t)y0 * w + x0) * 4 + c] + level[((size_t)y0 * w + x1) * 4 + c]
+                            + level[((size_t)y1 * w + x0) * 4 + c] + level[((size_t)y1 * w + x1) * 4 + c];
+                    next[((size_t)y * nw + x) * 4 + c] = (uint8_t)((sum + 2) / 4);
+                }
+        level.swap(next);
+        w = nw;
+        h = nh;
+    }
+    return data;
+}
@@ -22,6 +22,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+/* The loader itself always goes through the glad_gl* globals */
+#undef GLAD_GL_CONTEXT_DISPATCH
 #include <glad/glad.h>
 
 static void* get_proc(const char *namez);
@@ -165,63 +167,68 @@ struct gladGLversionStruct GLVersion = { 0, 0 };
 static int max_loaded_major;
 static int max_loaded_minor;
 
-static const char *exts = NULL;
-static int num_exts_i = 0;
-static char **exts_i = NULL;
+struct gladExtensions {
+    const char *exts;
+    int num_exts_i;
+    char **exts_i;
+};
 
-static int get_exts(void) {
+static int get_exts(struct gladExtensions *e, int major, PFNGLGETSTRINGPROC getString,
+                    PFNGLGETINTEGERVPROC getIntegerv, PFNGLGETSTRINGIPROC getStringi) {
+    e->exts = NULL;
+    e->num_exts_i = 0;
+    e->exts_i = NULL;
 #ifdef _GLAD_IS_SOME_NEW_VERSION
-    if(max_loaded_major < 3) {
+    if(major < 3) {
 #endif
-        exts = (const char *)glGetString(GL_EXTENSIONS);
+        e->exts = (const char *)getString(GL_EXTENSIONS);
 #ifdef _GLAD_IS_SOME_NEW_VERSION
     } else {
         int index;
 
-        num_exts_i = 0;
-        glGetIntegerv(GL_NUM_EXTENSIONS, &num_exts_i);
-        if (num_exts_i > 0) {
-            exts_i = (char **)malloc((size_t)num_exts_i * (sizeof *exts_i));
+        getIntegerv(GL_NUM_EXTENSIONS, &e->num_exts_i);
+        if (e->num_exts_i > 0) {
+            e->exts_i = (char **)malloc((size_t)e->num_exts_i * (sizeof *e->exts_i));
         }
 
-        if (exts_i == NULL) {
+        if (e->exts_i == NULL) {
             return 0;
         }
 
-        for(index = 0; index < num_exts_i; index++) {
-            const char *gl_str_tmp = (const char*)glGetStringi(GL_EXTENSIONS, index);
+        for(index = 0; index < e->num_exts_i; index++) {
+            const char *gl_str_tmp = (const char*)getStringi(GL_EXTENSIONS, index);
             size_t len = strlen(gl_str_tmp);
 
             char *local_str = (char*)malloc((len+1) * sizeof(char));
             if(local_str != NULL) {
                 memcpy(local_str, gl_str_tmp, (len+1) * sizeof(char));
             }
-            exts_i[index] = local_str;
+            e->exts_i[index] = local_str;
         }
     }
+#else
+    (void)major; (void)getIntegerv; (void)getStringi;
 #endif
     return 1;
 }
 
-static void free_exts(void) {
-    if (exts_i != NULL) {
+static void free_exts(struct gladExtensions *e) {
+    if (e->exts_i != NULL) {
         int index;
-        for(index = 0; index < num_exts_i; index++) {
-            free((char *)exts_i[index]);
+        for(index = 0; index < e->num_exts_i; index++) {
+            free((char *)e->exts_i[index]);
         }
-        free((void *)exts_i);
-        exts_i = NULL;
+        free((void *)e->exts_i);
+        e->exts_i = NULL;
     }
 }
 
-static int has_ext(const char *ext) {
-#ifdef _GLAD_IS_SOME_NEW_VERSION
-    if(max_loaded_major < 3) {
-#endif
+static int has_ext(const struct gladExtensions *e, const char *ext) {
+    if(e->exts_i == NULL) {
         const char *extensions;
         const char *loc;
         const char *terminator;
-        extensions = exts;
+        extensions = e->exts;
         if(extensions == NULL || ext == NULL) {
             return 0;
         }
@@ -239,19 +246,16 @@ static int has_ext(const char *ext) {
             }
             extensions = terminator;
         }
-#ifdef _GLAD_IS_SOME_NEW_VERSION
     } else {
         int index;
-        if(exts_i == NULL) return 0;
-        for(index = 0; index < num_exts_i; index++) {
-            const char *e = exts_i[index];
+        for(index = 0; index < e->num_exts_i; index++) {
+            const char *name = e->exts_i[index];
 
-            if(exts_i[index] != NULL && strcmp(e, ext) == 0) {
+            if(name != NULL && strcmp(name, ext) == 0) {
                 return 1;
             }
         }
     }
-#endif
 
     return 0;
 }
@@ -1055,9 +1059,10 @@ static void load_GL_VERSION_3_3(GLADloadproc load) {
 	glad_glSecondaryColorP3uiv = (PFNGLSECONDARYCOLORP3UIVPROC)load("glSecondaryColorP3uiv");
 }
 static int find_extensionsGL(void) {
-	if (!get_exts()) return 0;
+	struct gladExtensions e;
+	if (!get_exts(&e, max_loaded_major, glGetString, glGetIntegerv, glGetStringi)) return 0;
 	(void)&has_ext;
-	free_exts();
+	free_exts(&e);
 	return 1;
 }
 
@@ -1138,3 +1143,505 @@ int gladLoadGLLoader(GLADloadproc load) {
 	return GLVersion.major != 0 || GLVersion.minor != 0;
 }
 
+GLAD_THREAD_LOCAL GladGLContext *glad_gl_context = NULL;
+
+void gladSetGLContext(GladGLContext *context) {
+	glad_gl_context = context;
+}
+
+GladGLContext *gladGetGLContext(void) {
+	return glad_gl_context;
+}
+
+static void load_GL_VERSION_1_0_context(GladGLContext *context, GLADloadproc load) {
+	if(!context->VERSION_1_0) return;
+	context->CullFace = (PFNGLCULLFACEPROC)load("glCullFace");
+	context->FrontFace = (PFNGLFRONTFACEPROC)load("glFrontFace");
+	context->Hint = (PFNGLHINTPROC)load("glHint");
+	context->LineWidth = (PFNGLLINEWIDTHPROC)load("glLineWidth");
+	context->PointSize = (PFNGLPOINTSIZEPROC)load("glPointSize");
+	context->PolygonMode = (PFNGLPOLYGONMODEPROC)load("glPolygonMode");
+	context->Scissor = (PFNGLSCISSORPROC)load("glScissor");
+	context->TexParameterf = (PFNGLTEXPARAMETERFPROC)load("glTexParameterf");
+	context->TexParameterfv = (PFNGLTEXPARAMETERFVPROC)load("glTexParameterfv");
+	context->TexParameteri = (PFNGLTEXPARAMETERIPROC)load("glTexParameteri");
+	context->TexParameteriv = (PFNGLTEXPARAMETERIVPROC)load("glTexParameteriv");
+	context->TexImage1D = (PFNGLTEXIMAGE1DPROC)load("glTexImage1D");
+	context->TexImage2D = (PFNGLTEXIMAGE2DPROC)load("glTexImage2D");
+	context->DrawBuffer = (PFNGLDRAWBUFFERPROC)load("glDrawBuffer");
+	context->Clear = (PFNGLCLEARPROC)load("glClear");
+	context->ClearColor = (PFNGLCLEARCOLORPROC)load("glClearColor");
+	context->ClearStencil = (PFNGLCLEARSTENCILPROC)load("glClearStencil");
+	context->ClearDepth = (PFNGLCLEARDEPTHPROC)load("glClearDepth");
+	context->StencilMask = (PFNGLSTENCILMASKPROC)load("glStencilMask");
+	context->ColorMask = (PFNGLCOLORMASKPROC)load("glColorMask");
+	context->DepthMask = (PFNGLDEPTHMASKPROC)load("glDepthMask");
+	context->Disable = (PFNGLDISABLEPROC)load("glDisable");
+	context->Enable = (PFNGLENABLEPROC)load("glEnable");
+	context->Finish = (PFNGLFINISHPROC)load("glFinish");
+	context->Flush = (PFNGLFLUSHPROC)load("glFlush");
+	context->BlendFunc = (PFNGLBLENDFUNCPROC)load("glBlendFunc");
+	context->LogicOp = (PFNGLLOGICOPPROC)load("glLogicOp");
+	context->StencilFunc = (PFNGLSTENCILFUNCPROC)load("glStencilFunc");
+	context->StencilOp = (PFNGLSTENCILOPPROC)load("glStencilOp");
+	context->DepthFunc = (PFNGLDEPTHFUNCPROC)load("glDepthFunc");
+	context->PixelStoref = (PFNGLPIXELSTOREFPROC)load("glPixelStoref");
+	context->PixelStorei = (PFNGLPIXELSTOREIPROC)load("glPixelStorei");
+	context->ReadBuffer = (PFNGLREADBUFFERPROC)load("glReadBuffer");
+	context->ReadPixels = (PFNGLREADPIXELSPROC)load("glReadPixels");
+	context->GetBooleanv = (PFNGLGETBOOLEANVPROC)load("glGetBooleanv");
+	context->GetDoublev = (PFNGLGETDOUBLEVPROC)load("glGetDoublev");
+	context->GetError = (PFNGLGETERRORPROC)load("glGetError");
+	context->GetFloatv = (PFNGLGETFLOATVPROC)load("glGetFloatv");
+	context->GetIntegerv = (PFNGLGETINTEGERVPROC)load("glGetIntegerv");
+	context->GetString = (PFNGLGETSTRINGPROC)load("glGetString");
+	context->GetTexImage = (PFNGLGETTEXIMAGEPROC)load("glGetTexImage");
+	context->GetTexParameterfv = (PFNGLGETTEXPARAMETERFVPROC)load("glGetTexParameterfv");
+	context->GetTexParameteriv = (PFNGLGETTEXPARAMETERIVPROC)load("glGetTexParameteriv");
+	context->GetTexLevelParameterfv = (PFNGLGETTEXLEVELPARAMETERFVPROC)load("glGetTexLevelParameterfv");
+	context->GetTexLevelParameteriv = (PFNGLGETTEXLEVELPARAMETERIVPROC)load("glGetTexLevelParameteriv");
+	context->IsEnabled = (PFNGLISENABLEDPROC)load("glIsEnabled");
+	context->DepthRange = (PFNGLDEPTHRANGEPROC)load("glDepthRange");
+	context->Viewport = (PFNGLVIEWPORTPROC)load("glViewport");
+}
+static void load_GL_VERSION_1_1_context(GladGLContext *context, GLADloadproc load) {
+	if(!context->VERSION_1_1) return;
+	context->DrawArrays = (PFNGLDRAWARRAYSPROC)load("glDrawArrays");
+	context->DrawElements = (PFNGLDRAWELEMENTSPROC)load("glDrawElements");
+	context->PolygonOffset = (PFNGLPOLYGONOFFSETPROC)load("glPolygonOffset");
+	context->CopyTexImage1D = (PFNGLCOPYTEXIMAGE1DPROC)load("glCopyTexImage1D");
+	context->CopyTexImage2D = (PFNGLCOPYTEXIMAGE2DPROC)load("glCopyTexImage2D");
+	context->CopyTexSubImage1D = (PFNGLCOPYTEXSUBIMAGE1DPROC)load("glCopyTexSubImage1D");
+	context->CopyTexSubImage2D = (PFNGLCOPYTEXSUBIMAGE2DPROC)load("glCopyTexSubImage2D");
+	context->TexSubImage1D = (PFNGLTEXSUBIMAGE1DPROC)load("glTexSubImage1D");
+	context->TexSubImage2D = (PFNGLTEXSUBIMAGE2DPROC)load("glTexSubImage2D");
+	context->BindTexture = (PFNGLBINDTEXTUREPROC)load("glBindTexture");
+	context->DeleteTextures = (PFNGLDELETETEXTURESPROC)load("glDeleteTextures");
+	context->GenTextures = (PFNGLGENTEXTURESPROC)load("glGenTextures");
+	context->IsTexture = (PFNGLISTEXTUREPROC)load("glIsTexture");
+}
+static void load_GL_VERSION_1_2_context(GladGLContext *context, GLADloadproc load) {
+	if(!context->VERSION_1_2) return;
+	context->DrawRangeElements = (PFNGLDRAWRANGEELEMENTSPROC)load("glDrawRangeElements");
+	context->TexImage3D = (PFNGLTEXIMAGE3DPROC)load("glTexImage3D");
+	context->TexSubImage3D = (PFNGLTEXSUBIMAGE3DPROC)load("glTexSubImage3D");
+	context->CopyTexSubImage3D = (PFNGLCOPYTEXSUBIMAGE3DPROC)load("glCopyTexSubImage3D");
+}
+static void load_GL_VERSION_1_3_context(GladGLContext *context, GLADloadproc load) {
+	if(!context->VERSION_1_3) return;
+	context->ActiveTexture = (PFNGLACTIVETEXTUREPROC)load("glActiveTexture");
+	context->SampleCoverage = (PFNGLSAMPLECOVERAGEPROC)load("glSampleCoverage");
+	context->CompressedTexImage3D = (PFNGLCOMPRESSEDTEXIMAGE3DPROC)load("glCompressedTexImage3D");
+	context->CompressedTexImage2D = (PFNGLCOMPRESSEDTEXIMAGE2DPROC)load("glCompressedTexImage2D");
+	context->CompressedTexImage1D = (PFNGLCOMPRESSEDTEXIMAGE1DPROC)load("glCompressedTexImage1D");
+	context->CompressedTexSubImage3D = (PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC)load("glCompressedTexSubImage3D");
+	context->CompressedTexSubImage2D = (PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC)load("glCompressedTexSubImage2D");
+	context->CompressedTexSubImage1D = (PFNGLCOMPRESSEDTEXSUBIMAGE1DPROC)load("glCompressedTexSubImage1D");
+	context->GetCompressedTexImage = (PFNGLGETCOMPRESSEDTEXIMAGEPROC)load("glGetCompressedTexImage");
+}
+static void load_GL_VERSION_1_4_context(GladGLContext *context, GLADloadproc load) {
+	if(!context->VERSION_1_4) return;
+	context->BlendFuncSeparate = (PFNGLBLENDFUNCSEPARATEPROC)load("glBlendFuncSeparate");
+	context->MultiDrawArrays = (PFNGLMULTIDRAWARRAYSPROC)load("glMultiDrawArrays");
+	context->MultiDrawElements = (PFNGLMULTIDRAWELEMENTSPROC)load("glMultiDrawElements");
+	context->PointParameterf = (PFNGLPOINTPARAMETERFPROC)load("glPointParameterf");
+	context->PointParameterfv = (PFNGLPOINTPARAMETERFVPROC)load("glPointParameterfv");
+	context->PointParameteri = (PFNGLPOINTPARAMETERIPROC)load("glPointParameteri");
+	context->PointParameteriv = (PFNGLPOINTPARAMETERIVPROC)load("glPointParameteriv");
+	context->BlendColor = (PFNGLBLENDCOLORPROC)load("glBlendColor");
+	context->BlendEquation = (PFNGLBLENDEQUATIONPROC)load("glBlendEquation");
+}
+static void load_GL_VERSION_1_5_context(GladGLContext *context, GLADloadproc load) {
+	if(!context->VERSION_1_5) return;
+	context->GenQueries = (PFNGLGENQUERIESPROC)load("glGenQueries");
+	context->DeleteQueries = (PFNGLDELETEQUERIESPROC)load("glDeleteQueries");
+	context->IsQuery = (PFNGLISQUERYPROC)load("glIsQuery");
+	context->BeginQuery = (PFNGLBEGINQUERYPROC)load("glBeginQuery");
+	context->EndQuery = (PFNGLENDQUERYPROC)load("glEndQuery");
+	context->GetQueryiv = (PFNGLGETQUERYIVPROC)load("glGetQueryiv");
+	context->GetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)load("glGetQueryObjectiv");
+	context->GetQueryObjectuiv = (PFNGLGETQUERYOBJECTUIVPROC)load("glGetQueryObjectuiv");
+	context->BindBuffer = (PFNGLBINDBUFFERPROC)load("glBindBuffer");
+	context->DeleteBuffers = (PFNGLDELETEBUFFERSPROC)load("glDeleteBuffers");
+	context->GenBuffers = (PFNGLGENBUFFERSPROC)load("glGenBuffers");
+	context->IsBuffer = (PFNGLISBUFFERPROC)load("glIsBuffer");
+	context->BufferData = (PFNGLBUFFERDATAPROC)load("glBufferData");
+	context->BufferSubData = (PFNGLBUFFERSUBDATAPROC)load("glBufferSubData");
+	context->GetBufferSubData = (PFNGLGETBUFFERSUBDATAPROC)load("glGetBufferSubData");
+	context->MapBuffer = (PFNGLMAPBUFFERPROC)load("glMapBuffer");
+	context->UnmapBuffer = (PFNGLUNMAPBUFFERPROC)load("glUnmapBuffer");
+	context->GetBufferParameteriv = (PFNGLGETBUFFERPARAMETERIVPROC)load("glGetBufferParameteriv");
+	context->GetBufferPointerv = (PFNGLGETBUFFERPOINTERVPROC)load("glGetBufferPointerv");
+}
+static void load_GL_VERSION_2_0_context(GladGLContext *context, GLADloadproc load) {
+	if(!context->VERSION_2_0) return;
+	context->BlendEquationSeparate = (PFNGLBLENDEQUATIONSEPARATEPROC)load("glBlendEquationSeparate");
+	context->DrawBuffers = (PFNGLDRAWBUFFERSPROC)load("glDrawBuffers");
+	context->StencilOpSeparate = (PFNGLSTENCILOPSEPARATEPROC)load("glStencilOpSeparate");
+	context->StencilFuncSeparate = (PFNGLSTENCILFUNCSEPARATEPROC)load("glStencilFuncSeparate");
+	context->StencilMaskSeparate = (PFNGLSTENCILMASKSEPARATEPROC)load("glStencilMaskSeparate");
+	context->AttachShader = (PFNGLATTACHSHADERPROC)load("glAttachShader");
+	context->BindAttribLocation = (PFNGLBINDATTRIBLOCATIONPROC)load("glBindAttribLocation");
+	context->CompileShader = (PFNGLCOMPILESHADERPROC)load("glCompileShader");
+	context->CreateProgram = (PFNGLCREATEPROGRAMPROC)load("glCreateProgram");
+	context->CreateShader = (PFNGLCREATESHADERPROC)load("glCreateShader");
+	context->DeleteProgram = (PFNGLDELETEPROGRAMPROC)load("glDeleteProgram");
+	context->DeleteShader = (PFNGLDELETESHADERPROC)load("glDeleteShader");
+	context->DetachShader = (PFNGLDETACHSHADERPROC)load("glDetachShader");
+	context->DisableVertexAttribArray = (PFNGLDISABLEVERTEXATTRIBARRAYPROC)load("glDisableVertexAttribArray");
+	context->EnableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYPROC)load("glEnableVertexAttribArray");
+	context->GetActiveAttrib = (PFNGLGETACTIVEATTRIBPROC)load("glGetActiveAttrib");
+	context->GetActiveUniform = (PFNGLGETACTIVEUNIFORMPROC)load("glGetActiveUniform");
+	context->GetAttachedShaders = (PFNGLGETATTACHEDSHADERSPROC)load("glGetAttachedShaders");
+	context->GetAttribLocation = (PFNGLGETATTRIBLOCATIONPROC)load("glGetAttribLocation");
+	context->GetProgramiv = (PFNGLGETPROGRAMIVPROC)load("glGetProgramiv");
+	context->GetProgramInfoLog = (PFNGLGETPROGRAMINFOLOGPROC)load("glGetProgramInfoLog");
+	context->GetShaderiv = (PFNGLGETSHADERIVPROC)load("glGetShaderiv");
+	context->GetShaderInfoLog = (PFNGLGETSHADERINFOLOGPROC)load("glGetShaderInfoLog");
+	context->GetShaderSource = (PFNGLGETSHADERSOURCEPROC)load("glGetShaderSource");
+	context->GetUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC)load("glGetUniformLocation");
+	context->GetUniformfv = (PFNGLGETUNIFORMFVPROC)load("glGetUniformfv");
+	context->GetUniformiv = (PFNGLGETUNIFORMIVPROC)load("glGetUniformiv");
+	context->GetVertexAttribdv = (PFNGLGETVERTEXATTRIBDVPROC)load("glGetVertexAttribdv");
+	context->GetVertexAttribfv = (PFNGLGETVERTEXATTRIBFVPROC)load("glGetVertexAttribfv");
+	context->GetVertexAttribiv = (PFNGLGETVERTEXATTRIBIVPROC)load("glGetVertexAttribiv");
+	context->GetVertexAttribPointerv = (PFNGLGETVERTEXATTRIBPOINTERVPROC)load("glGetVertexAttribPointerv");
+	context->IsProgram = (PFNGLISPROGRAMPROC)load("glIsProgram");
+	context->IsShader = (PFNGLISSHADERPROC)load("glIsShader");
+	context->LinkProgram = (PFNGLLINKPROGRAMPROC)load("glLinkProgram");
+	context->ShaderSource = (PFNGLSHADERSOURCEPROC)load("glShaderSource");
+	context->UseProgram = (PFNGLUSEPROGRAMPROC)load("glUseProgram");
+	context->Uniform1f = (PFNGLUNIFORM1FPROC)load("glUniform1f");
+	context->Uniform2f = (PFNGLUNIFORM2FPROC)load("glUniform2f");
+	context->Uniform3f = (PFNGLUNIFORM3FPROC)load("glUniform3f");
+	context->Uniform4f = (PFNGLUNIFORM4FPROC)load("glUniform4f");
+	context->Uniform1i = (PFNGLUNIFORM1IPROC)load("glUniform1i");
+	context->Uniform2i = (PFNGLUNIFORM2IPROC)load("glUniform2i");
+	context->Uniform3i = (PFNGLUNIFORM3IPROC)load("glUniform3i");
+	context->Uniform4i = (PFNGLUNIFORM4IPROC)load("glUniform4i");
+	context->Uniform1fv = (PFNGLUNIFORM1FVPROC)load("glUniform1fv");
+	context->Uniform2fv = (PFNGLUNIFORM2FVPROC)load("glUniform2fv");
+	context->Uniform3fv = (PFNGLUNIFORM3FVPROC)load("glUniform3fv");
+	context->Uniform4fv = (PFNGLUNIFORM4FVPROC)load("glUniform4fv");
+	context->Uniform1iv = (PFNGLUNIFORM1IVPROC)load("glUniform1iv");
+	context->Uniform2iv = (PFNGLUNIFORM2IVPROC)load("glUniform2iv");
+	context->Uniform3iv = (PFNGLUNIFORM3IVPROC)load("glUniform3iv");
+	context->Uniform4iv = (PFNGLUNIFORM4IVPROC)load("glUniform4iv");
+	context->UniformMatrix2fv = (PFNGLUNIFORMMATRIX2FVPROC)load("glUniformMatrix2fv");
+	context->UniformMatrix3fv = (PFNGLUNIFORMMATRIX3FVPROC)load("glUniformMatrix3fv");
+	context->UniformMatrix4fv = (PFNGLUNIFORMMATRIX4FVPROC)load("glUniformMatrix4fv");
+	context->ValidateProgram = (PFNGLVALIDATEPROGRAMPROC)load("glValidateProgram");
+	context->VertexAttrib1d = (PFNGLVERTEXATTRIB1DPROC)load("glVertexAttrib1d");
+	context->VertexAttrib1dv = (PFNGLVERTEXATTRIB1DVPROC)load("glVertexAttrib1dv");
+	context->VertexAttrib1f = (PFNGLVERTEXATTRIB1FPROC)load("glVertexAttrib1f");
+	context->VertexAttrib1fv = (PFNGLVERTEXATTRIB1FVPROC)load("glVertexAttrib1fv");
+	context->VertexAttrib1s = (PFNGLVERTEXATTRIB1SPROC)load("glVertexAttrib1s");
+	context->VertexAttrib1sv = (PFNGLVERTEXATTRIB1SVPROC)load("glVertexAttrib1sv");
+	context->VertexAttrib2d = (PFNGLVERTEXATTRIB2DPROC)load("glVertexAttrib2d");
+	context->VertexAttrib2dv = (PFNGLVERTEXATTRIB2DVPROC)load("glVertexAttrib2dv");
+	context->VertexAttrib2f = (PFNGLVERTEXATTRIB2FPROC)load("glVertexAttrib2f");
+	context->VertexAttrib2fv = (PFNGLVERTEXATTRIB2FVPROC)load("glVertexAttrib2fv");
+	context->VertexAttrib2s = (PFNGLVERTEXATTRIB2SPROC)load("glVertexAttrib2s");
+	context->VertexAttrib2sv = (PFNGLVERTEXATTRIB2SVPROC)load("glVertexAttrib2sv");
+	context->VertexAttrib3d = (PFNGLVERTEXATTRIB3DPROC)load("glVertexAttrib3d");
+	context->VertexAttrib3dv = (PFNGLVERTEXATTRIB3DVPROC)load("glVertexAttrib3dv");
+	context->VertexAttrib3f = (PFNGLVERTEXATTRIB3FPROC)load("glVertexAttrib3f");
+	context->VertexAttrib3fv = (PFNGLVERTEXATTRIB3FVPROC)load("glVertexAttrib3fv");
+	context->VertexAttrib3s = (PFNGLVERTEXATTRIB3SPROC)load("glVertexAttrib3s");
+	context->VertexAttrib3sv = (PFNGLVERTEXATTRIB3SVPROC)load("glVertexAttrib3sv");
+	context->VertexAttrib4Nbv = (PFNGLVERTEXATTRIB4NBVPROC)load("glVertexAttrib4Nbv");
+	context->VertexAttrib4Niv = (PFNGLVERTEXATTRIB4NIVPROC)load("glVertexAttrib4Niv");
+	context->VertexAttrib4Nsv = (PFNGLVERTEXATTRIB4NSVPROC)load("glVertexAttrib4Nsv");
+	context->VertexAttrib4Nub = (PFNGLVERTEXATTRIB4NUBPROC)load("glVertexAttrib4Nub");
+	context->VertexAttrib4Nubv = (PFNGLVERTEXATTRIB4NUBVPROC)load("glVertexAttrib4Nubv");
+	context->VertexAttrib4Nuiv = (PFNGLVERTEXATTRIB4NUIVPROC)load("glVertexAttrib4Nuiv");
+	context->VertexAttrib4Nusv = (PFNGLVERTEXATTRIB4NUSVPROC)load("glVertexAttrib4Nusv");
+	context->VertexAttrib4bv = (PFNGLVERTEXATTRIB4BVPROC)load("glVertexAttrib4bv");
+	context->VertexAttrib4d = (PFNGLVERTEXATTRIB4DPROC)load("glVertexAttrib4d");
+	context->VertexAttrib4dv = (PFNGLVERTEXATTRIB4DVPROC)load("glVertexAttrib4dv");
+	context->VertexAttrib4f = (PFNGLVERTEXATTRIB4FPROC)load("glVertexAttrib4f");
+	context->VertexAttrib4fv = (PFNGLVERTEXATTRIB4FVPROC)load("glVertexAttrib4fv");
+	context->VertexAttrib4iv = (PFNGLVERTEXATTRIB4IVPROC)load("glVertexAttrib4iv");
+	context->VertexAttrib4s = (PFNGLVERTEXATTRIB4SPROC)load("glVertexAttrib4s");
+	context->VertexAttrib4sv = (PFNGLVERTEXATTRIB4SVPROC)load("glVertexAttrib4sv");
+	context->VertexAttrib4ubv = (PFNGLVERTEXATTRIB4UBVPROC)load("glVertexAttrib4ubv");
+	context->VertexAttrib4uiv = (PFNGLVERTEXATTRIB4UIVPROC)load("glVertexAttrib4uiv");
+	context->VertexAttrib4usv = (PFNGLVERTEXATTRIB4USVPROC)load("glVertexAttrib4usv");
+	context->VertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC)load("glVertexAttribPointer");
+}
+static void load_GL_VERSION_2_1_context(GladGLContext *context, GLADloadproc load) {
+	if(!context->VERSION_2_1) return;
+	context->UniformMatrix2x3fv = (PFNGLUNIFORMMATRIX2X3FVPROC)load("glUniformMatrix2x3fv");
+	context->UniformMatrix3x2fv = (PFNGLUNIFORMMATRIX3X2FVPROC)load("glUniformMatrix3x2fv");
+	context->UniformMatrix2x4fv = (PFNGLUNIFORMMATRIX2X4FVPROC)load("glUniformMatrix2x4fv");
+	context->UniformMatrix4x2fv = (PFNGLUNIFORMMATRIX4X2FVPROC)load("glUniformMatrix4x2fv");
+	context->UniformMatrix3x4fv = (PFNGLUNIFORMMATRIX3X4FVPROC)load("glUniformMatrix3x4fv");
+	context->UniformMatrix4x3fv = (PFNGLUNIFORMMATRIX4X3FVPROC)load("glUniformMatrix4x3fv");
+}
+static void load_GL_VERSION_3_0_context(GladGLContext *context, GLADloadproc load) {
+	if(!context->VERSION_3_0) return;
+	context->ColorMaski = (PFNGLCOLORMASKIPROC)load("glColorMaski");
+	context->GetBooleani_v = (PFNGLGETBOOLEANI_VPROC)load("glGetBooleani_v");
+	context->GetIntegeri_v = (PFNGLGETINTEGERI_VPROC)load("glGetIntegeri_v");
+	context->Enablei = (PFNGLENABLEIPROC)load("glEnablei");
+	context->Disablei = (PFNGLDISABLEIPROC)load("glDisablei");
+	context->IsEnabledi = (PFNGLISENABLEDIPROC)load("glIsEnabledi");
+	context->BeginTransformFeedback = (PFNGLBEGINTRANSFORMFEEDBACKPROC)load("glBeginTransformFeedback");
+	context->EndTransformFeedback = (PFNGLENDTRANSFORMFEEDBACKPROC)load("glEndTransformFeedback");
+	context->BindBufferRange = (PFNGLBINDBUFFERRANGEPROC)load("glBindBufferRange");
+	context->BindBufferBase = (PFNGLBINDBUFFERBASEPROC)load("glBindBufferBase");
+	context->TransformFeedbackVaryings = (PFNGLTRANSFORMFEEDBACKVARYINGSPROC)load("glTransformFeedbackVaryings");
+	context->GetTransformFeedbackVarying = (PFNGLGETTRANSFORMFEEDBACKVARYINGPROC)load("glGetTransformFeedbackVarying");
+	context->ClampColor = (PFNGLCLAMPCOLORPROC)load("glClampColor");
+	context->BeginConditionalRender = (PFNGLBEGINCONDITIONALRENDERPROC)load("glBeginConditionalRender");
+	context->EndConditionalRender = (PFNGLENDCONDITIONALRENDERPROC)load("glEndConditionalRender");
+	context->VertexAttribIPointer = (PFNGLVERTEXATTRIBIPOINTERPROC)load("glVertexAttribIPointer");
+	context->GetVertexAttribIiv = (PFNGLGETVERTEXATTRIBIIVPROC)load("glGetVertexAttribIiv");
+	context->GetVertexAttribIuiv = (PFNGLGETVERTEXATTRIBIUIVPROC)load("glGetVertexAttribIuiv");
+	context->VertexAttribI1i = (PFNGLVERTEXATTRIBI1IPROC)load("glVertexAttribI1i");
+	context->VertexAttribI2i = (PFNGLVERTEXATTRIBI2IPROC)load("glVertexAttribI2i");
+	context->VertexAttribI3i = (PFNGLVERTEXATTRIBI3IPROC)load("glVertexAttribI3i");
+	context->VertexAttribI4i = (PFNGLVERTEXATTRIBI4IPROC)load("glVertexAttribI4i");
+	context->VertexAttribI1ui = (PFNGLVERTEXATTRIBI1UIPROC)load("glVertexAttribI1ui");
+	context->VertexAttribI2ui = (PFNGLVERTEXATTRIBI2UIPROC)load("glVertexAttribI2ui");
+	context->VertexAttribI3ui = (PFNGLVERTEXATTRIBI3UIPROC)load("glVertexAttribI3ui");
+	context->VertexAttribI4ui = (PFNGLVERTEXATTRIBI4UIPROC)load("glVertexAttribI4ui");
+	context->VertexAttribI1iv = (PFNGLVERTEXATTRIBI1IVPROC)load("glVertexAttribI1iv");
+	context->VertexAttribI2iv = (PFNGLVERTEXATTRIBI2IVPROC)load("glVertexAttribI2iv");
+	context->VertexAttribI3iv = (PFNGLVERTEXATTRIBI3IVPROC)load("glVertexAttribI3iv");
+	context->VertexAttribI4iv = (PFNGLVERTEXATTRIBI4IVPROC)load("glVertexAttribI4iv");
+	context->VertexAttribI1uiv = (PFNGLVERTEXATTRIBI1UIVPROC)load("glVertexAttribI1uiv");
+	context->VertexAttribI2uiv = (PFNGLVERTEXATTRIBI2UIVPROC)load("glVertexAttribI2uiv");
+	context->VertexAttribI3uiv = (PFNGLVERTEXATTRIBI3UIVPROC)load("glVertexAttribI3uiv");
+	context->VertexAttribI4uiv = (PFNGLVERTEXATTRIBI4UIVPROC)load("glVertexAttribI4uiv");
+	context->VertexAttribI4bv = (PFNGLVERTEXATTRIBI4BVPROC)load("glVertexAttribI4bv");
+	context->VertexAttribI4sv = (PFNGLVERTEXATTRIBI4SVPROC)load("glVertexAttribI4sv");
+	context->VertexAttribI4ubv = (PFNGLVERTEXATTRIBI4UBVPROC)load("glVertexAttribI4ubv");
+	context->VertexAttribI4usv = (PFNGLVERTEXATTRIBI4USVPROC)load("glVertexAttribI4usv");
+	context->GetUniformuiv = (PFNGLGETUNIFORMUIVPROC)load("glGetUniformuiv");
+	context->BindFragDataLocation = (PFNGLBINDFRAGDATALOCATIONPROC)load("glBindFragDataLocation");
+	context->GetFragDataLocation = (PFNGLGETFRAGDATALOCATIONPROC)load("glGetFragDataLocation");
+	context->Uniform1ui = (PFNGLUNIFORM1UIPROC)load("glUniform1ui");
+	context->Uniform2ui = (PFNGLUNIFORM2UIPROC)load("glUniform2ui");
+	context->Uniform3ui = (PFNGLUNIFORM3UIPROC)load("glUniform3ui");
+	context->Uniform4ui = (PFNGLUNIFORM4UIPROC)load("glUniform4ui");
+	context->Uniform1uiv = (PFNGLUNIFORM1UIVPROC)load("glUniform1uiv");
+	context->Uniform2uiv = (PFNGLUNIFORM2UIVPROC)load("glUniform2uiv");
+	context->Uniform3uiv = (PFNGLUNIFORM3UIVPROC)load("glUniform3uiv");
+	context->Uniform4uiv = (PFNGLUNIFORM4UIVPROC)load("glUniform4uiv");
+	context->TexParameterIiv = (PFNGLTEXPARAMETERIIVPROC)load("glTexParameterIiv");
+	context->TexParameterIuiv = (PFNGLTEXPARAMETERIUIVPROC)load("glTexParameterIuiv");
+	context->GetTexParameterIiv = (PFNGLGETTEXPARAMETERIIVPROC)load("glGetTexParameterIiv");
+	context->GetTexParameterIuiv = (PFNGLGETTEXPARAMETERIUIVPROC)load("glGetTexParameterIuiv");
+	context->ClearBufferiv = (PFNGLCLEARBUFFERIVPROC)load("glClearBufferiv");
+	context->ClearBufferuiv = (PFNGLCLEARBUFFERUIVPROC)load("glClearBufferuiv");
+	context->ClearBufferfv = (PFNGLCLEARBUFFERFVPROC)load("glClearBufferfv");
+	context->ClearBufferfi = (PFNGLCLEARBUFFERFIPROC)load("glClearBufferfi");
+	context->GetStringi = (PFNGLGETSTRINGIPROC)load("glGetStringi");
+	context->IsRenderbuffer = (PFNGLISRENDERBUFFERPROC)load("glIsRenderbuffer");
+	context->BindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC)load("glBindRenderbuffer");
+	context->DeleteRenderbuffers = (PFNGLDELETERENDERBUFFERSPROC)load("glDeleteRenderbuffers");
+	context->GenRenderbuffers = (PFNGLGENRENDERBUFFERSPROC)load("glGenRenderbuffers");
+	context->RenderbufferStorage = (PFNGLRENDERBUFFERSTORAGEPROC)load("glRenderbufferStorage");
+	context->GetRenderbufferParameteriv = (PFNGLGETRENDERBUFFERPARAMETERIVPROC)load("glGetRenderbufferParameteriv");
+	context->IsFramebuffer = (PFNGLISFRAMEBUFFERPROC)load("glIsFramebuffer");
+	context->BindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)load("glBindFramebuffer");
+	context->DeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)load("glDeleteFramebuffers");
+	context->GenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)load("glGenFramebuffers");
+	context->CheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)load("glCheckFramebufferStatus");
+	context->FramebufferTexture1D = (PFNGLFRAMEBUFFERTEXTURE1DPROC)load("glFramebufferTexture1D");
+	context->FramebufferTexture2D = (PFNGLFRAMEBUFFERTEXTURE2DPROC)load("glFramebufferTexture2D");
+	context->FramebufferTexture3D = (PFNGLFRAMEBUFFERTEXTURE3DPROC)load("glFramebufferTexture3D");
+	context->FramebufferRenderbuffer = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)load("glFramebufferRenderbuffer");
+	context->GetFramebufferAttachmentParameteriv = (PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC)load("glGetFramebufferAttachmentParameteriv");
+	context->GenerateMipmap = (PFNGLGENERATEMIPMAPPROC)load("glGenerateMipmap");
+	context->BlitFramebuffer = (PFNGLBLITFRAMEBUFFERPROC)load("glBlitFramebuffer");
+	context->RenderbufferStorageMultisample = (PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC)load("glRenderbufferStorageMultisample");
+	context->FramebufferTextureLayer = (PFNGLFRAMEBUFFERTEXTURELAYERPROC)load("glFramebufferTextureLayer");
+	context->MapBufferRange = (PFNGLMAPBUFFERRANGEPROC)load("glMapBufferRange");
+	context->FlushMappedBufferRange = (PFNGLFLUSHMAPPEDBUFFERRANGEPROC)load("glFlushMappedBufferRange");
+	context->BindVertexArray = (PFNGLBINDVERTEXARRAYPROC)load("glBindVertexArray");
+	context->DeleteVertexArrays = (PFNGLDELETEVERTEXARRAYSPROC)load("glDeleteVertexArrays");
+	context->GenVertexArrays = (PFNGLGENVERTEXARRAYSPROC)load("glGenVertexArrays");
+	context->IsVertexArray = (PFNGLISVERTEXARRAYPROC)load("glIsVertexArray");
+}
+static void load_GL_VERSION_3_1_context(GladGLContext *context, GLADloadproc load) {
+	if(!context->VERSION_3_1) return;
+	context->DrawArraysInstanced = (PFNGLDRAWARRAYSINSTANCEDPROC)load("glDrawArraysInstanced");
+	context->DrawElementsInstanced = (PFNGLDRAWELEMENTSINSTANCEDPROC)load("glDrawElementsInstanced");
+	context->TexBuffer = (PFNGLTEXBUFFERPROC)load("glTexBuffer");
+	context->PrimitiveRestartIndex = (PFNGLPRIMITIVERESTARTINDEXPROC)load("glPrimitiveRestartIndex");
+	context->CopyBufferSubData = (PFNGLCOPYBUFFERSUBDATAPROC)load("glCopyBufferSubData");
+	context->GetUniformIndices = (PFNGLGETUNIFORMINDICESPROC)load("glGetUniformIndices");
+	context->GetActiveUniformsiv = (PFNGLGETACTIVEUNIFORMSIVPROC)load("glGetActiveUniformsiv");
+	context->GetActiveUniformName = (PFNGLGETACTIVEUNIFORMNAMEPROC)load("glGetActiveUniformName");
+	context->GetUniformBlockIndex = (PFNGLGETUNIFORMBLOCKINDEXPROC)load("glGetUniformBlockIndex");
+	context->GetActiveUniformBlockiv = (PFNGLGETACTIVEUNIFORMBLOCKIVPROC)load("glGetActiveUniformBlockiv");
+	context->GetActiveUniformBlockName = (PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC)load("glGetActiveUniformBlockName");
+	context->UniformBlockBinding = (PFNGLUNIFORMBLOCKBINDINGPROC)load("glUniformBlockBinding");
+	context->BindBufferRange = (PFNGLBINDBUFFERRANGEPROC)load("glBindBufferRange");
+	context->BindBufferBase = (PFNGLBINDBUFFERBASEPROC)load("glBindBufferBase");
+	context->GetIntegeri_v = (PFNGLGETINTEGERI_VPROC)load("glGetIntegeri_v");
+}
+static void load_GL_VERSION_3_2_context(GladGLContext *context, GLADloadproc load) {
+	if(!context->VERSION_3_2) return;
+	context->DrawElementsBaseVertex = (PFNGLDRAWELEMENTSBASEVERTEXPROC)load("glDrawElementsBaseVertex");
+	context->DrawRangeElementsBaseVertex = (PFNGLDRAWRANGEELEMENTSBASEVERTEXPROC)load("glDrawRangeElementsBaseVertex");
+	context->DrawElementsInstancedBaseVertex = (PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC)load("glDrawElementsInstancedBaseVertex");
+	context->MultiDrawElementsBaseVertex = (PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC)load("glMultiDrawElementsBaseVertex");
+	context->ProvokingVertex = (PFNGLPROVOKINGVERTEXPROC)load("glProvokingVertex");
+	context->FenceSync = (PFNGLFENCESYNCPROC)load("glFenceSync");
+	context->IsSync = (PFNGLISSYNCPROC)load("glIsSync");
+	context->DeleteSync = (PFNGLDELETESYNCPROC)load("glDeleteSync");
+	context->ClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)load("glClientWaitSync");
+	context->WaitSync = (PFNGLWAITSYNCPROC)load("glWaitSync");
+	context->GetInteger64v = (PFNGLGETINTEGER64VPROC)load("glGetInteger64v");
+	context->GetSynciv = (PFNGLGETSYNCIVPROC)load("glGetSynciv");
+	context->GetInteger64i_v = (PFNGLGETINTEGER64I_VPROC)load("glGetInteger64i_v");
+	context->GetBufferParameteri64v = (PFNGLGETBUFFERPARAMETERI64VPROC)load("glGetBufferParameteri64v");
+	context->FramebufferTexture = (PFNGLFRAMEBUFFERTEXTUREPROC)load("glFramebufferTexture");
+	context->TexImage2DMultisample = (PFNGLTEXIMAGE2DMULTISAMPLEPROC)load("glTexImage2DMultisample");
+	context->TexImage3DMultisample = (PFNGLTEXIMAGE3DMULTISAMPLEPROC)load("glTexImage3DMultisample");
+	context->GetMultisamplefv = (PFNGLGETMULTISAMPLEFVPROC)load("glGetMultisamplefv");
+	context->SampleMaski = (PFNGLSAMPLEMASKIPROC)load("glSampleMaski");
+}
+static void load_GL_VERSION_3_3_context(GladGLContext *context, GLADloadproc load) {
+	if(!context->VERSION_3_3) return;
+	context->BindFragDataLocationIndexed = (PFNGLBINDFRAGDATALOCATIONINDEXEDPROC)load("glBindFragDataLocationIndexed");
+	context->GetFragDataIndex = (PFNGLGETFRAGDATAINDEXPROC)load("glGetFragDataIndex");
+	context->GenSamplers = (PFNGLGENSAMPLERSPROC)load("glGenSamplers");
+	context->DeleteSamplers = (PFNGLDELETESAMPLERSPROC)load("glDeleteSamplers");
+	context->IsSampler = (PFNGLISSAMPLERPROC)load("glIsSampler");
+	context->BindSampler = (PFNGLBINDSAMPLERPROC)load("glBindSampler");
+	context->SamplerParameteri = (PFNGLSAMPLERPARAMETERIPROC)load("glSamplerParameteri");
+	context->SamplerParameteriv = (PFNGLSAMPLERPARAMETERIVPROC)load("glSamplerParameteriv");
+	context->SamplerParameterf = (PFNGLSAMPLERPARAMETERFPROC)load("glSamplerParameterf");
+	context->SamplerParameterfv = (PFNGLSAMPLERPARAMETERFVPROC)load("glSamplerParameterfv");
+	context->SamplerParameterIiv = (PFNGLSAMPLERPARAMETERIIVPROC)load("glSamplerParameterIiv");
+	context->SamplerParameterIuiv = (PFNGLSAMPLERPARAMETERIUIVPROC)load("glSamplerParameterIuiv");
+	context->GetSamplerParameteriv = (PFNGLGETSAMPLERPARAMETERIVPROC)load("glGetSamplerParameteriv");
+	context->GetSamplerParameterIiv = (PFNGLGETSAMPLERPARAMETERIIVPROC)load("glGetSamplerParameterIiv");
+	context->GetSamplerParameterfv = (PFNGLGETSAMPLERPARAMETERFVPROC)load("glGetSamplerParameterfv");
+	context->GetSamplerParameterIuiv = (PFNGLGETSAMPLERPARAMETERIUIVPROC)load("glGetSamplerParameterIuiv");
+	context->QueryCounter = (PFNGLQUERYCOUNTERPROC)load("glQueryCounter");
+	context->GetQueryObjecti64v = (PFNGLGETQUERYOBJECTI64VPROC)load("glGetQueryObjecti64v");
+	context->GetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)load("glGetQueryObjectui64v");
+	context->VertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORPROC)load("glVertexAttribDivisor");
+	context->VertexAttribP1ui = (PFNGLVERTEXATTRIBP1UIPROC)load("glVertexAttribP1ui");
+	context->VertexAttribP1uiv = (PFNGLVERTEXATTRIBP1UIVPROC)load("glVertexAttribP1uiv");
+	context->VertexAttribP2ui = (PFNGLVERTEXATTRIBP2UIPROC)load("glVertexAttribP2ui");
+	context->VertexAttribP2uiv = (PFNGLVERTEXATTRIBP2UIVPROC)load("glVertexAttribP2uiv");
+	context->VertexAttribP3ui = (PFNGLVERTEXATTRIBP3UIPROC)load("glVertexAttribP3ui");
+	context->VertexAttribP3uiv = (PFNGLVERTEXATTRIBP3UIVPROC)load("glVertexAttribP3uiv");
+	context->VertexAttribP4ui = (PFNGLVERTEXATTRIBP4UIPROC)load("glVertexAttribP4ui");
+	context->VertexAttribP4uiv = (PFNGLVERTEXATTRIBP4UIVPROC)load("glVertexAttribP4uiv");
+	context->VertexP2ui = (PFNGLVERTEXP2UIPROC)load("glVertexP2ui");
+	context->VertexP2uiv = (PFNGLVERTEXP2UIVPROC)load("glVertexP2uiv");
+	context->VertexP3ui = (PFNGLVERTEXP3UIPROC)load("glVertexP3ui");
+	context->VertexP3uiv = (PFNGLVERTEXP3UIVPROC)load("glVertexP3uiv");
+	context->VertexP4ui = (PFNGLVERTEXP4UIPROC)load("glVertexP4ui");
+	context->VertexP4uiv = (PFNGLVERTEXP4UIVPROC)load("glVertexP4uiv");
+	context->TexCoordP1ui = (PFNGLTEXCOORDP1UIPROC)load("glTexCoordP1ui");
+	context->TexCoordP1uiv = (PFNGLTEXCOORDP1UIVPROC)load("glTexCoordP1uiv");
+	context->TexCoordP2ui = (PFNGLTEXCOORDP2UIPROC)load("glTexCoordP2ui");
+	context->TexCoordP2uiv = (PFNGLTEXCOORDP2UIVPROC)load("glTexCoordP2uiv");
+	context->TexCoordP3ui = (PFNGLTEXCOORDP3UIPROC)load("glTexCoordP3ui");
+	context->TexCoordP3uiv = (PFNGLTEXCOORDP3UIVPROC)load("glTexCoordP3uiv");
+	context->TexCoordP4ui = (PFNGLTEXCOORDP4UIPROC)load("glTexCoordP4ui");
+	context->TexCoordP4uiv = (PFNGLTEXCOORDP4UIVPROC)load("glTexCoordP4uiv");
+	context->MultiTexCoordP1ui = (PFNGLMULTITEXCOORDP1UIPROC)load("glMultiTexCoordP1ui");
+	context->MultiTexCoordP1uiv = (PFNGLMULTITEXCOORDP1UIVPROC)load("glMultiTexCoordP1uiv");
+	context->MultiTexCoordP2ui = (PFNGLMULTITEXCOORDP2UIPROC)load("glMultiTexCoordP2ui");
+	context->MultiTexCoordP2uiv = (PFNGLMULTITEXCOORDP2UIVPROC)load("glMultiTexCoordP2uiv");
+	context->MultiTexCoordP3ui = (PFNGLMULTITEXCOORDP3UIPROC)load("glMultiTexCoordP3ui");
+	context->MultiTexCoordP3uiv = (PFNGLMULTITEXCOORDP3UIVPROC)load("glMultiTexCoordP3uiv");
+	context->MultiTexCoordP4ui = (PFNGLMULTITEXCOORDP4UIPROC)load("glMultiTexCoordP4ui");
+	context->MultiTexCoordP4uiv = (PFNGLMULTITEXCOORDP4UIVPROC)load("glMultiTexCoordP4uiv");
+	context->NormalP3ui = (PFNGLNORMALP3UIPROC)load("glNormalP3ui");
+	context->NormalP3uiv = (PFNGLNORMALP3UIVPROC)load("glNormalP3uiv");
+	context->ColorP3ui = (PFNGLCOLORP3UIPROC)load("glColorP3ui");
+	context->ColorP3uiv = (PFNGLCOLORP3UIVPROC)load("glColorP3uiv");
+	context->ColorP4ui = (PFNGLCOLORP4UIPROC)load("glColorP4ui");
+	context->ColorP4uiv = (PFNGLCOLORP4UIVPROC)load("glColorP4uiv");
+	context->SecondaryColorP3ui = (PFNGLSECONDARYCOLORP3UIPROC)load("glSecondaryColorP3ui");
+	context->SecondaryColorP3uiv = (PFNGLSECONDARYCOLORP3UIVPROC)load("glSecondaryColorP3uiv");
+}
+static int find_extensions_context(GladGLContext *context, int major) {
+	struct gladExtensions e;
+	if (!get_exts(&e, major, context->GetString, context->GetIntegerv, context->GetStringi)) return 0;
+	(void)&has_ext;
+	free_exts(&e);
+	return 1;
+}
+
+static int find_core_context(GladGLContext *context) {
+    int i, major, minor;
+
+    const char* version;
+    const char* prefixes[] = {
+        "OpenGL ES-CM ",
+        "OpenGL ES-CL ",
+        "OpenGL ES ",
+        NULL
+    };
+
+    version = (const char*) context->GetString(GL_VERSION);
+    if (!version) return 0;
+
+    for (i = 0;  prefixes[i];  i++) {
+        const size_t length = strlen(prefixes[i]);
+        if (strncmp(version, prefixes[i], length) == 0) {
+            version += length;
+            break;
+        }
+    }
+
+    major = 0; minor = 0;
+#ifdef _MSC_VER
+    sscanf_s(version, "%d.%d", &major, &minor);
+#else
+    sscanf(version, "%d.%d", &major, &minor);
+#endif
+
+    context->version.major = major; context->version.minor = minor;
+	context->VERSION_1_0 = (major == 1 && minor >= 0) || major > 1;
+	context->VERSION_1_1 = (major == 1 && minor >= 1) || major > 1;
+	context->VERSION_1_2 = (major == 1 && minor >= 2) || major > 1;
+	context->VERSION_1_3 = (major == 1 && minor >= 3) || major > 1;
+	context->VERSION_1_4 = (major == 1 && minor >= 4) || major > 1;
+	context->VERSION_1_5 = (major == 1 && minor >= 5) || major > 1;
+	context->VERSION_2_0 = (major == 2 && minor >= 0) || major > 2;
+	context->VERSION_2_1 = (major == 2 && minor >= 1) || major > 2;
+	context->VERSION_3_0 = (major == 3 && minor >= 0) || major > 3;
+	context->VERSION_3_1 = (major == 3 && minor >= 1) || major > 3;
+	context->VERSION_3_2 = (major == 3 && minor >= 2) || major > 3;
+	context->VERSION_3_3 = (major == 3 && minor >= 3) || major > 3;
+	if (major > 3 || (major == 3 && minor > 3)) {
+		major = 3;
+	}
+	return major;
+}
+
+int gladLoadGLContext(GladGLContext *context, GLADloadproc load) {
+	int major;
+	memset(context, 0, sizeof(*context));
+	context->GetString = (PFNGLGETSTRINGPROC)load("glGetString");
+	if(context->GetString == NULL) return 0;
+	if(context->GetString(GL_VERSION) == NULL) return 0;
+	major = find_core_context(context);
+	load_GL_VERSION_1_0_context(context, load);
+	load_GL_VERSION_1_1_context(context, load);
+	load_GL_VERSION_1_2_context(context, load);
+	load_GL_VERSION_1_3_context(context, load);
+	load_GL_VERSION_1_4_context(context, load);
+	load_GL_VERSION_1_5_context(context, load);
+	load_GL_VERSION_2_0_context(context, load);
+	load_GL_VERSION_2_1_context(context, load);
+	load_GL_VERSION_3_0_context(context, load);
+	load_GL_VERSION_3_1_context(context, load);
+	load_GL_VERSION_3_2_context(context, load);
+	load_GL_VERSION_3_3_context(context, load);
+
+	if (!find_extensions_context(context, major)) return 0;
+	return context->version.major != 0 || context->version.minor != 0;
+}
@@ -0,0 +1,433 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "tasks.h"
+
+// Уровни качества затенения: сколько срезов и шагов на сторону среза.
+// Стоимость растёт примерно как срезы * шаги, так что регулятор качества
+// может понижать уровень по lastMs(), не трогая остальной кадр.
+enum AOQuality
+{
+    AO_OFF,
+    AO_LOW,
+    AO_MEDIUM,
+    AO_HIGH
+};
+
+// Ambient occlusion в духе GTAO (Jimenez et al. 2016) для программного
+// растеризатора. Считается в половинном разрешении по глубине кадра: для
+// каждого пикселя ищутся горизонты в нескольких срезах и аналитически
+// интегрируется видимость с косинусом. Поворот срезов и шаги меняются от
+// кадра к кадру, а результат копится в истории с репроекцией по прошлой
+// камере, поэтому каждый кадр дёшев, а картинка сходится за несколько кадров.
+// Наверх результат поднимается с учётом глубины, чтобы не растекаться через
+// края предметов. Глубина — оконная [0, 1], строки снизу вверх, как у GL.
+class GroundTruthAO
+{
+public:
+    GroundTruthAO(ThreadPool& pool, int width, int height)
+        : pool(pool), width(width), height(height),
+          halfW((width + 1) / 2), halfH((height + 1) / 2),
+          positions((size_t)halfW * halfH), current((size_t)halfW * halfH)
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            history[i].assign((size_t)halfW * halfH, 1.0f);
+            historyZ[i].assign((size_t)halfW * halfH, 0.0f);
+            historyCount[i].assign((size_t)halfW * halfH, 0);
+        }
+    }
+
+    void setQuality(AOQuality q) { quality = q; }
+    AOQuality getQuality() const { return quality; }
+
+    // Радиус поиска горизонтов в мировых единицах
+    void setRadius(float r) { radius = r; }
+
+    // Время последнего apply(), мс — для регулятора качества
+    double lastMs() const { return elapsedMs; }
+
+    // Затенить color по depth; proj и view — камера этого кадра. Пиксели,
+    // отмеченные в skip (полупрозрачное поверх), остаются как есть.
+    void apply(const std::vector<float>& depth, const glm::mat4& proj, const glm::mat4& view, std::vector<uint32_t>& color,
+               const std::vector<uint8_t>* skip = nullptr)
+    {
+        if (quality == AO_OFF)
+        {
+            elapsedMs = 0.0;
+            hasHistory = false;
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+
+        invProj = glm::inverse(proj);
+        this->proj = proj;
+        // Направления срезов: шум пикселя выбирает один из ROTATIONS поворотов
+        int slices = sliceCount();
+        for (int s = 0; s < slices; ++s)
+            for (int r = 0; r < ROTATIONS; ++r)
+            {
+                float phi = ((float)s + ((float)r + 0.5f) / (float)ROTATIONS) * glm::pi<float>() / (float)slices;
+                directions[s * ROTATIONS + r] = glm::vec2(std::cos(phi), std::sin(phi));
+            }
+        pool.parallelFor((size_t)halfH, 8, [&](size_t begin, size_t end)
+        {
+            for (size_t y = begin; y < end; ++y)
+                downsampleRow(depth, (int)y);
+        });
+        pool.parallelFor((size_t)halfH, 4, [&](size_t begin, size_t end)
+        {
+            for (size_t y = begin; y < end; ++y)
+                occlusionRow((int)y);
+        });
+
+        // Из пространства этой камеры сразу в клип прошлой
+        glm::mat4 reproject = prevViewProj * glm::inverse(view);
+        int write = frame & 1, read = write ^ 1;
+        pool.parallelFor((size_t)halfH, 8, [&](size_t begin, size_t end)
+        {
+            for (size_t y = begin; y < end; ++y)
+                accumulateRow((int)y, reproject, read, write);
+        });
+        pool.parallelFor((size_t)height, 8, [&](size_t begin, size_t end)
+        {
+            for (size_t y = begin; y < end; ++y)
+                upsampleRow(depth, color, skip, (int)y, write);
+        });
+
+        prevViewProj = proj * view;
+        hasHistory = true;
+        ++frame;
+        elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+private:
+    static constexpr float MAX_RADIUS_PIXELS = 48.0f;   // в пикселях половинного разрешения
+    static constexpr uint8_t MAX_HISTORY = 8;            // кадров в скользящем среднем
+    static constexpr int MAX_SLICES = 3;
+    static constexpr int ROTATIONS = 16;
+
+    // Срезов за кадр немного: поворот меняется каждый кадр, и история
+    // из MAX_HISTORY кадров набирает в MAX_HISTORY раз больше направлений
+    int sliceCount() const { return quality == AO_LOW ? 1 : quality == AO_MEDIUM ? 2 : MAX_SLICES; }
+
+    // Позиция в пространстве камеры; z = 0 — небо
+    glm::vec3 viewPosition(float sx, float sy, float d) const
+    {
+        glm::vec4 ndc(sx / (float)width * 2.0f - 1.0f, sy / (float)height * 2.0f - 1.0f, d * 2.0f - 1.0f, 1.0f);
+        glm::vec4 v = invProj * ndc;
+        return glm::vec3(v) / v.w;
+    }
+
+    float linearDepth(float d) const
+    {
+        return -proj[3][2] / (d * 2.0f - 1.0f + proj[2][2]);
+    }
+
+    static float fract(float v) { return v - std::floor(v); }
+
+    // Interleaved gradient noise (Jimenez 2014): равномерный шум без текстуры
+    static float gradientNoise(float x, float y)
+    {
+        return fract(52.9829189f * fract(0.06711056f * x + 0.00583715f * y));
+    }
+
+    // Из четвёрки пикселей берётся ближайший: тонкие предметы не пропадают
+    void downsampleRow(const std::vector<float>& depth, int hy)
+    {
+        for (int hx = 0; hx < halfW; ++hx)
+        {
+            float best = 1.0f;
+            int bx = 0, by = 0;
+            for (int dy = 0; dy < 2; ++dy)
+                for (int dx = 0; dx < 2; ++dx)
+                {
+                    int x = std::min(hx * 2 + dx, width - 1), y = std::min(hy * 2 + dy, height - 1);
+                    float d = depth[(size_t)y * width + x];
+                    if (d < best)
+                    {
+                        best = d;
+                        bx = x;
+                        by = y;
+                    }
+                }
+            positions[(size_t)hy * halfW + hx] = best < 1.0f ? viewPosition(bx + 0.5f, by + 0.5f, best) : glm::vec3(0.0f);
+        }
+    }
+
+    const glm::vec3* positionAt(int x, int y) const
+    {
+        if (x < 0 || y < 0 || x >= halfW || y >= halfH)
+            return nullptr;
+        const glm::vec3& p = positions[(size_t)y * halfW + x];
+        return p.z < 0.0f ? &p : nullptr;
+    }
+
+    // Нормаль по глубине: с каждой оси берётся та сторона, чья линейная
+    // экстраполяция по двум соседям лучше попадает в центр. Простое «меньший
+    // скачок» путает поверхности на сгибах, где глубина непрерывна.
+    glm::vec3 reconstructNormal(int x, int y, const glm::vec3& p) const
+    {
+        auto pick = [&](int dx, int dy)
+        {
+            const glm::vec3* minus = positionAt(x - dx, y - dy);
+            const glm::vec3* plus = positionAt(x + dx, y + dy);
+            if (!minus && !plus)
+                return glm::vec3(0.0f);
+            if (!minus)
+                return *plus - p;
+            if (!plus)
+                return p - *minus;
+            const glm::vec3* minus2 = positionAt(x - 2 * dx, y - 2 * dy);
+            const glm::vec3* plus2 = positionAt(x + 2 * dx, y + 2 * dy);
+            float errorMinus = minus2 ? std::abs(2.0f * minus->z - minus2->z - p.z) : std::abs(minus->z - p.z);
+            float errorPlus = plus2 ? std::abs(2.0f * plus->z - plus2->z - p.z) : std::abs(plus->z - p.z);
+            return errorMinus < errorPlus ? p - *minus : *plus - p;
+        };
+        glm::vec3 n = glm::cross(pick(1, 0), pick(0, 1));
+        float len = glm::length(n);
+        if (len < 1e-12f)
+            return glm::normalize(-p);
+        n /= len;
+        return glm::dot(n, p) > 0.0f ? -n : n;
+    }
+
+    // acos с ошибкой ~1e-2 рад (Eberly): точнее для AO не нужно
+    static float fastAcos(float x)
+    {
+        float ax = std::abs(x);
+        float r = (-0.156583f * ax + glm::half_pi<float>()) * std::sqrt(1.0f - ax);
+        return x >= 0.0f ? r : glm::pi<float>() - r;
+    }
+
+    // Вклад одной стороны среза: интеграл cos-взвешенной видимости от нормали
+    // до горизонта h (Jimenez 2016). h = side * acos(horizonCos), ограничен
+    // полусферой вокруг нормали; cos(2h - n) раскрыт без тригонометрии.
+    static float arc(float horizonCos, float side, float angleN, float cosN, float sinN)
+    {
+        const float halfPi = glm::half_pi<float>();
+        float h = side * fastAcos(horizonCos);
+        float cos2hn;
+        if (side * (h - angleN) > halfPi)
+        {
+            h = angleN + side * halfPi;
+            cos2hn = -cosN;
+        }
+        else
+        {
+            float sinH = side * std::sqrt(std::max(1.0f - horizonCos * horizonCos, 0.0f));
+            cos2hn = (2.0f * horizonCos * horizonCos - 1.0f) * cosN + 2.0f * sinH * horizonCos * sinN;
+        }
+        return 0.25f * (cosN + 2.0f * h * sinN - cos2hn);
+    }
+
+    void occlusionRow(int y)
+    {
+        int slices = sliceCount();
+        int steps = quality == AO_HIGH ? 6 : 4;
+        // Проекция мировой единицы в пиксели половинного разрешения на глубине 1
+        float unitPixels = proj[1][1] * 0.5f * (float)halfH;
+        float frameShift = 5.588238f * (float)(frame % 64);
+        float invRadius2 = 1.0f / (radius * radius);
+
+        for (int x = 0; x < halfW; ++x)
+        {
+            size_t index = (size_t)y * halfW + x;
+            const glm::vec3* center = positionAt(x, y);
+            if (!center)
+            {
+                current[index] = 1.0f;
+                continue;
+            }
+            glm::vec3 p = *center;
+            float screenRadius = std::min(radius * unitPixels / -p.z, MAX_RADIUS_PIXELS);
+            if (screenRadius < 1.0f)
+            {
+                current[index] = 1.0f;
+                continue;
+            }
+
+            glm::vec3 v = glm::normalize(-p);
+            glm::vec3 n = reconstructNormal(x, y, p);
+            int rotation = (int)(gradientNoise((float)x + frameShift, (float)y + frameShift) * (float)ROTATIONS);
+            float stepJitter = gradientNoise((float)x + 2.0f * frameShift + 17.0f, (float)y + 31.0f);
+
+            float visibility = 0.0f;
+            for (int s = 0; s < slices; ++s)
+            {
+                glm::vec2 dir = directions[s * ROTATIONS + rotation];
+
+                // Плоскость среза проходит через направление на камеру
+                glm::vec3 dirView(dir, 0.0f);
+                glm::vec3 ortho = dirView - v * glm::dot(dirView, v);
+                glm::vec3 axis = glm::normalize(glm::cross(ortho, v));
+                glm::vec3 projN = n - axis * glm::dot(n, axis);
+                float projLen = glm::length(projN);
+                if (projLen < 1e-6f)
+                    continue;
+                float sign = glm::dot(ortho, projN) < 0.0f ? -1.0f : 1.0f;
+                float cosN = glm::clamp(glm::dot(projN, v) / projLen, -1.0f, 1.0f);
+                float sinN = sign * std::sqrt(1.0f - cosN * cosN);
+                float angleN = sign * fastAcos(cosN);
+
+                float horizonCos[2] = { -1.0f, -1.0f };
+                for (int side = 0; side < 2; ++side)
+                {
+                    glm::vec2 sideDir = side == 0 ? dir : -dir;
+                    for (int i = 0; i < steps; ++i)
+                    {
+                        // Квадратичное распределение: больше шагов у центра
+                        float t = ((float)i + stepJitter) / (float)steps;
+                        glm::vec2 offset = sideDir * std::max(t * t * screenRadius, 1.0f);
+                        const glm::vec3* sample = positionAt(x + (int)std::floor(offset.x + 0.5f), y + (int)std::floor(offset.y + 0.5f));
+                        if (!sample)
+                            continue;
+                        glm::vec3 delta = *sample - p;
+                        float dist2 = glm::dot(delta, delta);
+                        if (dist2 < 1e-12f)
+                            continue;
+                        // Вклад гаснет к краю радиуса
+                        float weight = glm::clamp((1.0f - dist2 * invRadius2) * 2.0f, 0.0f, 1.0f);
+                        float c = glm::mix(-1.0f, glm::dot(delta, v) / std::sqrt(dist2), weight);
+                        horizonCos[side] = std::max(horizonCos[side], c);
+                    }
+                }
+
+                // Положительная сторона среза — горизонт h1, отрицательная — h0
+                visibility += projLen * (arc(horizonCos[0], 1.0f, angleN, cosN, sinN) +
+                                         arc(horizonCos[1], -1.0f, angleN, cosN, sinN));
+            }
+            current[index] = glm::clamp(visibility / (float)slices, 0.0f, 1.0f);
+        }
+    }
+
+    // Скользящее среднее по репроецированной истории; при расхождении
+    // глубины (открывшаяся поверхность) история сбрасывается
+    void accumulateRow(int y, const glm::mat4& reproject, int read, int write)
+    {
+        for (int x = 0; x < halfW; ++x)
+        {
+            size_t index = (size_t)y * halfW + x;
+            const glm::vec3* p = positionAt(x, y);
+            float ao = current[index];
+            uint8_t count = 1;
+            if (p && hasHistory)
+            {
+                glm::vec4 clip = reproject * glm::vec4(*p, 1.0f);
+                if (clip.w > 0.0f)
+                {
+                    float px = (clip.x / clip.w * 0.5f + 0.5f) * (float)halfW;
+                    float py = (clip.y / clip.w * 0.5f + 0.5f) * (float)halfH;
+                    int hx = (int)std::floor(px), hy = (int)std::floor(py);
+                    if (hx >= 0 && hy >= 0 && hx < halfW && hy < halfH)
+                    {
+                        size_t prev = (size_t)hy * halfW + hx;
+                        float prevZ = historyZ[read][prev];
+                        if (prevZ < 0.0f && std::abs(prevZ + clip.w) < 0.05f * clip.w)
+                        {
+                            count = (uint8_t)std::min<int>(historyCount[read][prev] + 1, MAX_HISTORY);
+                            ao = glm::mix(history[read][prev], ao, 1.0f / (float)count);
+                        }
+                    }
+                }
+            }
+            history[write][index] = ao;
+            historyZ[write][index] = p ? p->z : 0.0f;
+            historyCount[write][index] = count;
+        }
+    }
+
+    float nearestAO(const float* ao, const float* aoZ, int hx, int hy, float z) const
+    {
+        float best = 1.0f, bestDiff = INFINITY;
+        for (int y = std::max(hy - 1, 0); y <= std::min(hy + 1, halfH - 1); ++y)
+            for (int x = std::max(hx - 1, 0); x <= std::min(hx + 1, halfW - 1); ++x)
+            {
+                size_t s = (size_t)y * halfW + x;
+                float diff = std::abs(aoZ[s] - z);
+                if (aoZ[s] < 0.0f && diff < bestDiff)
+                {
+                    best = ao[s];
+                    bestDiff = diff;
+                }
+            }
+        return best;
+    }
+
+    // Билинейные веса четырёх соседей половинного разрешения (при ровно
+    // половинном размере это всегда 1/4 и 3/4), умноженные на близость их
+    // глубины к глубине пикселя
+    void upsampleRow(const std::vector<float>& depth, std::vector<uint32_t>& color, const std::vector<uint8_t>* skip,
+                     int y, int write)
+    {
+        int y0 = (y - 1) >> 1;
+        float ty = (y & 1) ? 0.25f : 0.75f;
+        size_t rows[2] = { (size_t)std::max(y0, 0) * halfW, (size_t)std::min(y0 + 1, halfH - 1) * halfW };
+        const float rowWeight[2] = { 1.0f - ty, ty };
+        const float* ao = history[write].data();
+        const float* aoZ = historyZ[write].data();
+        for (int x = 0; x < width; ++x)
+        {
+            size_t index = (size_t)y * width + x;
+            float d = depth[index];
+            if (d >= 1.0f || (skip && (*skip)[index]))
+                continue;
+            float z = linearDepth(d);
+            float depthScale = -20.0f / z;   // 5% расхождения глубины — вес 0
+
+            int x0 = (x - 1) >> 1;
+            float tx = (x & 1) ? 0.25f : 0.75f;
+            int cols[2] = { std::max(x0, 0), std::min(x0 + 1, halfW - 1) };
+            const float colWeight[2] = { 1.0f - tx, tx };
+            float sum = 0.0f, weights = 0.0f;
+            for (int j = 0; j < 2; ++j)
+                for (int i = 0; i < 2; ++i)
+                {
+                    size_t s = rows[j] + cols[i];
+                    if (aoZ[s] >= 0.0f)
+                        continue;
+                    float w = colWeight[i] * rowWeight[j] * std::max(1.0f - std::abs(aoZ[s] - z) * depthScale, 0.0f);
+                    sum += ao[s] * w;
+                    weights += w;
+                }
+            // На силуэте ближайший из четвёрки бывает чужой поверхностью:
+            // тогда берётся самый близкий по глубине из окрестности 3x3
+            float value = weights > 0.0f ? sum / weights : nearestAO(ao, aoZ, x >> 1, y >> 1, z);
+
+            // Множитель в 8.8 с фиксированной точкой, каналы — целыми
+            uint32_t factor = (uint32_t)(value * 256.0f + 0.5f);
+            uint32_t c = color[index];
+            uint32_t rb = ((c & 0x00FF00FFu) * factor >> 8) & 0x00FF00FFu;
+            uint32_t g = ((c & 0x0000FF00u) * factor >> 8) & 0x0000FF00u;
+            color[index] = (c & 0xFF000000u) | rb | g;
+        }
+    }
+
+    ThreadPool& pool;
+    int width, height;
+    int halfW, halfH;
+
+    AOQuality quality = AO_MEDIUM;
+    float radius = 0.5f;
+    double elapsedMs = 0.0;
+
+    glm::mat4 proj = glm::mat4(1.0f), invProj = glm::mat4(1.0f);
+    glm::mat4 prevViewProj = glm::mat4(1.0f);
+    bool hasHistory = false;
+    uint32_t frame = 0;
+
+    glm::vec2 directions[MAX_SLICES * ROTATIONS];
+    std::vector<glm::vec3> positions;   // половинное разрешение, пространство камеры
+    std::vector<float> current;
+    std::vector<float> history[2];
+    std::vector<float> historyZ[2];
+    std::vector<uint8_t> historyCount[2];
+};
@@ -2122,6 +2122,1184 @@ GLAPI PFNGLSECONDARYCOLORP3UIVPROC glad_glSecondaryColorP3uiv;
 #define glSecondaryColorP3uiv glad_glSecondaryColorP3uiv
 #endif
 
+#ifndef GLAD_THREAD_LOCAL
+#if defined(__GNUC__)
+#define GLAD_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define GLAD_THREAD_LOCAL __declspec(thread)
+#elif defined(__cplusplus) && __cplusplus >= 201103L
+#define GLAD_THREAD_LOCAL thread_local
+#else
+#define GLAD_THREAD_LOCAL _Thread_local
+#endif
+#endif
+
+/* Per-context loader: every GL context owns its function table and
+ * capability flags. gladLoadGLContext() fills a table without touching
+ * any global state, so contexts can be loaded on their own threads at the
+ * same time. gladSetGLContext() makes a table current for the calling
+ * thread (a single pointer store). With GLAD_GL_CONTEXT_DISPATCH defined
+ * before this header, gl* calls and GLAD_GL_VERSION_* go through the
+ * current table of the calling thread instead of the glad_gl* globals. */
+typedef struct GladGLContext {
+    struct gladGLversionStruct version;
+    int VERSION_1_0;
+    int VERSION_1_1;
+    int VERSION_1_2;
+    int VERSION_1_3;
+    int VERSION_1_4;
+    int VERSION_1_5;
+    int VERSION_2_0;
+    int VERSION_2_1;
+    int VERSION_3_0;
+    int VERSION_3_1;
+    int VERSION_3_2;
+    int VERSION_3_3;
+    PFNGLCULLFACEPROC CullFace;
+    PFNGLFRONTFACEPROC FrontFace;
+    PFNGLHINTPROC Hint;
+    PFNGLLINEWIDTHPROC LineWidth;
+    PFNGLPOINTSIZEPROC PointSize;
+    PFNGLPOLYGONMODEPROC PolygonMode;
+    PFNGLSCISSORPROC Scissor;
+    PFNGLTEXPARAMETERFPROC TexParameterf;
+    PFNGLTEXPARAMETERFVPROC TexParameterfv;
+    PFNGLTEXPARAMETERIPROC TexParameteri;
+    PFNGLTEXPARAMETERIVPROC TexParameteriv;
+    PFNGLTEXIMAGE1DPROC TexImage1D;
+    PFNGLTEXIMAGE2DPROC TexImage2D;
+    PFNGLDRAWBUFFERPROC DrawBuffer;
+    PFNGLCLEARPROC Clear;
+    PFNGLCLEARCOLORPROC ClearColor;
+    PFNGLCLEARSTENCILPROC ClearStencil;
+    PFNGLCLEARDEPTHPROC ClearDepth;
+    PFNGLSTENCILMASKPROC StencilMask;
+    PFNGLCOLORMASKPROC ColorMask;
+    PFNGLDEPTHMASKPROC DepthMask;
+    PFNGLDISABLEPROC Disable;
+    PFNGLENABLEPROC Enable;
+    PFNGLFINISHPROC Finish;
+    PFNGLFLUSHPROC Flush;
+    PFNGLBLENDFUNCPROC BlendFunc;
+    PFNGLLOGICOPPROC LogicOp;
+    PFNGLSTENCILFUNCPROC StencilFunc;
+    PFNGLSTENCILOPPROC StencilOp;
+    PFNGLDEPTHFUNCPROC DepthFunc;
+    PFNGLPIXELSTOREFPROC PixelStoref;
+    PFNGLPIXELSTOREIPROC PixelStorei;
+    PFNGLREADBUFFERPROC ReadBuffer;
+    PFNGLREADPIXELSPROC ReadPixels;
+    PFNGLGETBOOLEANVPROC GetBooleanv;
+    PFNGLGETDOUBLEVPROC GetDoublev;
+    PFNGLGETERRORPROC GetError;
+    PFNGLGETFLOATVPROC GetFloatv;
+    PFNGLGETINTEGERVPROC GetIntegerv;
+    PFNGLGETSTRINGPROC GetString;
+    PFNGLGETTEXIMAGEPROC GetTexImage;
+    PFNGLGETTEXPARAMETERFVPROC GetTexParameterfv;
+    PFNGLGETTEXPARAMETERIVPROC GetTexParameteriv;
+    PFNGLGETTEXLEVELPARAMETERFVPROC GetTexLevelParameterfv;
+    PFNGLGETTEXLEVELPARAMETERIVPROC GetTexLevelParameteriv;
+    PFNGLISENABLEDPROC IsEnabled;
+    PFNGLDEPTHRANGEPROC DepthRange;
+    PFNGLVIEWPORTPROC Viewport;
+    PFNGLDRAWARRAYSPROC DrawArrays;
+    PFNGLDRAWELEMENTSPROC DrawElements;
+    PFNGLPOLYGONOFFSETPROC PolygonOffset;
+    PFNGLCOPYTEXIMAGE1DPROC CopyTexImage1D;
+    PFNGLCOPYTEXIMAGE2DPROC CopyTexImage2D;
+    PFNGLCOPYTEXSUBIMAGE1DPROC CopyTexSubImage1D;
+    PFNGLCOPYTEXSUBIMAGE2DPROC CopyTexSubImage2D;
+    PFNGLTEXSUBIMAGE1DPROC TexSubImage1D;
+    PFNGLTEXSUBIMAGE2DPROC TexSubImage2D;
+    PFNGLBINDTEXTUREPROC BindTexture;
+    PFNGLDELETETEXTURESPROC DeleteTextures;
+    PFNGLGENTEXTURESPROC GenTextures;
+    PFNGLISTEXTUREPROC IsTexture;
+    PFNGLDRAWRANGEELEMENTSPROC DrawRangeElements;
+    PFNGLTEXIMAGE3DPROC TexImage3D;
+    PFNGLTEXSUBIMAGE3DPROC TexSubImage3D;
+    PFNGLCOPYTEXSUBIMAGE3DPROC CopyTexSubImage3D;
+    PFNGLACTIVETEXTUREPROC ActiveTexture;
+    PFNGLSAMPLECOVERAGEPROC SampleCoverage;
+    PFNGLCOMPRESSEDTEXIMAGE3DPROC CompressedTexImage3D;
+    PFNGLCOMPRESSEDTEXIMAGE2DPROC CompressedTexImage2D;
+    PFNGLCOMPRESSEDTEXIMAGE1DPROC CompressedTexImage1D;
+    PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC CompressedTexSubImage3D;
+    PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC CompressedTexSubImage2D;
+    PFNGLCOMPRESSEDTEXSUBIMAGE1DPROC CompressedTexSubImage1D;
+    PFNGLGETCOMPRESSEDTEXIMAGEPROC GetCompressedTexImage;
+    PFNGLBLENDFUNCSEPARATEPROC BlendFuncSeparate;
+    PFNGLMULTIDRAWARRAYSPROC MultiDrawArrays;
+    PFNGLMULTIDRAWELEMENTSPROC MultiDrawElements;
+    PFNGLPOINTPARAMETERFPROC PointParameterf;
+    PFNGLPOINTPARAMETERFVPROC PointParameterfv;
+    PFNGLPOINTPARAMETERIPROC PointParameteri;
+    PFNGLPOINTPARAMETERIVPROC PointParameteriv;
+    PFNGLBLENDCOLORPROC BlendColor;
+    PFNGLBLENDEQUATIONPROC BlendEquation;
+    PFNGLGENQUERIESPROC GenQueries;
+    PFNGLDELETEQUERIESPROC DeleteQueries;
+    PFNGLISQUERYPROC IsQuery;
+    PFNGLBEGINQUERYPROC BeginQuery;
+    PFNGLENDQUERYPROC EndQuery;
+    PFNGLGETQUERYIVPROC GetQueryiv;
+    PFNGLGETQUERYOBJECTIVPROC GetQueryObjectiv;
+    PFNGLGETQUERYOBJECTUIVPROC GetQueryObjectuiv;
+    PFNGLBINDBUFFERPROC BindBuffer;
+    PFNGLDELETEBUFFERSPROC DeleteBuffers;
+    PFNGLGENBUFFERSPROC GenBuffers;
+    PFNGLISBUFFERPROC IsBuffer;
+    PFNGLBUFFERDATAPROC BufferData;
+    PFNGLBUFFERSUBDATAPROC BufferSubData;
+    PFNGLGETBUFFERSUBDATAPROC GetBufferSubData;
+    PFNGLMAPBUFFERPROC MapBuffer;
+    PFNGLUNMAPBUFFERPROC UnmapBuffer;
+    PFNGLGETBUFFERPARAMETERIVPROC GetBufferParameteriv;
+    PFNGLGETBUFFERPOINTERVPROC GetBufferPointerv;
+    PFNGLBLENDEQUATIONSEPARATEPROC BlendEquationSeparate;
+    PFNGLDRAWBUFFERSPROC DrawBuffers;
+    PFNGLSTENCILOPSEPARATEPROC StencilOpSeparate;
+    PFNGLSTENCILFUNCSEPARATEPROC StencilFuncSeparate;
+    PFNGLSTENCILMASKSEPARATEPROC StencilMaskSeparate;
+    PFNGLATTACHSHADERPROC AttachShader;
+    PFNGLBINDATTRIBLOCATIONPROC BindAttribLocation;
+    PFNGLCOMPILESHADERPROC CompileShader;
+    PFNGLCREATEPROGRAMPROC CreateProgram;
+    PFNGLCREATESHADERPROC CreateShader;
+    PFNGLDELETEPROGRAMPROC DeleteProgram;
+    PFNGLDELETESHADERPROC DeleteShader;
+    PFNGLDETACHSHADERPROC DetachShader;
+    PFNGLDISABLEVERTEXATTRIBARRAYPROC DisableVertexAttribArray;
+    PFNGLENABLEVERTEXATTRIBARRAYPROC EnableVertexAttribArray;
+    PFNGLGETACTIVEATTRIBPROC GetActiveAttrib;
+    PFNGLGETACTIVEUNIFORMPROC GetActiveUniform;
+    PFNGLGETATTACHEDSHADERSPROC GetAttachedShaders;
+    PFNGLGETATTRIBLOCATIONPROC GetAttribLocation;
+    PFNGLGETPROGRAMIVPROC GetProgramiv;
+    PFNGLGETPROGRAMINFOLOGPROC GetProgramInfoLog;
+    PFNGLGETSHADERIVPROC GetShaderiv;
+    PFNGLGETSHADERINFOLOGPROC GetShaderInfoLog;
+    PFNGLGETSHADERSOURCEPROC GetShaderSource;
+    PFNGLGETUNIFORMLOCATIONPROC GetUniformLocation;
+    PFNGLGETUNIFORMFVPROC GetUniformfv;
+    PFNGLGETUNIFORMIVPROC GetUniformiv;
+    PFNGLGETVERTEXATTRIBDVPROC GetVertexAttribdv;
+    PFNGLGETVERTEXATTRIBFVPROC GetVertexAttribfv;
+    PFNGLGETVERTEXATTRIBIVPROC GetVertexAttribiv;
+    PFNGLGETVERTEXATTRIBPOINTERVPROC GetVertexAttribPointerv;
+    PFNGLISPROGRAMPROC IsProgram;
+    PFNGLISSHADERPROC IsShader;
+    PFNGLLINKPROGRAMPROC LinkProgram;
+    PFNGLSHADERSOURCEPROC ShaderSource;
+    PFNGLUSEPROGRAMPROC UseProgram;
+    PFNGLUNIFORM1FPROC Uniform1f;
+    PFNGLUNIFORM2FPROC Uniform2f;
+    PFNGLUNIFORM3FPROC Uniform3f;
+    PFNGLUNIFORM4FPROC Uniform4f;
+    PFNGLUNIFORM1IPROC Uniform1i;
+    PFNGLUNIFORM2IPROC Uniform2i;
+    PFNGLUNIFORM3IPROC Uniform3i;
+    PFNGLUNIFORM4IPROC Uniform4i;
+    PFNGLUNIFORM1FVPROC Uniform1fv;
+    PFNGLUNIFORM2FVPROC Uniform2fv;
+    PFNGLUNIFORM3FVPROC Uniform3fv;
+    PFNGLUNIFORM4FVPROC Uniform4fv;
+    PFNGLUNIFORM1IVPROC Uniform1iv;
+    PFNGLUNIFORM2IVPROC Uniform2iv;
+    PFNGLUNIFORM3IVPROC Uniform3iv;
+    PFNGLUNIFORM4IVPROC Uniform4iv;
+    PFNGLUNIFORMMATRIX2FVPROC UniformMatrix2fv;
+    PFNGLUNIFORMMATRIX3FVPROC UniformMatrix3fv;
+    PFNGLUNIFORMMATRIX4FVPROC UniformMatrix4fv;
+    PFNGLVALIDATEPROGRAMPROC ValidateProgram;
+    PFNGLVERTEXATTRIB1DPROC VertexAttrib1d;
+    PFNGLVERTEXATTRIB1DVPROC VertexAttrib1dv;
+    PFNGLVERTEXATTRIB1FPROC VertexAttrib1f;
+    PFNGLVERTEXATTRIB1FVPROC VertexAttrib1fv;
+    PFNGLVERTEXATTRIB1SPROC VertexAttrib1s;
+    PFNGLVERTEXATTRIB1SVPROC VertexAttrib1sv;
+    PFNGLVERTEXATTRIB2DPROC VertexAttrib2d;
+    PFNGLVERTEXATTRIB2DVPROC VertexAttrib2dv;
+    PFNGLVERTEXATTRIB2FPROC VertexAttrib2f;
+    PFNGLVERTEXATTRIB2FVPROC VertexAttrib2fv;
+    PFNGLVERTEXATTRIB2SPROC VertexAttrib2s;
+    PFNGLVERTEXATTRIB2SVPROC VertexAttrib2sv;
+    PFNGLVERTEXATTRIB3DPROC VertexAttrib3d;
+    PFNGLVERTEXATTRIB3DVPROC VertexAttrib3dv;
+    PFNGLVERTEXATTRIB3FPROC VertexAttrib3f;
+    PFNGLVERTEXATTRIB3FVPROC VertexAttrib3fv;
+    PFNGLVERTEXATTRIB3SPROC VertexAttrib3s;
+    PFNGLVERTEXATTRIB3SVPROC VertexAttrib3sv;
+    PFNGLVERTEXATTRIB4NBVPROC VertexAttrib4Nbv;
+    PFNGLVERTEXATTRIB4NIVPROC VertexAttrib4Niv;
+    PFNGLVERTEXATTRIB4NSVPROC VertexAttrib4Nsv;
+    PFNGLVERTEXATTRIB4NUBPROC VertexAttrib4Nub;
+    PFNGLVERTEXATTRIB4NUBVPROC VertexAttrib4Nubv;
+    PFNGLVERTEXATTRIB4NUIVPROC VertexAttrib4Nuiv;
+    PFNGLVERTEXATTRIB4NUSVPROC VertexAttrib4Nusv;
+    PFNGLVERTEXATTRIB4BVPROC VertexAttrib4bv;
+    PFNGLVERTEXATTRIB4DPROC VertexAttrib4d;
+    PFNGLVERTEXATTRIB4DVPROC VertexAttrib4dv;
+    PFNGLVERTEXATTRIB4FPROC VertexAttrib4f;
+    PFNGLVERTEXATTRIB4FVPROC VertexAttrib4fv;
+    PFNGLVERTEXATTRIB4IVPROC VertexAttrib4iv;
+    PFNGLVERTEXATTRIB4SPROC VertexAttrib4s;
+    PFNGLVERTEXATTRIB4SVPROC VertexAttrib4sv;
+    PFNGLVERTEXATTRIB4UBVPROC VertexAttrib4ubv;
+    PFNGLVERTEXATTRIB4UIVPROC VertexAttrib4uiv;
+    PFNGLVERTEXATTRIB4USVPROC VertexAttrib4usv;
+    PFNGLVERTEXATTRIBPOINTERPROC VertexAttribPointer;
+    PFNGLUNIFORMMATRIX2X3FVPROC UniformMatrix2x3fv;
+    PFNGLUNIFORMMATRIX3X2FVPROC UniformMatrix3x2fv;
+    PFNGLUNIFORMMATRIX2X4FVPROC UniformMatrix2x4fv;
+    PFNGLUNIFORMMATRIX4X2FVPROC UniformMatrix4x2fv;
+    PFNGLUNIFORMMATRIX3X4FVPROC UniformMatrix3x4fv;
+    PFNGLUNIFORMMATRIX4X3FVPROC UniformMatrix4x3fv;
+    PFNGLCOLORMASKIPROC ColorMaski;
+    PFNGLGETBOOLEANI_VPROC GetBooleani_v;
+    PFNGLGETINTEGERI_VPROC GetIntegeri_v;
+    PFNGLENABLEIPROC Enablei;
+    PFNGLDISABLEIPROC Disablei;
+    PFNGLISENABLEDIPROC IsEnabledi;
+    PFNGLBEGINTRANSFORMFEEDBACKPROC BeginTransformFeedback;
+    PFNGLENDTRANSFORMFEEDBACKPROC EndTransformFeedback;
+    PFNGLBINDBUFFERRANGEPROC BindBufferRange;
+    PFNGLBINDBUFFERBASEPROC BindBufferBase;
+    PFNGLTRANSFORMFEEDBACKVARYINGSPROC TransformFeedbackVaryings;
+    PFNGLGETTRANSFORMFEEDBACKVARYINGPROC GetTransformFeedbackVarying;
+    PFNGLCLAMPCOLORPROC ClampColor;
+    PFNGLBEGINCONDITIONALRENDERPROC BeginConditionalRender;
+    PFNGLENDCONDITIONALRENDERPROC EndConditionalRender;
+    PFNGLVERTEXATTRIBIPOINTERPROC VertexAttribIPointer;
+    PFNGLGETVERTEXATTRIBIIVPROC GetVertexAttribIiv;
+    PFNGLGETVERTEXATTRIBIUIVPROC GetVertexAttribIuiv;
+    PFNGLVERTEXATTRIBI1IPROC VertexAttribI1i;
+    PFNGLVERTEXATTRIBI2IPROC VertexAttribI2i;
+    PFNGLVERTEXATTRIBI3IPROC VertexAttribI3i;
+    PFNGLVERTEXATTRIBI4IPROC VertexAttribI4i;
+    PFNGLVERTEXATTRIBI1UIPROC VertexAttribI1ui;
+    PFNGLVERTEXATTRIBI2UIPROC VertexAttribI2ui;
+    PFNGLVERTEXATTRIBI3UIPROC VertexAttribI3ui;
+    PFNGLVERTEXATTRIBI4UIPROC VertexAttribI4ui;
+    PFNGLVERTEXATTRIBI1IVPROC VertexAttribI1iv;
+    PFNGLVERTEXATTRIBI2IVPROC VertexAttribI2iv;
+    PFNGLVERTEXATTRIBI3IVPROC VertexAttribI3iv;
+    PFNGLVERTEXATTRIBI4IVPROC VertexAttribI4iv;
+    PFNGLVERTEXATTRIBI1UIVPROC VertexAttribI1uiv;
+    PFNGLVERTEXATTRIBI2UIVPROC VertexAttribI2uiv;
+    PFNGLVERTEXATTRIBI3UIVPROC VertexAttribI3uiv;
+    PFNGLVERTEXATTRIBI4UIVPROC VertexAttribI4uiv;
+    PFNGLVERTEXATTRIBI4BVPROC VertexAttribI4bv;
+    PFNGLVERTEXATTRIBI4SVPROC VertexAttribI4sv;
+    PFNGLVERTEXATTRIBI4UBVPROC VertexAttribI4ubv;
+    PFNGLVERTEXATTRIBI4USVPROC VertexAttribI4usv;
+    PFNGLGETUNIFORMUIVPROC GetUniformuiv;
+    PFNGLBINDFRAGDATALOCATIONPROC BindFragDataLocation;
+    PFNGLGETFRAGDATALOCATIONPROC GetFragDataLocation;
+    PFNGLUNIFORM1UIPROC Uniform1ui;
+    PFNGLUNIFORM2UIPROC Uniform2ui;
+    PFNGLUNIFORM3UIPROC Uniform3ui;
+    PFNGLUNIFORM4UIPROC Uniform4ui;
+    PFNGLUNIFORM1UIVPROC Uniform1uiv;
+    PFNGLUNIFORM2UIVPROC Uniform2uiv;
+    PFNGLUNIFORM3UIVPROC Uniform3uiv;
+    PFNGLUNIFORM4UIVPROC Uniform4uiv;
+    PFNGLTEXPARAMETERIIVPROC TexParameterIiv;
+    PFNGLTEXPARAMETERIUIVPROC TexParameterIuiv;
+    PFNGLGETTEXPARAMETERIIVPROC GetTexParameterIiv;
+    PFNGLGETTEXPARAMETERIUIVPROC GetTexParameterIuiv;
+    PFNGLCLEARBUFFERIVPROC ClearBufferiv;
+    PFNGLCLEARBUFFERUIVPROC ClearBufferuiv;
+    PFNGLCLEARBUFFERFVPROC ClearBufferfv;
+    PFNGLCLEARBUFFERFIPROC ClearBufferfi;
+    PFNGLGETSTRINGIPROC GetStringi;
+    PFNGLISRENDERBUFFERPROC IsRenderbuffer;
+    PFNGLBINDRENDERBUFFERPROC BindRenderbuffer;
+    PFNGLDELETERENDERBUFFERSPROC DeleteRenderbuffers;
+    PFNGLGENRENDERBUFFERSPROC GenRenderbuffers;
+    PFNGLRENDERBUFFERSTORAGEPROC RenderbufferStorage;
+    PFNGLGETRENDERBUFFERPARAMETERIVPROC GetRenderbufferParameteriv;
+    PFNGLISFRAMEBUFFERPROC IsFramebuffer;
+    PFNGLBINDFRAMEBUFFERPROC BindFramebuffer;
+    PFNGLDELETEFRAMEBUFFERSPROC DeleteFramebuffers;
+    PFNGLGENFRAMEBUFFERSPROC GenFramebuffers;
+    PFNGLCHECKFRAMEBUFFERSTATUSPROC CheckFramebufferStatus;
+    PFNGLFRAMEBUFFERTEXTURE1DPROC FramebufferTexture1D;
+    PFNGLFRAMEBUFFERTEXTURE2DPROC FramebufferTexture2D;
+    PFNGLFRAMEBUFFERTEXTURE3DPROC FramebufferTexture3D;
+    PFNGLFRAMEBUFFERRENDERBUFFERPROC FramebufferRenderbuffer;
+    PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC GetFramebufferAttachmentParameteriv;
+    PFNGLGENERATEMIPMAPPROC GenerateMipmap;
+    PFNGLBLITFRAMEBUFFERPROC BlitFramebuffer;
+    PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC RenderbufferStorageMultisample;
+    PFNGLFRAMEBUFFERTEXTURELAYERPROC FramebufferTextureLayer;
+    PFNGLMAPBUFFERRANGEPROC MapBufferRange;
+    PFNGLFLUSHMAPPEDBUFFERRANGEPROC FlushMappedBufferRange;
+    PFNGLBINDVERTEXARRAYPROC BindVertexArray;
+    PFNGLDELETEVERTEXARRAYSPROC DeleteVertexArrays;
+    PFNGLGENVERTEXARRAYSPROC GenVertexArrays;
+    PFNGLISVERTEXARRAYPROC IsVertexArray;
+    PFNGLDRAWARRAYSINSTANCEDPROC DrawArraysInstanced;
+    PFNGLDRAWELEMENTSINSTANCEDPROC DrawElementsInstanced;
+    PFNGLTEXBUFFERPROC TexBuffer;
+    PFNGLPRIMITIVERESTARTINDEXPROC PrimitiveRestartIndex;
+    PFNGLCOPYBUFFERSUBDATAPROC CopyBufferSubData;
+    PFNGLGETUNIFORMINDICESPROC GetUniformIndices;
+    PFNGLGETACTIVEUNIFORMSIVPROC GetActiveUniformsiv;
+    PFNGLGETACTIVEUNIFORMNAMEPROC GetActiveUniformName;
+    PFNGLGETUNIFORMBLOCKINDEXPROC GetUniformBlockIndex;
+    PFNGLGETACTIVEUNIFORMBLOCKIVPROC GetActiveUniformBlockiv;
+    PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC GetActiveUniformBlockName;
+    PFNGLUNIFORMBLOCKBINDINGPROC UniformBlockBinding;
+    PFNGLDRAWELEMENTSBASEVERTEXPROC DrawElementsBaseVertex;
+    PFNGLDRAWRANGEELEMENTSBASEVERTEXPROC DrawRangeElementsBaseVertex;
+    PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC DrawElementsInstancedBaseVertex;
+    PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC MultiDrawElementsBaseVertex;
+    PFNGLPROVOKINGVERTEXPROC ProvokingVertex;
+    PFNGLFENCESYNCPROC FenceSync;
+    PFNGLISSYNCPROC IsSync;
+    PFNGLDELETESYNCPROC DeleteSync;
+    PFNGLCLIENTWAITSYNCPROC ClientWaitSync;
+    PFNGLWAITSYNCPROC WaitSync;
+    PFNGLGETINTEGER64VPROC GetInteger64v;
+    PFNGLGETSYNCIVPROC GetSynciv;
+    PFNGLGETINTEGER64I_VPROC GetInteger64i_v;
+    PFNGLGETBUFFERPARAMETERI64VPROC GetBufferParameteri64v;
+    PFNGLFRAMEBUFFERTEXTUREPROC FramebufferTexture;
+    PFNGLTEXIMAGE2DMULTISAMPLEPROC TexImage2DMultisample;
+    PFNGLTEXIMAGE3DMULTISAMPLEPROC TexImage3DMultisample;
+    PFNGLGETMULTISAMPLEFVPROC GetMultisamplefv;
+    PFNGLSAMPLEMASKIPROC SampleMaski;
+    PFNGLBINDFRAGDATALOCATIONINDEXEDPROC BindFragDataLocationIndexed;
+    PFNGLGETFRAGDATAINDEXPROC GetFragDataIndex;
+    PFNGLGENSAMPLERSPROC GenSamplers;
+    PFNGLDELETESAMPLERSPROC DeleteSamplers;
+    PFNGLISSAMPLERPROC IsSampler;
+    PFNGLBINDSAMPLERPROC BindSampler;
+    PFNGLSAMPLERPARAMETERIPROC SamplerParameteri;
+    PFNGLSAMPLERPARAMETERIVPROC SamplerParameteriv;
+    PFNGLSAMPLERPARAMETERFPROC SamplerParameterf;
+    PFNGLSAMPLERPARAMETERFVPROC SamplerParameterfv;
+    PFNGLSAMPLERPARAMETERIIVPROC SamplerParameterIiv;
+    PFNGLSAMPLERPARAMETERIUIVPROC SamplerParameterIuiv;
+    PFNGLGETSAMPLERPARAMETERIVPROC GetSamplerParameteriv;
+    PFNGLGETSAMPLERPARAMETERIIVPROC GetSamplerParameterIiv;
+    PFNGLGETSAMPLERPARAMETERFVPROC GetSamplerParameterfv;
+    PFNGLGETSAMPLERPARAMETERIUIVPROC GetSamplerParameterIuiv;
+    PFNGLQUERYCOUNTERPROC QueryCounter;
+    PFNGLGETQUERYOBJECTI64VPROC GetQueryObjecti64v;
+    PFNGLGETQUERYOBJECTUI64VPROC GetQueryObjectui64v;
+    PFNGLVERTEXATTRIBDIVISORPROC VertexAttribDivisor;
+    PFNGLVERTEXATTRIBP1UIPROC VertexAttribP1ui;
+    PFNGLVERTEXATTRIBP1UIVPROC VertexAttribP1uiv;
+    PFNGLVERTEXATTRIBP2UIPROC VertexAttribP2ui;
+    PFNGLVERTEXATTRIBP2UIVPROC VertexAttribP2uiv;
+    PFNGLVERTEXATTRIBP3UIPROC VertexAttribP3ui;
+    PFNGLVERTEXATTRIBP3UIVPROC VertexAttribP3uiv;
+    PFNGLVERTEXATTRIBP4UIPROC VertexAttribP4ui;
+    PFNGLVERTEXATTRIBP4UIVPROC VertexAttribP4uiv;
+    PFNGLVERTEXP2UIPROC VertexP2ui;
+    PFNGLVERTEXP2UIVPROC VertexP2uiv;
+    PFNGLVERTEXP3UIPROC VertexP3ui;
+    PFNGLVERTEXP3UIVPROC VertexP3uiv;
+    PFNGLVERTEXP4UIPROC VertexP4ui;
+    PFNGLVERTEXP4UIVPROC VertexP4uiv;
+    PFNGLTEXCOORDP1UIPROC TexCoordP1ui;
+    PFNGLTEXCOORDP1UIVPROC TexCoordP1uiv;
+    PFNGLTEXCOORDP2UIPROC TexCoordP2ui;
+    PFNGLTEXCOORDP2UIVPROC TexCoordP2uiv;
+    PFNGLTEXCOORDP3UIPROC TexCoordP3ui;
+    PFNGLTEXCOORDP3UIVPROC TexCoordP3uiv;
+    PFNGLTEXCOORDP4UIPROC TexCoordP4ui;
+    PFNGLTEXCOORDP4UIVPROC TexCoordP4uiv;
+    PFNGLMULTITEXCOORDP1UIPROC MultiTexCoordP1ui;
+    PFNGLMULTITEXCOORDP1UIVPROC MultiTexCoordP1uiv;
+    PFNGLMULTITEXCOORDP2UIPROC MultiTexCoordP2ui;
+    PFNGLMULTITEXCOORDP2UIVPROC MultiTexCoordP2uiv;
+    PFNGLMULTITEXCOORDP3UIPROC MultiTexCoordP3ui;
+    PFNGLMULTITEXCOORDP3UIVPROC MultiTexCoordP3uiv;
+    PFNGLMULTITEXCOORDP4UIPROC MultiTexCoordP4ui;
+    PFNGLMULTITEXCOORDP4UIVPROC MultiTexCoordP4uiv;
+    PFNGLNORMALP3UIPROC NormalP3ui;
+    PFNGLNORMALP3UIVPROC NormalP3uiv;
+    PFNGLCOLORP3UIPROC ColorP3ui;
+    PFNGLCOLORP3UIVPROC ColorP3uiv;
+    PFNGLCOLORP4UIPROC ColorP4ui;
+    PFNGLCOLORP4UIVPROC ColorP4uiv;
+    PFNGLSECONDARYCOLORP3UIPROC SecondaryColorP3ui;
+    PFNGLSECONDARYCOLORP3UIVPROC SecondaryColorP3uiv;
+} GladGLContext;
+
+GLAPI GLAD_THREAD_LOCAL GladGLContext *glad_gl_context;
+
+GLAPI int gladLoadGLContext(GladGLContext *context, GLADloadproc load);
+GLAPI void gladSetGLContext(GladGLContext *context);
+GLAPI GladGLContext *gladGetGLContext(void);
+
+#ifdef GLAD_GL_CONTEXT_DISPATCH
+#define GLAD_GL_VERSION_1_0 (glad_gl_context->VERSION_1_0)
+#define GLAD_GL_VERSION_1_1 (glad_gl_context->VERSION_1_1)
+#define GLAD_GL_VERSION_1_2 (glad_gl_context->VERSION_1_2)
+#define GLAD_GL_VERSION_1_3 (glad_gl_context->VERSION_1_3)
+#define GLAD_GL_VERSION_1_4 (glad_gl_context->VERSION_1_4)
+#define GLAD_GL_VERSION_1_5 (glad_gl_context->VERSION_1_5)
+#define GLAD_GL_VERSION_2_0 (glad_gl_context->VERSION_2_0)
+#define GLAD_GL_VERSION_2_1 (glad_gl_context->VERSION_2_1)
+#define GLAD_GL_VERSION_3_0 (glad_gl_context->VERSION_3_0)
+#define GLAD_GL_VERSION_3_1 (glad_gl_context->VERSION_3_1)
+#define GLAD_GL_VERSION_3_2 (glad_gl_context->VERSION_3_2)
+#define GLAD_GL_VERSION_3_3 (glad_gl_context->VERSION_3_3)
+#undef glCullFace
+#define glCullFace (glad_gl_context->CullFace)
+#undef glFrontFace
+#define glFrontFace (glad_gl_context->FrontFace)
+#undef glHint
+#define glHint (glad_gl_context->Hint)
+#undef glLineWidth
+#define glLineWidth (glad_gl_context->LineWidth)
+#undef glPointSize
+#define glPointSize (glad_gl_context->PointSize)
+#undef glPolygonMode
+#define glPolygonMode (glad_gl_context->PolygonMode)
+#undef glScissor
+#define glScissor (glad_gl_context->Scissor)
+#undef glTexParameterf
+#define glTexParameterf (glad_gl_context->TexParameterf)
+#undef glTexParameterfv
+#define glTexParameterfv (glad_gl_context->TexParameterfv)
+#undef glTexParameteri
+#define glTexParameteri (glad_gl_context->TexParameteri)
+#undef glTexParameteriv
+#define glTexParameteriv (glad_gl_context->TexParameteriv)
+#undef glTexImage1D
+#define glTexImage1D (glad_gl_context->TexImage1D)
+#undef glTexImage2D
+#define glTexImage2D (glad_gl_context->TexImage2D)
+#undef glDrawBuffer
+#define glDrawBuffer (glad_gl_context->DrawBuffer)
+#undef glClear
+#define glClear (glad_gl_context->Clear)
+#undef glClearColor
+#define glClearColor (glad_gl_context->ClearColor)
+#undef glClearStencil
+#define glClearStencil (glad_gl_context->ClearStencil)
+#undef glClearDepth
+#define glClearDepth (glad_gl_context->ClearDepth)
+#undef glStencilMask
+#define glStencilMask (glad_gl_context->StencilMask)
+#undef glColorMask
+#define glColorMask (glad_gl_context->ColorMask)
+#undef glDepthMask
+#define glDepthMask (glad_gl_context->DepthMask)
+#undef glDisable
+#define glDisable (glad_gl_context->Disable)
+#undef glEnable
+#define glEnable (glad_gl_context->Enable)
+#undef glFinish
+#define glFinish (glad_gl_context->Finish)
+#undef glFlush
+#define glFlush (glad_gl_context->Flush)
+#undef glBlendFunc
+#define glBlendFunc (glad_gl_context->BlendFunc)
+#undef glLogicOp
+#define glLogicOp (glad_gl_context->LogicOp)
+#undef glStencilFunc
+#define glStencilFunc (glad_gl_context->StencilFunc)
+#undef glStencilOp
+#define glStencilOp (glad_gl_context->StencilOp)
+#undef glDepthFunc
+#define glDepthFunc (glad_gl_context->DepthFunc)
+#undef glPixelStoref
+#define glPixelStoref (glad_gl_context->PixelStoref)
+#undef glPixelStorei
+#define glPixelStorei (glad_gl_context->PixelStorei)
+#undef glReadBuffer
+#define glReadBuffer (glad_gl_context->ReadBuffer)
+#undef glReadPixels
+#define glReadPixels (glad_gl_context->ReadPixels)
+#undef glGetBooleanv
+#define glGetBooleanv (glad_gl_context->GetBooleanv)
+#undef glGetDoublev
+#define glGetDoublev (glad_gl_context->GetDoublev)
+#undef glGetError
+#define glGetError (glad_gl_context->GetError)
+#undef glGetFloatv
+#define glGetFloatv (glad_gl_context->GetFloatv)
+#undef glGetIntegerv
+#define glGetIntegerv (glad_gl_context->GetIntegerv)
+#undef glGetString
+#define glGetString (glad_gl_context->GetString)
+#undef glGetTexImage
+#define glGetTexImage (glad_gl_context->GetTexImage)
+#undef glGetTexParameterfv
+#define glGetTexParameterfv (glad_gl_context->GetTexParameterfv)
+#undef glGetTexParameteriv
+#define glGetTexParameteriv (glad_gl_context->GetTexParameteriv)
+#undef glGetTexLevelParameterfv
+#define glGetTexLevelParameterfv (glad_gl_context->GetTexLevelParameterfv)
+#undef glGetTexLevelParameteriv
+#define glGetTexLevelParameteriv (glad_gl_context->GetTexLevelParameteriv)
+#undef glIsEnabled
+#define glIsEnabled (glad_gl_context->IsEnabled)
+#undef glDepthRange
+#define glDepthRange (glad_gl_context->DepthRange)
+#undef glViewport
+#define glViewport (glad_gl_context->Viewport)
+#undef glDrawArrays
+#define glDrawArrays (glad_gl_context->DrawArrays)
+#undef glDrawElements
+#define glDrawElements (glad_gl_context->DrawElements)
+#undef glPolygonOffset
+#define glPolygonOffset (glad_gl_context->PolygonOffset)
+#undef glCopyTexImage1D
+#define glCopyTexImage1D (glad_gl_context->CopyTexImage1D)
+#undef glCopyTexImage2D
+#define glCopyTexImage2D (glad_gl_context->CopyTexImage2D)
+#undef glCopyTexSubImage1D
+#define glCopyTexSubImage1D (glad_gl_context->CopyTexSubImage1D)
+#undef glCopyTexSubImage2D
+#define glCopyTexSubImage2D (glad_gl_context->CopyTexSubImage2D)
+#undef glTexSubImage1D
+#define glTexSubImage1D (glad_gl_context->TexSubImage1D)
+#undef glTexSubImage2D
+#define glTexSubImage2D (glad_gl_context->TexSubImage2D)
+#undef glBindTexture
+#define glBindTexture (glad_gl_context->BindTexture)
+#undef glDeleteTextures
+#define glDeleteTextures (glad_gl_context->DeleteTextures)
+#undef glGenTextures
+#define glGenTextures (glad_gl_context->GenTextures)
+#undef glIsTexture
+#define glIsTexture (glad_gl_context->IsTexture)
+#undef glDrawRangeElements
+#define glDrawRangeElements (glad_gl_context->DrawRangeElements)
+#undef glTexImage3D
+#define glTexImage3D (glad_gl_context->TexImage3D)
+#undef glTexSubImage3D
+#define glTexSubImage3D (glad_gl_context->TexSubImage3D)
+#undef glCopyTexSubImage3D
+#define glCopyTexSubImage3D (glad_gl_context->CopyTexSubImage3D)
+#undef glActiveTexture
+#define glActiveTexture (glad_gl_context->ActiveTexture)
+#undef glSampleCoverage
+#define glSampleCoverage (glad_gl_context->SampleCoverage)
+#undef glCompressedTexImage3D
+#define glCompressedTexImage3D (glad_gl_context->CompressedTexImage3D)
+#undef glCompressedTexImage2D
+#define glCompressedTexImage2D (glad_gl_context->CompressedTexImage2D)
+#undef glCompressedTexImage1D
+#define glCompressedTexImage1D (glad_gl_context->CompressedTexImage1D)
+#undef glCompressedTexSubImage3D
+#define glCompressedTexSubImage3D (glad_gl_context->CompressedTexSubImage3D)
+#undef glCompressedTexSubImage2D
+#define glCompressedTexSubImage2D (glad_gl_context->CompressedTexSubImage2D)
+#undef glCompressedTexSubImage1D
+#define glCompressedTexSubImage1D (glad_gl_context->CompressedTexSubImage1D)
+#undef glGetCompressedTexImage
+#define glGetCompressedTexImage (glad_gl_context->GetCompressedTexImage)
+#undef glBlendFuncSeparate
+#define glBlendFuncSeparate (glad_gl_context->BlendFuncSeparate)
+#undef glMultiDrawArrays
+#define glMultiDrawArrays (glad_gl_context->MultiDrawArrays)
+#undef glMultiDrawElements
+#define glMultiDrawElements (glad_gl_context->MultiDrawElements)
+#undef glPointParameterf
+#define glPointParameterf (glad_gl_context->PointParameterf)
+#undef glPointParameterfv
+#define glPointParameterfv (glad_gl_context->PointParameterfv)
+#undef glPointParameteri
+#define glPointParameteri (glad_gl_context->PointParameteri)
+#undef glPointParameteriv
+#define glPointParameteriv (glad_gl_context->PointParameteriv)
+#undef glBlendColor
+#define glBlendColor (glad_gl_context->BlendColor)
+#undef glBlendEquation
+#define glBlendEquation (glad_gl_context->BlendEquation)
+#undef glGenQueries
+#define glGenQueries (glad_gl_context->GenQueries)
+#undef glDeleteQueries
+#define glDeleteQueries (glad_gl_context->DeleteQueries)
+#undef glIsQuery
+#define glIsQuery (glad_gl_context->IsQuery)
+#undef glBeginQuery
+#define glBeginQuery (glad_gl_context->BeginQuery)
+#undef glEndQuery
+#define glEndQuery (glad_gl_context->EndQuery)
+#undef glGetQueryiv
+#define glGetQueryiv (glad_gl_context->GetQueryiv)
+#undef glGetQueryObjectiv
+#define glGetQueryObjectiv (glad_gl_context->GetQueryObjectiv)
+#undef glGetQueryObjectuiv
+#define glGetQueryObjectuiv (glad_gl_context->GetQueryObjectuiv)
+#undef glBindBuffer
+#define glBindBuffer (glad_gl_context->BindBuffer)
+#undef glDeleteBuffers
+#define glDeleteBuffers (glad_gl_context->DeleteBuffers)
+#undef glGenBuffers
+#define glGenBuffers (glad_gl_context->GenBuffers)
+#undef glIsBuffer
+#define glIsBuffer (glad_gl_context->IsBuffer)
+#undef glBufferData
+#define glBufferData (glad_gl_context->BufferData)
+#undef glBufferSubData
+#define glBufferSubData (glad_gl_context->BufferSubData)
+#undef glGetBufferSubData
+#define glGetBufferSubData (glad_gl_context->GetBufferSubData)
+#undef glMapBuffer
+#define glMapBuffer (glad_gl_context->MapBuffer)
+#undef glUnmapBuffer
+#define glUnmapBuffer (glad_gl_context->UnmapBuffer)
+#undef glGetBufferParameteriv
+#define glGetBufferParameteriv (glad_gl_context->GetBufferParameteriv)
+#undef glGetBufferPointerv
+#define glGetBufferPointerv (glad_gl_context->GetBufferPointerv)
+#undef glBlendEquationSeparate
+#define glBlendEquationSeparate (glad_gl_context->BlendEquationSeparate)
+#undef glDrawBuffers
+#define glDrawBuffers (glad_gl_context->DrawBuffers)
+#undef glStencilOpSeparate
+#define glStencilOpSeparate (glad_gl_context->StencilOpSeparate)
+#undef glStencilFuncSeparate
+#define glStencilFuncSeparate (glad_gl_context->StencilFuncSeparate)
+#undef glStencilMaskSeparate
+#define glStencilMaskSeparate (glad_gl_context->StencilMaskSeparate)
+#undef glAttachShader
+#define glAttachShader (glad_gl_context->AttachShader)
+#undef glBindAttribLocation
+#define glBindAttribLocation (glad_gl_context->BindAttribLocation)
+#undef glCompileShader
+#define glCompileShader (glad_gl_context->CompileShader)
+#undef glCreateProgram
+#define glCreateProgram (glad_gl_context->CreateProgram)
+#undef glCreateShader
+#define glCreateShader (glad_gl_context->CreateShader)
+#undef glDeleteProgram
+#define glDeleteProgram (glad_gl_context->DeleteProgram)
+#undef glDeleteShader
+#define glDeleteShader (glad_gl_context->DeleteShader)
+#undef glDetachShader
+#define glDetachShader (glad_gl_context->DetachShader)
+#undef glDisableVertexAttribArray
+#define glDisableVertexAttribArray (glad_gl_context->DisableVertexAttribArray)
+#undef glEnableVertexAttribArray
+#define glEnableVertexAttribArray (glad_gl_context->EnableVertexAttribArray)
+#undef glGetActiveAttrib
+#define glGetActiveAttrib (glad_gl_context->GetActiveAttrib)
+#undef glGetActiveUniform
+#define glGetActiveUniform (glad_gl_context->GetActiveUniform)
+#undef glGetAttachedShaders
+#define glGetAttachedShaders (glad_gl_context->GetAttachedShaders)
+#undef glGetAttribLocation
+#define glGetAttribLocation (glad_gl_context->GetAttribLocation)
+#undef glGetProgramiv
+#define glGetProgramiv (glad_gl_context->GetProgramiv)
+#undef glGetProgramInfoLog
+#define glGetProgramInfoLog (glad_gl_context->GetProgramInfoLog)
+#undef glGetShaderiv
+#define glGetShaderiv (glad_gl_context->GetShaderiv)
+#undef glGetShaderInfoLog
+#define glGetShaderInfoLog (glad_gl_context->GetShaderInfoLog)
+#undef glGetShaderSource
+#define glGetShaderSource (glad_gl_context->GetShaderSource)
+#undef glGetUniformLocation
+#define glGetUniformLocation (glad_gl_context->GetUniformLocation)
+#undef glGetUniformfv
+#define glGetUniformfv (glad_gl_context->GetUniformfv)
+#undef glGetUniformiv
+#define glGetUniformiv (glad_gl_context->GetUniformiv)
+#undef glGetVertexAttribdv
+#define glGetVertexAttribdv (glad_gl_context->GetVertexAttribdv)
+#undef glGetVertexAttribfv
+#define glGetVertexAttribfv (glad_gl_context->GetVertexAttribfv)
+#undef glGetVertexAttribiv
+#define glGetVertexAttribiv (glad_gl_context->GetVertexAttribiv)
+#undef glGetVertexAttribPointerv
+#define glGetVertexAttribPointerv (glad_gl_context->GetVertexAttribPointerv)
+#undef glIsProgram
+#define glIsProgram (glad_gl_context->IsProgram)
+#undef glIsShader
+#define glIsShader (glad_gl_context->IsShader)
+#undef glLinkProgram
+#define glLinkProgram (glad_gl_context->LinkProgram)
+#undef glShaderSource
+#define glShaderSource (glad_gl_context->ShaderSource)
+#undef glUseProgram
+#define glUseProgram (glad_gl_context->UseProgram)
+#undef glUniform1f
+#define glUniform1f (glad_gl_context->Uniform1f)
+#undef glUniform2f
+#define glUniform2f (glad_gl_context->Uniform2f)
+#undef glUniform3f
+#define glUniform3f (glad_gl_context->Uniform3f)
+#undef glUniform4f
+#define glUniform4f (glad_gl_context->Uniform4f)
+#undef glUniform1i
+#define glUniform1i (glad_gl_context->Uniform1i)
+#undef glUniform2i
+#define glUniform2i (glad_gl_context->Uniform2i)
+#undef glUniform3i
+#define glUniform3i (glad_gl_context->Uniform3i)
+#undef glUniform4i
+#define glUniform4i (glad_gl_context->Uniform4i)
+#undef glUniform1fv
+#define glUniform1fv (glad_gl_context->Uniform1fv)
+#undef glUniform2fv
+#define glUniform2fv (glad_gl_context->Uniform2fv)
+#undef glUniform3fv
+#define glUniform3fv (glad_gl_context->Uniform3fv)
+#undef glUniform4fv
+#define glUniform4fv (glad_gl_context->Uniform4fv)
+#undef glUniform1iv
+#define glUniform1iv (glad_gl_context->Uniform1iv)
+#undef glUniform2iv
+#define glUniform2iv (glad_gl_context->Uniform2iv)
+#undef glUniform3iv
+#define glUniform3iv (glad_gl_context->Uniform3iv)
+#undef glUniform4iv
+#define glUniform4iv (glad_gl_context->Uniform4iv)
+#undef glUniformMatrix2fv
+#define glUniformMatrix2fv (glad_gl_context->UniformMatrix2fv)
+#undef glUniformMatrix3fv
+#define glUniformMatrix3fv (glad_gl_context->UniformMatrix3fv)
+#undef glUniformMatrix4fv
+#define glUniformMatrix4fv (glad_gl_context->UniformMatrix4fv)
+#undef glValidateProgram
+#define glValidateProgram (glad_gl_context->ValidateProgram)
+#undef glVertexAttrib1d
+#define glVertexAttrib1d (glad_gl_context->VertexAttrib1d)
+#undef glVertexAttrib1dv
+#define glVertexAttrib1dv (glad_gl_context->VertexAttrib1dv)
+#undef glVertexAttrib1f
+#define glVertexAttrib1f (glad_gl_context->VertexAttrib1f)
+#undef glVertexAttrib1fv
+#define glVertexAttrib1fv (glad_gl_context->VertexAttrib1fv)
+#undef glVertexAttrib1s
+#define glVertexAttrib1s (glad_gl_context->VertexAttrib1s)
+#undef glVertexAttrib1sv
+#define glVertexAttrib1sv (glad_gl_context->VertexAttrib1sv)
+#undef glVertexAttrib2d
+#define glVertexAttrib2d (glad_gl_context->VertexAttrib2d)
+#undef glVertexAttrib2dv
+#define glVertexAttrib2dv (glad_gl_context->VertexAttrib2dv)
+#undef glVertexAttrib2f
+#define glVertexAttrib2f (glad_gl_context->VertexAttrib2f)
+#undef glVertexAttrib2fv
+#define glVertexAttrib2fv (glad_gl_context->VertexAttrib2fv)
+#undef glVertexAttrib2s
+#define glVertexAttrib2s (glad_gl_context->VertexAttrib2s)
+#undef glVertexAttrib2sv
+#define glVertexAttrib2sv (glad_gl_context->VertexAttrib2sv)
+#undef glVertexAttrib3d
+#define glVertexAttrib3d (glad_gl_context->VertexAttrib3d)
+#undef glVertexAttrib3dv
+#define glVertexAttrib3dv (glad_gl_context->VertexAttrib3dv)
+#undef glVertexAttrib3f
+#define glVertexAttrib3f (glad_gl_context->VertexAttrib3f)
+#undef glVertexAttrib3fv
+#define glVertexAttrib3fv (glad_gl_context->VertexAttrib3fv)
+#undef glVertexAttrib3s
+#define glVertexAttrib3s (glad_gl_context->VertexAttrib3s)
+#undef glVertexAttrib3sv
+#define glVertexAttrib3sv (glad_gl_context->VertexAttrib3sv)
+#undef glVertexAttrib4Nbv
+#define glVertexAttrib4Nbv (glad_gl_context->VertexAttrib4Nbv)
+#undef glVertexAttrib4Niv
+#define glVertexAttrib4Niv (glad_gl_context->VertexAttrib4Niv)
+#undef glVertexAttrib4Nsv
+#define glVertexAttrib4Nsv (glad_gl_context->VertexAttrib4Nsv)
+#undef glVertexAttrib4Nub
+#define glVertexAttrib4Nub (glad_gl_context->VertexAttrib4Nub)
+#undef glVertexAttrib4Nubv
+#define glVertexAttrib4Nubv (glad_gl_context->VertexAttrib4Nubv)
+#undef glVertexAttrib4Nuiv
+#define glVertexAttrib4Nuiv (glad_gl_context->VertexAttrib4Nuiv)
+#undef glVertexAttrib4Nusv
+#define glVertexAttrib4Nusv (glad_gl_context->VertexAttrib4Nusv)
+#undef glVertexAttrib4bv
+#define glVertexAttrib4bv (glad_gl_context->VertexAttrib4bv)
+#undef glVertexAttrib4d
+#define glVertexAttrib4d (glad_gl_context->VertexAttrib4d)
+#undef glVertexAttrib4dv
+#define glVertexAttrib4dv (glad_gl_context->VertexAttrib4dv)
+#undef glVertexAttrib4f
+#define glVertexAttrib4f (glad_gl_context->VertexAttrib4f)
+#undef glVertexAttrib4fv
+#define glVertexAttrib4fv (glad_gl_context->VertexAttrib4fv)
+#undef glVertexAttrib4iv
+#define glVertexAttrib4iv (glad_gl_context->VertexAttrib4iv)
+#undef glVertexAttrib4s
+#define glVertexAttrib4s (glad_gl_context->VertexAttrib4s)
+#undef glVertexAttrib4sv
+#define glVertexAttrib4sv (glad_gl_context->VertexAttrib4sv)
+#undef glVertexAttrib4ubv
+#define glVertexAttrib4ubv (glad_gl_context->VertexAttrib4ubv)
+#undef glVertexAttrib4uiv
+#define glVertexAttrib4uiv (glad_gl_context->VertexAttrib4uiv)
+#undef glVertexAttrib4usv
+#define glVertexAttrib4usv (glad_gl_context->VertexAttrib4usv)
+#undef glVertexAttribPointer
+#define glVertexAttribPointer (glad_gl_context->VertexAttribPointer)
+#undef glUniformMatrix2x3fv
+#define glUniformMatrix2x3fv (glad_gl_context->UniformMatrix2x3fv)
+#undef glUniformMatrix3x2fv
+#define glUniformMatrix3x2fv (glad_gl_context->UniformMatrix3x2fv)
+#undef glUniformMatrix2x4fv
+#define glUniformMatrix2x4fv (glad_gl_context->UniformMatrix2x4fv)
+#undef glUniformMatrix4x2fv
+#define glUniformMatrix4x2fv (glad_gl_context->UniformMatrix4x2fv)
+#undef glUniformMatrix3x4fv
+#define glUniformMatrix3x4fv (glad_gl_context->UniformMatrix3x4fv)
+#undef glUniformMatrix4x3fv
+#define glUniformMatrix4x3fv (glad_gl_context->UniformMatrix4x3fv)
+#undef glColorMaski
+#define glColorMaski (glad_gl_context->ColorMaski)
+#undef glGetBooleani_v
+#define glGetBooleani_v (glad_gl_context->GetBooleani_v)
+#undef glGetIntegeri_v
+#define glGetIntegeri_v (glad_gl_context->GetIntegeri_v)
+#undef glEnablei
+#define glEnablei (glad_gl_context->Enablei)
+#undef glDisablei
+#define glDisablei (glad_gl_context->Disablei)
+#undef glIsEnabledi
+#define glIsEnabledi (glad_gl_context->IsEnabledi)
+#undef glBeginTransformFeedback
+#define glBeginTransformFeedback (glad_gl_context->BeginTransformFeedback)
+#undef glEndTransformFeedback
+#define glEndTransformFeedback (glad_gl_context->EndTransformFeedback)
+#undef glBindBufferRange
+#define glBindBufferRange (glad_gl_context->BindBufferRange)
+#undef glBindBufferBase
+#define glBindBufferBase (glad_gl_context->BindBufferBase)
+#undef glTransformFeedbackVaryings
+#define glTransformFeedbackVaryings (glad_gl_context->TransformFeedbackVaryings)
+#undef glGetTransformFeedbackVarying
+#define glGetTransformFeedbackVarying (glad_gl_context->GetTransformFeedbackVarying)
+#undef glClampColor
+#define glClampColor (glad_gl_context->ClampColor)
+#undef glBeginConditionalRender
+#define glBeginConditionalRender (glad_gl_context->BeginConditionalRender)
+#undef glEndConditionalRender
+#define glEndConditionalRender (glad_gl_context->EndConditionalRender)
+#undef glVertexAttribIPointer
+#define glVertexAttribIPointer (glad_gl_context->VertexAttribIPointer)
+#undef glGetVertexAttribIiv
+#define glGetVertexAttribIiv (glad_gl_context->GetVertexAttribIiv)
+#undef glGetVertexAttribIuiv
+#define glGetVertexAttribIuiv (glad_gl_context->GetVertexAttribIuiv)
+#undef glVertexAttribI1i
+#define glVertexAttribI1i (glad_gl_context->VertexAttribI1i)
+#undef glVertexAttribI2i
+#define glVertexAttribI2i (glad_gl_context->VertexAttribI2i)
+#undef glVertexAttribI3i
+#define glVertexAttribI3i (glad_gl_context->VertexAttribI3i)
+#undef glVertexAttribI4i
+#define glVertexAttribI4i (glad_gl_context->VertexAttribI4i)
+#undef glVertexAttribI1ui
+#define glVertexAttribI1ui (glad_gl_context->VertexAttribI1ui)
+#undef glVertexAttribI2ui
+#define glVertexAttribI2ui (glad_gl_context->VertexAttribI2ui)
+#undef glVertexAttribI3ui
+#define glVertexAttribI3ui (glad_gl_context->VertexAttribI3ui)
+#undef glVertexAttribI4ui
+#define glVertexAttribI4ui (glad_gl_context->VertexAttribI4ui)
+#undef glVertexAttribI1iv
+#define glVertexAttribI1iv (glad_gl_context->VertexAttribI1iv)
+#undef glVertexAttribI2iv
+#define glVertexAttribI2iv (glad_gl_context->VertexAttribI2iv)
+#undef glVertexAttribI3iv
+#define glVertexAttribI3iv (glad_gl_context->VertexAttribI3iv)
+#undef glVertexAttribI4iv
+#define glVertexAttribI4iv (glad_gl_context->VertexAttribI4iv)
+#undef glVertexAttribI1uiv
+#define glVertexAttribI1uiv (glad_gl_context->VertexAttribI1uiv)
+#undef glVertexAttribI2uiv
+#define glVertexAttribI2uiv (glad_gl_context->VertexAttribI2uiv)
+#undef glVertexAttribI3uiv
+#define glVertexAttribI3uiv (glad_gl_context->VertexAttribI3uiv)
+#undef glVertexAttribI4uiv
+#define glVertexAttribI4uiv (glad_gl_context->VertexAttribI4uiv)
+#undef glVertexAttribI4bv
+#define glVertexAttribI4bv (glad_gl_context->VertexAttribI4bv)
+#undef glVertexAttribI4sv
+#define glVertexAttribI4sv (glad_gl_context->VertexAttribI4sv)
+#undef glVertexAttribI4ubv
+#define glVertexAttribI4ubv (glad_gl_context->VertexAttribI4ubv)
+#undef glVertexAttribI4usv
+#define glVertexAttribI4usv (glad_gl_context->VertexAttribI4usv)
+#undef glGetUniformuiv
+#define glGetUniformuiv (glad_gl_context->GetUniformuiv)
+#undef glBindFragDataLocation
+#define glBindFragDataLocation (glad_gl_context->BindFragDataLocation)
+#undef glGetFragDataLocation
+#define glGetFragDataLocation (glad_gl_context->GetFragDataLocation)
+#undef glUniform1ui
+#define glUniform1ui (glad_gl_context->Uniform1ui)
+#undef glUniform2ui
+#define glUniform2ui (glad_gl_context->Uniform2ui)
+#undef glUniform3ui
+#define glUniform3ui (glad_gl_context->Uniform3ui)
+#undef glUniform4ui
+#define glUniform4ui (glad_gl_context->Uniform4ui)
+#undef glUniform1uiv
+#define glUniform1uiv (glad_gl_context->Uniform1uiv)
+#undef glUniform2uiv
+#define glUniform2uiv (glad_gl_context->Uniform2uiv)
+#undef glUniform3uiv
+#define glUniform3uiv (glad_gl_context->Uniform3uiv)
+#undef glUniform4uiv
+#define glUniform4uiv (glad_gl_context->Uniform4uiv)
+#undef glTexParameterIiv
+#define glTexParameterIiv (glad_gl_context->TexParameterIiv)
+#undef glTexParameterIuiv
+#define glTexParameterIuiv (glad_gl_context->TexParameterIuiv)
+#undef glGetTexParameterIiv
+#define glGetTexParameterIiv (glad_gl_context->GetTexParameterIiv)
+#undef glGetTexParameterIuiv
+#define glGetTexParameterIuiv (glad_gl_context->GetTexParameterIuiv)
+#undef glClearBufferiv
+#define glClearBufferiv (glad_gl_context->ClearBufferiv)
+#undef glClearBufferuiv
+#define glClearBufferuiv (glad_gl_context->ClearBufferuiv)
+#undef glClearBufferfv
+#define glClearBufferfv (glad_gl_context->ClearBufferfv)
+#undef glClearBufferfi
+#define glClearBufferfi (glad_gl_context->ClearBufferfi)
+#undef glGetStringi
+#define glGetStringi (glad_gl_context->GetStringi)
+#undef glIsRenderbuffer
+#define glIsRenderbuffer (glad_gl_context->IsRenderbuffer)
+#undef glBindRenderbuffer
+#define glBindRenderbuffer (glad_gl_context->BindRenderbuffer)
+#undef glDeleteRenderbuffers
+#define glDeleteRenderbuffers (glad_gl_context->DeleteRenderbuffers)
+#undef glGenRenderbuffers
+#define glGenRenderbuffers (glad_gl_context->GenRenderbuffers)
+#undef glRenderbufferStorage
+#define glRenderbufferStorage (glad_gl_context->RenderbufferStorage)
+#undef glGetRenderbufferParameteriv
+#define glGetRenderbufferParameteriv (glad_gl_context->GetRenderbufferParameteriv)
+#undef glIsFramebuffer
+#define glIsFramebuffer (glad_gl_context->IsFramebuffer)
+#undef glBindFramebuffer
+#define glBindFramebuffer (glad_gl_context->BindFramebuffer)
+#undef glDeleteFramebuffers
+#define glDeleteFramebuffers (glad_gl_context->DeleteFramebuffers)
+#undef glGenFramebuffers
+#define glGenFramebuffers (glad_gl_context->GenFramebuffers)
+#undef glCheckFramebufferStatus
+#define glCheckFramebufferStatus (glad_gl_context->CheckFramebufferStatus)
+#undef glFramebufferTexture1D
+#define glFramebufferTexture1D (glad_gl_context->FramebufferTexture1D)
+#undef glFramebufferTexture2D
+#define glFramebufferTexture2D (glad_gl_context->FramebufferTexture2D)
+#undef glFramebufferTexture3D
+#define glFramebufferTexture3D (glad_gl_context->FramebufferTexture3D)
+#undef glFramebufferRenderbuffer
+#define glFramebufferRenderbuffer (glad_gl_context->FramebufferRenderbuffer)
+#undef glGetFramebufferAttachmentParameteriv
+#define glGetFramebufferAttachmentParameteriv (glad_gl_context->GetFramebufferAttachmentParameteriv)
+#undef glGenerateMipmap
+#define glGenerateMipmap (glad_gl_context->GenerateMipmap)
+#undef glBlitFramebuffer
+#define glBlitFramebuffer (glad_gl_context->BlitFramebuffer)
+#undef glRenderbufferStorageMultisample
+#define glRenderbufferStorageMultisample (glad_gl_context->RenderbufferStorageMultisample)
+#undef glFramebufferTextureLayer
+#define glFramebufferTextureLayer (glad_gl_context->FramebufferTextureLayer)
+#undef glMapBufferRange
+#define glMapBufferRange (glad_gl_context->MapBufferRange)
+#undef glFlushMappedBufferRange
+#define glFlushMappedBufferRange (glad_gl_context->FlushMappedBufferRange)
+#undef glBindVertexArray
+#define glBindVertexArray (glad_gl_context->BindVertexArray)
+#undef glDeleteVertexArrays
+#define glDeleteVertexArrays (glad_gl_context->DeleteVertexArrays)
+#undef glGenVertexArrays
+#define glGenVertexArrays (glad_gl_context->GenVertexArrays)
+#undef glIsVertexArray
+#define glIsVertexArray (glad_gl_context->IsVertexArray)
+#undef glDrawArraysInstanced
+#define glDrawArraysInstanced (glad_gl_context->DrawArraysInstanced)
+#undef glDrawElementsInstanced
+#define glDrawElementsInstanced (glad_gl_context->DrawElementsInstanced)
+#undef glTexBuffer
+#define glTexBuffer (glad_gl_context->TexBuffer)
+#undef glPrimitiveRestartIndex
+#define glPrimitiveRestartIndex (glad_gl_context->PrimitiveRestartIndex)
+#undef glCopyBufferSubData
+#define glCopyBufferSubData (glad_gl_context->CopyBufferSubData)
+#undef glGetUniformIndices
+#define glGetUniformIndices (glad_gl_context->GetUniformIndices)
+#undef glGetActiveUniformsiv
+#define glGetActiveUniformsiv (glad_gl_context->GetActiveUniformsiv)
+#undef glGetActiveUniformName
+#define glGetActiveUniformName (glad_gl_context->GetActiveUniformName)
+#undef glGetUniformBlockIndex
+#define glGetUniformBlockIndex (glad_gl_context->GetUniformBlockIndex)
+#undef glGetActiveUniformBlockiv
+#define glGetActiveUniformBlockiv (glad_gl_context->GetActiveUniformBlockiv)
+#undef glGetActiveUniformBlockName
+#define glGetActiveUniformBlockName (glad_gl_context->GetActiveUniformBlockName)
+#undef glUniformBlockBinding
+#define glUniformBlockBinding (glad_gl_context->UniformBlockBinding)
+#undef glDrawElementsBaseVertex
+#define glDrawElementsBaseVertex (glad_gl_context->DrawElementsBaseVertex)
+#undef glDrawRangeElementsBaseVertex
+#define glDrawRangeElementsBaseVertex (glad_gl_context->DrawRangeElementsBaseVertex)
+#undef glDrawElementsInstancedBaseVertex
+#define glDrawElementsInstancedBaseVertex (glad_gl_context->DrawElementsInstancedBaseVertex)
+#undef glMultiDrawElementsBaseVertex
+#define glMultiDrawElementsBaseVertex (glad_gl_context->MultiDrawElementsBaseVertex)
+#undef glProvokingVertex
+#define glProvokingVertex (glad_gl_context->ProvokingVertex)
+#undef glFenceSync
+#define glFenceSync (glad_gl_context->FenceSync)
+#undef glIsSync
+#define glIsSync (glad_gl_context->IsSync)
+#undef glDeleteSync
+#define glDeleteSync (glad_gl_context->DeleteSync)
+#undef glClientWaitSync
+#define glClientWaitSync (glad_gl_context->ClientWaitSync)
+#undef glWaitSync
+#define glWaitSync (glad_gl_context->WaitSync)
+#undef glGetInteger64v
+#define glGetInteger64v (glad_gl_context->GetInteger64v)
+#undef glGetSynciv
+#define glGetSynciv (glad_gl_context->GetSynciv)
+#undef glGetInteger64i_v
+#define glGetInteger64i_v (glad_gl_context->GetInteger64i_v)
+#undef glGetBufferParameteri64v
+#define glGetBufferParameteri64v (glad_gl_context->GetBufferParameteri64v)
+#undef glFramebufferTexture
+#define glFramebufferTexture (glad_gl_context->FramebufferTexture)
+#undef glTexImage2DMultisample
+#define glTexImage2DMultisample (glad_gl_context->TexImage2DMultisample)
+#undef glTexImage3DMultisample
+#define glTexImage3DMultisample (glad_gl_context->TexImage3DMultisample)
+#undef glGetMultisamplefv
+#define glGetMultisamplefv (glad_gl_context->GetMultisamplefv)
+#undef glSampleMaski
+#define glSampleMaski (glad_gl_context->SampleMaski)
+#undef glBindFragDataLocationIndexed
+#define glBindFragDataLocationIndexed (glad_gl_context->BindFragDataLocationIndexed)
+#undef glGetFragDataIndex
+#define glGetFragDataIndex (glad_gl_context->GetFragDataIndex)
+#undef glGenSamplers
+#define glGenSamplers (glad_gl_context->GenSamplers)
+#undef glDeleteSamplers
+#define glDeleteSamplers (glad_gl_context->DeleteSamplers)
+#undef glIsSampler
+#define glIsSampler (glad_gl_context->IsSampler)
+#undef glBindSampler
+#define glBindSampler (glad_gl_context->BindSampler)
+#undef glSamplerParameteri
+#define glSamplerParameteri (glad_gl_context->SamplerParameteri)
+#undef glSamplerParameteriv
+#define glSamplerParameteriv (glad_gl_context->SamplerParameteriv)
+#undef glSamplerParameterf
+#define glSamplerParameterf (glad_gl_context->SamplerParameterf)
+#undef glSamplerParameterfv
+#define glSamplerParameterfv (glad_gl_context->SamplerParameterfv)
+#undef glSamplerParameterIiv
+#define glSamplerParameterIiv (glad_gl_context->SamplerParameterIiv)
+#undef glSamplerParameterIuiv
+#define glSamplerParameterIuiv (glad_gl_context->SamplerParameterIuiv)
+#undef glGetSamplerParameteriv
+#define glGetSamplerParameteriv (glad_gl_context->GetSamplerParameteriv)
+#undef glGetSamplerParameterIiv
+#define glGetSamplerParameterIiv (glad_gl_context->GetSamplerParameterIiv)
+#undef glGetSamplerParameterfv
+#define glGetSamplerParameterfv (glad_gl_context->GetSamplerParameterfv)
+#undef glGetSamplerParameterIuiv
+#define glGetSamplerParameterIuiv (glad_gl_context->GetSamplerParameterIuiv)
+#undef glQueryCounter
+#define glQueryCounter (glad_gl_context->QueryCounter)
+#undef glGetQueryObjecti64v
+#define glGetQueryObjecti64v (glad_gl_context->GetQueryObjecti64v)
+#undef glGetQueryObjectui64v
+#define glGetQueryObjectui64v (glad_gl_context->GetQueryObjectui64v)
+#undef glVertexAttribDivisor
+#define glVertexAttribDivisor (glad_gl_context->VertexAttribDivisor)
+#undef glVertexAttribP1ui
+#define glVertexAttribP1ui (glad_gl_context->VertexAttribP1ui)
+#undef glVertexAttribP1uiv
+#define glVertexAttribP1uiv (glad_gl_context->VertexAttribP1uiv)
+#undef glVertexAttribP2ui
+#define glVertexAttribP2ui (glad_gl_context->VertexAttribP2ui)
+#undef glVertexAttribP2uiv
+#define glVertexAttribP2uiv (glad_gl_context->VertexAttribP2uiv)
+#undef glVertexAttribP3ui
+#define glVertexAttribP3ui (glad_gl_context->VertexAttribP3ui)
+#undef glVertexAttribP3uiv
+#define glVertexAttribP3uiv (glad_gl_context->VertexAttribP3uiv)
+#undef glVertexAttribP4ui
+#define glVertexAttribP4ui (glad_gl_context->VertexAttribP4ui)
+#undef glVertexAttribP4uiv
+#define glVertexAttribP4uiv (glad_gl_context->VertexAttribP4uiv)
+#undef glVertexP2ui
+#define glVertexP2ui (glad_gl_context->VertexP2ui)
+#undef glVertexP2uiv
+#define glVertexP2uiv (glad_gl_context->VertexP2uiv)
+#undef glVertexP3ui
+#define glVertexP3ui (glad_gl_context->VertexP3ui)
+#undef glVertexP3uiv
+#define glVertexP3uiv (glad_gl_context->VertexP3uiv)
+#undef glVertexP4ui
+#define glVertexP4ui (glad_gl_context->VertexP4ui)
+#undef glVertexP4uiv
+#define glVertexP4uiv (glad_gl_context->VertexP4uiv)
+#undef glTexCoordP1ui
+#define glTexCoordP1ui (glad_gl_context->TexCoordP1ui)
+#undef glTexCoordP1uiv
+#define glTexCoordP1uiv (glad_gl_context->TexCoordP1uiv)
+#undef glTexCoordP2ui
+#define glTexCoordP2ui (glad_gl_context->TexCoordP2ui)
+#undef glTexCoordP2uiv
+#define glTexCoordP2uiv (glad_gl_context->TexCoordP2uiv)
+#undef glTexCoordP3ui
+#define glTexCoordP3ui (glad_gl_context->TexCoordP3ui)
+#undef glTexCoordP3uiv
+#define glTexCoordP3uiv (glad_gl_context->TexCoordP3uiv)
+#undef glTexCoordP4ui
+#define glTexCoordP4ui (glad_gl_context->TexCoordP4ui)
+#undef glTexCoordP4uiv
+#define glTexCoordP4uiv (glad_gl_context->TexCoordP4uiv)
+#undef glMultiTexCoordP1ui
+#define glMultiTexCoordP1ui (glad_gl_context->MultiTexCoordP1ui)
+#undef glMultiTexCoordP1uiv
+#define glMultiTexCoordP1uiv (glad_gl_context->MultiTexCoordP1uiv)
+#undef glMultiTexCoordP2ui
+#define glMultiTexCoordP2ui (glad_gl_context->MultiTexCoordP2ui)
+#undef glMultiTexCoordP2uiv
+#define glMultiTexCoordP2uiv (glad_gl_context->MultiTexCoordP2uiv)
+#undef glMultiTexCoordP3ui
+#define glMultiTexCoordP3ui (glad_gl_context->MultiTexCoordP3ui)
+#undef glMultiTexCoordP3uiv
+#define glMultiTexCoordP3uiv (glad_gl_context->MultiTexCoordP3uiv)
+#undef glMultiTexCoordP4ui
+#define glMultiTexCoordP4ui (glad_gl_context->MultiTexCoordP4ui)
+#undef glMultiTexCoordP4uiv
+#define glMultiTexCoordP4uiv (glad_gl_context->MultiTexCoordP4uiv)
+#undef glNormalP3ui
+#define glNormalP3ui (glad_gl_context->NormalP3ui)
+#undef glNormalP3uiv
+#define glNormalP3uiv (glad_gl_context->NormalP3uiv)
+#undef glColorP3ui
+#define glColorP3ui (glad_gl_context->ColorP3ui)
+#undef glColorP3uiv
+#define glColorP3uiv (glad_gl_context->ColorP3uiv)
+#undef glColorP4ui
+#define glColorP4ui (glad_gl_context->ColorP4ui)
+#undef glColorP4uiv
+#define glColorP4uiv (glad_gl_context->ColorP4uiv)
+#undef glSecondaryColorP3ui
+#define glSecondaryColorP3ui (glad_gl_context->SecondaryColorP3ui)
+#undef glSecondaryColorP3uiv
+#define glSecondaryColorP3uiv (glad_gl_context->SecondaryColorP3uiv)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
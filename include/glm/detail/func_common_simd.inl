@@ -203,6 +203,18 @@ namespace detail
 			return Result;
 		}
 	};
+
+	template<qualifier Q>
+	struct compute_mix_vector<3, float, float, Q, true>
+	{
+		GLM_FUNC_QUALIFIER static vec<3, float, Q> call(vec<3, float, Q> const& x, vec<3, float, Q> const& y, vec<3, float, Q> const& a)
+		{
+			vec<3, float, Q> Result;
+			compute_vec3_io::store(Result, glm_vec3_mix(compute_vec3_io::load(x), compute_vec3_io::load(y), compute_vec3_io::load(a)));
+			return Result;
+		}
+	};
+
 /* FIXME
 	template<qualifier Q>
 	struct compute_step_vector<float, Q, tvec4>
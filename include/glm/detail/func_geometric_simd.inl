@@ -35,18 +35,47 @@ namespace detail
 		}
 	};
 
+	template<qualifier Q>
+	struct compute_length<3, float, Q, true>
+	{
+		GLM_FUNC_QUALIFIER static float call(vec<3, float, Q> const& v)
+		{
+			__m128 const v0 = compute_vec3_io::load(v);
+			return _mm_cvtss_f32(_mm_sqrt_ss(glm_vec3_dot(v0, v0)));
+		}
+	};
+
+	template<qualifier Q>
+	struct compute_dot<vec<3, float, Q>, float, true>
+	{
+		GLM_FUNC_QUALIFIER static float call(vec<3, float, Q> const& x, vec<3, float, Q> const& y)
+		{
+			return _mm_cvtss_f32(glm_vec3_dot(compute_vec3_io::load(x), compute_vec3_io::load(y)));
+		}
+	};
+
 	template<qualifier Q>
 	struct compute_cross<float, Q, true>
 	{
 		GLM_FUNC_QUALIFIER static vec<3, float, Q> call(vec<3, float, Q> const& a, vec<3, float, Q> const& b)
 		{
-			__m128 const set0 = _mm_set_ps(0.0f, a.z, a.y, a.x);
-			__m128 const set1 = _mm_set_ps(0.0f, b.z, b.y, b.x);
-			__m128 const xpd0 = glm_vec4_cross(set0, set1);
+			vec<3, float, Q> Result;
+			compute_vec3_io::store(Result, glm_vec4_cross(compute_vec3_io::load(a), compute_vec3_io::load(b)));
+			return Result;
+		}
+	};
 
-			vec<4, float, Q> Result;
-			Result.data = xpd0;
-			return vec<3, float, Q>(Result);
+	template<qualifier Q>
+	struct compute_normalize<3, float, Q, true>
+	{
+		GLM_FUNC_QUALIFIER static vec<3, float, Q> call(vec<3, float, Q> const& v)
+		{
+			__m128 const v0 = compute_vec3_io::load(v);
+			__m128 const inv0 = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(glm_vec3_dot(v0, v0)));
+
+			vec<3, float, Q> Result;
+			compute_vec3_io::store(Result, _mm_mul_ps(v0, inv0));
+			return Result;
 		}
 	};
 
@@ -0,0 +1,127 @@
+/// @ref core
+/// @file glm/detail/type_vec3_simd.inl
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+namespace glm{
+namespace detail
+{
+	/// Moves an aligned vec3 of floats in and out of a 4 lanes register. Aligned vec3 is padded
+	/// to 16 bytes and moved whole, padding lane included, which the constructors below keep
+	/// cleared. Packed vec3 has no padding lane: packing and unpacking its three components
+	/// costs more than the single operation saves, so it keeps the scalar code.
+	struct compute_vec3_io
+	{
+		template<qualifier Q>
+		GLM_FUNC_QUALIFIER static __m128 load(vec<3, float, Q> const& v)
+		{
+			GLM_IF_CONSTEXPR(sizeof(vec<3, float, Q>) == sizeof(__m128))
+				return _mm_load_ps(&v.x);
+			else
+				return _mm_set_ps(0.0f, v.z, v.y, v.x);
+		}
+
+		template<qualifier Q>
+		GLM_FUNC_QUALIFIER static void store(vec<3, float, Q>& v, __m128 data)
+		{
+			GLM_IF_CONSTEXPR(sizeof(vec<3, float, Q>) == sizeof(__m128))
+				_mm_store_ps(&v.x, data);
+			else
+			{
+				v.x = _mm_cvtss_f32(data);
+				v.y = _mm_cvtss_f32(_mm_shuffle_ps(data, data, _MM_SHUFFLE(1, 1, 1, 1)));
+				v.z = _mm_cvtss_f32(_mm_movehl_ps(data, data));
+			}
+		}
+	};
+
+	/// Divisor with its padding lane set to one, whatever the padding lane holds.
+	GLM_FUNC_QUALIFIER __m128 glm_vec3_divisor(__m128 v)
+	{
+		__m128 const Mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+		return _mm_or_ps(_mm_and_ps(Mask, v), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+	}
+
+	template<qualifier Q>
+	struct compute_vec3_add<float, Q, true>
+	{
+		GLM_FUNC_QUALIFIER static vec<3, float, Q> call(vec<3, float, Q> const& a, vec<3, float, Q> const& b)
+		{
+			vec<3, float, Q> Result;
+			compute_vec3_io::store(Result, _mm_add_ps(compute_vec3_io::load(a), compute_vec3_io::load(b)));
+			return Result;
+		}
+	};
+
+	template<qualifier Q>
+	struct compute_vec3_sub<float, Q, true>
+	{
+		GLM_FUNC_QUALIFIER static vec<3, float, Q> call(vec<3, float, Q> const& a, vec<3, float, Q> const& b)
+		{
+			vec<3, float, Q> Result;
+			compute_vec3_io::store(Result, _mm_sub_ps(compute_vec3_io::load(a), compute_vec3_io::load(b)));
+			return Result;
+		}
+	};
+
+	template<qualifier Q>
+	struct compute_vec3_mul<float, Q, true>
+	{
+		GLM_FUNC_QUALIFIER static vec<3, float, Q> call(vec<3, float, Q> const& a, vec<3, float, Q> const& b)
+		{
+			vec<3, float, Q> Result;
+			compute_vec3_io::store(Result, _mm_mul_ps(compute_vec3_io::load(a), compute_vec3_io::load(b)));
+			return Result;
+		}
+	};
+
+	template<qualifier Q>
+	struct compute_vec3_div<float, Q, true>
+	{
+		GLM_FUNC_QUALIFIER static vec<3, float, Q> call(vec<3, float, Q> const& a, vec<3, float, Q> const& b)
+		{
+			vec<3, float, Q> Result;
+			compute_vec3_io::store(Result, _mm_div_ps(compute_vec3_io::load(a), glm_vec3_divisor(compute_vec3_io::load(b))));
+			return Result;
+		}
+	};
+}//namespace detail
+
+	template<>
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, float, aligned_lowp>::vec(float _s)
+	{
+		detail::compute_vec3_io::store(*this, _mm_set_ps(0.0f, _s, _s, _s));
+	}
+
+	template<>
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, float, aligned_mediump>::vec(float _s)
+	{
+		detail::compute_vec3_io::store(*this, _mm_set_ps(0.0f, _s, _s, _s));
+	}
+
+	template<>
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, float, aligned_highp>::vec(float _s)
+	{
+		detail::compute_vec3_io::store(*this, _mm_set_ps(0.0f, _s, _s, _s));
+	}
+
+	template<>
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, float, aligned_lowp>::vec(float _x, float _y, float _z)
+	{
+		detail::compute_vec3_io::store(*this, _mm_set_ps(0.0f, _z, _y, _x));
+	}
+
+	template<>
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, float, aligned_mediump>::vec(float _x, float _y, float _z)
+	{
+		detail::compute_vec3_io::store(*this, _mm_set_ps(0.0f, _z, _y, _x));
+	}
+
+	template<>
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR vec<3, float, aligned_highp>::vec(float _x, float _y, float _z)
+	{
+		detail::compute_vec3_io::store(*this, _mm_set_ps(0.0f, _z, _y, _x));
+	}
+}//namespace glm
+
+#endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
@@ -16,6 +16,7 @@
 // Dependency:
 #include "type_precision.hpp"
 #include "../ext/vector_packing.hpp"
+#include <cstddef>
 
 #if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
 #	pragma message("GLM: GLM_GTC_packing extension included")
@@ -491,6 +492,73 @@ namespace glm
 	template<length_t L, typename T, qualifier Q>
 	GLM_FUNC_DECL vec<3, T, Q> unpackRGBM(vec<4, T, Q> const& rgbm);
 
+	/// Span versions of the HDR and 10-bit color formats: convert count values at once,
+	/// four at a time with SSE2 when GLM SIMD is enabled (GLM_FORCE_INTRINSICS or GLM_FORCE_SSE2).
+	/// The SIMD path and the scalar tail give the same bits, whatever the position in the span.
+	/// Color spans take vec3 or vec4 (w is ignored when packing, set to 1 when unpacking a vec4).
+	///
+	/// packF2x11_1x10 span truncates the mantissa like packF2x11_1x10 and is bit-exact with it
+	/// for values it encodes right. It also defines the others: zero, negative values and values
+	/// below 2^-14 give 0, finite values above the largest representable one give the largest one,
+	/// +Inf gives Inf and NaN gives NaN.
+	///
+	/// @see gtc_packing
+	/// @see uint32 packF2x11_1x10(vec3 const& v)
+	template<length_t L, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void packF2x11_1x10(vec<L, float, Q> const* v, uint32* out, std::size_t count);
+
+	/// unpackF2x11_1x10 span also decodes denormals, Inf and NaN, which unpackF2x11_1x10
+	/// does not. Normal values and zero are bit-exact with unpackF2x11_1x10.
+	///
+	/// @see gtc_packing
+	/// @see vec3 unpackF2x11_1x10(uint32 const& p)
+	template<length_t L, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void unpackF2x11_1x10(uint32 const* p, vec<L, float, Q>* out, std::size_t count);
+
+	/// packF3x9_E1x5 span, bit-exact with packF3x9_E1x5: same clamp to [0, 32768] and rounding.
+	/// The shared exponent comes from the bits of the largest component instead of log2. NaN gives 0.
+	///
+	/// @see gtc_packing
+	/// @see uint32 packF3x9_E1x5(vec3 const& v)
+	template<length_t L, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void packF3x9_E1x5(vec<L, float, Q> const* v, uint32* out, std::size_t count);
+
+	/// unpackF3x9_E1x5 span, bit-exact with unpackF3x9_E1x5.
+	///
+	/// @see gtc_packing
+	/// @see vec3 unpackF3x9_E1x5(uint32 const& p)
+	template<length_t L, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void unpackF3x9_E1x5(uint32 const* p, vec<L, float, Q>* out, std::size_t count);
+
+	/// packUnorm3x10_1x2 span, bit-exact with packUnorm3x10_1x2. Halves round away from zero,
+	/// which packUnorm3x10_1x2 only does when round of vec4 does not use SIMD.
+	///
+	/// @see gtc_packing
+	/// @see uint32 packUnorm3x10_1x2(vec4 const& v)
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void packUnorm3x10_1x2(vec<4, float, Q> const* v, uint32* out, std::size_t count);
+
+	/// unpackUnorm3x10_1x2 span, bit-exact with unpackUnorm3x10_1x2.
+	///
+	/// @see gtc_packing
+	/// @see vec4 unpackUnorm3x10_1x2(uint32 const& p)
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void unpackUnorm3x10_1x2(uint32 const* p, vec<4, float, Q>* out, std::size_t count);
+
+	/// packRGBM span, bit-exact with packRGBM.
+	///
+	/// @see gtc_packing
+	/// @see vec<4, T, Q> packRGBM(vec<3, float, Q> const& v)
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void packRGBM(vec<3, float, Q> const* rgb, vec<4, float, Q>* out, std::size_t count);
+
+	/// unpackRGBM span, bit-exact with unpackRGBM.
+	///
+	/// @see gtc_packing
+	/// @see vec<3, T, Q> unpackRGBM(vec<4, T, Q> const& p)
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void unpackRGBM(vec<4, float, Q> const* rgbm, vec<3, float, Q>* out, std::size_t count);
+
 	/// Returns an unsigned integer vector obtained by converting the components of a floating-point vector
 	/// to the 16-bit floating-point representation found in the OpenGL Specification.
 	/// The first vector component specifies the 16 least-significant bits of the result;
@@ -947,5 +947,387 @@ namespace detail
 		memcpy(&Unpack, &p, sizeof(Unpack));
 		return Unpack;
 	}
+
+	namespace detail
+	{
+		// Lanes of the span functions: same operations as the SSE2 paths, for the tails
+		// and for builds without SIMD. M is the mantissa width: 6 for F11, 5 for F10.
+		template<int M>
+		GLM_FUNC_QUALIFIER uint32 span_pack_packed_float(float x)
+		{
+			uint32 Bits = 0;
+			memcpy(&Bits, &x, sizeof(Bits));
+			if(x != x)
+				return (1u << (M + 5)) - 1u;
+			else if(x >= 65536.f)
+				return x == std::numeric_limits<float>::infinity() ? (31u << M) : (31u << M) - 1u;
+			else if(!(x >= 6.103515625e-05f)) // 2^-14, smallest normal
+				return 0u;
+			return (Bits - 0x38000000u) >> (23 - M);
+		}
+
+		template<int M>
+		GLM_FUNC_QUALIFIER float span_unpack_packed_float(uint32 p)
+		{
+			uint32 const Exp = p >> M;
+			if(Exp == 0u)
+				return static_cast<float>(p) * (M == 6 ? 9.5367431640625e-07f : 1.9073486328125e-06f); // 2^-(14 + M)
+			uint32 const Bits = (p << (23 - M)) + (Exp == 31u ? 0x70000000u : 0x38000000u);
+			float Result = 0;
+			memcpy(&Result, &Bits, sizeof(Result));
+			return Result;
+		}
+
+		GLM_FUNC_QUALIFIER float span_exp2(int e)
+		{
+			uint32 const Bits = static_cast<uint32>(e + 127) << 23;
+			float Result = 0;
+			memcpy(&Result, &Bits, sizeof(Result));
+			return Result;
+		}
+
+		GLM_FUNC_QUALIFIER uint32 span_pack_rgb9e5(float x, float y, float z)
+		{
+			float const r = x > 0.0f ? (x < 32768.f ? x : 32768.f) : 0.0f;
+			float const g = y > 0.0f ? (y < 32768.f ? y : 32768.f) : 0.0f;
+			float const b = z > 0.0f ? (z < 32768.f ? z : 32768.f) : 0.0f;
+			float const MaxRG = r > g ? r : g;
+			float const MaxColor = MaxRG > b ? MaxRG : b;
+
+			// floor(log2(MaxColor)) + 16 from the exponent bits, clamped to 0 like packF3x9_E1x5
+			uint32 Bits = 0;
+			memcpy(&Bits, &MaxColor, sizeof(Bits));
+			int ExpShared = static_cast<int>(Bits >> 23) - 111;
+			ExpShared = ExpShared > 0 ? ExpShared : 0;
+			if(static_cast<int>(MaxColor * span_exp2(24 - ExpShared) + 0.5f) == 512)
+				++ExpShared;
+
+			float const Scale = span_exp2(24 - ExpShared);
+			return
+				static_cast<uint32>(r * Scale + 0.5f) |
+				static_cast<uint32>(g * Scale + 0.5f) << 9 |
+				static_cast<uint32>(b * Scale + 0.5f) << 18 |
+				static_cast<uint32>(ExpShared) << 27;
+		}
+
+		template<length_t L, qualifier Q>
+		GLM_FUNC_QUALIFIER void span_store_rgb(vec<L, float, Q>& v, float x, float y, float z)
+		{
+			v[0] = x;
+			v[1] = y;
+			v[2] = z;
+			GLM_IF_CONSTEXPR(L == 4)
+				v[L - 1] = 1.0f;
+		}
+
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		// Four vec3 or vec4 to x, y, z, w lanes and back. Packed vec3 takes three loads and no w,
+		// 16 bytes vectors a load each and a transpose; w of an aligned vec3 is its padding.
+		template<length_t L, qualifier Q>
+		GLM_FUNC_QUALIFIER void span_load_x4(vec<L, float, Q> const* v, __m128& x, __m128& y, __m128& z, __m128& w)
+		{
+			GLM_IF_CONSTEXPR(sizeof(vec<L, float, Q>) == 3 * sizeof(float))
+			{
+				float const* p = &v[0][0];
+				__m128 const v0 = _mm_loadu_ps(p);
+				__m128 const v1 = _mm_loadu_ps(p + 4);
+				__m128 const v2 = _mm_loadu_ps(p + 8);
+				x = _mm_shuffle_ps(v0, _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+				y = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+				z = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(v2, v2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+				w = _mm_setzero_ps();
+			}
+			else
+			{
+				x = _mm_loadu_ps(&v[0][0]);
+				y = _mm_loadu_ps(&v[1][0]);
+				z = _mm_loadu_ps(&v[2][0]);
+				w = _mm_loadu_ps(&v[3][0]);
+				_MM_TRANSPOSE4_PS(x, y, z, w);
+			}
+		}
+
+		template<length_t L, qualifier Q>
+		GLM_FUNC_QUALIFIER void span_store_x4(vec<L, float, Q>* v, __m128 x, __m128 y, __m128 z, __m128 w)
+		{
+			GLM_IF_CONSTEXPR(sizeof(vec<L, float, Q>) == 3 * sizeof(float))
+			{
+				float* p = &v[0][0];
+				__m128 const xy = _mm_unpacklo_ps(x, y);
+				_mm_storeu_ps(p, _mm_shuffle_ps(xy, _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));
+				_mm_storeu_ps(p + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+				_mm_storeu_ps(p + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+			}
+			else
+			{
+				_MM_TRANSPOSE4_PS(x, y, z, w);
+				_mm_storeu_ps(&v[0][0], x);
+				_mm_storeu_ps(&v[1][0], y);
+				_mm_storeu_ps(&v[2][0], z);
+				_mm_storeu_ps(&v[3][0], w);
+			}
+		}
+
+		// w written by the unpack spans: 1 for vec4, the cleared padding for aligned vec3
+		template<length_t L>
+		GLM_FUNC_QUALIFIER __m128 span_store_w()
+		{
+			return L == 4 ? _mm_set1_ps(1.0f) : _mm_setzero_ps();
+		}
+
+		template<int M>
+		GLM_FUNC_QUALIFIER __m128i span_pack_packed_float_sse(__m128 x)
+		{
+			__m128 const Big = _mm_cmpge_ps(x, _mm_set1_ps(65536.f));
+			__m128 const Normal = _mm_andnot_ps(Big, _mm_cmpge_ps(x, _mm_set1_ps(6.103515625e-05f)));
+			__m128i const Inf = _mm_castps_si128(_mm_cmpeq_ps(x, _mm_set1_ps(std::numeric_limits<float>::infinity())));
+			__m128i const Nan = _mm_castps_si128(_mm_cmpunord_ps(x, x));
+			__m128i const Packed = _mm_srli_epi32(_mm_sub_epi32(_mm_castps_si128(x), _mm_set1_epi32(0x38000000)), 23 - M);
+			__m128i const Result = _mm_or_si128(
+				_mm_and_si128(_mm_castps_si128(Normal), Packed),
+				_mm_and_si128(_mm_castps_si128(Big), _mm_sub_epi32(_mm_set1_epi32((31 << M) - 1), Inf)));
+			return _mm_and_si128(_mm_or_si128(Result, Nan), _mm_set1_epi32((1 << (M + 5)) - 1));
+		}
+
+		template<int M>
+		GLM_FUNC_QUALIFIER __m128 span_unpack_packed_float_sse(__m128i p)
+		{
+			__m128i const Exp = _mm_srli_epi32(p, M);
+			__m128 const Denormal = _mm_castsi128_ps(_mm_cmpeq_epi32(Exp, _mm_setzero_si128()));
+			__m128i const Special = _mm_cmpeq_epi32(Exp, _mm_set1_epi32(31));
+			__m128i const Bias = _mm_or_si128(
+				_mm_andnot_si128(Special, _mm_set1_epi32(0x38000000)),
+				_mm_and_si128(Special, _mm_set1_epi32(0x70000000)));
+			__m128 const Normal = _mm_castsi128_ps(_mm_add_epi32(_mm_slli_epi32(p, 23 - M), Bias));
+			__m128 const Small = _mm_mul_ps(_mm_cvtepi32_ps(p), _mm_set1_ps(M == 6 ? 9.5367431640625e-07f : 1.9073486328125e-06f));
+			return _mm_or_ps(_mm_andnot_ps(Denormal, Normal), _mm_and_ps(Denormal, Small));
+		}
+
+		GLM_FUNC_QUALIFIER __m128 span_exp2_sse(__m128i e)
+		{
+			return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(e, _mm_set1_epi32(127)), 23));
+		}
+
+		GLM_FUNC_QUALIFIER __m128i span_pack_rgb9e5_sse(__m128 x, __m128 y, __m128 z)
+		{
+			__m128 const Zero = _mm_setzero_ps();
+			__m128 const Limit = _mm_set1_ps(32768.f);
+			__m128 const Half = _mm_set1_ps(0.5f);
+			__m128 const r = _mm_and_ps(_mm_cmpgt_ps(x, Zero), _mm_min_ps(x, Limit));
+			__m128 const g = _mm_and_ps(_mm_cmpgt_ps(y, Zero), _mm_min_ps(y, Limit));
+			__m128 const b = _mm_and_ps(_mm_cmpgt_ps(z, Zero), _mm_min_ps(z, Limit));
+			__m128 const MaxColor = _mm_max_ps(_mm_max_ps(r, g), b);
+
+			__m128i ExpShared = _mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(MaxColor), 23), _mm_set1_epi32(111));
+			ExpShared = _mm_and_si128(ExpShared, _mm_cmpgt_epi32(ExpShared, _mm_setzero_si128()));
+			__m128i const Exp24 = _mm_set1_epi32(24);
+			__m128i const MaxShared = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(MaxColor, span_exp2_sse(_mm_sub_epi32(Exp24, ExpShared))), Half));
+			ExpShared = _mm_sub_epi32(ExpShared, _mm_cmpeq_epi32(MaxShared, _mm_set1_epi32(512)));
+
+			__m128 const Scale = span_exp2_sse(_mm_sub_epi32(Exp24, ExpShared));
+			__m128i const R = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(r, Scale), Half));
+			__m128i const G = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(g, Scale), Half));
+			__m128i const B = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(b, Scale), Half));
+			return _mm_or_si128(_mm_or_si128(R, _mm_slli_epi32(G, 9)), _mm_or_si128(_mm_slli_epi32(B, 18), _mm_slli_epi32(ExpShared, 27)));
+		}
+
+		// round() of non negative values: truncation, plus one from one half
+		GLM_FUNC_QUALIFIER __m128i span_round_sse(__m128 x)
+		{
+			__m128i const t = _mm_cvttps_epi32(x);
+			__m128 const Up = _mm_cmpge_ps(_mm_sub_ps(x, _mm_cvtepi32_ps(t)), _mm_set1_ps(0.5f));
+			return _mm_sub_epi32(t, _mm_castps_si128(Up));
+		}
+
+		// ceil() of values in [0, 2^31)
+		GLM_FUNC_QUALIFIER __m128 span_ceil_sse(__m128 x)
+		{
+			__m128 const t = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+			return _mm_add_ps(t, _mm_and_ps(_mm_cmplt_ps(t, x), _mm_set1_ps(1.0f)));
+		}
+#		endif
+	}//namespace detail
+
+	template<length_t L, qualifier Q>
+	GLM_FUNC_QUALIFIER void packF2x11_1x10(vec<L, float, Q> const* v, uint32* out, std::size_t count)
+	{
+		GLM_STATIC_ASSERT(L == 3 || L == 4, "'packF2x11_1x10' span only accepts vec3 or vec4");
+
+		std::size_t i = 0;
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128 x, y, z, w;
+			detail::span_load_x4(v + i, x, y, z, w);
+			__m128i const Result = _mm_or_si128(
+				_mm_or_si128(detail::span_pack_packed_float_sse<6>(x), _mm_slli_epi32(detail::span_pack_packed_float_sse<6>(y), 11)),
+				_mm_slli_epi32(detail::span_pack_packed_float_sse<5>(z), 22));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), Result);
+		}
+#		endif
+		for(; i < count; ++i)
+			out[i] =
+				detail::span_pack_packed_float<6>(v[i][0]) |
+				detail::span_pack_packed_float<6>(v[i][1]) << 11 |
+				detail::span_pack_packed_float<5>(v[i][2]) << 22;
+	}
+
+	template<length_t L, qualifier Q>
+	GLM_FUNC_QUALIFIER void unpackF2x11_1x10(uint32 const* p, vec<L, float, Q>* out, std::size_t count)
+	{
+		GLM_STATIC_ASSERT(L == 3 || L == 4, "'unpackF2x11_1x10' span only accepts vec3 or vec4");
+
+		std::size_t i = 0;
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		__m128i const Mask11 = _mm_set1_epi32(0x7FF);
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128i const Packed = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+			detail::span_store_x4(out + i,
+				detail::span_unpack_packed_float_sse<6>(_mm_and_si128(Packed, Mask11)),
+				detail::span_unpack_packed_float_sse<6>(_mm_and_si128(_mm_srli_epi32(Packed, 11), Mask11)),
+				detail::span_unpack_packed_float_sse<5>(_mm_srli_epi32(Packed, 22)),
+				detail::span_store_w<L>());
+		}
+#		endif
+		for(; i < count; ++i)
+			detail::span_store_rgb(out[i],
+				detail::span_unpack_packed_float<6>(p[i] & 0x7FFu),
+				detail::span_unpack_packed_float<6>((p[i] >> 11) & 0x7FFu),
+				detail::span_unpack_packed_float<5>(p[i] >> 22));
+	}
+
+	template<length_t L, qualifier Q>
+	GLM_FUNC_QUALIFIER void packF3x9_E1x5(vec<L, float, Q> const* v, uint32* out, std::size_t count)
+	{
+		GLM_STATIC_ASSERT(L == 3 || L == 4, "'packF3x9_E1x5' span only accepts vec3 or vec4");
+
+		std::size_t i = 0;
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128 x, y, z, w;
+			detail::span_load_x4(v + i, x, y, z, w);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), detail::span_pack_rgb9e5_sse(x, y, z));
+		}
+#		endif
+		for(; i < count; ++i)
+			out[i] = detail::span_pack_rgb9e5(v[i][0], v[i][1], v[i][2]);
+	}
+
+	template<length_t L, qualifier Q>
+	GLM_FUNC_QUALIFIER void unpackF3x9_E1x5(uint32 const* p, vec<L, float, Q>* out, std::size_t count)
+	{
+		GLM_STATIC_ASSERT(L == 3 || L == 4, "'unpackF3x9_E1x5' span only accepts vec3 or vec4");
+
+		std::size_t i = 0;
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		__m128i const Mask9 = _mm_set1_epi32(0x1FF);
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128i const Packed = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+			__m128 const Scale = detail::span_exp2_sse(_mm_sub_epi32(_mm_srli_epi32(Packed, 27), _mm_set1_epi32(24)));
+			detail::span_store_x4(out + i,
+				_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(Packed, Mask9)), Scale),
+				_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(Packed, 9), Mask9)), Scale),
+				_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(Packed, 18), Mask9)), Scale),
+				detail::span_store_w<L>());
+		}
+#		endif
+		for(; i < count; ++i)
+		{
+			float const Scale = detail::span_exp2(static_cast<int>(p[i] >> 27) - 24);
+			detail::span_store_rgb(out[i],
+				static_cast<float>(p[i] & 0x1FFu) * Scale,
+				static_cast<float>((p[i] >> 9) & 0x1FFu) * Scale,
+				static_cast<float>((p[i] >> 18) & 0x1FFu) * Scale);
+		}
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void packUnorm3x10_1x2(vec<4, float, Q> const* v, uint32* out, std::size_t count)
+	{
+		std::size_t i = 0;
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		__m128 const Zero = _mm_setzero_ps();
+		__m128 const One = _mm_set1_ps(1.0f);
+		__m128 const Max10 = _mm_set1_ps(1023.f);
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128 x, y, z, w;
+			detail::span_load_x4(v + i, x, y, z, w);
+			__m128i const r = detail::span_round_sse(_mm_mul_ps(_mm_min_ps(_mm_max_ps(x, Zero), One), Max10));
+			__m128i const g = detail::span_round_sse(_mm_mul_ps(_mm_min_ps(_mm_max_ps(y, Zero), One), Max10));
+			__m128i const b = detail::span_round_sse(_mm_mul_ps(_mm_min_ps(_mm_max_ps(z, Zero), One), Max10));
+			__m128i const a = detail::span_round_sse(_mm_mul_ps(_mm_min_ps(_mm_max_ps(w, Zero), One), _mm_set1_ps(3.f)));
+			__m128i const Result = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 10)), _mm_or_si128(_mm_slli_epi32(b, 20), _mm_slli_epi32(a, 30)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), Result);
+		}
+#		endif
+		for(; i < count; ++i)
+			out[i] = packUnorm3x10_1x2(vec4(v[i]));
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void unpackUnorm3x10_1x2(uint32 const* p, vec<4, float, Q>* out, std::size_t count)
+	{
+		std::size_t i = 0;
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		__m128i const Mask10 = _mm_set1_epi32(0x3FF);
+		__m128 const Scale10 = _mm_set1_ps(1.0f / 1023.f);
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128i const Packed = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+			detail::span_store_x4(out + i,
+				_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(Packed, Mask10)), Scale10),
+				_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(Packed, 10), Mask10)), Scale10),
+				_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(Packed, 20), Mask10)), Scale10),
+				_mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(Packed, 30)), _mm_set1_ps(1.0f / 3.f)));
+		}
+#		endif
+		for(; i < count; ++i)
+			out[i] = vec<4, float, Q>(unpackUnorm3x10_1x2(p[i]));
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void packRGBM(vec<3, float, Q> const* rgb, vec<4, float, Q>* out, std::size_t count)
+	{
+		std::size_t i = 0;
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		__m128 const Sixth = _mm_set1_ps(static_cast<float>(1.0 / 6.0));
+		__m128 const Max8 = _mm_set1_ps(255.0f);
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128 x, y, z, w;
+			detail::span_load_x4(rgb + i, x, y, z, w);
+			x = _mm_mul_ps(x, Sixth);
+			y = _mm_mul_ps(y, Sixth);
+			z = _mm_mul_ps(z, Sixth);
+			__m128 Alpha = _mm_max_ps(_mm_max_ps(x, y), _mm_max_ps(z, _mm_set1_ps(1e-6f)));
+			Alpha = _mm_min_ps(_mm_max_ps(Alpha, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+			Alpha = _mm_div_ps(detail::span_ceil_sse(_mm_mul_ps(Alpha, Max8)), Max8);
+			detail::span_store_x4(out + i, _mm_div_ps(x, Alpha), _mm_div_ps(y, Alpha), _mm_div_ps(z, Alpha), Alpha);
+		}
+#		endif
+		for(; i < count; ++i)
+			out[i] = packRGBM(rgb[i]);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void unpackRGBM(vec<4, float, Q> const* rgbm, vec<3, float, Q>* out, std::size_t count)
+	{
+		std::size_t i = 0;
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		__m128 const Six = _mm_set1_ps(6.0f);
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128 x, y, z, w;
+			detail::span_load_x4(rgbm + i, x, y, z, w);
+			detail::span_store_x4(out + i, _mm_mul_ps(_mm_mul_ps(x, w), Six), _mm_mul_ps(_mm_mul_ps(y, w), Six), _mm_mul_ps(_mm_mul_ps(z, w), Six), _mm_setzero_ps());
+		}
+#		endif
+		for(; i < count; ++i)
+			out[i] = unpackRGBM(rgbm[i]);
+	}
 }//namespace glm
 
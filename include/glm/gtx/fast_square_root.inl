@@ -72,4 +72,214 @@ namespace glm
 	{
 		return x * fastInverseSqrt(dot(x, x));
 	}
+
+	namespace detail
+	{
+		// One lane of the span functions: same operations and order as the packed paths
+		GLM_FUNC_QUALIFIER float fast_inversesqrt_lane(float x, int refinements)
+		{
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			__m128 const v = _mm_set_ss(x);
+			__m128 const h = _mm_mul_ss(v, _mm_set_ss(0.5f));
+			__m128 y = _mm_rsqrt_ss(v);
+			for(int i = 0; i < refinements; ++i)
+				y = _mm_mul_ss(y, _mm_sub_ss(_mm_set_ss(1.5f), _mm_mul_ss(_mm_mul_ss(h, y), y)));
+			return _mm_cvtss_f32(y);
+#		else
+			float const h = x * 0.5f;
+			uint i;
+			std::memcpy(&i, &x, sizeof(i));
+			i = 0x5f375a86u - (i >> 1);
+			float y;
+			std::memcpy(&y, &i, sizeof(y));
+			for(int r = 0; r < refinements; ++r)
+				y = y * (1.5f - (h * y) * y);
+			return y;
+#		endif
+		}
+
+		template<length_t L, qualifier Q>
+		GLM_FUNC_QUALIFIER float fast_span_dot(vec<L, float, Q> const& v)
+		{
+			float Result = v[0] * v[0] + v[1] * v[1];
+			GLM_IF_CONSTEXPR(L == 4)
+				return Result + (v[2] * v[2] + v[3] * v[3]);
+			GLM_IF_CONSTEXPR(L == 3)
+				return Result + v[2] * v[2];
+			return Result;
+		}
+
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		GLM_FUNC_QUALIFIER __m128 fast_inversesqrt_sse(__m128 x, int refinements)
+		{
+			__m128 const h = _mm_mul_ps(x, _mm_set1_ps(0.5f));
+			__m128 y = _mm_rsqrt_ps(x);
+			for(int i = 0; i < refinements; ++i)
+				y = _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(h, y), y)));
+			return y;
+		}
+
+		// Four packed vec3 (three loads) to x, y, z lanes and back
+		GLM_FUNC_QUALIFIER void fast_load_vec3x4(float const* p, __m128& x, __m128& y, __m128& z)
+		{
+			__m128 const v0 = _mm_loadu_ps(p);
+			__m128 const v1 = _mm_loadu_ps(p + 4);
+			__m128 const v2 = _mm_loadu_ps(p + 8);
+			x = _mm_shuffle_ps(v0, _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+			y = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+			z = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(v2, v2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+		}
+
+		GLM_FUNC_QUALIFIER void fast_store_vec3x4(float* p, __m128 x, __m128 y, __m128 z)
+		{
+			__m128 const xy = _mm_unpacklo_ps(x, y);
+			_mm_storeu_ps(p, _mm_shuffle_ps(xy, _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));
+			_mm_storeu_ps(p + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm_storeu_ps(p + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+		}
+
+		// Dot product of a vec4 with itself, in every lane: (x * x + y * y) + (z * z + w * w)
+		GLM_FUNC_QUALIFIER __m128 fast_dot4_sse(__m128 v)
+		{
+			__m128 const d = _mm_mul_ps(v, v);
+			__m128 const s = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)));
+			return _mm_add_ps(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 3, 2)));
+		}
+#		endif
+
+#		if GLM_ARCH & GLM_ARCH_AVX_BIT
+		GLM_FUNC_QUALIFIER __m256 fast_inversesqrt_avx(__m256 x, int refinements)
+		{
+			__m256 const h = _mm256_mul_ps(x, _mm256_set1_ps(0.5f));
+			__m256 y = _mm256_rsqrt_ps(x);
+			for(int i = 0; i < refinements; ++i)
+				y = _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(h, y), y)));
+			return y;
+		}
+#		endif
+
+		// out[i] = f(x[i], 1 / sqrt(x[i])); Mode 0 - inverse, 1 - x * inverse with 0 for x <= 0
+		template<int Mode>
+		GLM_FUNC_QUALIFIER void fast_sqrt_span(float const* x, float* out, std::size_t count, int refinements)
+		{
+			std::size_t i = 0;
+#		if GLM_ARCH & GLM_ARCH_AVX_BIT
+			for(; i + 8 <= count; i += 8)
+			{
+				__m256 const v = _mm256_loadu_ps(x + i);
+				__m256 r = fast_inversesqrt_avx(v, refinements);
+				if(Mode == 1)
+					r = _mm256_and_ps(_mm256_cmp_ps(v, _mm256_setzero_ps(), _CMP_GT_OQ), _mm256_mul_ps(v, r));
+				_mm256_storeu_ps(out + i, r);
+			}
+#		endif
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			for(; i + 4 <= count; i += 4)
+			{
+				__m128 const v = _mm_loadu_ps(x + i);
+				__m128 r = fast_inversesqrt_sse(v, refinements);
+				if(Mode == 1)
+					r = _mm_and_ps(_mm_cmpgt_ps(v, _mm_setzero_ps()), _mm_mul_ps(v, r));
+				_mm_storeu_ps(out + i, r);
+			}
+#		endif
+			for(; i < count; ++i)
+			{
+				float const v = x[i];
+				float const r = fast_inversesqrt_lane(v, refinements);
+				out[i] = Mode == 0 ? r : (v > 0.0f ? v * r : 0.0f);
+			}
+		}
+
+		// Mode 0 - lengths into out, 1 - normalized vectors into out
+		template<int Mode, length_t L, qualifier Q>
+		GLM_FUNC_QUALIFIER void fast_length_span(vec<L, float, Q> const* v, void* out, std::size_t count, int refinements)
+		{
+			float* lengths = static_cast<float*>(out);
+			vec<L, float, Q>* normals = static_cast<vec<L, float, Q>*>(out);
+			std::size_t i = 0;
+#		if GLM_ARCH & GLM_ARCH_AVX_BIT
+			GLM_IF_CONSTEXPR(L == 4 && sizeof(vec<L, float, Q>) == 4 * sizeof(float))
+			{
+				for(; i + 2 <= count; i += 2)
+				{
+					__m256 const a = _mm256_loadu_ps(&v[i][0]);
+					__m256 const d0 = _mm256_mul_ps(a, a);
+					__m256 const s = _mm256_add_ps(d0, _mm256_permute_ps(d0, _MM_SHUFFLE(2, 3, 0, 1)));
+					__m256 const d = _mm256_add_ps(s, _mm256_permute_ps(s, _MM_SHUFFLE(1, 0, 3, 2)));
+					__m256 const nonzero = _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_GT_OQ);
+					__m256 const r = _mm256_and_ps(nonzero, fast_inversesqrt_avx(d, refinements));
+					if(Mode == 0)
+					{
+						__m256 const len = _mm256_mul_ps(d, r);
+						lengths[i] = _mm_cvtss_f32(_mm256_castps256_ps128(len));
+						lengths[i + 1] = _mm_cvtss_f32(_mm256_extractf128_ps(len, 1));
+					}
+					else
+						_mm256_storeu_ps(&normals[i][0], _mm256_mul_ps(a, r));
+				}
+			}
+#		endif
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			GLM_IF_CONSTEXPR(L == 3 && sizeof(vec<L, float, Q>) == 3 * sizeof(float))
+			{
+				for(; i + 4 <= count; i += 4)
+				{
+					__m128 x, y, z;
+					fast_load_vec3x4(&v[i][0], x, y, z);
+					__m128 const d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+					__m128 const r = _mm_and_ps(_mm_cmpgt_ps(d, _mm_setzero_ps()), fast_inversesqrt_sse(d, refinements));
+					if(Mode == 0)
+						_mm_storeu_ps(lengths + i, _mm_mul_ps(d, r));
+					else
+						fast_store_vec3x4(&normals[i][0], _mm_mul_ps(x, r), _mm_mul_ps(y, r), _mm_mul_ps(z, r));
+				}
+			}
+			else GLM_IF_CONSTEXPR(L == 4 && sizeof(vec<L, float, Q>) == 4 * sizeof(float))
+			{
+				for(; i < count; ++i)
+				{
+					__m128 const a = _mm_loadu_ps(&v[i][0]);
+					__m128 const d = fast_dot4_sse(a);
+					__m128 const r = _mm_and_ps(_mm_cmpgt_ps(d, _mm_setzero_ps()), fast_inversesqrt_sse(d, refinements));
+					if(Mode == 0)
+						lengths[i] = _mm_cvtss_f32(_mm_mul_ss(d, r));
+					else
+						_mm_storeu_ps(&normals[i][0], _mm_mul_ps(a, r));
+				}
+			}
+#		endif
+			for(; i < count; ++i)
+			{
+				float const d = fast_span_dot(v[i]);
+				float const r = d > 0.0f ? fast_inversesqrt_lane(d, refinements) : 0.0f;
+				if(Mode == 0)
+					lengths[i] = d * r;
+				else
+					normals[i] = v[i] * r;
+			}
+		}
+	}//namespace detail
+
+	GLM_FUNC_QUALIFIER void fastInverseSqrt(float const* x, float* out, std::size_t count, int refinements)
+	{
+		detail::fast_sqrt_span<0>(x, out, count, refinements);
+	}
+
+	GLM_FUNC_QUALIFIER void fastSqrt(float const* x, float* out, std::size_t count, int refinements)
+	{
+		detail::fast_sqrt_span<1>(x, out, count, refinements);
+	}
+
+	template<length_t L, qualifier Q>
+	GLM_FUNC_QUALIFIER void fastLength(vec<L, float, Q> const* v, float* out, std::size_t count, int refinements)
+	{
+		detail::fast_length_span<0>(v, out, count, refinements);
+	}
+
+	template<length_t L, qualifier Q>
+	GLM_FUNC_QUALIFIER void fastNormalize(vec<L, float, Q> const* v, vec<L, float, Q>* out, std::size_t count, int refinements)
+	{
+		detail::fast_length_span<1>(v, out, count, refinements);
+	}
 }//namespace glm
@@ -14,6 +14,7 @@
 
 // Dependency:
 #include "../glm.hpp"
+#include <cstddef>
 
 #ifndef GLM_ENABLE_EXPERIMENTAL
 #	error "GLM: GLM_GTX_matrix_factorisation is an experimental extension and may change in the future. Use #define GLM_ENABLE_EXPERIMENTAL before including it, if you really want to use it."
@@ -61,6 +62,42 @@ namespace glm
 	template <length_t C, length_t R, typename T, qualifier Q>
 	GLM_FUNC_DISCARD_DECL void rq_decompose(mat<C, R, T, Q> const& in, mat<(C < R ? C : R), R, T, Q>& r, mat<C, (C < R ? C : R), T, Q>& q);
 
+	/// Performs the singular value decomposition of a 3x3 matrix: in = u * diag(s) * transpose(v).
+	/// u and v are rotations (determinant 1) and s is sorted by decreasing magnitude; a reflection
+	/// in the input shows as a negative s.z instead of a reflection in u or v.
+	/// Branch-free, with a fixed number of iterations (McAdams et al. 2011): six Jacobi sweeps on
+	/// transpose(in) * in, then a Givens QR. Float results have an error around 1e-5 relative to
+	/// the largest singular value, rank deficient matrices included. transpose(in) * in must stay
+	/// in the normal float range. With SSE2, denormals are flushed to zero during the decomposition.
+	///
+	/// From GLM_GTX_matrix_factorisation extension.
+	template <typename T, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void svd_decompose(mat<3, 3, T, Q> const& in, mat<3, 3, T, Q>& u, vec<3, T, Q>& s, mat<3, 3, T, Q>& v);
+
+	/// Performs the polar decomposition of a 3x3 matrix: in = r * s, with r a rotation and s symmetric.
+	/// Computed from svd_decompose: r = u * transpose(v) and s = v * diag(s) * transpose(v), so r is
+	/// a rotation even when the input contains a reflection, as shape matching needs.
+	///
+	/// From GLM_GTX_matrix_factorisation extension.
+	template <typename T, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void polar_decompose(mat<3, 3, T, Q> const& in, mat<3, 3, T, Q>& r, mat<3, 3, T, Q>& s);
+
+	/// Span version of svd_decompose: count matrices, 8 at a time with AVX and 4 with SSE2 when GLM
+	/// SIMD is enabled, one lane per matrix. With SSE2 the single matrix float version uses the same
+	/// inverse square root estimate, so results do not depend on the position in the span, as long as
+	/// the compiler does not contract the scalar code into FMA (-mfma without -ffp-contract=off).
+	/// u, s and v may be null when not needed.
+	///
+	/// From GLM_GTX_matrix_factorisation extension.
+	template <qualifier Q>
+	GLM_FUNC_DISCARD_DECL void svd_decompose(mat<3, 3, float, Q> const* in, mat<3, 3, float, Q>* u, vec<3, float, Q>* s, mat<3, 3, float, Q>* v, std::size_t count);
+
+	/// Span version of polar_decompose. s may be null when only the rotations are needed.
+	///
+	/// From GLM_GTX_matrix_factorisation extension.
+	template <qualifier Q>
+	GLM_FUNC_DISCARD_DECL void polar_decompose(mat<3, 3, float, Q> const* in, mat<3, 3, float, Q>* r, mat<3, 3, float, Q>* s, std::size_t count);
+
 	/// @}
 }
 
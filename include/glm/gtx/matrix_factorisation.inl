@@ -81,4 +81,382 @@ namespace glm
 		tq = fliplr(tq);
 		q = transpose(tq);
 	}
+
+	namespace detail
+	{
+		// 3x3 SVD after McAdams et al. 2011, "Computing the Singular Value Decomposition of 3x3
+		// matrices with minimal branching and elementary floating point operations": Jacobi
+		// eigenanalysis of A^T * A with approximate Givens rotations, sort of the columns of A * V,
+		// then QR by Givens rotations. The same code runs on one matrix or on a SIMD register of
+		// matrices, one per lane; svd_lane hides the difference.
+
+		template<typename T>
+		GLM_FUNC_QUALIFIER T svd_rsqrt(T x)
+		{
+			return static_cast<T>(1) / std::sqrt(x);
+		}
+
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		// rsqrt estimate plus one Newton step, as in the SIMD lanes
+		GLM_FUNC_QUALIFIER float svd_rsqrt(float x)
+		{
+			__m128 const v = _mm_set_ss(x);
+			__m128 const y = _mm_rsqrt_ss(v);
+			__m128 const h = _mm_mul_ss(v, _mm_set_ss(0.5f));
+			return _mm_cvtss_f32(_mm_mul_ss(y, _mm_sub_ss(_mm_set_ss(1.5f), _mm_mul_ss(_mm_mul_ss(h, y), y))));
+		}
+#		endif
+
+		template<typename T>
+		struct svd_lane
+		{
+			typedef T type;
+			typedef bool mask;
+			enum { size = 1 };
+
+			GLM_FUNC_QUALIFIER static T splat(double x) { return static_cast<T>(x); }
+			GLM_FUNC_QUALIFIER static T load(T const* p) { return *p; }
+			GLM_FUNC_QUALIFIER static void store(T* p, T x) { *p = x; }
+			GLM_FUNC_QUALIFIER static bool less(T a, T b) { return a < b; }
+			GLM_FUNC_QUALIFIER static T select(bool m, T a, T b) { return m ? a : b; }
+			GLM_FUNC_QUALIFIER static T max(T a, T b) { return a > b ? a : b; }
+			GLM_FUNC_QUALIFIER static T abs(T a) { return std::fabs(a); }
+			GLM_FUNC_QUALIFIER static T sqrt(T a) { return std::sqrt(a); }
+			GLM_FUNC_QUALIFIER static T rsqrt(T a) { return svd_rsqrt(a); }
+		};
+
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		struct svd_sse
+		{
+			__m128 data;
+		};
+
+		GLM_FUNC_QUALIFIER svd_sse operator+(svd_sse a, svd_sse b) { svd_sse r = {_mm_add_ps(a.data, b.data)}; return r; }
+		GLM_FUNC_QUALIFIER svd_sse operator-(svd_sse a, svd_sse b) { svd_sse r = {_mm_sub_ps(a.data, b.data)}; return r; }
+		GLM_FUNC_QUALIFIER svd_sse operator*(svd_sse a, svd_sse b) { svd_sse r = {_mm_mul_ps(a.data, b.data)}; return r; }
+		GLM_FUNC_QUALIFIER svd_sse operator-(svd_sse a) { svd_sse r = {_mm_xor_ps(a.data, _mm_set1_ps(-0.0f))}; return r; }
+
+		template<>
+		struct svd_lane<svd_sse>
+		{
+			typedef svd_sse type;
+			typedef __m128 mask;
+			enum { size = 4 };
+
+			GLM_FUNC_QUALIFIER static svd_sse splat(double x) { svd_sse r = {_mm_set1_ps(static_cast<float>(x))}; return r; }
+			GLM_FUNC_QUALIFIER static svd_sse load(float const* p) { svd_sse r = {_mm_loadu_ps(p)}; return r; }
+			GLM_FUNC_QUALIFIER static void store(float* p, svd_sse x) { _mm_storeu_ps(p, x.data); }
+			GLM_FUNC_QUALIFIER static __m128 less(svd_sse a, svd_sse b) { return _mm_cmplt_ps(a.data, b.data); }
+			GLM_FUNC_QUALIFIER static svd_sse select(__m128 m, svd_sse a, svd_sse b) { svd_sse r = {_mm_or_ps(_mm_and_ps(m, a.data), _mm_andnot_ps(m, b.data))}; return r; }
+			GLM_FUNC_QUALIFIER static svd_sse max(svd_sse a, svd_sse b) { svd_sse r = {_mm_max_ps(a.data, b.data)}; return r; }
+			GLM_FUNC_QUALIFIER static svd_sse abs(svd_sse a) { svd_sse r = {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.data)}; return r; }
+			GLM_FUNC_QUALIFIER static svd_sse sqrt(svd_sse a) { svd_sse r = {_mm_sqrt_ps(a.data)}; return r; }
+			GLM_FUNC_QUALIFIER static svd_sse rsqrt(svd_sse a)
+			{
+				__m128 const y = _mm_rsqrt_ps(a.data);
+				__m128 const h = _mm_mul_ps(a.data, _mm_set1_ps(0.5f));
+				svd_sse r = {_mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(h, y), y)))};
+				return r;
+			}
+		};
+#		endif
+
+#		if GLM_ARCH & GLM_ARCH_AVX_BIT
+		struct svd_avx
+		{
+			__m256 data;
+		};
+
+		GLM_FUNC_QUALIFIER svd_avx operator+(svd_avx a, svd_avx b) { svd_avx r = {_mm256_add_ps(a.data, b.data)}; return r; }
+		GLM_FUNC_QUALIFIER svd_avx operator-(svd_avx a, svd_avx b) { svd_avx r = {_mm256_sub_ps(a.data, b.data)}; return r; }
+		GLM_FUNC_QUALIFIER svd_avx operator*(svd_avx a, svd_avx b) { svd_avx r = {_mm256_mul_ps(a.data, b.data)}; return r; }
+		GLM_FUNC_QUALIFIER svd_avx operator-(svd_avx a) { svd_avx r = {_mm256_xor_ps(a.data, _mm256_set1_ps(-0.0f))}; return r; }
+
+		template<>
+		struct svd_lane<svd_avx>
+		{
+			typedef svd_avx type;
+			typedef __m256 mask;
+			enum { size = 8 };
+
+			GLM_FUNC_QUALIFIER static svd_avx splat(double x) { svd_avx r = {_mm256_set1_ps(static_cast<float>(x))}; return r; }
+			GLM_FUNC_QUALIFIER static svd_avx load(float const* p) { svd_avx r = {_mm256_loadu_ps(p)}; return r; }
+			GLM_FUNC_QUALIFIER static void store(float* p, svd_avx x) { _mm256_storeu_ps(p, x.data); }
+			GLM_FUNC_QUALIFIER static __m256 less(svd_avx a, svd_avx b) { return _mm256_cmp_ps(a.data, b.data, _CMP_LT_OQ); }
+			GLM_FUNC_QUALIFIER static svd_avx select(__m256 m, svd_avx a, svd_avx b) { svd_avx r = {_mm256_blendv_ps(b.data, a.data, m)}; return r; }
+			GLM_FUNC_QUALIFIER static svd_avx max(svd_avx a, svd_avx b) { svd_avx r = {_mm256_max_ps(a.data, b.data)}; return r; }
+			GLM_FUNC_QUALIFIER static svd_avx abs(svd_avx a) { svd_avx r = {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.data)}; return r; }
+			GLM_FUNC_QUALIFIER static svd_avx sqrt(svd_avx a) { svd_avx r = {_mm256_sqrt_ps(a.data)}; return r; }
+			GLM_FUNC_QUALIFIER static svd_avx rsqrt(svd_avx a)
+			{
+				__m256 const y = _mm256_rsqrt_ps(a.data);
+				__m256 const h = _mm256_mul_ps(a.data, _mm256_set1_ps(0.5f));
+				svd_avx r = {_mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(h, y), y)))};
+				return r;
+			}
+		};
+#		endif
+
+		// Jacobi step on the symmetric s in the (p, q) plane: s = G^T * s * G and v = v * G,
+		// with the rotation from the approximate half angle, or pi / 4 when it is too large
+		template<typename L, int p, int q>
+		GLM_FUNC_QUALIFIER void svd_jacobi(typename L::type s[3][3], typename L::type v[3][3])
+		{
+			typedef typename L::type T;
+			int const k = 3 - p - q;
+
+			T ch = L::splat(2.0) * (s[p][p] - s[q][q]);
+			T sh = s[p][q];
+			typename L::mask const Small = L::less(L::splat(5.828427124746190) * sh * sh, ch * ch); // (3 + 2 * sqrt(2)) sh^2 < ch^2
+			T const w = L::rsqrt(ch * ch + sh * sh);
+			ch = L::select(Small, w * ch, L::splat(0.923879532511287)); // cos(pi / 8)
+			sh = L::select(Small, w * sh, L::splat(0.382683432365090)); // sin(pi / 8)
+
+			T const c = ch * ch - sh * sh;
+			T const n = L::splat(2.0) * ch * sh;
+			T const cc = c * c;
+			T const nn = n * n;
+			T const cn = c * n;
+			T const spp = s[p][p], sqq = s[q][q], spq = s[p][q], spk = s[p][k], sqk = s[q][k];
+			s[p][p] = cc * spp + L::splat(2.0) * cn * spq + nn * sqq;
+			s[q][q] = nn * spp - L::splat(2.0) * cn * spq + cc * sqq;
+			s[p][q] = s[q][p] = (cc - nn) * spq + cn * (sqq - spp);
+			s[p][k] = s[k][p] = c * spk + n * sqk;
+			s[q][k] = s[k][q] = c * sqk - n * spk;
+
+			for(int r = 0; r < 3; ++r)
+			{
+				T const vp = v[r][p], vq = v[r][q];
+				v[r][p] = c * vp + n * vq;
+				v[r][q] = c * vq - n * vp;
+			}
+		}
+
+		// Swaps columns p and q of b and v when m is set, negating one to keep det(v) = 1
+		template<typename L, int p, int q>
+		GLM_FUNC_QUALIFIER void svd_swap(typename L::mask m, typename L::type b[3][3], typename L::type v[3][3], typename L::type rho[3])
+		{
+			typedef typename L::type T;
+			for(int r = 0; r < 3; ++r)
+			{
+				T const bp = b[r][p], vp = v[r][p];
+				b[r][p] = L::select(m, b[r][q], bp);
+				b[r][q] = L::select(m, -bp, b[r][q]);
+				v[r][p] = L::select(m, v[r][q], vp);
+				v[r][q] = L::select(m, -vp, v[r][q]);
+			}
+			T const rp = rho[p];
+			rho[p] = L::select(m, rho[q], rp);
+			rho[q] = L::select(m, rp, rho[q]);
+		}
+
+		// Givens rotation zeroing b[q][p]: b = G^T * b and u = u * G
+		template<typename L, int p, int q>
+		GLM_FUNC_QUALIFIER void svd_qr(typename L::type b[3][3], typename L::type u[3][3])
+		{
+			typedef typename L::type T;
+			T const Epsilon = L::splat(1e-18);
+			T const a1 = b[p][p], a2 = b[q][p];
+			T const rho = L::sqrt(a1 * a1 + a2 * a2);
+			T sh = L::select(L::less(Epsilon, rho), a2, L::splat(0.0));
+			T ch = L::abs(a1) + L::max(rho, Epsilon);
+			typename L::mask const Negative = L::less(a1, L::splat(0.0));
+			T const t = L::select(Negative, sh, ch);
+			sh = L::select(Negative, ch, sh);
+			ch = t;
+			T const w = L::rsqrt(ch * ch + sh * sh);
+			ch = ch * w;
+			sh = sh * w;
+
+			T const c = ch * ch - sh * sh;
+			T const n = L::splat(2.0) * ch * sh;
+			for(int j = 0; j < 3; ++j)
+			{
+				T const bp = b[p][j], bq = b[q][j];
+				b[p][j] = c * bp + n * bq;
+				b[q][j] = c * bq - n * bp;
+			}
+			for(int r = 0; r < 3; ++r)
+			{
+				T const up = u[r][p], uq = u[r][q];
+				u[r][p] = c * up + n * uq;
+				u[r][q] = c * uq - n * up;
+			}
+		}
+
+		// a[row][column] = u * diag(sigma) * transpose(v)
+		template<typename L>
+		GLM_FUNC_QUALIFIER void svd3(typename L::type const a[3][3], typename L::type u[3][3], typename L::type sigma[3], typename L::type v[3][3])
+		{
+			typedef typename L::type T;
+
+			T s[3][3];
+			for(int i = 0; i < 3; ++i)
+				for(int j = i; j < 3; ++j)
+					s[i][j] = s[j][i] = a[0][i] * a[0][j] + a[1][i] * a[1][j] + a[2][i] * a[2][j];
+
+			for(int i = 0; i < 3; ++i)
+				for(int j = 0; j < 3; ++j)
+					v[i][j] = u[i][j] = L::splat(i == j ? 1.0 : 0.0);
+
+			for(int Sweep = 0; Sweep < 6; ++Sweep)
+			{
+				svd_jacobi<L, 0, 1>(s, v);
+				svd_jacobi<L, 1, 2>(s, v);
+				svd_jacobi<L, 2, 0>(s, v);
+			}
+
+			T b[3][3];
+			T rho[3];
+			for(int r = 0; r < 3; ++r)
+				for(int c = 0; c < 3; ++c)
+					b[r][c] = a[r][0] * v[0][c] + a[r][1] * v[1][c] + a[r][2] * v[2][c];
+			for(int c = 0; c < 3; ++c)
+				rho[c] = b[0][c] * b[0][c] + b[1][c] * b[1][c] + b[2][c] * b[2][c];
+
+			svd_swap<L, 0, 1>(L::less(rho[0], rho[1]), b, v, rho);
+			svd_swap<L, 0, 2>(L::less(rho[0], rho[2]), b, v, rho);
+			svd_swap<L, 1, 2>(L::less(rho[1], rho[2]), b, v, rho);
+
+			svd_qr<L, 0, 1>(b, u);
+			svd_qr<L, 0, 2>(b, u);
+			svd_qr<L, 1, 2>(b, u);
+
+			for(int i = 0; i < 3; ++i)
+				sigma[i] = b[i][i];
+		}
+
+		// r = u * transpose(v) and, if wanted, s = v * diag(sigma) * transpose(v)
+		template<typename L>
+		GLM_FUNC_QUALIFIER void svd_polar(typename L::type const u[3][3], typename L::type const sigma[3], typename L::type const v[3][3],
+			typename L::type r[3][3], typename L::type s[3][3], bool stretch)
+		{
+			for(int i = 0; i < 3; ++i)
+				for(int j = 0; j < 3; ++j)
+				{
+					r[i][j] = u[i][0] * v[j][0] + u[i][1] * v[j][1] + u[i][2] * v[j][2];
+					if(stretch)
+						s[i][j] = v[i][0] * sigma[0] * v[j][0] + v[i][1] * sigma[1] * v[j][1] + v[i][2] * sigma[2] * v[j][2];
+				}
+		}
+
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		// The converging off-diagonal terms underflow into denormals, which run several times
+		// slower; flush them to zero (FTZ | DAZ) while decomposing and restore MXCSR after
+		struct svd_flush_denormals
+		{
+			unsigned int Csr;
+
+			GLM_FUNC_QUALIFIER svd_flush_denormals() : Csr(_mm_getcsr()) { _mm_setcsr(Csr | 0x8040); }
+			GLM_FUNC_QUALIFIER ~svd_flush_denormals() { _mm_setcsr(Csr); }
+		};
+#		endif
+
+		// L::size matrices from m through lanes; pointers may be null for outputs not wanted
+		template<typename L, typename T, qualifier Q>
+		GLM_FUNC_QUALIFIER void svd_batch(mat<3, 3, T, Q> const* m, mat<3, 3, T, Q>* u, vec<3, T, Q>* sigma, mat<3, 3, T, Q>* v,
+			mat<3, 3, T, Q>* rotation, mat<3, 3, T, Q>* stretch)
+		{
+			typedef typename L::type V;
+			int const N = L::size;
+
+			T Lanes[9][N];
+			V a[3][3];
+			for(int r = 0; r < 3; ++r)
+				for(int c = 0; c < 3; ++c)
+				{
+					for(int i = 0; i < N; ++i)
+						Lanes[r * 3 + c][i] = m[i][c][r];
+					a[r][c] = L::load(Lanes[r * 3 + c]);
+				}
+
+			V U[3][3], Sigma[3], W[3][3];
+			V R[3][3], S[3][3];
+			{
+#				if GLM_ARCH & GLM_ARCH_SSE2_BIT
+				svd_flush_denormals const Flush;
+#				endif
+				svd3<L>(a, U, Sigma, W);
+				if(rotation)
+					svd_polar<L>(U, Sigma, W, R, S, stretch != 0);
+			}
+
+			for(int r = 0; r < 3; ++r)
+				for(int c = 0; c < 3; ++c)
+				{
+					if(u)
+					{
+						L::store(Lanes[0], U[r][c]);
+						for(int i = 0; i < N; ++i)
+							u[i][c][r] = Lanes[0][i];
+					}
+					if(v)
+					{
+						L::store(Lanes[1], W[r][c]);
+						for(int i = 0; i < N; ++i)
+							v[i][c][r] = Lanes[1][i];
+					}
+					if(rotation)
+					{
+						L::store(Lanes[2], R[r][c]);
+						for(int i = 0; i < N; ++i)
+							rotation[i][c][r] = Lanes[2][i];
+					}
+					if(stretch)
+					{
+						L::store(Lanes[3], S[r][c]);
+						for(int i = 0; i < N; ++i)
+							stretch[i][c][r] = Lanes[3][i];
+					}
+				}
+			if(sigma)
+				for(int c = 0; c < 3; ++c)
+				{
+					L::store(Lanes[4], Sigma[c]);
+					for(int i = 0; i < N; ++i)
+						sigma[i][c] = Lanes[4][i];
+				}
+		}
+
+		template<qualifier Q>
+		GLM_FUNC_QUALIFIER void svd_span(mat<3, 3, float, Q> const* m, mat<3, 3, float, Q>* u, vec<3, float, Q>* sigma, mat<3, 3, float, Q>* v,
+			mat<3, 3, float, Q>* rotation, mat<3, 3, float, Q>* stretch, std::size_t count)
+		{
+			std::size_t i = 0;
+#		if GLM_ARCH & GLM_ARCH_AVX_BIT
+			for(; i + 8 <= count; i += 8)
+				svd_batch<svd_lane<svd_avx> >(m + i, u ? u + i : 0, sigma ? sigma + i : 0, v ? v + i : 0, rotation ? rotation + i : 0, stretch ? stretch + i : 0);
+#		endif
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			for(; i + 4 <= count; i += 4)
+				svd_batch<svd_lane<svd_sse> >(m + i, u ? u + i : 0, sigma ? sigma + i : 0, v ? v + i : 0, rotation ? rotation + i : 0, stretch ? stretch + i : 0);
+#		endif
+			for(std::size_t Tail = count - i; Tail > 0; --Tail, ++i)
+				svd_batch<svd_lane<float> >(m + i, u ? u + i : 0, sigma ? sigma + i : 0, v ? v + i : 0, rotation ? rotation + i : 0, stretch ? stretch + i : 0);
+		}
+	}//namespace detail
+
+	template <typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void svd_decompose(mat<3, 3, T, Q> const& in, mat<3, 3, T, Q>& u, vec<3, T, Q>& s, mat<3, 3, T, Q>& v)
+	{
+		detail::svd_batch<detail::svd_lane<T> >(&in, &u, &s, &v, static_cast<mat<3, 3, T, Q>*>(0), static_cast<mat<3, 3, T, Q>*>(0));
+	}
+
+	template <typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void polar_decompose(mat<3, 3, T, Q> const& in, mat<3, 3, T, Q>& r, mat<3, 3, T, Q>& s)
+	{
+		detail::svd_batch<detail::svd_lane<T> >(&in, static_cast<mat<3, 3, T, Q>*>(0), static_cast<vec<3, T, Q>*>(0), static_cast<mat<3, 3, T, Q>*>(0), &r, &s);
+	}
+
+	template <qualifier Q>
+	GLM_FUNC_QUALIFIER void svd_decompose(mat<3, 3, float, Q> const* in, mat<3, 3, float, Q>* u, vec<3, float, Q>* s, mat<3, 3, float, Q>* v, std::size_t count)
+	{
+		detail::svd_span(in, u, s, v, static_cast<mat<3, 3, float, Q>*>(0), static_cast<mat<3, 3, float, Q>*>(0), count);
+	}
+
+	template <qualifier Q>
+	GLM_FUNC_QUALIFIER void polar_decompose(mat<3, 3, float, Q> const* in, mat<3, 3, float, Q>* r, mat<3, 3, float, Q>* s, std::size_t count)
+	{
+		detail::svd_span(in, static_cast<mat<3, 3, float, Q>*>(0), static_cast<vec<3, float, Q>*>(0), static_cast<mat<3, 3, float, Q>*>(0), r, s, count);
+	}
 } //namespace glm
@@ -237,4 +237,12 @@ GLM_FUNC_QUALIFIER glm_vec4 glm_vec4_inf(glm_vec4 x)
 	return _mm_castsi128_ps(_mm_cmpeq_epi32(t2, _mm_set1_epi32(int(0xFF000000))));		// exponent is all 1s, fraction is 0
 }
 
+/// x * (1 - a) + y * a, in the same order as the scalar mix.
+GLM_FUNC_QUALIFIER glm_vec4 glm_vec3_mix(glm_vec4 x, glm_vec4 y, glm_vec4 a)
+{
+	glm_vec4 const mul0 = _mm_mul_ps(x, _mm_sub_ps(_mm_set1_ps(1.0f), a));
+	glm_vec4 const mul1 = _mm_mul_ps(y, a);
+	return _mm_add_ps(mul0, mul1);
+}
+
 #endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
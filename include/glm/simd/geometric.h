@@ -62,6 +62,15 @@ GLM_FUNC_QUALIFIER glm_vec4 glm_vec1_dot(glm_vec4 v1, glm_vec4 v2)
 #	endif
 }
 
+/// Dot product of xyz summed as (x + y) + z like the scalar code, broadcast to all lanes.
+GLM_FUNC_QUALIFIER glm_vec4 glm_vec3_dot(glm_vec4 a, glm_vec4 b)
+{
+	glm_vec4 const mul0 = _mm_mul_ps(a, b);
+	glm_vec4 const add0 = _mm_add_ss(mul0, _mm_shuffle_ps(mul0, mul0, _MM_SHUFFLE(1, 1, 1, 1)));
+	glm_vec4 const add1 = _mm_add_ss(add0, _mm_shuffle_ps(mul0, mul0, _MM_SHUFFLE(2, 2, 2, 2)));
+	return _mm_shuffle_ps(add1, add1, _MM_SHUFFLE(0, 0, 0, 0));
+}
+
 GLM_FUNC_QUALIFIER glm_vec4 glm_vec4_cross(glm_vec4 v1, glm_vec4 v2)
 {
 	glm_vec4 const swp0 = _mm_shuffle_ps(v1, v1, _MM_SHUFFLE(3, 0, 2, 1));
@@ -0,0 +1,603 @@
+#pragma once
+
+#ifndef GLM_ENABLE_EXPERIMENTAL
+#define GLM_ENABLE_EXPERIMENTAL
+#endif
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtx/intersect.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "render_backend.h"
+#include "tasks.h"
+
+// Собирает статическую часть сцены из вызовов RenderBackend; дым пропускается
+class SceneCapture : public RenderBackend
+{
+public:
+    struct Box
+    {
+        glm::mat4 model;
+        glm::vec3 albedo;
+    };
+
+    void setCamera(const glm::mat4&, const glm::mat4&) override {}
+    void drawCube(const glm::mat4& model, const glm::vec3& color) override { boxes.push_back({ model, color }); }
+    void drawGround(const glm::mat4& model, const glm::vec3& color) override { boxes.push_back({ model, color }); }
+    void drawSmoke(const glm::vec3&, float) override {}
+
+    std::vector<Box> boxes;
+};
+
+struct BakeSettings
+{
+    float texelsPerUnit = 16.0f;
+    int atlasWidth = 512;           // высота атласа — по заполнению
+    int samplesPerPass = 4;
+    int bounces = 2;
+
+    glm::vec3 sunDirection = glm::normalize(glm::vec3(0.5f, 1.0f, 0.3f)); // к солнцу
+    glm::vec3 sunIrradiance = glm::vec3(0.75f, 0.72f, 0.65f);
+    float sunRadius = 0.02f;        // угловой радиус диска — мягкость теней
+    glm::vec3 skyIrradiance = glm::vec3(0.30f, 0.33f, 0.38f);
+
+    glm::ivec3 probeGrid = glm::ivec3(8, 4, 8);
+};
+
+// Грани единичного куба: угол и два ребра, u x v — наружная нормаль.
+// Тот же порядок у вершин litCube в midterm.cpp.
+struct CubeFace
+{
+    glm::vec3 origin, u, v;
+};
+
+const CubeFace CUBE_FACES[6] = {
+    { {  0.5f, -0.5f,  0.5f }, {  0.0f, 0.0f, -1.0f }, { 0.0f, 1.0f,  0.0f } }, // +X
+    { { -0.5f, -0.5f, -0.5f }, {  0.0f, 0.0f,  1.0f }, { 0.0f, 1.0f,  0.0f } }, // -X
+    { { -0.5f,  0.5f,  0.5f }, {  1.0f, 0.0f,  0.0f }, { 0.0f, 0.0f, -1.0f } }, // +Y
+    { { -0.5f, -0.5f, -0.5f }, {  1.0f, 0.0f,  0.0f }, { 0.0f, 0.0f,  1.0f } }, // -Y
+    { { -0.5f, -0.5f,  0.5f }, {  1.0f, 0.0f,  0.0f }, { 0.0f, 1.0f,  0.0f } }, // +Z
+    { {  0.5f, -0.5f, -0.5f }, { -1.0f, 0.0f,  0.0f }, { 0.0f, 1.0f,  0.0f } }, // -Z
+};
+
+// Запекание статического освещения: трассировка путей по BVH сцены из
+// коробок (пересечения — glm::intersectRayTriangle), прямое солнце с мягкой
+// тенью, небо и bounces отражений. Каждая грань — прямоугольник в атласе с
+// полем в тексель, плотность texelsPerUnit. Карта хранит освещённость без
+// альбедо: на рантайме цвет = uColor * texture(lightmap). pass() добавляет
+// samplesPerPass выборок на тексель и пробу и пересобирает результат с
+// подавлением шума, так что карту можно показывать после каждого прохода.
+// Пробы — L1 SH освещённости на решётке probeGrid над сценой, для
+// динамических объектов.
+class LightmapBaker
+{
+public:
+    LightmapBaker(ThreadPool& pool, std::vector<SceneCapture::Box> boxes, const BakeSettings& settings = BakeSettings())
+        : pool(pool), settings(settings), boxes(std::move(boxes))
+    {
+        buildTriangles();
+        buildBVH();
+        packCharts();
+        placeProbes();
+    }
+
+    void pass()
+    {
+        int passIndex = passes++;
+        pool.parallelFor(atlasHeight, 4, [this, passIndex](size_t begin, size_t end)
+        {
+            for (size_t y = begin; y < end; ++y)
+                for (int x = 0; x < atlasWidth; ++x)
+                    bakeTexel(x, (int)y, passIndex);
+        });
+        pool.parallelFor(probes.size(), 1, [this, passIndex](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+                bakeProbe(i, passIndex);
+        });
+        sampleCount += settings.samplesPerPass;
+        denoise();
+        pool.parallelFor(output.size(), 4096, [this](size_t begin, size_t end)
+        {
+            glm::packF3x9_E1x5(output.data() + begin, packed.data() + begin, end - begin);
+        });
+    }
+
+    int samples() const { return sampleCount; }
+    int width() const { return atlasWidth; }
+    int height() const { return atlasHeight; }
+
+    // Освещённость RGB, a = 1 у занятых текселей
+    const std::vector<glm::vec4>& lightmap() const { return output; }
+    // То же в RGB9E5 (GL_RGB9_E5): 4 байта на тексель вместо 8 у RGBA16F
+    const std::vector<uint32_t>& packedLightmap() const { return packed; }
+
+    size_t boxCount() const { return boxes.size(); }
+    const glm::mat4& boxModel(size_t box) const { return boxes[box].model; }
+
+    // Прямоугольник грани в UV атласа: xy — начало, zw — размер
+    glm::vec4 faceRect(size_t box, int face) const
+    {
+        const Chart& c = charts[box * 6 + face];
+        return glm::vec4((float)c.x / atlasWidth, (float)c.y / atlasHeight,
+                         (float)c.w / atlasWidth, (float)c.h / atlasHeight);
+    }
+
+    // Освещённость поверхности с нормалью normal в точке pos — из проб
+    glm::vec3 irradiance(const glm::vec3& pos, const glm::vec3& normal) const
+    {
+        glm::vec3 g = glm::clamp((pos - probeMin) / probeStep, glm::vec3(0.0f), glm::vec3(settings.probeGrid - 1));
+        glm::ivec3 i0 = glm::min(glm::ivec3(g), settings.probeGrid - 2);
+        glm::vec3 f = g - glm::vec3(i0);
+        glm::vec3 sh[4] = {};
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            glm::ivec3 o(corner & 1, corner >> 1 & 1, corner >> 2 & 1);
+            float w = (o.x ? f.x : 1.0f - f.x) * (o.y ? f.y : 1.0f - f.y) * (o.z ? f.z : 1.0f - f.z);
+            const Probe& p = probes[probeIndex(i0 + o)];
+            for (int k = 0; k < 4; ++k)
+                sh[k] += p.sh[k] * (w / (float)std::max(p.samples, 1));
+        }
+        // Свёртка с косинусом: A0 = pi, A1 = 2pi/3
+        const float Y0 = 0.282095f, Y1 = 0.488603f;
+        glm::vec3 e = sh[0] * (glm::pi<float>() * Y0)
+            + (sh[1] * normal.y + sh[2] * normal.z + sh[3] * normal.x) * (2.0f * glm::pi<float>() / 3.0f * Y1);
+        return glm::max(e, glm::vec3(0.0f));
+    }
+
+private:
+    struct Triangle
+    {
+        glm::vec3 v0, v1, v2;
+        glm::vec3 normal;
+        glm::vec3 albedo;
+    };
+
+    // Лист — count > 0; у внутреннего левый ребёнок следующий, правый — first
+    struct Node
+    {
+        glm::vec3 lo, hi;
+        uint32_t first, count;
+    };
+
+    struct Chart
+    {
+        int x, y, w, h;     // без поля
+        glm::vec3 origin, u, v, normal;
+    };
+
+    struct Texel
+    {
+        glm::vec3 sum = glm::vec3(0.0f);
+        int samples = 0;
+        int inside = 0;     // выборки, упёршиеся в изнанку: тексель внутри геометрии
+    };
+
+    struct Probe
+    {
+        glm::vec3 pos;
+        glm::vec3 sh[4] = {};
+        int samples = 0;
+    };
+
+    struct Hit
+    {
+        float t;
+        uint32_t triangle;
+    };
+
+    static constexpr uint32_t NO_CHART = 0xFFFFFFFFu;
+    static constexpr float RAY_EPSILON = 1e-3f;
+
+    // Независимые случайные числа для текселя и прохода: итог не зависит
+    // от того, как parallelFor поделил строки
+    struct Random
+    {
+        uint32_t state;
+
+        explicit Random(uint32_t seed) : state(seed * 0x9E3779B9u + 0x7F4A7C15u) { next(); }
+
+        uint32_t next()
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        float uniform() { return (float)(next() >> 8) * (1.0f / 16777216.0f); }
+    };
+
+    static uint32_t hashSeed(uint32_t a, uint32_t b)
+    {
+        uint32_t h = a * 0x8da6b343u ^ b * 0xd8163841u;
+        h ^= h >> 13;
+        h *= 0x5bd1e995u;
+        h ^= h >> 15;
+        return h | 1u;
+    }
+
+    static glm::vec3 cosineSample(const glm::vec3& n, Random& rng)
+    {
+        float r = std::sqrt(rng.uniform());
+        float phi = 2.0f * glm::pi<float>() * rng.uniform();
+        glm::vec3 t = std::fabs(n.x) > 0.5f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+        glm::vec3 b1 = glm::normalize(glm::cross(t, n));
+        glm::vec3 b2 = glm::cross(n, b1);
+        return b1 * (r * std::cos(phi)) + b2 * (r * std::sin(phi)) + n * std::sqrt(std::max(0.0f, 1.0f - r * r));
+    }
+
+    static glm::vec3 sphereSample(Random& rng)
+    {
+        float z = 1.0f - 2.0f * rng.uniform();
+        float r = std::sqrt(std::max(0.0f, 1.0f - z * z));
+        float phi = 2.0f * glm::pi<float>() * rng.uniform();
+        return glm::vec3(r * std::cos(phi), r * std::sin(phi), z);
+    }
+
+    void buildTriangles()
+    {
+        for (const SceneCapture::Box& box : boxes)
+            for (const CubeFace& f : CUBE_FACES)
+            {
+                glm::vec3 o = glm::vec3(box.model * glm::vec4(f.origin, 1.0f));
+                glm::vec3 u = glm::mat3(box.model) * f.u, v = glm::mat3(box.model) * f.v;
+                glm::vec3 n = glm::normalize(glm::cross(u, v));
+                triangles.push_back({ o, o + u, o + u + v, n, box.albedo });
+                triangles.push_back({ o, o + u + v, o + v, n, box.albedo });
+            }
+    }
+
+    void buildBVH()
+    {
+        order.resize(triangles.size());
+        for (uint32_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        nodes.reserve(triangles.size() * 2);
+        buildNode(0, (uint32_t)order.size());
+    }
+
+    uint32_t buildNode(uint32_t first, uint32_t count)
+    {
+        uint32_t index = (uint32_t)nodes.size();
+        nodes.push_back({});
+        glm::vec3 lo(1e30f), hi(-1e30f), clo(1e30f), chi(-1e30f);
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            const Triangle& t = triangles[order[i]];
+            lo = glm::min(lo, glm::min(t.v0, glm::min(t.v1, t.v2)));
+            hi = glm::max(hi, glm::max(t.v0, glm::max(t.v1, t.v2)));
+            glm::vec3 c = (t.v0 + t.v1 + t.v2) / 3.0f;
+            clo = glm::min(clo, c);
+            chi = glm::max(chi, c);
+        }
+        nodes[index].lo = lo;
+        nodes[index].hi = hi;
+        if (count <= 4)
+        {
+            nodes[index].first = first;
+            nodes[index].count = count;
+            return index;
+        }
+
+        // Деление по медиане центров вдоль самой длинной оси
+        glm::vec3 extent = chi - clo;
+        int axis = extent.x > extent.y && extent.x > extent.z ? 0 : (extent.y > extent.z ? 1 : 2);
+        uint32_t mid = first + count / 2;
+        std::nth_element(order.begin() + first, order.begin() + mid, order.begin() + first + count,
+                         [this, axis](uint32_t a, uint32_t b)
+        {
+            const Triangle& ta = triangles[a];
+            const Triangle& tb = triangles[b];
+            return ta.v0[axis] + ta.v1[axis] + ta.v2[axis] < tb.v0[axis] + tb.v1[axis] + tb.v2[axis];
+        });
+        buildNode(first, mid - first);
+        uint32_t right = buildNode(mid, first + count - mid);
+        nodes[index].first = right;
+        nodes[index].count = 0;
+        return index;
+    }
+
+    static bool slab(const Node& n, const glm::vec3& o, const glm::vec3& inv, float maxT)
+    {
+        glm::vec3 t0 = (n.lo - o) * inv, t1 = (n.hi - o) * inv;
+        glm::vec3 tmin = glm::min(t0, t1), tmax = glm::max(t0, t1);
+        float enter = std::max(std::max(tmin.x, tmin.y), std::max(tmin.z, 0.0f));
+        float exit = std::min(std::min(tmax.x, tmax.y), std::min(tmax.z, maxT));
+        return enter <= exit;
+    }
+
+    // Ближайшее пересечение в (RAY_EPSILON, maxT); anyHit — первое попавшееся
+    bool trace(const glm::vec3& o, const glm::vec3& d, float maxT, Hit& hit, bool anyHit) const
+    {
+        glm::vec3 inv;
+        for (int k = 0; k < 3; ++k)
+            inv[k] = 1.0f / (std::fabs(d[k]) > 1e-8f ? d[k] : 1e-8f);
+        hit.t = maxT;
+        bool found = false;
+        uint32_t stack[64];
+        int sp = 0;
+        stack[sp++] = 0;
+        while (sp > 0)
+        {
+            const Node& n = nodes[stack[--sp]];
+            if (!slab(n, o, inv, hit.t))
+                continue;
+            if (n.count == 0)
+            {
+                stack[sp++] = n.first;
+                stack[sp++] = (uint32_t)(&n - nodes.data()) + 1;
+                continue;
+            }
+            for (uint32_t i = n.first; i < n.first + n.count; ++i)
+            {
+                const Triangle& t = triangles[order[i]];
+                glm::vec2 bary;
+                float dist;
+                if (glm::intersectRayTriangle(o, d, t.v0, t.v1, t.v2, bary, dist)
+                    && dist > RAY_EPSILON && dist < hit.t)
+                {
+                    hit.t = dist;
+                    hit.triangle = order[i];
+                    found = true;
+                    if (anyHit)
+                        return true;
+                }
+            }
+        }
+        return found;
+    }
+
+    // Прямое солнце: точка на диске вокруг направления — мягкая полутень
+    glm::vec3 sunLight(const glm::vec3& p, const glm::vec3& n, Random& rng) const
+    {
+        float cosine = glm::dot(n, settings.sunDirection);
+        if (cosine <= 0.0f)
+            return glm::vec3(0.0f);
+        glm::vec3 dir = glm::normalize(settings.sunDirection + sphereSample(rng) * settings.sunRadius);
+        Hit hit;
+        if (trace(p + n * RAY_EPSILON, dir, 1e30f, hit, true))
+            return glm::vec3(0.0f);
+        return settings.sunIrradiance * cosine;
+    }
+
+    glm::vec3 skyRadiance(const glm::vec3& d) const
+    {
+        // Ниже горизонта — далёкая земля, тусклее неба
+        return settings.skyIrradiance / glm::pi<float>() * (d.y > 0.0f ? 1.0f : 0.3f);
+    }
+
+    // Освещённость точки: солнце плюс одна выборка входящего света
+    glm::vec3 irradianceAt(const glm::vec3& p, const glm::vec3& n, int depth, Random& rng, bool* inside) const
+    {
+        glm::vec3 e = sunLight(p, n, rng);
+        if (depth > settings.bounces)
+            return e;
+        glm::vec3 d = cosineSample(n, rng);
+        return e + glm::pi<float>() * radiance(p + n * RAY_EPSILON, d, depth, rng, inside);
+    }
+
+    glm::vec3 radiance(const glm::vec3& o, const glm::vec3& d, int depth, Random& rng, bool* inside) const
+    {
+        Hit hit;
+        if (!trace(o, d, 1e30f, hit, false))
+            return skyRadiance(d);
+        const Triangle& t = triangles[hit.triangle];
+        if (glm::dot(t.normal, d) > 0.0f)
+        {
+            if (inside)
+                *inside = true;
+            return glm::vec3(0.0f);
+        }
+        glm::vec3 p = o + d * hit.t;
+        return t.albedo / glm::pi<float>() * irradianceAt(p, t.normal, depth + 1, rng, nullptr);
+    }
+
+    void packCharts()
+    {
+        charts.resize(boxes.size() * 6);
+        std::vector<uint32_t> sorted(charts.size());
+        for (uint32_t i = 0; i < charts.size(); ++i)
+        {
+            const SceneCapture::Box& box = boxes[i / 6];
+            const CubeFace& f = CUBE_FACES[i % 6];
+            Chart& c = charts[i];
+            c.origin = glm::vec3(box.model * glm::vec4(f.origin, 1.0f));
+            c.u = glm::mat3(box.model) * f.u;
+            c.v = glm::mat3(box.model) * f.v;
+            c.normal = glm::normalize(glm::cross(c.u, c.v));
+            int limit = settings.atlasWidth - 2;
+            c.w = std::clamp((int)std::ceil(glm::length(c.u) * settings.texelsPerUnit), 2, limit);
+            c.h = std::clamp((int)std::ceil(glm::length(c.v) * settings.texelsPerUnit), 2, limit);
+            sorted[i] = i;
+        }
+
+        // Полки: самые высокие первыми, у каждого прямоугольника поле в тексель
+        std::sort(sorted.begin(), sorted.end(), [this](uint32_t a, uint32_t b) { return charts[a].h > charts[b].h; });
+        atlasWidth = settings.atlasWidth;
+        int x = 0, y = 0, shelf = 0;
+        for (uint32_t i : sorted)
+        {
+            Chart& c = charts[i];
+            if (x + c.w + 2 > atlasWidth)
+            {
+                x = 0;
+                y += shelf;
+                shelf = 0;
+            }
+            c.x = x + 1;
+            c.y = y + 1;
+            x += c.w + 2;
+            shelf = std::max(shelf, c.h + 2);
+        }
+        atlasHeight = 4;
+        while (atlasHeight < y + shelf)
+            atlasHeight *= 2;
+
+        texels.assign((size_t)atlasWidth * atlasHeight, Texel());
+        chartOf.assign(texels.size(), NO_CHART);
+        output.assign(texels.size(), glm::vec4(0.0f));
+        packed.assign(texels.size(), 0);
+        for (uint32_t i = 0; i < charts.size(); ++i)
+        {
+            const Chart& c = charts[i];
+            for (int ty = 0; ty < c.h; ++ty)
+                for (int tx = 0; tx < c.w; ++tx)
+                    chartOf[(size_t)(c.y + ty) * atlasWidth + c.x + tx] = i;
+        }
+    }
+
+    void bakeTexel(int x, int y, int passIndex)
+    {
+        size_t index = (size_t)y * atlasWidth + x;
+        if (chartOf[index] == NO_CHART)
+            return;
+        const Chart& c = charts[chartOf[index]];
+        Random rng(hashSeed((uint32_t)index, (uint32_t)passIndex));
+        Texel& texel = texels[index];
+        for (int s = 0; s < settings.samplesPerPass; ++s)
+        {
+            // Случайная точка внутри текселя — заодно сглаживает края теней
+            float fs = ((float)(x - c.x) + rng.uniform()) / (float)c.w;
+            float ft = ((float)(y - c.y) + rng.uniform()) / (float)c.h;
+            glm::vec3 p = c.origin + c.u * fs + c.v * ft;
+            bool inside = false;
+            texel.sum += irradianceAt(p, c.normal, 1, rng, &inside);
+            texel.inside += inside ? 1 : 0;
+            ++texel.samples;
+        }
+    }
+
+    void placeProbes()
+    {
+        glm::vec3 lo(1e30f), hi(-1e30f);
+        for (const Triangle& t : triangles)
+        {
+            lo = glm::min(lo, glm::min(t.v0, glm::min(t.v1, t.v2)));
+            hi = glm::max(hi, glm::max(t.v0, glm::max(t.v1, t.v2)));
+        }
+        if (triangles.empty())
+            lo = hi = glm::vec3(0.0f);
+        settings.probeGrid = glm::max(settings.probeGrid, glm::ivec3(2));
+        probeMin = lo;
+        probeStep = glm::max(hi - lo, glm::vec3(1e-3f)) / glm::vec3(settings.probeGrid - 1);
+        probes.resize((size_t)settings.probeGrid.x * settings.probeGrid.y * settings.probeGrid.z);
+        for (int z = 0; z < settings.probeGrid.z; ++z)
+            for (int y = 0; y < settings.probeGrid.y; ++y)
+                for (int x = 0; x < settings.probeGrid.x; ++x)
+                    probes[probeIndex(glm::ivec3(x, y, z))].pos = probeMin + probeStep * glm::vec3(x, y, z);
+    }
+
+    size_t probeIndex(const glm::ivec3& i) const
+    {
+        return ((size_t)i.z * settings.probeGrid.y + i.y) * settings.probeGrid.x + i.x;
+    }
+
+    // Проекция входящего света на L1 SH; выборки по сфере, вес 4pi/N
+    void bakeProbe(size_t index, int passIndex)
+    {
+        Probe& p = probes[index];
+        Random rng(hashSeed((uint32_t)index ^ 0x55555555u, (uint32_t)passIndex));
+        const float Y0 = 0.282095f, Y1 = 0.488603f;
+        int rays = settings.samplesPerPass * 16;
+        for (int i = 0; i < rays; ++i)
+        {
+            glm::vec3 d = sphereSample(rng);
+            glm::vec3 l = radiance(p.pos, d, 1, rng, nullptr) * (4.0f * glm::pi<float>());
+            p.sh[0] += l * Y0;
+            p.sh[1] += l * (Y1 * d.y);
+            p.sh[2] += l * (Y1 * d.z);
+            p.sh[3] += l * (Y1 * d.x);
+        }
+        p.samples += rays;
+    }
+
+    // Совместный двусторонний фильтр 5x5 внутри своей грани: сила падает с
+    // числом выборок. Тексели внутри геометрии не участвуют и заполняются
+    // соседями; поле вокруг граней — копия краёв, для билинейной выборки.
+    void denoise()
+    {
+        auto valid = [this](size_t i) { return texels[i].samples > 0 && texels[i].inside * 2 < texels[i].samples; };
+        float sigma = 0.25f / std::sqrt((float)std::max(sampleCount, 1) / (float)settings.samplesPerPass);
+        float inv2Sigma2 = 1.0f / (2.0f * sigma * sigma);
+
+        pool.parallelFor(atlasHeight, 8, [&](size_t begin, size_t end)
+        {
+            for (size_t y = begin; y < end; ++y)
+                for (int x = 0; x < atlasWidth; ++x)
+                {
+                    size_t index = y * atlasWidth + x;
+                    uint32_t chart = chartOf[index];
+                    if (chart == NO_CHART)
+                        continue;
+                    bool self = valid(index);
+                    glm::vec3 center = self ? texels[index].sum / (float)texels[index].samples : glm::vec3(0.0f);
+                    float centerLum = glm::dot(center, glm::vec3(0.299f, 0.587f, 0.114f));
+                    glm::vec3 sum(0.0f);
+                    float weightSum = 0.0f;
+                    for (int dy = -2; dy <= 2; ++dy)
+                        for (int dx = -2; dx <= 2; ++dx)
+                        {
+                            int nx = x + dx, ny = (int)y + dy;
+                            if (nx < 0 || ny < 0 || nx >= atlasWidth || ny >= atlasHeight)
+                                continue;
+                            size_t n = (size_t)ny * atlasWidth + nx;
+                            if (chartOf[n] != chart || !valid(n))
+                                continue;
+                            glm::vec3 c = texels[n].sum / (float)texels[n].samples;
+                            float w = std::exp(-(float)(dx * dx + dy * dy) * 0.25f);
+                            if (self)
+                            {
+                                float dl = glm::dot(c, glm::vec3(0.299f, 0.587f, 0.114f)) - centerLum;
+                                w *= std::exp(-dl * dl * inv2Sigma2);
+                            }
+                            sum += c * w;
+                            weightSum += w;
+                        }
+                    output[index] = weightSum > 0.0f ? glm::vec4(sum / weightSum, 1.0f) : glm::vec4(center, 1.0f);
+                }
+        });
+
+        for (const Chart& c : charts)
+        {
+            auto at = [this](int x, int y) -> glm::vec4& { return output[(size_t)y * atlasWidth + x]; };
+            for (int tx = -1; tx <= c.w; ++tx)
+            {
+                int sx = std::clamp(tx, 0, c.w - 1);
+                at(c.x + tx, c.y - 1) = at(c.x + sx, c.y);
+                at(c.x + tx, c.y + c.h) = at(c.x + sx, c.y + c.h - 1);
+            }
+            for (int ty = 0; ty < c.h; ++ty)
+            {
+                at(c.x - 1, c.y + ty) = at(c.x, c.y + ty);
+                at(c.x + c.w, c.y + ty) = at(c.x + c.w - 1, c.y + ty);
+            }
+        }
+    }
+
+    ThreadPool& pool;
+    BakeSettings settings;
+    std::vector<SceneCapture::Box> boxes;
+
+    std::vector<Triangle> triangles;
+    std::vector<uint32_t> order;
+    std::vector<Node> nodes;
+
+    std::vector<Chart> charts;
+    int atlasWidth = 0, atlasHeight = 0;
+    std::vector<Texel> texels;
+    std::vector<uint32_t> chartOf;
+    std::vector<glm::vec4> output;
+    std::vector<uint32_t> packed;
+
+    std::vector<Probe> probes;
+    glm::vec3 probeMin = glm::vec3(0.0f), probeStep = glm::vec3(1.0f);
+
+    int passes = 0;
+    int sampleCount = 0;
+};
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "textures.h"
+
+// ARB_bindless_texture в glad не сгенерирован — указатели берём сами
+typedef GLuint64 (APIENTRYP PFNGLGETTEXTUREHANDLEARBPROC_MID)(GLuint texture);
+typedef void (APIENTRYP PFNGLMAKETEXTUREHANDLERESIDENTARBPROC_MID)(GLuint64 handle);
+typedef void (APIENTRYP PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC_MID)(GLuint64 handle);
+
+struct BindlessTextures
+{
+    PFNGLGETTEXTUREHANDLEARBPROC_MID getTextureHandle = nullptr;
+    PFNGLMAKETEXTUREHANDLERESIDENTARBPROC_MID makeTextureHandleResident = nullptr;
+    PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC_MID makeTextureHandleNonResident = nullptr;
+
+    bool available() const { return getTextureHandle && makeTextureHandleResident && makeTextureHandleNonResident; }
+};
+
+// Загружается один раз при первом вызове; нужен текущий GL-контекст.
+// Хэндл в шейдере свой у каждого инстанса, то есть неоднородный в пределах
+// вызова: это допустимо только с NV_gpu_shader5, без него bindless не берём
+inline const BindlessTextures& bindlessTextures()
+{
+    static const BindlessTextures api = []
+    {
+        BindlessTextures b;
+        if (!glfwExtensionSupported("GL_ARB_bindless_texture") || !glfwExtensionSupported("GL_NV_gpu_shader5"))
+            return b;
+        b.getTextureHandle = (PFNGLGETTEXTUREHANDLEARBPROC_MID)glfwGetProcAddress("glGetTextureHandleARB");
+        b.makeTextureHandleResident =
+            (PFNGLMAKETEXTUREHANDLERESIDENTARBPROC_MID)glfwGetProcAddress("glMakeTextureHandleResidentARB");
+        b.makeTextureHandleNonResident =
+            (PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC_MID)glfwGetProcAddress("glMakeTextureHandleNonResidentARB");
+        return b;
+    }();
+    return api;
+}
+
+struct Material
+{
+    TextureId texture = NO_TEXTURE;
+    glm::vec4 tint = glm::vec4(1.0f);
+};
+
+// Без bindless массивы привязываются к юнитам подряд, начиная с этого
+constexpr GLuint MATERIAL_TABLE_UNIT = 4;
+constexpr GLuint MATERIAL_ARRAY_UNIT = 5;
+constexpr int MATERIAL_ARRAY_SLOTS = 8;
+
+// GLSL-функция vec4 materialColor(uint material, vec2 uv): цвет материала с
+// текстурой. Вставляется после #version; для bindless добавляет #extension.
+inline std::string materialShaderSource(bool bindless)
+{
+    std::string s = bindless ? "#extension GL_ARB_bindless_texture : require\n"
+                               "#extension GL_NV_gpu_shader5 : require\n" : "";
+    s += R"(
+uniform usamplerBuffer uMaterials;
+)";
+    if (bindless)
+    {
+        // Неоднородный хэндл разрешает NV_gpu_shader5 — без него сюда не попадаем
+        s += R"(
+vec4 sampleMaterial(uvec4 m, vec2 uv)
+{
+    return texture(sampler2DArray(m.xy), vec3(uv, float(m.z)));
+}
+)";
+    }
+    else
+    {
+        // В GLSL 3.30 массив сэмплеров индексируется только константой —
+        // отсюда цепочка сравнений; производные берём до ветвления
+        s += "uniform sampler2DArray uMaterialArrays[" + std::to_string(MATERIAL_ARRAY_SLOTS) + "];\n";
+        s += R"(
+vec4 sampleMaterial(uvec4 m, vec2 uv)
+{
+    vec3 coord = vec3(uv, float(m.z));
+    vec2 dx = dFdx(uv), dy = dFdy(uv);
+)";
+        for (int i = 0; i < MATERIAL_ARRAY_SLOTS; ++i)
+            s += "    if (m.x == " + std::to_string(i) + "u) return textureGrad(uMaterialArrays["
+                + std::to_string(i) + "], coord, dx, dy);\n";
+        s += "    return vec4(1.0);\n}\n";
+    }
+    s += R"(
+vec4 materialColor(uint material, vec2 uv)
+{
+    int index = int(material) < textureSize(uMaterials) ? int(material) : 0;
+    uvec4 m = texelFetch(uMaterials, index);
+    vec4 tint = vec4(uvec4(m.w, m.w >> 8, m.w >> 16, m.w >> 24) & 0xFFu) / 255.0;
+    if (m.x == 0xFFFFFFFFu && m.y == 0xFFFFFFFFu)
+        return tint;
+    return sampleMaterial(m, uv) * tint;
+}
+)";
+    return s;
+}
+
+// Таблица материалов в текстурном буфере: на материал один uvec4 —
+// хэндл bindless (или номер слота массива), слой и оттенок RGBA8. Шейдер
+// берёт материал по индексу инстанса, поэтому кубы с любыми текстурами
+// рисуются одним вызовом. Без пары ARB_bindless_texture и NV_gpu_shader5
+// (например, llvmpipe) — до MATERIAL_ARRAY_SLOTS массивов TextureManager
+// на юнитах подряд.
+// Материал 0 — без текстуры, белый.
+class MaterialTable
+{
+public:
+    explicit MaterialTable(TextureManager& textures)
+        : textures(textures), useBindless(bindlessTextures().available())
+    {
+        glGenBuffers(1, &buffer);
+        glGenTextures(1, &bufferTexture);
+        materials.push_back(Material());
+        entries.push_back(untextured(materials[0]));
+        dirty = true;
+
+        // Хэндл снимается до удаления массива, иначе он остаётся резидентным
+        textures.onArrayRelease = [this](uint64_t serial, GLuint)
+        {
+            auto it = handles.find(serial);
+            if (it == handles.end())
+                return;
+            bindlessTextures().makeTextureHandleNonResident(it->second);
+            handles.erase(it);
+        };
+    }
+
+    ~MaterialTable()
+    {
+        textures.onArrayRelease = nullptr;
+        for (const auto& [serial, handle] : handles)
+            bindlessTextures().makeTextureHandleNonResident(handle);
+        glDeleteTextures(1, &bufferTexture);
+        glDeleteBuffers(1, &buffer);
+    }
+
+    MaterialTable(const MaterialTable&) = delete;
+    MaterialTable& operator=(const MaterialTable&) = delete;
+
+    uint32_t add(const Material& m)
+    {
+        materials.push_back(m);
+        entries.push_back(untextured(m));
+        dirty = true;
+        return (uint32_t)materials.size() - 1;
+    }
+
+    void set(uint32_t index, const Material& m)
+    {
+        if (index < materials.size())
+            materials[index] = m;
+    }
+
+    bool bindless() const { return useBindless; }
+
+    // Раз в кадр перед рисованием: текстуры могли переехать в другой массив
+    void update()
+    {
+        slotArrays.clear();
+        for (size_t i = 0; i < materials.size(); ++i)
+        {
+            uint32_t entry[4];
+            TextureManager::Location loc;
+            if (materials[i].texture == NO_TEXTURE || !textures.locate(materials[i].texture, loc))
+                std::memcpy(entry, untextured(materials[i]).v, sizeof(entry));
+            else if (useBindless)
+                bindlessEntry(loc, materials[i], entry);
+            else
+                slotEntry(loc, materials[i], entry);
+
+            if (std::memcmp(entry, entries[i].v, sizeof(entry)) != 0)
+            {
+                std::memcpy(entries[i].v, entry, sizeof(entry));
+                dirty = true;
+            }
+        }
+
+        if (!dirty)
+            return;
+        glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+        glBufferData(GL_TEXTURE_BUFFER, (GLsizeiptr)(entries.size() * sizeof(Entry)), entries.data(), GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        glBindTexture(GL_TEXTURE_BUFFER, bufferTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32UI, buffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        dirty = false;
+    }
+
+    // Привязать таблицу и массивы; программа должна использовать materialShaderSource()
+    void bind(GLuint program) const
+    {
+        glActiveTexture(GL_TEXTURE0 + MATERIAL_TABLE_UNIT);
+        glBindTexture(GL_TEXTURE_BUFFER, bufferTexture);
+        glUniform1i(glGetUniformLocation(program, "uMaterials"), (GLint)MATERIAL_TABLE_UNIT);
+
+        if (!useBindless)
+        {
+            GLint units[MATERIAL_ARRAY_SLOTS];
+            for (int i = 0; i < MATERIAL_ARRAY_SLOTS; ++i)
+            {
+                units[i] = (GLint)(MATERIAL_ARRAY_UNIT + i);
+                glActiveTexture(GL_TEXTURE0 + MATERIAL_ARRAY_UNIT + i);
+                glBindTexture(GL_TEXTURE_2D_ARRAY, i < (int)slotArrays.size() ? slotArrays[i] : 0);
+            }
+            glUniform1iv(glGetUniformLocation(program, "uMaterialArrays"), MATERIAL_ARRAY_SLOTS, units);
+        }
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+private:
+    struct Entry
+    {
+        uint32_t v[4];
+    };
+
+    static uint32_t packTint(const glm::vec4& c)
+    {
+        glm::uvec4 u = glm::uvec4(glm::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f);
+        return u.r | u.g << 8 | u.b << 16 | u.a << 24;
+    }
+
+    static Entry untextured(const Material& m)
+    {
+        return { { 0xFFFFFFFFu, 0xFFFFFFFFu, 0, packTint(m.tint) } };
+    }
+
+    void bindlessEntry(const TextureManager::Location& loc, const Material& m, uint32_t entry[4])
+    {
+        // Хэндл живёт, пока жив массив: onArrayRelease снимает его с резидентности
+        auto it = handles.find(loc.serial);
+        if (it == handles.end())
+        {
+            GLuint64 h = bindlessTextures().getTextureHandle(loc.array);
+            bindlessTextures().makeTextureHandleResident(h);
+            it = handles.emplace(loc.serial, h).first;
+        }
+        entry[0] = (uint32_t)it->second;
+        entry[1] = (uint32_t)(it->second >> 32);
+        entry[2] = loc.layer;
+        entry[3] = packTint(m.tint);
+    }
+
+    void slotEntry(const TextureManager::Location& loc, const Material& m, uint32_t entry[4])
+    {
+        size_t slot = 0;
+        while (slot < slotArrays.size() && slotArrays[slot] != loc.array)
+            ++slot;
+        if (slot == slotArrays.size())
+        {
+            if (slot == MATERIAL_ARRAY_SLOTS)
+            {
+                // Слоты кончились — рисуем без текстуры, но одним вызовом
+                if (!warnedSlots)
+                    std::cerr << "More than " << MATERIAL_ARRAY_SLOTS << " texture arrays in use, "
+                              << "some materials drawn untextured\n";
+                warnedSlots = true;
+                std::memcpy(entry, untextured(m).v, sizeof(Entry));
+                return;
+            }
+            slotArrays.push_back(loc.array);
+        }
+        entry[0] = (uint32_t)slot;
+        entry[1] = 0;
+        entry[2] = loc.layer;
+        entry[3] = packTint(m.tint);
+    }
+
+    TextureManager& textures;
+    bool useBindless;
+
+    std::vector<Material> materials;
+    std::vector<Entry> entries;
+    bool dirty = false;
+
+    GLuint buffer = 0, bufferTexture = 0;
+    std::vector<GLuint> slotArrays;
+    std::unordered_map<uint64_t, GLuint64> handles;
+    bool warnedSlots = false;
+};
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "span_reduce.h"
+
+// Импортированная треугольная сетка: общие вершины и индексы по три.
+// texcoords, normals и tangents — либо пустые, либо по одному на вершину;
+// нормали и касательные считает generateNormals/generateTangents
+// (mesh_attributes.h), w касательной — знак битангенса
+struct Mesh
+{
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texcoords;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec4> tangents;
+    std::vector<uint32_t> indices;
+    glm::vec3 boundsMin = glm::vec3(0.0f), boundsMax = glm::vec3(0.0f);
+
+    size_t triangleCount() const { return indices.size() / 3; }
+
+    void computeBounds()
+    {
+        if (positions.empty())
+            return;
+        Bounds b = reduceBounds(positions.data(), positions.size());
+        boundsMin = b.min;
+        boundsMax = b.max;
+    }
+};
+
+// Wavefront OBJ: берутся «v», «vt» и «f»; многоугольники режутся веером,
+// отрицательные индексы — от конца списка. Вершина сетки — пара «v/vt»:
+// на швах развёртки позиция повторяется. «vn» пропускаются, нормали
+// строятся заново
+inline bool parseObj(const char* data, size_t size, Mesh& out)
+{
+    out = Mesh();
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texcoords;
+    std::unordered_map<uint64_t, uint32_t> vertexOf;   // (v << 32) | vt -> вершина
+    const char* p = data;
+    const char* end = data + size;
+    std::vector<uint32_t> face;
+
+    auto readFloats = [](const std::string& text, float* v, int count)
+    {
+        const char* s = text.c_str() + text.find(' ');
+        char* next;
+        for (int i = 0; i < count; ++i)
+        {
+            v[i] = std::strtof(s, &next);
+            if (next == s)
+                return false;
+            s = next;
+        }
+        return true;
+    };
+    auto resolve = [](long index, size_t count)
+    {
+        long resolved = index < 0 ? (long)count + index : index - 1;
+        return index == 0 || resolved < 0 || resolved >= (long)count ? -1L : resolved;
+    };
+
+    while (p < end)
+    {
+        const char* line = p;
+        while (p < end && *p != '\n')
+            ++p;
+        std::string text(line, p);
+        if (p < end)
+            ++p;
+
+        if (text.size() > 2 && text[0] == 'v' && text[1] == ' ')
+        {
+            glm::vec3 v;
+            if (!readFloats(text, &v.x, 3))
+            {
+                std::cerr << "Bad OBJ vertex: " << text << "\n";
+                return false;
+            }
+            positions.push_back(v);
+        }
+        else if (text.size() > 3 && text[0] == 'v' && text[1] == 't' && text[2] == ' ')
+        {
+            glm::vec2 t;
+            if (!readFloats(text, &t.x, 2))
+            {
+                std::cerr << "Bad OBJ texcoord: " << text << "\n";
+                return false;
+            }
+            texcoords.push_back(t);
+        }
+        else if (text.size() > 2 && text[0] == 'f' && text[1] == ' ')
+        {
+            face.clear();
+            const char* s = text.c_str() + 2;
+            char* next;
+            for (;;)
+            {
+                long v = resolve(std::strtol(s, &next, 10), positions.size());
+                if (next == s)
+                    break;
+                long vt = -1;
+                s = next;
+                if (*s == '/' && s[1] != '/')
+                {
+                    vt = resolve(std::strtol(s + 1, &next, 10), texcoords.size());
+                    if (next == s + 1 || vt < 0)
+                        v = -1;
+                    s = next;
+                }
+                if (v < 0)
+                {
+                    std::cerr << "Bad OBJ face index: " << text << "\n";
+                    return false;
+                }
+                while (*s == '/' || (*s >= '0' && *s <= '9') || *s == '-')
+                    ++s;
+
+                uint64_t key = ((uint64_t)v << 32) | (uint32_t)vt;
+                auto [it, added] = vertexOf.emplace(key, (uint32_t)out.positions.size());
+                if (added)
+                {
+                    out.positions.push_back(positions[(size_t)v]);
+                    out.texcoords.push_back(vt < 0 ? glm::vec2(0.0f) : texcoords[(size_t)vt]);
+                }
+                face.push_back(it->second);
+            }
+            for (size_t i = 2; i < face.size(); ++i)
+                out.indices.insert(out.indices.end(), { face[0], face[i - 1], face[i] });
+        }
+    }
+    if (out.indices.empty())
+    {
+        std::cerr << "OBJ has no faces\n";
+        return false;
+    }
+    if (texcoords.empty())
+        out.texcoords.clear();
+    out.computeBounds();
+    return true;
+}
+
+inline bool loadObj(const std::string& path, Mesh& out)
+{
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in)
+    {
+        std::cerr << "Failed to open " << path << "\n";
+        return false;
+    }
+    std::vector<char> data((size_t)in.tellg());
+    in.seekg(0);
+    in.read(data.data(), (std::streamsize)data.size());
+    return parseObj(data.data(), data.size(), out);
+}
@@ -0,0 +1,413 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MID_ATTRIBUTES_SSE2 1
+#endif
+
+#include "mesh.h"
+#include "tasks.h"
+
+// Нормали и касательные для импортированных сеток.
+//   Smooth — вершины с одинаковой позицией (швы развёртки) свариваются
+//            хэшем, нормаль — сумма нормалей граней с весом угла при вершине;
+//   Flat   — у каждой грани свои вершины; совпавшие вершина и нормаль
+//            (соседние треугольники одной плоскости) снова сливаются.
+// Касательные считаются как в MikkTSpace: направление s из развёртки
+// грани, проекция на плоскость нормали вершины, вес угла, знак битангенса
+// по ориентации развёртки; вершины, где сходятся зеркальные половины
+// развёртки, раздваиваются. Без развёртки касательная — любая
+// перпендикулярная нормали.
+// Проходы по треугольникам идут по четыре (SSE2), суммы по вершинам —
+// параллельно по пулу; pool == nullptr — всё в текущем потоке.
+enum class NormalMode { Smooth, Flat };
+
+namespace mesh_attributes
+{
+constexpr size_t GRAIN = 4096;
+
+template <class F>
+void forRange(ThreadPool* pool, size_t count, F&& body)
+{
+    if (pool)
+        pool->parallelFor(count, GRAIN, body);
+    else if (count)
+        body(size_t(0), count);
+}
+
+// acos с ошибкой ~7e-5 (Абрамовиц и Стиган 4.4.45) — для весов хватает,
+// и скалярная версия совпадает с SSE2 бит в бит
+inline float acosApprox(float x)
+{
+    float a = std::min(std::fabs(x), 1.0f);
+    float r = std::sqrt(1.0f - a) * (((-0.0187293f * a + 0.0742610f) * a - 0.2121144f) * a + 1.5707288f);
+    return x < 0.0f ? 3.14159265f - r : r;
+}
+
+// Грань: единичная нормаль (ноль у вырожденной) и углы при вершинах
+inline void faceScalar(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, glm::vec3& normal, float* angles)
+{
+    glm::vec3 e01 = p1 - p0, e02 = p2 - p0, e12 = p2 - p1;
+    glm::vec3 n = glm::cross(e01, e02);
+    float len = std::sqrt(glm::dot(n, n));
+    normal = len > 0.0f ? n * (1.0f / len) : glm::vec3(0.0f);
+    float l01 = 1.0f / std::max(std::sqrt(glm::dot(e01, e01)), 1e-30f);
+    float l02 = 1.0f / std::max(std::sqrt(glm::dot(e02, e02)), 1e-30f);
+    float l12 = 1.0f / std::max(std::sqrt(glm::dot(e12, e12)), 1e-30f);
+    angles[0] = acosApprox(glm::dot(e01, e02) * (l01 * l02));
+    angles[1] = acosApprox(-glm::dot(e01, e12) * (l01 * l12));
+    angles[2] = acosApprox(glm::dot(e02, e12) * (l02 * l12));
+}
+
+// Направление s развёртки грани (единичное, с учётом ориентации) и
+// ориентация: +1, -1 или 0 у вырожденной развёртки
+inline void tangentScalar(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2,
+                          const glm::vec2& t0, const glm::vec2& t1, const glm::vec2& t2,
+                          glm::vec3& tangent, int8_t& orient)
+{
+    glm::vec3 d1 = p1 - p0, d2 = p2 - p0;
+    glm::vec2 s1 = t1 - t0, s2 = t2 - t0;
+    float area = s1.x * s2.y - s1.y * s2.x;
+    glm::vec3 s = d1 * s2.y - d2 * s1.y;
+    float len = std::sqrt(glm::dot(s, s));
+    float sign = area > 0.0f ? 1.0f : -1.0f;
+    tangent = area != 0.0f && len > 0.0f ? s * (sign / len) : glm::vec3(0.0f);
+    orient = area != 0.0f && len > 0.0f ? (int8_t)sign : (int8_t)0;
+}
+
+#ifdef MID_ATTRIBUTES_SSE2
+struct Lanes3
+{
+    __m128 x, y, z;
+};
+
+inline Lanes3 gather(const glm::vec3* v, const uint32_t* idx)
+{
+    return { _mm_setr_ps(v[idx[0]].x, v[idx[3]].x, v[idx[6]].x, v[idx[9]].x),
+             _mm_setr_ps(v[idx[0]].y, v[idx[3]].y, v[idx[6]].y, v[idx[9]].y),
+             _mm_setr_ps(v[idx[0]].z, v[idx[3]].z, v[idx[6]].z, v[idx[9]].z) };
+}
+
+inline Lanes3 sub(const Lanes3& a, const Lanes3& b)
+{
+    return { _mm_sub_ps(a.x, b.x), _mm_sub_ps(a.y, b.y), _mm_sub_ps(a.z, b.z) };
+}
+
+inline __m128 dot(const Lanes3& a, const Lanes3& b)
+{
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)), _mm_mul_ps(a.z, b.z));
+}
+
+inline __m128 acosApprox4(__m128 x)
+{
+    __m128 a = _mm_min_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), x), _mm_set1_ps(1.0f));
+    __m128 poly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-0.0187293f), a), _mm_set1_ps(0.0742610f));
+    poly = _mm_sub_ps(_mm_mul_ps(poly, a), _mm_set1_ps(0.2121144f));
+    poly = _mm_add_ps(_mm_mul_ps(poly, a), _mm_set1_ps(1.5707288f));
+    __m128 r = _mm_mul_ps(_mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), a)), poly);
+    __m128 neg = _mm_cmplt_ps(x, _mm_setzero_ps());
+    return _mm_or_ps(_mm_and_ps(neg, _mm_sub_ps(_mm_set1_ps(3.14159265f), r)), _mm_andnot_ps(neg, r));
+}
+
+inline __m128 inverseLength(__m128 squared)
+{
+    return _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(_mm_sqrt_ps(squared), _mm_set1_ps(1e-30f)));
+}
+
+// Четыре грани подряд начиная с t; то же, что faceScalar
+inline void face4(const glm::vec3* positions, const uint32_t* indices, size_t t, glm::vec3* normals, float* angles)
+{
+    const uint32_t* idx = indices + t * 3;
+    Lanes3 p0 = gather(positions, idx), p1 = gather(positions, idx + 1), p2 = gather(positions, idx + 2);
+    Lanes3 e01 = sub(p1, p0), e02 = sub(p2, p0), e12 = sub(p2, p1);
+    Lanes3 n = { _mm_sub_ps(_mm_mul_ps(e01.y, e02.z), _mm_mul_ps(e01.z, e02.y)),
+                 _mm_sub_ps(_mm_mul_ps(e01.z, e02.x), _mm_mul_ps(e01.x, e02.z)),
+                 _mm_sub_ps(_mm_mul_ps(e01.x, e02.y), _mm_mul_ps(e01.y, e02.x)) };
+    __m128 len = _mm_sqrt_ps(dot(n, n));
+    __m128 valid = _mm_cmpgt_ps(len, _mm_setzero_ps());
+    __m128 inv = _mm_and_ps(valid, _mm_div_ps(_mm_set1_ps(1.0f), _mm_or_ps(len, _mm_andnot_ps(valid, _mm_set1_ps(1.0f)))));
+    __m128 l01 = inverseLength(dot(e01, e01)), l02 = inverseLength(dot(e02, e02)), l12 = inverseLength(dot(e12, e12));
+    __m128 a0 = acosApprox4(_mm_mul_ps(dot(e01, e02), _mm_mul_ps(l01, l02)));
+    __m128 a1 = acosApprox4(_mm_mul_ps(_mm_sub_ps(_mm_setzero_ps(), dot(e01, e12)), _mm_mul_ps(l01, l12)));
+    __m128 a2 = acosApprox4(_mm_mul_ps(dot(e02, e12), _mm_mul_ps(l02, l12)));
+
+    alignas(16) float nx[4], ny[4], nz[4], c0[4], c1[4], c2[4];
+    _mm_store_ps(nx, _mm_mul_ps(n.x, inv));
+    _mm_store_ps(ny, _mm_mul_ps(n.y, inv));
+    _mm_store_ps(nz, _mm_mul_ps(n.z, inv));
+    _mm_store_ps(c0, a0);
+    _mm_store_ps(c1, a1);
+    _mm_store_ps(c2, a2);
+    for (int i = 0; i < 4; ++i)
+    {
+        normals[t + i] = glm::vec3(nx[i], ny[i], nz[i]);
+        angles[(t + i) * 3 + 0] = c0[i];
+        angles[(t + i) * 3 + 1] = c1[i];
+        angles[(t + i) * 3 + 2] = c2[i];
+    }
+}
+#endif
+
+// Нормали и углы всех граней
+inline void computeFaces(const Mesh& mesh, std::vector<glm::vec3>& normals, std::vector<float>& angles, ThreadPool* pool)
+{
+    size_t triangles = mesh.triangleCount();
+    normals.resize(triangles);
+    angles.resize(triangles * 3);
+    forRange(pool, triangles, [&](size_t begin, size_t end)
+    {
+        size_t t = begin;
+#ifdef MID_ATTRIBUTES_SSE2
+        for (; t + 4 <= end; t += 4)
+            face4(mesh.positions.data(), mesh.indices.data(), t, normals.data(), angles.data());
+#endif
+        for (; t < end; ++t)
+        {
+            const uint32_t* idx = &mesh.indices[t * 3];
+            faceScalar(mesh.positions[idx[0]], mesh.positions[idx[1]], mesh.positions[idx[2]], normals[t], &angles[t * 3]);
+        }
+    });
+}
+
+// Открытая адресация по 64-битному ключу; возвращает номер первой вершины
+// с этим ключом или добавляет next
+class WeldTable
+{
+public:
+    explicit WeldTable(size_t count)
+    {
+        size_t size = 16;
+        while (size < count * 2)
+            size *= 2;
+        keys.resize(size);
+        values.assign(size, EMPTY);
+        mask = size - 1;
+    }
+
+    uint32_t find(uint64_t key, uint32_t next)
+    {
+        uint64_t h = key * 0x9E3779B97F4A7C15ull;
+        for (size_t i = (size_t)(h >> 32) & mask;; i = (i + 1) & mask)
+        {
+            if (values[i] == EMPTY)
+            {
+                keys[i] = key;
+                values[i] = next;
+                return next;
+            }
+            if (keys[i] == key)
+                return values[i];
+        }
+    }
+
+private:
+    static constexpr uint32_t EMPTY = ~0u;
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> values;
+    size_t mask = 0;
+};
+
+inline uint32_t floatBits(float f)
+{
+    f += 0.0f;  // -0 -> +0
+    uint32_t u;
+    std::memcpy(&u, &f, 4);
+    return u;
+}
+
+// remap[v] — первая вершина с той же позицией
+inline std::vector<uint32_t> weldPositions(const std::vector<glm::vec3>& positions)
+{
+    std::vector<uint32_t> remap(positions.size());
+    WeldTable table(positions.size());
+    for (size_t v = 0; v < positions.size(); ++v)
+    {
+        const glm::vec3& p = positions[v];
+        uint64_t key = ((uint64_t)floatBits(p.x) * 0xFF51AFD7ED558CCDull) ^
+                       ((uint64_t)floatBits(p.y) << 21) ^ ((uint64_t)floatBits(p.z) * 0xC4CEB9FE1A85EC53ull);
+        uint32_t first = table.find(key, (uint32_t)v);
+        // столкновение ключей у разных позиций — вершина остаётся сама по себе
+        remap[v] = positions[first] == p ? first : (uint32_t)v;
+    }
+    return remap;
+}
+
+// Углы треугольников при каждой вершине: corners[offsets[v] .. offsets[v + 1]) —
+// номера углов 3 * t + k, по возрастанию (суммы не зависят от разбиения пула)
+struct Adjacency
+{
+    std::vector<uint32_t> offsets, corners;
+};
+
+inline Adjacency buildAdjacency(const std::vector<uint32_t>& indices, size_t vertexCount, const uint32_t* remap)
+{
+    Adjacency adj;
+    adj.offsets.assign(vertexCount + 1, 0);
+    for (uint32_t i : indices)
+        ++adj.offsets[(remap ? remap[i] : i) + 1];
+    for (size_t v = 0; v < vertexCount; ++v)
+        adj.offsets[v + 1] += adj.offsets[v];
+    adj.corners.resize(indices.size());
+    std::vector<uint32_t> fill(adj.offsets.begin(), adj.offsets.end() - 1);
+    for (size_t c = 0; c < indices.size(); ++c)
+        adj.corners[fill[remap ? remap[indices[c]] : indices[c]]++] = (uint32_t)c;
+    return adj;
+}
+
+// Перпендикуляр к единичной n (Duff и др., «Building an Orthonormal Basis, Revisited»)
+inline glm::vec3 anyTangent(const glm::vec3& n)
+{
+    float sign = std::copysign(1.0f, n.z);
+    float a = -1.0f / (sign + n.z);
+    return glm::vec3(1.0f + sign * n.x * n.x * a, sign * n.x * n.y * a, -sign * n.x);
+}
+} // namespace mesh_attributes
+
+inline void generateNormals(Mesh& mesh, NormalMode mode, ThreadPool* pool = nullptr)
+{
+    using namespace mesh_attributes;
+    std::vector<glm::vec3> faceNormals;
+    std::vector<float> angles;
+    computeFaces(mesh, faceNormals, angles, pool);
+
+    if (mode == NormalMode::Flat)
+    {
+        // вершина грани -> (исходная вершина, нормаль в 1/511), одинаковые сливаются
+        Mesh flat;
+        flat.indices.resize(mesh.indices.size());
+        WeldTable table(mesh.indices.size());
+        for (size_t c = 0; c < mesh.indices.size(); ++c)
+        {
+            uint32_t v = mesh.indices[c];
+            glm::ivec3 q = glm::ivec3(glm::round(faceNormals[c / 3] * 511.0f)) & 0x3FF;
+            uint64_t key = ((uint64_t)v << 30) | ((uint64_t)q.x << 20) | ((uint64_t)q.y << 10) | (uint64_t)q.z;
+            uint32_t next = (uint32_t)flat.positions.size();
+            uint32_t id = table.find(key, next);
+            if (id == next)
+            {
+                flat.positions.push_back(mesh.positions[v]);
+                if (!mesh.texcoords.empty())
+                    flat.texcoords.push_back(mesh.texcoords[v]);
+                glm::vec3 n = faceNormals[c / 3];
+                flat.normals.push_back(n == glm::vec3(0.0f) ? glm::vec3(0.0f, 1.0f, 0.0f) : n);
+            }
+            flat.indices[c] = id;
+        }
+        flat.boundsMin = mesh.boundsMin;
+        flat.boundsMax = mesh.boundsMax;
+        mesh = std::move(flat);
+        return;
+    }
+
+    std::vector<uint32_t> remap = weldPositions(mesh.positions);
+    Adjacency adj = buildAdjacency(mesh.indices, mesh.positions.size(), remap.data());
+    mesh.normals.resize(mesh.positions.size());
+    forRange(pool, mesh.positions.size(), [&](size_t begin, size_t end)
+    {
+        for (size_t v = begin; v < end; ++v)
+        {
+            glm::vec3 sum(0.0f);
+            for (uint32_t i = adj.offsets[v]; i < adj.offsets[v + 1]; ++i)
+            {
+                uint32_t c = adj.corners[i];
+                sum += faceNormals[c / 3] * angles[c];
+            }
+            float len = std::sqrt(glm::dot(sum, sum));
+            mesh.normals[v] = len > 0.0f ? sum / len : glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+    });
+    // сваренные вершины берут нормаль у первой
+    for (size_t v = 0; v < remap.size(); ++v)
+        mesh.normals[v] = mesh.normals[remap[v]];
+}
+
+// Нужны нормали (generateNormals); может добавить вершины на швах зеркальной развёртки
+inline void generateTangents(Mesh& mesh, ThreadPool* pool = nullptr)
+{
+    using namespace mesh_attributes;
+    if (mesh.texcoords.empty())
+    {
+        mesh.tangents.resize(mesh.positions.size());
+        forRange(pool, mesh.positions.size(), [&](size_t begin, size_t end)
+        {
+            for (size_t v = begin; v < end; ++v)
+                mesh.tangents[v] = glm::vec4(anyTangent(mesh.normals[v]), 1.0f);
+        });
+        return;
+    }
+
+    std::vector<glm::vec3> faceNormals, faceTangents(mesh.triangleCount());
+    std::vector<float> angles;
+    std::vector<int8_t> orient(mesh.triangleCount());
+    computeFaces(mesh, faceNormals, angles, pool);
+    forRange(pool, mesh.triangleCount(), [&](size_t begin, size_t end)
+    {
+        for (size_t t = begin; t < end; ++t)
+        {
+            const uint32_t* idx = &mesh.indices[t * 3];
+            tangentScalar(mesh.positions[idx[0]], mesh.positions[idx[1]], mesh.positions[idx[2]],
+                          mesh.texcoords[idx[0]], mesh.texcoords[idx[1]], mesh.texcoords[idx[2]],
+                          faceTangents[t], orient[t]);
+        }
+    });
+
+    // вершина получает ориентацию первой невырожденной грани; грани с
+    // обратной ориентацией переводятся на её копию
+    size_t original = mesh.positions.size();
+    std::vector<int8_t> vertexOrient(original, 0);
+    std::vector<uint32_t> mirror(original, ~0u);
+    for (size_t c = 0; c < mesh.indices.size(); ++c)
+    {
+        int8_t o = orient[c / 3];
+        uint32_t v = mesh.indices[c];
+        if (o == 0 || vertexOrient[v] == o)
+            continue;
+        if (vertexOrient[v] == 0)
+        {
+            vertexOrient[v] = o;
+            continue;
+        }
+        if (mirror[v] == ~0u)
+        {
+            mirror[v] = (uint32_t)mesh.positions.size();
+            glm::vec3 p = mesh.positions[v], n = mesh.normals[v];
+            glm::vec2 uv = mesh.texcoords[v];
+            mesh.positions.push_back(p);
+            mesh.normals.push_back(n);
+            mesh.texcoords.push_back(uv);
+            vertexOrient.push_back(o);
+        }
+        mesh.indices[c] = mirror[v];
+    }
+
+    Adjacency adj = buildAdjacency(mesh.indices, mesh.positions.size(), nullptr);
+    mesh.tangents.resize(mesh.positions.size());
+    forRange(pool, mesh.positions.size(), [&](size_t begin, size_t end)
+    {
+        for (size_t v = begin; v < end; ++v)
+        {
+            const glm::vec3& n = mesh.normals[v];
+            glm::vec3 sum(0.0f);
+            for (uint32_t i = adj.offsets[v]; i < adj.offsets[v + 1]; ++i)
+            {
+                uint32_t c = adj.corners[i];
+                glm::vec3 s = faceTangents[c / 3];
+                s -= n * glm::dot(n, s);
+                float len = std::sqrt(glm::dot(s, s));
+                if (len > 0.0f)
+                    sum += s * (angles[c] / len);
+            }
+            float len = std::sqrt(glm::dot(sum, sum));
+            glm::vec3 t = len > 0.0f ? sum / len : anyTangent(n);
+            mesh.tangents[v] = glm::vec4(t, vertexOrient[v] < 0 ? -1.0f : 1.0f);
+        }
+    });
+}
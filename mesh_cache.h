@@ -0,0 +1,223 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "mesh.h"
+#include "mesh_attributes.h"
+#include "mesh_codec.h"
+#include "meshlets.h"
+
+// Вершина в кэше и на GPU, 20 байт: позиция квантована в 16 бит по рамке
+// сетки, нормаль и касательная — октаэдрическая развёртка в snorm16,
+// развёртка текстуры — half
+struct PackedVertex
+{
+    uint16_t position[4];   // xyz; w — знак битангенса: 0 -> -1, 65535 -> +1
+    int16_t normal[2];
+    int16_t tangent[2];
+    uint16_t texcoord[2];
+};
+
+// Единичный вектор -> точка квадрата [-1, 1]^2
+inline glm::vec2 octEncode(const glm::vec3& n)
+{
+    glm::vec2 p = glm::vec2(n.x, n.y) / (std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z));
+    if (n.z < 0.0f)
+        p = (1.0f - glm::abs(glm::vec2(p.y, p.x))) * glm::vec2(p.x >= 0.0f ? 1.0f : -1.0f, p.y >= 0.0f ? 1.0f : -1.0f);
+    return p;
+}
+
+inline void packSnorm2(const glm::vec2& v, int16_t* out)
+{
+    for (int k = 0; k < 2; ++k)
+        out[k] = (int16_t)std::lround(glm::clamp(v[k], -1.0f, 1.0f) * 32767.0f);
+}
+
+// Нужны нормали и касательные (mesh_attributes.h); texcoords могут быть пустыми
+inline std::vector<PackedVertex> quantizeVertices(const Mesh& mesh)
+{
+    glm::vec3 extent = glm::max(mesh.boundsMax - mesh.boundsMin, glm::vec3(1e-20f));
+    std::vector<PackedVertex> out(mesh.positions.size());
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        glm::vec3 q = (mesh.positions[i] - mesh.boundsMin) / extent * 65535.0f;
+        for (int k = 0; k < 3; ++k)
+            out[i].position[k] = (uint16_t)std::lround(glm::clamp(q[k], 0.0f, 65535.0f));
+        out[i].position[3] = mesh.tangents[i].w < 0.0f ? 0 : 65535;
+        packSnorm2(octEncode(mesh.normals[i]), out[i].normal);
+        packSnorm2(octEncode(glm::vec3(mesh.tangents[i])), out[i].tangent);
+        glm::vec2 uv = mesh.texcoords.empty() ? glm::vec2(0.0f) : mesh.texcoords[i];
+        out[i].texcoord[0] = (uint16_t)glm::packHalf1x16(uv.x);
+        out[i].texcoord[1] = (uint16_t)glm::packHalf1x16(uv.y);
+    }
+    return out;
+}
+
+// Матрица из нормированных [0, 1] координат атрибута обратно в координаты сетки
+inline glm::mat4 dequantization(const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+    return glm::scale(glm::translate(glm::mat4(1.0f), boundsMin), boundsMax - boundsMin);
+}
+
+// Двоичный кэш импортированной сетки (<файл>.midm рядом с исходником):
+//   MeshCacheHeader
+//   Meshlet[meshletCount], firstIndex[meshletCount + 1]
+//   границы кластеров: восемь массивов float[meshletCount] (как в ClusteredMesh)
+//   вершины PackedVertex через encodeVertexBuffer
+//   индексы через encodeIndexBuffer
+// Локальные списки кластеров (meshletVertices/meshletTriangles) нужны только
+// при сборке и в кэш не пишутся. Кэш устаревает, если у исходника поменялся
+// размер или время изменения либо просят другие нормали.
+const uint32_t MESH_CACHE_VERSION = 2;
+
+struct MeshCacheHeader
+{
+    char magic[4];          // "MIDM"
+    uint32_t version;
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    uint32_t vertexCount;
+    uint32_t vertexStride;
+    uint32_t indexCount;
+    uint32_t meshletCount;
+    uint32_t normalMode;    // NormalMode
+    uint32_t reserved;
+    float boundsMin[3];
+    float boundsMax[3];
+    uint64_t vertexBytes;   // закодированные потоки
+    uint64_t indexBytes;
+};
+
+// Отметка исходника; false — файла нет
+inline bool sourceStamp(const std::string& path, uint64_t& size, int64_t& time)
+{
+    std::error_code ec;
+    size = (uint64_t)std::filesystem::file_size(path, ec);
+    if (ec)
+        return false;
+    time = (int64_t)std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+    return !ec;
+}
+
+inline bool writeMeshCache(const std::string& path, const std::string& sourcePath, const Mesh& mesh, NormalMode mode,
+                           const ClusteredMesh& clusters, const std::vector<PackedVertex>& vertices)
+{
+    MeshCacheHeader header = {};
+    std::memcpy(header.magic, "MIDM", 4);
+    header.version = MESH_CACHE_VERSION;
+    if (!sourceStamp(sourcePath, header.sourceSize, header.sourceTime))
+        return false;
+    header.vertexCount = (uint32_t)vertices.size();
+    header.vertexStride = sizeof(PackedVertex);
+    header.indexCount = (uint32_t)clusters.indices.size();
+    header.meshletCount = (uint32_t)clusters.size();
+    header.normalMode = (uint32_t)mode;
+    for (int k = 0; k < 3; ++k)
+    {
+        header.boundsMin[k] = mesh.boundsMin[k];
+        header.boundsMax[k] = mesh.boundsMax[k];
+    }
+    std::vector<uint8_t> vertexData = encodeVertexBuffer(vertices.data(), vertices.size(), sizeof(PackedVertex));
+    std::vector<uint8_t> indexData = encodeIndexBuffer(clusters.indices.data(), clusters.indices.size());
+    header.vertexBytes = vertexData.size();
+    header.indexBytes = indexData.size();
+
+    // Пишем во временный файл и подменяем целиком: оборванная запись не должна
+    // оставить кэш, который meshCacheFresh сочтёт свежим
+    std::string tempPath = path + ".tmp";
+    std::ofstream out(tempPath, std::ios::binary);
+    auto put = [&out](const void* data, size_t size) { out.write((const char*)data, (std::streamsize)size); };
+    put(&header, sizeof(header));
+    put(clusters.meshlets.data(), clusters.meshlets.size() * sizeof(Meshlet));
+    put(clusters.firstIndex.data(), clusters.firstIndex.size() * sizeof(uint32_t));
+    for (const std::vector<float>* a : { &clusters.centerX, &clusters.centerY, &clusters.centerZ, &clusters.radius,
+                                         &clusters.axisX, &clusters.axisY, &clusters.axisZ, &clusters.cutoff })
+        put(a->data(), a->size() * sizeof(float));
+    put(vertexData.data(), vertexData.size());
+    put(indexData.data(), indexData.size());
+    out.close();
+    std::error_code ec;
+    if (out)
+        std::filesystem::rename(tempPath, path, ec);
+    if (!out || ec)
+    {
+        std::cerr << "Failed to write mesh cache " << path << "\n";
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+// Свежий ли кэш: читается только заголовок
+inline bool meshCacheFresh(const std::string& path, const std::string& sourcePath, NormalMode mode)
+{
+    std::ifstream in(path, std::ios::binary);
+    MeshCacheHeader header = {};
+    uint64_t size;
+    int64_t time;
+    return in.read((char*)&header, sizeof(header)) && std::memcmp(header.magic, "MIDM", 4) == 0 &&
+           header.version == MESH_CACHE_VERSION && header.normalMode == (uint32_t)mode && sourceStamp(sourcePath, size, time) &&
+           header.sourceSize == size && header.sourceTime == time;
+}
+
+// Разобранный кэш: кластеры скопированы, потоки вершин и индексов остаются
+// в исходном буфере и декодируются отдельно — сразу в память GPU
+struct MeshCacheView
+{
+    MeshCacheHeader header = {};
+    ClusteredMesh clusters;
+    const uint8_t* vertexData = nullptr;
+    const uint8_t* indexData = nullptr;
+};
+
+inline bool parseMeshCache(const void* data, size_t size, MeshCacheView& out)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    const uint8_t* end = p + size;
+    if (size < sizeof(MeshCacheHeader))
+        return false;
+    std::memcpy(&out.header, p, sizeof(MeshCacheHeader));
+    p += sizeof(MeshCacheHeader);
+    const MeshCacheHeader& h = out.header;
+    if (std::memcmp(h.magic, "MIDM", 4) != 0 || h.version != MESH_CACHE_VERSION || h.vertexStride != sizeof(PackedVertex))
+        return false;
+
+    uint64_t need = (uint64_t)h.meshletCount * sizeof(Meshlet) + ((uint64_t)h.meshletCount + 1) * 4 +
+                    (uint64_t)h.meshletCount * 8 * sizeof(float) + h.vertexBytes + h.indexBytes;
+    if ((uint64_t)(end - p) < need)
+        return false;
+
+    ClusteredMesh& c = out.clusters;
+    auto take = [&p](auto& v, size_t count)
+    {
+        v.resize(count);
+        std::memcpy(v.data(), p, count * sizeof(v[0]));
+        p += count * sizeof(v[0]);
+    };
+    take(c.meshlets, h.meshletCount);
+    take(c.firstIndex, h.meshletCount + 1);
+    for (std::vector<float>* a : { &c.centerX, &c.centerY, &c.centerZ, &c.radius, &c.axisX, &c.axisY, &c.axisZ, &c.cutoff })
+        take(*a, h.meshletCount);
+    // Диапазоны кластеров идут подряд от 0 до indexCount: по ним рисуются
+    // куски индексного буфера
+    if (c.firstIndex.front() != 0 || c.firstIndex.back() != h.indexCount)
+        return false;
+    for (size_t i = 1; i < c.firstIndex.size(); ++i)
+        if (c.firstIndex[i] < c.firstIndex[i - 1])
+            return false;
+    out.vertexData = p;
+    out.indexData = p + h.vertexBytes;
+    return true;
+}
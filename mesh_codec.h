@@ -0,0 +1,396 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MID_CODEC_SSE2 1
+#endif
+
+#include "tasks.h"
+
+// Сжатие вершинных и индексных буферов (в духе vertex codec из
+// meshoptimizer). Данные режутся на независимые блоки по BLOCK элементов:
+//   вершины — по байтам: каждый байт вершины — отдельный поток, кодируется
+//             разность с тем же байтом предыдущей вершины (по модулю 256);
+//   индексы — разность с предыдущим индексом в 32 битах, затем четыре
+//             байтовых потока.
+// Разности переводятся в zigzag (малые по модулю — в малые беззнаковые),
+// поток байтов делится на группы по 16, и каждая группа пишется 0, 2, 4
+// или 8 битами на байт; режимы групп — 2-битный заголовок на поток.
+// В начале — таблица смещений блоков: блоки декодируются параллельно, и
+// каждый пишется в выход одним непрерывным куском (годится для отображённой
+// памяти GPU с комбинированием записи).
+namespace mesh_codec
+{
+constexpr uint32_t BLOCK = 256;
+constexpr uint32_t GROUP = 16;
+constexpr uint32_t GROUPS = BLOCK / GROUP;
+constexpr uint32_t HEADER_BYTES = GROUPS * 2 / 8;
+
+inline uint8_t zigzag8(uint8_t d) { return (uint8_t)((d << 1) ^ (uint8_t)((int8_t)d >> 7)); }
+inline uint8_t unzigzag8(uint8_t z) { return (uint8_t)((z >> 1) ^ (uint8_t)-(int)(z & 1)); }
+inline uint32_t zigzag32(uint32_t d) { return (d << 1) ^ (uint32_t)((int32_t)d >> 31); }
+inline uint32_t unzigzag32(uint32_t z) { return (z >> 1) ^ (0u - (z & 1)); }
+
+// Поток из BLOCK байт (хвост — нули): заголовок и группы
+inline void packStream(const uint8_t* values, std::vector<uint8_t>& out)
+{
+    size_t header = out.size();
+    out.resize(out.size() + HEADER_BYTES, 0);
+    for (uint32_t g = 0; g < GROUPS; ++g)
+    {
+        const uint8_t* v = values + g * GROUP;
+        uint8_t top = 0;
+        for (uint32_t i = 0; i < GROUP; ++i)
+            top |= v[i];
+        uint32_t mode = top == 0 ? 0 : top < 4 ? 1 : top < 16 ? 2 : 3;
+        out[header + g / 4] |= (uint8_t)(mode << ((g % 4) * 2));
+        if (mode == 1)
+            for (uint32_t i = 0; i < GROUP; i += 4)
+                out.push_back((uint8_t)(v[i] | (v[i + 1] << 2) | (v[i + 2] << 4) | (v[i + 3] << 6)));
+        else if (mode == 2)
+            for (uint32_t i = 0; i < GROUP; i += 2)
+                out.push_back((uint8_t)(v[i] | (v[i + 1] << 4)));
+        else if (mode == 3)
+            out.insert(out.end(), v, v + GROUP);
+    }
+}
+
+// Обратное к packStream; false — данные кончились раньше времени
+inline bool unpackStream(const uint8_t*& src, const uint8_t* end, uint8_t* values)
+{
+    if (end - src < (ptrdiff_t)HEADER_BYTES)
+        return false;
+    const uint8_t* header = src;
+    src += HEADER_BYTES;
+    static const uint8_t groupBytes[4] = { 0, 4, 8, 16 };
+    for (uint32_t g = 0; g < GROUPS; ++g)
+    {
+        uint32_t mode = (header[g / 4] >> ((g % 4) * 2)) & 3;
+        if (end - src < groupBytes[mode])
+            return false;
+        uint8_t* v = values + g * GROUP;
+#ifdef MID_CODEC_SSE2
+        __m128i r;
+        if (mode == 0)
+            r = _mm_setzero_si128();
+        else if (mode == 1)
+        {
+            uint32_t packed;
+            std::memcpy(&packed, src, 4);
+            __m128i x = _mm_cvtsi32_si128((int)packed);
+            __m128i m = _mm_set1_epi8(3);
+            __m128i a0 = _mm_and_si128(x, m), a1 = _mm_and_si128(_mm_srli_epi16(x, 2), m);
+            __m128i a2 = _mm_and_si128(_mm_srli_epi16(x, 4), m), a3 = _mm_and_si128(_mm_srli_epi16(x, 6), m);
+            r = _mm_unpacklo_epi16(_mm_unpacklo_epi8(a0, a1), _mm_unpacklo_epi8(a2, a3));
+        }
+        else if (mode == 2)
+        {
+            __m128i x = _mm_loadl_epi64((const __m128i*)src);
+            __m128i m = _mm_set1_epi8(15);
+            r = _mm_unpacklo_epi8(_mm_and_si128(x, m), _mm_and_si128(_mm_srli_epi16(x, 4), m));
+        }
+        else
+            r = _mm_loadu_si128((const __m128i*)src);
+        _mm_storeu_si128((__m128i*)v, r);
+#else
+        if (mode == 0)
+            std::memset(v, 0, GROUP);
+        else if (mode == 1)
+            for (uint32_t i = 0; i < GROUP; ++i)
+                v[i] = (uint8_t)((src[i / 4] >> ((i % 4) * 2)) & 3);
+        else if (mode == 2)
+            for (uint32_t i = 0; i < GROUP; ++i)
+                v[i] = (uint8_t)((src[i / 2] >> ((i % 2) * 4)) & 15);
+        else
+            std::memcpy(v, src, GROUP);
+#endif
+        src += groupBytes[mode];
+    }
+    return true;
+}
+
+// Таблица смещений: число блоков, затем конец каждого блока от начала данных
+inline void beginBlocks(std::vector<uint8_t>& out, uint32_t blocks)
+{
+    out.resize(4 + (size_t)blocks * 4);
+    std::memcpy(out.data(), &blocks, 4);
+}
+
+inline void endBlock(std::vector<uint8_t>& out, uint32_t block)
+{
+    uint32_t end = (uint32_t)out.size();
+    std::memcpy(out.data() + 4 + (size_t)block * 4, &end, 4);
+}
+
+// Границы блока b в закодированном буфере
+inline bool blockRange(const uint8_t* src, size_t size, uint32_t blocks, uint32_t b,
+                       const uint8_t*& begin, const uint8_t*& end)
+{
+    size_t tableEnd = 4 + (size_t)blocks * 4;
+    uint32_t from = (uint32_t)tableEnd, to;
+    if (b > 0)
+        std::memcpy(&from, src + 4 + (size_t)(b - 1) * 4, 4);
+    std::memcpy(&to, src + 4 + (size_t)b * 4, 4);
+    if (from < tableEnd || to < from || to > size)
+        return false;
+    begin = src + from;
+    end = src + to;
+    return true;
+}
+
+inline bool checkTable(const uint8_t* src, size_t size, uint32_t expected)
+{
+    uint32_t blocks = 0;
+    if (size < 4)
+        return false;
+    std::memcpy(&blocks, src, 4);
+    return blocks == expected && size >= 4 + (size_t)blocks * 4;
+}
+
+// Префиксная сумма 16 байт с переносом carry (последний байт прошлой группы)
+inline void prefixSum8(uint8_t* v, uint8_t& carry)
+{
+#ifdef MID_CODEC_SSE2
+    __m128i x = _mm_loadu_si128((const __m128i*)v);
+    // unzigzag: (z >> 1) ^ -(z & 1) побайтно
+    __m128i half = _mm_and_si128(_mm_srli_epi16(x, 1), _mm_set1_epi8(0x7f));
+    __m128i sign = _mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(x, _mm_set1_epi8(1)));
+    x = _mm_xor_si128(half, sign);
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 1));
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 2));
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+    x = _mm_add_epi8(x, _mm_set1_epi8((char)carry));
+    _mm_storeu_si128((__m128i*)v, x);
+    carry = v[15];
+#else
+    for (uint32_t i = 0; i < GROUP; ++i)
+    {
+        carry = (uint8_t)(carry + unzigzag8(v[i]));
+        v[i] = carry;
+    }
+#endif
+}
+
+// Четыре байтовых потока -> 16 индексов: unzigzag и префиксная сумма
+inline void combineIndices(const uint8_t* p0, const uint8_t* p1, const uint8_t* p2, const uint8_t* p3,
+                           uint32_t* dst, uint32_t& carry)
+{
+#ifdef MID_CODEC_SSE2
+    __m128i b0 = _mm_loadu_si128((const __m128i*)p0), b1 = _mm_loadu_si128((const __m128i*)p1);
+    __m128i b2 = _mm_loadu_si128((const __m128i*)p2), b3 = _mm_loadu_si128((const __m128i*)p3);
+    __m128i lo01 = _mm_unpacklo_epi8(b0, b1), hi01 = _mm_unpackhi_epi8(b0, b1);
+    __m128i lo23 = _mm_unpacklo_epi8(b2, b3), hi23 = _mm_unpackhi_epi8(b2, b3);
+    __m128i words[4] = { _mm_unpacklo_epi16(lo01, lo23), _mm_unpackhi_epi16(lo01, lo23),
+                         _mm_unpacklo_epi16(hi01, hi23), _mm_unpackhi_epi16(hi01, hi23) };
+    __m128i run = _mm_set1_epi32((int)carry);
+    for (int k = 0; k < 4; ++k)
+    {
+        __m128i z = words[k];
+        __m128i x = _mm_xor_si128(_mm_srli_epi32(z, 1), _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(z, _mm_set1_epi32(1))));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, run);
+        _mm_storeu_si128((__m128i*)(dst + k * 4), x);
+        run = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    carry = dst[15];
+#else
+    for (uint32_t i = 0; i < GROUP; ++i)
+    {
+        uint32_t z = (uint32_t)p0[i] | ((uint32_t)p1[i] << 8) | ((uint32_t)p2[i] << 16) | ((uint32_t)p3[i] << 24);
+        carry += unzigzag32(z);
+        dst[i] = carry;
+    }
+#endif
+}
+
+inline bool decodeVertexBlock(uint8_t* dst, uint32_t count, size_t stride, const uint8_t* src, const uint8_t* end)
+{
+    uint8_t planes[4][BLOCK];
+    uint8_t block[BLOCK * 64];
+    for (size_t k = 0; k < stride; k += 4)
+    {
+        // Четыре байта вершины за раз: потоки -> 32-битные слова -> в вершины
+        size_t n = std::min<size_t>(4, stride - k);
+        for (size_t j = 0; j < n; ++j)
+        {
+            if (!unpackStream(src, end, planes[j]))
+                return false;
+            uint8_t carry = 0;
+            for (uint32_t g = 0; g < GROUPS; ++g)
+                prefixSum8(planes[j] + g * GROUP, carry);
+        }
+#ifdef MID_CODEC_SSE2
+        if (n == 4)
+        {
+            for (uint32_t i = 0; i < count; i += GROUP)
+            {
+                __m128i b0 = _mm_loadu_si128((const __m128i*)(planes[0] + i)), b1 = _mm_loadu_si128((const __m128i*)(planes[1] + i));
+                __m128i b2 = _mm_loadu_si128((const __m128i*)(planes[2] + i)), b3 = _mm_loadu_si128((const __m128i*)(planes[3] + i));
+                __m128i lo01 = _mm_unpacklo_epi8(b0, b1), hi01 = _mm_unpackhi_epi8(b0, b1);
+                __m128i lo23 = _mm_unpacklo_epi8(b2, b3), hi23 = _mm_unpackhi_epi8(b2, b3);
+                alignas(16) uint32_t words[GROUP];
+                _mm_store_si128((__m128i*)words, _mm_unpacklo_epi16(lo01, lo23));
+                _mm_store_si128((__m128i*)(words + 4), _mm_unpackhi_epi16(lo01, lo23));
+                _mm_store_si128((__m128i*)(words + 8), _mm_unpacklo_epi16(hi01, hi23));
+                _mm_store_si128((__m128i*)(words + 12), _mm_unpackhi_epi16(hi01, hi23));
+                uint32_t m = std::min<uint32_t>(GROUP, count - i);
+                for (uint32_t v = 0; v < m; ++v)
+                    std::memcpy(block + (i + v) * stride + k, &words[v], 4);
+            }
+            continue;
+        }
+#endif
+        for (size_t j = 0; j < n; ++j)
+            for (uint32_t i = 0; i < count; ++i)
+                block[i * stride + k + j] = planes[j][i];
+    }
+    std::memcpy(dst, block, count * stride);
+    return true;
+}
+
+inline bool decodeIndexBlock(uint32_t* dst, uint32_t count, const uint8_t* src, const uint8_t* end, size_t vertexCount)
+{
+    uint8_t planes[4][BLOCK];
+    for (int k = 0; k < 4; ++k)
+        if (!unpackStream(src, end, planes[k]))
+            return false;
+    uint32_t block[BLOCK];
+    uint32_t carry = 0;
+    for (uint32_t g = 0; g < GROUPS; ++g)
+    {
+        uint32_t o = g * GROUP;
+        combineIndices(planes[0] + o, planes[1] + o, planes[2] + o, planes[3] + o, block + o, carry);
+    }
+    // Проверяем до копирования: dst может быть отображённым буфером GPU
+    uint32_t maxIndex = 0;
+    for (uint32_t i = 0; i < count; ++i)
+        maxIndex = std::max(maxIndex, block[i]);
+    if (count > 0 && maxIndex >= vertexCount)
+        return false;
+    std::memcpy(dst, block, count * sizeof(uint32_t));
+    return true;
+}
+
+// Блоки [0, blocks) — на пуле, если он есть
+template <class F>
+bool forBlocks(ThreadPool* pool, uint32_t blocks, F&& decode)
+{
+    if (!pool)
+    {
+        for (uint32_t b = 0; b < blocks; ++b)
+            if (!decode(b))
+                return false;
+        return true;
+    }
+    std::atomic<bool> ok{ true };
+    pool->parallelFor(blocks, 16, [&](size_t begin, size_t end)
+    {
+        for (size_t b = begin; b < end; ++b)
+            if (!decode((uint32_t)b))
+                ok = false;
+    });
+    return ok;
+}
+} // namespace mesh_codec
+
+// Вершины: count штук по stride байт (stride <= 64)
+inline std::vector<uint8_t> encodeVertexBuffer(const void* vertices, size_t count, size_t stride)
+{
+    using namespace mesh_codec;
+    const uint8_t* data = (const uint8_t*)vertices;
+    uint32_t blocks = (uint32_t)((count + BLOCK - 1) / BLOCK);
+    std::vector<uint8_t> out;
+    beginBlocks(out, blocks);
+    uint8_t plane[BLOCK];
+    for (uint32_t b = 0; b < blocks; ++b)
+    {
+        size_t first = (size_t)b * BLOCK;
+        uint32_t n = (uint32_t)std::min<size_t>(BLOCK, count - first);
+        for (size_t k = 0; k < stride; ++k)
+        {
+            uint8_t prev = 0;
+            std::memset(plane, 0, BLOCK);
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                uint8_t v = data[(first + i) * stride + k];
+                plane[i] = zigzag8((uint8_t)(v - prev));
+                prev = v;
+            }
+            packStream(plane, out);
+        }
+        endBlock(out, b);
+    }
+    return out;
+}
+
+// false — буфер повреждён или не от этих count/stride
+inline bool decodeVertexBuffer(void* dst, size_t count, size_t stride, const uint8_t* src, size_t size,
+                               ThreadPool* pool = nullptr)
+{
+    using namespace mesh_codec;
+    uint32_t blocks = (uint32_t)((count + BLOCK - 1) / BLOCK);
+    if (stride == 0 || stride > 64 || !checkTable(src, size, blocks))
+        return false;
+    return forBlocks(pool, blocks, [&](uint32_t b)
+    {
+        const uint8_t *begin, *end;
+        size_t first = (size_t)b * BLOCK;
+        return blockRange(src, size, blocks, b, begin, end) &&
+               decodeVertexBlock((uint8_t*)dst + first * stride, (uint32_t)std::min<size_t>(BLOCK, count - first),
+                                 stride, begin, end);
+    });
+}
+
+inline std::vector<uint8_t> encodeIndexBuffer(const uint32_t* indices, size_t count)
+{
+    using namespace mesh_codec;
+    uint32_t blocks = (uint32_t)((count + BLOCK - 1) / BLOCK);
+    std::vector<uint8_t> out;
+    beginBlocks(out, blocks);
+    uint8_t planes[4][BLOCK];
+    for (uint32_t b = 0; b < blocks; ++b)
+    {
+        size_t first = (size_t)b * BLOCK;
+        uint32_t n = (uint32_t)std::min<size_t>(BLOCK, count - first);
+        std::memset(planes, 0, sizeof(planes));
+        uint32_t prev = 0;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            uint32_t z = zigzag32(indices[first + i] - prev);
+            prev = indices[first + i];
+            for (int k = 0; k < 4; ++k)
+                planes[k][i] = (uint8_t)(z >> (k * 8));
+        }
+        for (int k = 0; k < 4; ++k)
+            packStream(planes[k], out);
+        endBlock(out, b);
+    }
+    return out;
+}
+
+// false — буфер повреждён или в нём есть индекс >= vertexCount
+inline bool decodeIndexBuffer(uint32_t* dst, size_t count, const uint8_t* src, size_t size, ThreadPool* pool = nullptr,
+                              size_t vertexCount = SIZE_MAX)
+{
+    using namespace mesh_codec;
+    uint32_t blocks = (uint32_t)((count + BLOCK - 1) / BLOCK);
+    if (!checkTable(src, size, blocks))
+        return false;
+    return forBlocks(pool, blocks, [&](uint32_t b)
+    {
+        const uint8_t *begin, *end;
+        size_t first = (size_t)b * BLOCK;
+        return blockRange(src, size, blocks, b, begin, end) &&
+               decodeIndexBlock(dst + first, (uint32_t)std::min<size_t>(BLOCK, count - first), begin, end,
+                                vertexCount);
+    });
+}
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MID_CLUSTER_SSE2 1
+#endif
+
+#include "mesh.h"
+
+// Кластер сетки: до MAX_VERTICES своих вершин и MAX_TRIANGLES треугольников
+// с локальными 8-битными индексами
+struct Meshlet
+{
+    uint32_t vertexOffset;      // в ClusteredMesh::meshletVertices
+    uint32_t triangleOffset;    // в ClusteredMesh::meshletTriangles, по 3 байта
+    uint32_t vertexCount;
+    uint32_t triangleCount;
+};
+
+// Сетка, разбитая на кластеры при импорте. Границы кластеров лежат по
+// массивам (SoA) — так их проверяет cullClusters по четыре за раз.
+// indices — те же треугольники глобальными индексами, кластер за кластером:
+// видимые подряд кластеры рисуются одним диапазоном.
+struct ClusteredMesh
+{
+    static constexpr uint32_t MAX_VERTICES = 64;
+    static constexpr uint32_t MAX_TRIANGLES = 124;
+
+    std::vector<Meshlet> meshlets;
+    std::vector<uint32_t> meshletVertices;
+    std::vector<uint8_t> meshletTriangles;
+
+    // Сфера: центр и радиус. Конус нормалей: ось и cutoff = sin угла
+    // раствора; кластер повёрнут от камеры, если
+    // dot(center - eye, axis) >= cutoff * |center - eye| + radius.
+    // У кластеров с разворотом нормалей больше ~85° cutoff = 1: не отсекаются.
+    std::vector<float> centerX, centerY, centerZ, radius;
+    std::vector<float> axisX, axisY, axisZ, cutoff;
+
+    std::vector<uint32_t> indices;
+    std::vector<uint32_t> firstIndex;   // по кластерам, плюс конец
+
+    size_t size() const { return meshlets.size(); }
+};
+
+// Жадная сборка (в духе meshoptimizer): к кластеру добавляется соседний
+// треугольник, приносящий меньше всего новых вершин; при равенстве —
+// ближе по нормали к кластеру, чтобы конусы были узкими. Когда соседей нет
+// или кластер полон, начинается новый с первого свободного треугольника.
+inline ClusteredMesh buildMeshlets(const Mesh& mesh, float coneWeight = 0.5f)
+{
+    const uint32_t vertexCount = (uint32_t)mesh.positions.size();
+    const uint32_t triangleCount = (uint32_t)mesh.triangleCount();
+    const std::vector<uint32_t>& idx = mesh.indices;
+
+    // Треугольники при каждой вершине (CSR) и их нормали
+    std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0), adjacency(idx.size());
+    for (uint32_t v : idx)
+        ++adjacencyOffset[v + 1];
+    for (uint32_t v = 0; v < vertexCount; ++v)
+        adjacencyOffset[v + 1] += adjacencyOffset[v];
+    {
+        std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+        for (uint32_t t = 0; t < triangleCount; ++t)
+            for (int k = 0; k < 3; ++k)
+                adjacency[fill[idx[t * 3 + k]]++] = t;
+    }
+    std::vector<glm::vec3> normals(triangleCount);
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        glm::vec3 a = mesh.positions[idx[t * 3]], b = mesh.positions[idx[t * 3 + 1]], c = mesh.positions[idx[t * 3 + 2]];
+        glm::vec3 n = glm::cross(b - a, c - a);
+        float len = glm::length(n);
+        normals[t] = len > 0.0f ? n / len : glm::vec3(0.0f);
+    }
+
+    ClusteredMesh out;
+    std::vector<uint8_t> used(triangleCount, 0);
+    std::vector<uint8_t> local(vertexCount, 0xff);   // номер вершины в текущем кластере
+    std::vector<uint32_t> verts, tris;
+    glm::vec3 normalSum(0.0f);
+    uint32_t cursor = 0;
+
+    auto flush = [&]
+    {
+        if (tris.empty())
+            return;
+        Meshlet m;
+        m.vertexOffset = (uint32_t)out.meshletVertices.size();
+        m.triangleOffset = (uint32_t)out.meshletTriangles.size();
+        m.vertexCount = (uint32_t)verts.size();
+        m.triangleCount = (uint32_t)tris.size();
+        out.meshletVertices.insert(out.meshletVertices.end(), verts.begin(), verts.end());
+        out.firstIndex.push_back((uint32_t)out.indices.size());
+        for (uint32_t t : tris)
+            for (int k = 0; k < 3; ++k)
+            {
+                out.meshletTriangles.push_back(local[idx[t * 3 + k]]);
+                out.indices.push_back(idx[t * 3 + k]);
+            }
+
+        // Сфера по рамке вершин, конус по нормалям треугольников
+        glm::vec3 lo = mesh.positions[verts[0]], hi = lo;
+        for (uint32_t v : verts)
+        {
+            lo = glm::min(lo, mesh.positions[v]);
+            hi = glm::max(hi, mesh.positions[v]);
+        }
+        glm::vec3 center = (lo + hi) * 0.5f;
+        float r = 0.0f;
+        for (uint32_t v : verts)
+            r = std::max(r, glm::length(mesh.positions[v] - center));
+
+        float len = glm::length(normalSum);
+        glm::vec3 axis = len > 0.0f ? normalSum / len : glm::vec3(0.0f, 0.0f, 1.0f);
+        float minDot = len > 0.0f ? 1.0f : -1.0f;
+        for (uint32_t t : tris)
+            if (normals[t] != glm::vec3(0.0f))
+                minDot = std::min(minDot, glm::dot(axis, normals[t]));
+        float coneCutoff = minDot <= 0.1f ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+
+        out.centerX.push_back(center.x);
+        out.centerY.push_back(center.y);
+        out.centerZ.push_back(center.z);
+        out.radius.push_back(r);
+        out.axisX.push_back(axis.x);
+        out.axisY.push_back(axis.y);
+        out.axisZ.push_back(axis.z);
+        out.cutoff.push_back(coneCutoff);
+        out.meshlets.push_back(m);
+
+        for (uint32_t v : verts)
+            local[v] = 0xff;
+        verts.clear();
+        tris.clear();
+        normalSum = glm::vec3(0.0f);
+    };
+
+    auto add = [&](uint32_t t)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            uint32_t v = idx[t * 3 + k];
+            if (local[v] == 0xff)
+            {
+                local[v] = (uint8_t)verts.size();
+                verts.push_back(v);
+            }
+        }
+        tris.push_back(t);
+        used[t] = 1;
+        normalSum += normals[t];
+    };
+
+    auto newVertices = [&](uint32_t t)
+    {
+        return (uint32_t)(local[idx[t * 3]] == 0xff) + (uint32_t)(local[idx[t * 3 + 1]] == 0xff) +
+               (uint32_t)(local[idx[t * 3 + 2]] == 0xff);
+    };
+
+    for (uint32_t placed = 0; placed < triangleCount; ++placed)
+    {
+        uint32_t best = UINT32_MAX;
+        float bestScore = 1e30f;
+        if (!tris.empty())
+        {
+            glm::vec3 axis = glm::length(normalSum) > 0.0f ? glm::normalize(normalSum) : glm::vec3(0.0f);
+            for (uint32_t v : verts)
+                for (uint32_t a = adjacencyOffset[v]; a < adjacencyOffset[v + 1]; ++a)
+                {
+                    uint32_t t = adjacency[a];
+                    if (used[t])
+                        continue;
+                    float score = (float)newVertices(t) + coneWeight * (1.0f - glm::dot(axis, normals[t]));
+                    if (score < bestScore)
+                    {
+                        bestScore = score;
+                        best = t;
+                    }
+                }
+        }
+        if (best == UINT32_MAX)
+        {
+            while (used[cursor])
+                ++cursor;
+            best = cursor;
+        }
+        // Полный кластер: следующий начинается с этого же соседа
+        if (verts.size() + newVertices(best) > ClusteredMesh::MAX_VERTICES || tris.size() + 1 > ClusteredMesh::MAX_TRIANGLES)
+            flush();
+        add(best);
+    }
+    flush();
+    out.firstIndex.push_back((uint32_t)out.indices.size());
+    return out;
+}
+
+// Диапазоны индексов видимых кластеров для glMultiDrawElements: соседние
+// видимые кластеры сливаются в один диапазон
+struct ClusterDrawList
+{
+    std::vector<int> counts;
+    std::vector<const void*> offsets;
+    size_t clusters = 0;
+    size_t triangles = 0;
+
+    void clear()
+    {
+        counts.clear();
+        offsets.clear();
+        clusters = triangles = 0;
+    }
+};
+
+// Отсечение кластеров пирамидой видимости и конусами нормалей. Всё в
+// пространстве сетки: плоскости — из viewProj * model, камера — через
+// обратную model (масштаб модели должен быть равномерным).
+inline void cullClusters(const ClusteredMesh& mesh, const glm::mat4& viewProj, const glm::mat4& model,
+                         const glm::vec3& eye, ClusterDrawList& out)
+{
+    out.clear();
+    glm::mat4 m = viewProj * model;
+    glm::vec4 rows[4] = { glm::vec4(m[0][0], m[1][0], m[2][0], m[3][0]), glm::vec4(m[0][1], m[1][1], m[2][1], m[3][1]),
+                          glm::vec4(m[0][2], m[1][2], m[2][2], m[3][2]), glm::vec4(m[0][3], m[1][3], m[2][3], m[3][3]) };
+    glm::vec4 planes[6] = { rows[3] + rows[0], rows[3] - rows[0], rows[3] + rows[1],
+                            rows[3] - rows[1], rows[3] + rows[2], rows[3] - rows[2] };
+    for (glm::vec4& p : planes)
+        p /= glm::length(glm::vec3(p));
+    glm::vec3 camera = glm::vec3(glm::inverse(model) * glm::vec4(eye, 1.0f));
+
+    const size_t n = mesh.size();
+    int runStart = -1;
+    auto emit = [&](size_t i, bool visible)
+    {
+        if (visible)
+        {
+            ++out.clusters;
+            out.triangles += mesh.meshlets[i].triangleCount;
+            if (runStart < 0)
+                runStart = (int)i;
+        }
+        else if (runStart >= 0)
+        {
+            out.counts.push_back((int)(mesh.firstIndex[i] - mesh.firstIndex[runStart]));
+            out.offsets.push_back((const void*)(uintptr_t)(mesh.firstIndex[runStart] * sizeof(uint32_t)));
+            runStart = -1;
+        }
+    };
+
+    size_t i = 0;
+#ifdef MID_CLUSTER_SSE2
+    __m128 px[6], py[6], pz[6], pw[6];
+    for (int k = 0; k < 6; ++k)
+    {
+        px[k] = _mm_set1_ps(planes[k].x);
+        py[k] = _mm_set1_ps(planes[k].y);
+        pz[k] = _mm_set1_ps(planes[k].z);
+        pw[k] = _mm_set1_ps(planes[k].w);
+    }
+    __m128 ex = _mm_set1_ps(camera.x), ey = _mm_set1_ps(camera.y), ez = _mm_set1_ps(camera.z);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 cx = _mm_loadu_ps(&mesh.centerX[i]), cy = _mm_loadu_ps(&mesh.centerY[i]);
+        __m128 cz = _mm_loadu_ps(&mesh.centerZ[i]), r = _mm_loadu_ps(&mesh.radius[i]);
+        __m128 negR = _mm_sub_ps(_mm_setzero_ps(), r);
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int k = 0; k < 6; ++k)
+        {
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px[k], cx), _mm_mul_ps(py[k], cy)),
+                                  _mm_add_ps(_mm_mul_ps(pz[k], cz), pw[k]));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, negR));
+        }
+        __m128 dx = _mm_sub_ps(cx, ex), dy = _mm_sub_ps(cy, ey), dz = _mm_sub_ps(cz, ez);
+        __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+        __m128 along = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, _mm_loadu_ps(&mesh.axisX[i])), _mm_mul_ps(dy, _mm_loadu_ps(&mesh.axisY[i]))),
+                                  _mm_mul_ps(dz, _mm_loadu_ps(&mesh.axisZ[i])));
+        __m128 backface = _mm_cmpge_ps(along, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&mesh.cutoff[i]), dist), r));
+        int mask = _mm_movemask_ps(_mm_andnot_ps(backface, inside));
+        for (int k = 0; k < 4; ++k)
+            emit(i + k, (mask >> k) & 1);
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        glm::vec3 c(mesh.centerX[i], mesh.centerY[i], mesh.centerZ[i]);
+        float r = mesh.radius[i];
+        bool visible = true;
+        for (const glm::vec4& p : planes)
+            visible = visible && glm::dot(glm::vec3(p), c) + p.w >= -r;
+        glm::vec3 d = c - camera;
+        float along = glm::dot(d, glm::vec3(mesh.axisX[i], mesh.axisY[i], mesh.axisZ[i]));
+        visible = visible && along < mesh.cutoff[i] * glm::length(d) + r;
+        emit(i, visible);
+    }
+    emit(n, false);
+}
@@ -8,7 +8,30 @@
 #include <vector>
 #include <iostream>
 #include <cstdlib>
-#include <ctime>
+#include <random>
+#include <cstring>
+#include <memory>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+
+#include "tasks.h"
+#include "upload_worker.h"
+#include "world_stream.h"
+#include "textures.h"
+#include "block_compress.h"
+#include "materials.h"
+#include "render_backend.h"
+#include "soft_raster.h"
+#include "vulkan_backend.h"
+#include "lightmap_baker.h"
+#include "post_process.h"
+#include "sky.h"
+#include "meshlets.h"
+#include "mesh_cache.h"
+#include "physics.h"
+#include "village.h"
+
 const char* cubeVS = R"(#version 330 core
 layout(location=0) in vec3 aPos;
 uniform mat4 uMVP;
@@ -26,9 +49,144 @@ void main()
     FragColor = vec4(uColor, 1.0);
 }
 )";
+// Инстанс читается из текстурного буфера ячейки по индексу из списка видимых
+const char* cubeInstVS = R"(#version 330 core
+layout(location=0) in vec3 aPos;
+layout(location=1) in uint aInstance;
+uniform usamplerBuffer uInstances;
+uniform mat4 uViewProj;
+out vec3 vColor;
+out vec3 vLocal;
+flat out uint vMaterial;
+vec4 column(int i) { return uintBitsToFloat(texelFetch(uInstances, i)); }
+void main()
+{
+    int base = int(aInstance) * 5;
+    mat4 model = mat4(column(base), column(base + 1), column(base + 2), column(base + 3));
+    gl_Position = uViewProj * model * vec4(aPos, 1.0);
+    uvec2 word = texelFetch(uInstances, base + 4).xy;
+    vColor = vec3(word.x & 1023u, (word.x >> 10) & 1023u, (word.x >> 20) & 1023u) / 1023.0;
+    vLocal = aPos;
+    vMaterial = word.y;
+}
+)";
+
+// #version и materialColor() дописываются в compilePrograms
+const char* cubeInstFS = R"(
+in vec3 vColor;
+in vec3 vLocal;
+flat in uint vMaterial;
+out vec4 FragColor;
+void main()
+{
+    // Грань — по производным позиции, UV — две оставшиеся координаты
+    vec3 n = abs(cross(dFdx(vLocal), dFdy(vLocal)));
+    vec2 uv = n.x > n.y && n.x > n.z ? vLocal.zy : (n.y > n.z ? vLocal.xz : vLocal.xy);
+    FragColor = vec4(vColor, 1.0) * materialColor(vMaterial, uv + 0.5);
+}
+)";
+const char* groundVS = R"(#version 330 core
+layout(location=0) in vec3 aPos;
+uniform mat4 uMVP;
+uniform mat4 uModel;
+out vec2 vUV;
+void main()
+{
+    vec4 world = uModel * vec4(aPos, 1.0);
+    vUV = world.xz * 0.25;
+    gl_Position = uMVP * vec4(aPos, 1.0);
+}
+)";
+
+const char* groundFS = R"(#version 330 core
+in vec2 vUV;
+out vec4 FragColor;
+uniform sampler2DArray uTex;
+uniform float uLayer;
+void main()
+{
+    FragColor = vec4(texture(uTex, vec3(vUV, uLayer)).rgb, 1.0);
+}
+)";
+// Запечённый свет: грань куба берёт свой прямоугольник атласа по номеру
+const char* litVS = R"(#version 330 core
+layout(location=0) in vec3 aPos;
+layout(location=1) in vec3 aFace; // s, t и номер грани
+uniform mat4 uMVP;
+uniform mat4 uModel;
+uniform vec4 uFaceRects[6];
+out vec2 vLightUV;
+out vec2 vUV;
+void main()
+{
+    vec4 rect = uFaceRects[int(aFace.z)];
+    vLightUV = rect.xy + aFace.xy * rect.zw;
+    vUV = (uModel * vec4(aPos, 1.0)).xz * 0.25;
+    gl_Position = uMVP * vec4(aPos, 1.0);
+}
+)";
+
+const char* litCubeFS = R"(#version 330 core
+in vec2 vLightUV;
+out vec4 FragColor;
+uniform vec3 uColor;
+uniform sampler2D uLightmap;
+void main()
+{
+    FragColor = vec4(uColor * texture(uLightmap, vLightUV).rgb, 1.0);
+}
+)";
+
+const char* litGroundFS = R"(#version 330 core
+in vec2 vLightUV;
+in vec2 vUV;
+out vec4 FragColor;
+uniform sampler2DArray uTex;
+uniform float uLayer;
+uniform sampler2D uLightmap;
+void main()
+{
+    FragColor = vec4(texture(uTex, vec3(vUV, uLayer)).rgb * texture(uLightmap, vLightUV).rgb, 1.0);
+}
+)";
+
+// Импортированная сетка: позиции квантованы (uModel с деквантованием),
+// нормаль — октаэдрическая развёртка (PackedVertex)
+const char* meshVS = R"(#version 330 core
+layout(location=0) in vec4 aPos;
+layout(location=1) in vec2 aNormal;
+uniform mat4 uMVP;
+uniform mat3 uNormalMatrix;
+out vec3 vNormal;
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+void main()
+{
+    vNormal = uNormalMatrix * octDecode(aNormal);
+    gl_Position = uMVP * vec4(aPos.xyz, 1.0);
+}
+)";
+
+const char* meshFS = R"(#version 330 core
+in vec3 vNormal;
+out vec4 FragColor;
+uniform vec3 uColor;
+void main()
+{
+    vec3 n = normalize(vNormal);
+    float sun = max(dot(n, normalize(vec3(0.5, 1.0, 0.3))), 0.0);
+    FragColor = vec4(uColor * (0.35 + 0.15 * n.y + 0.65 * sun), 1.0);
+}
+)";
 const char* particleVS = R"(#version 330 core
 layout(location = 0) in vec3 aPos;
 uniform float uTime;
+uniform vec3 uBase;
 
 out vec3 vWorldPos;
 out float vAlpha;
@@ -44,7 +202,7 @@ void main()
     float factor = age / lifetime;
 
     // Базовая точка выхода дыма (из трубы)
-    vec3 base = vec3(0.6, 1.4, 0.0);
+    vec3 base = uBase;
 
     // Небольшое горизонтальное колебание (эффект ветра)
     float windX = sin(uTime * 0.7 + seed) * 0.05 * factor;
@@ -136,6 +294,11 @@ GLuint compileShader(GLenum type, const char* src)
     GLuint sh = glCreateShader(type);
     glShaderSource(sh, 1, &src, nullptr);
     glCompileShader(sh);
+    return sh;
+}
+
+bool checkShader(GLuint sh)
+{
     GLint ok;
     glGetShaderiv(sh, GL_COMPILE_STATUS, &ok);
     if (!ok)
@@ -144,11 +307,33 @@ GLuint compileShader(GLenum type, const char* src)
         glGetShaderInfoLog(sh, 1024, nullptr, log);
         std::cerr << "Shader compile error:\n" << log << "\n";
     }
-    return sh;
+    return ok != 0;
 }
 
-GLuint makeProgram(const char* vsSrc, const char* fsSrc, const char* gsSrc = nullptr)
+bool hasExtension(const char* name)
 {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i)
+    {
+        const char* ext = (const char*)glGetStringi(GL_EXTENSIONS, i);
+        if (ext && std::strcmp(ext, name) == 0)
+            return true;
+    }
+    return false;
+}
+
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+// Компиляция без блокировки кадра: шейдеры отправляются драйверу сразу,
+// а статус проверяется, когда драйвер закончит (KHR_parallel_shader_compile)
+// или хотя бы на следующем кадре.
+Task<GLuint> makeProgramAsync(RenderQueue& renderQueue, const char* vsSrc, const char* fsSrc, const char* gsSrc = nullptr)
+{
+    co_await renderQueue.schedule();
+
     GLuint vs = compileShader(GL_VERTEX_SHADER, vsSrc);
     GLuint fs = compileShader(GL_FRAGMENT_SHADER, fsSrc);
     GLuint gs = 0;
@@ -162,6 +347,25 @@ GLuint makeProgram(const char* vsSrc, const char* fsSrc, const char* gsSrc = nul
 
     glLinkProgram(prog);
 
+    static const bool parallelCompile = hasExtension("GL_KHR_parallel_shader_compile");
+    if (parallelCompile)
+    {
+        co_await renderQueue.until([prog]
+        {
+            GLint done = 0;
+            glGetProgramiv(prog, GL_COMPLETION_STATUS_KHR, &done);
+            return done != 0;
+        });
+    }
+    else
+    {
+        co_await renderQueue.nextFrame();
+    }
+
+    checkShader(vs);
+    checkShader(fs);
+    if (gsSrc) checkShader(gs);
+
     GLint ok;
     glGetProgramiv(prog, GL_LINK_STATUS, &ok);
     if (!ok)
@@ -175,7 +379,7 @@ GLuint makeProgram(const char* vsSrc, const char* fsSrc, const char* gsSrc = nul
     glDeleteShader(fs);
     if (gsSrc) glDeleteShader(gs);
 
-    return prog;
+    co_return prog;
 }
 
 float cubeVerts[] = {
@@ -199,190 +403,1100 @@ unsigned int cubeIdx[] = {
 };
 
 
-int main()
-{
-    
-    std::srand((unsigned)std::time(nullptr));
+const int NUM_PARTICLES = 700;
 
-    if (!glfwInit())
-    {
-        std::cerr << "Failed to init GLFW\n";
-        return -1;
-    }
+constexpr GLuint LIGHTMAP_UNIT = 1;
 
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+struct SceneGL
+{
+    GLuint cubeProg = 0, smokeProg = 0, cubeInstProg = 0, groundProg = 0;
+    GLuint litCubeProg = 0, litGroundProg = 0;
+    PostPrograms post;
+    SkyPrograms sky;
+    GLuint cubeVAO = 0, cubeVBO = 0, cubeEBO = 0;
+    GLuint litCubeVAO = 0, litCubeVBO = 0, litCubeEBO = 0;
+    GLuint smokeVAO = 0, smokeVBO = 0;
+    bool ready = false; // трогается только рендер-потоком
+
+    // Запечённый свет домика: пока lightmap == 0, кубы плоские
+    GLuint lightmap = 0;
+    std::vector<glm::mat4> litModels;  // коробки в порядке вызовов drawHouse
+    std::vector<glm::vec4> litRects;   // по 6 прямоугольников граней на коробку
+
+    // Сетка из --mesh: пока meshVAO == 0, не рисуется
+    GLuint meshProg = 0, meshVAO = 0, meshVBO = 0, meshEBO = 0;
+    ClusteredMesh mesh;
+    glm::mat4 meshModel = glm::mat4(1.0f);        // координаты сетки -> мир
+    glm::mat4 meshDequantize = glm::mat4(1.0f);   // атрибут [0, 1] -> координаты сетки
+};
 
-    GLFWwindow* win = glfwCreateWindow(800, 600, "Steam from Chimney - Geometry Shader", nullptr, nullptr);
-    if (!win)
+// Куб из 24 вершин: позиция и (s, t, грань) в порядке CUBE_FACES
+void makeLitCube(std::vector<float>& verts, std::vector<uint32_t>& idx)
+{
+    const glm::vec2 corners[4] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+    for (int f = 0; f < 6; ++f)
     {
-        std::cerr << "Failed to create window\n";
-        glfwTerminate();
-        return -1;
+        for (const glm::vec2& st : corners)
+        {
+            glm::vec3 p = CUBE_FACES[f].origin + CUBE_FACES[f].u * st.x + CUBE_FACES[f].v * st.y;
+            verts.insert(verts.end(), { p.x, p.y, p.z, st.x, st.y, (float)f });
+        }
+        uint32_t base = (uint32_t)f * 4;
+        idx.insert(idx.end(), { base, base + 1, base + 2, base + 2, base + 3, base });
     }
+}
 
-    glfwMakeContextCurrent(win);
-
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+std::vector<glm::vec3> makeParticles(unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pick(0, 99);
+    std::vector<glm::vec3> particles(NUM_PARTICLES);
+    for (int i = 0; i < NUM_PARTICLES; ++i)
     {
-        std::cerr << "Failed to init GLAD\n";
-        return -1;
+        float rx = (pick(rng) / 100.0f - 0.5f) * 0.18f;
+        float rz = (pick(rng) / 100.0f - 0.5f) * 0.18f;
+        particles[i] = glm::vec3(rx, 0.0f, rz);
     }
+    return particles;
+}
 
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    GLuint cubeProg  = makeProgram(cubeVS, cubeFS);
-    GLuint smokeProg = makeProgram(particleVS, particleFS, particleGS);
+Task<void> generateParticles(ThreadPool& pool, std::vector<glm::vec3>& particles, unsigned seed)
+{
+    co_await pool.schedule();
+    particles = makeParticles(seed);
+}
 
-    GLuint cubeVAO, cubeVBO, cubeEBO;
-    glGenVertexArrays(1, &cubeVAO);
-    glGenBuffers(1, &cubeVBO);
-    glGenBuffers(1, &cubeEBO);
+Task<void> makeProgramInto(RenderQueue& renderQueue, GLuint& out, const char* vsSrc, const char* fsSrc,
+                           const char* gsSrc = nullptr)
+{
+    out = co_await makeProgramAsync(renderQueue, vsSrc, fsSrc, gsSrc);
+}
 
-    glBindVertexArray(cubeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(cubeVerts), cubeVerts, GL_STATIC_DRAW);
+// Все программы отправляются в драйвер в одном кадре и собираются параллельно;
+// ожидание по одной сводило бы параллельную компиляцию на нет
+Task<void> compilePrograms(RenderQueue& renderQueue, SceneGL& scene)
+{
+    std::string instFS = "#version 330 core\n" + materialShaderSource(bindlessTextures().available()) + cubeInstFS;
+    co_await whenAll(makeProgramInto(renderQueue, scene.cubeProg, cubeVS, cubeFS),
+                     makeProgramInto(renderQueue, scene.smokeProg, particleVS, particleFS, particleGS),
+                     makeProgramInto(renderQueue, scene.cubeInstProg, cubeInstVS, instFS.c_str()),
+                     makeProgramInto(renderQueue, scene.groundProg, groundVS, groundFS),
+                     makeProgramInto(renderQueue, scene.litCubeProg, litVS, litCubeFS),
+                     makeProgramInto(renderQueue, scene.litGroundProg, litVS, litGroundFS),
+                     makeProgramInto(renderQueue, scene.post.downsample, POST_VS, BLOOM_DOWNSAMPLE_FS),
+                     makeProgramInto(renderQueue, scene.post.upsample, POST_VS, BLOOM_UPSAMPLE_FS),
+                     makeProgramInto(renderQueue, scene.post.final, POST_VS, POST_FINAL_FS),
+                     makeProgramInto(renderQueue, scene.meshProg, meshVS, meshFS),
+                     makeProgramInto(renderQueue, scene.sky.sky, POST_VS, SKY_FS),
+                     makeProgramInto(renderQueue, scene.sky.aerial, POST_VS, AERIAL_FS));
+}
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, cubeEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(cubeIdx), cubeIdx, GL_STATIC_DRAW);
+// Загрузка сцены: частицы считаются на пуле, пока драйвер компилирует шейдеры;
+// буферы заливаются потоком загрузки, на рендер-потоке остаются только VAO.
+Task<void> loadScene(ThreadPool& pool, RenderQueue& renderQueue, UploadWorker& uploader, SceneGL& scene, unsigned seed)
+{
+    std::vector<glm::vec3> particles;
+    co_await whenAll(generateParticles(pool, particles, seed),
+                     compilePrograms(renderQueue, scene));
+
+    scene.cubeVBO  = co_await uploader.uploadBuffer(cubeVerts, sizeof(cubeVerts));
+    scene.cubeEBO  = co_await uploader.uploadBuffer(cubeIdx, sizeof(cubeIdx));
+    scene.smokeVBO = co_await uploader.uploadBuffer(particles.data(), particles.size() * sizeof(glm::vec3));
+    std::vector<float> litVerts;
+    std::vector<uint32_t> litIdx;
+    makeLitCube(litVerts, litIdx);
+    scene.litCubeVBO = co_await uploader.uploadBuffer(litVerts.data(), litVerts.size() * sizeof(float));
+    scene.litCubeEBO = co_await uploader.uploadBuffer(litIdx.data(), litIdx.size() * sizeof(uint32_t));
+
+    // VAO между контекстами не разделяются — собираем здесь
+    co_await renderQueue.schedule();
+
+    glGenVertexArrays(1, &scene.cubeVAO);
+    glBindVertexArray(scene.cubeVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, scene.cubeVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, scene.cubeEBO);
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
     glBindVertexArray(0);
 
-    const int NUM_PARTICLES = 700;
-    std::vector<glm::vec3> particles(NUM_PARTICLES);
-    for (int i = 0; i < NUM_PARTICLES; ++i)
-    {
-        float rx = ((std::rand() % 100) / 100.0f - 0.5f) * 0.18f;
-        float rz = ((std::rand() % 100) / 100.0f - 0.5f) * 0.18f;
-        particles[i] = glm::vec3(rx, 0.0f, rz);
-    }
-
-    GLuint smokeVAO, smokeVBO;
-    glGenVertexArrays(1, &smokeVAO);
-    glGenBuffers(1, &smokeVBO);
+    glGenVertexArrays(1, &scene.litCubeVAO);
+    glBindVertexArray(scene.litCubeVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, scene.litCubeVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, scene.litCubeEBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
 
-    glBindVertexArray(smokeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, smokeVBO);
-    glBufferData(GL_ARRAY_BUFFER, particles.size() * sizeof(glm::vec3), particles.data(), GL_STATIC_DRAW);
+    glGenVertexArrays(1, &scene.smokeVAO);
+    glBindVertexArray(scene.smokeVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, scene.smokeVBO);
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
     glEnableVertexAttribArray(0);
     glBindVertexArray(0);
 
-    float startTime = (float)glfwGetTime();
-    while (!glfwWindowShouldClose(win))
+    scene.ready = true;
+}
+
+
+// Гладкий шум по решётке с хешем; решётка свёрнута с периодом period — тайлится
+float valueNoise(float x, float y, int32_t period, uint32_t seed)
+{
+    auto hash = [seed, period](int32_t ix, int32_t iy)
+    {
+        ix = ((ix % period) + period) % period;
+        iy = ((iy % period) + period) % period;
+        uint32_t h = (uint32_t)ix * 0x8da6b343u ^ (uint32_t)iy * 0xd8163841u ^ seed * 0xcb1ab31fu;
+        h ^= h >> 13;
+        h *= 0x5bd1e995u;
+        h ^= h >> 15;
+        return (h & 0xffffff) / float(0xffffff);
+    };
+    int32_t ix = (int32_t)std::floor(x), iy = (int32_t)std::floor(y);
+    float fx = x - ix, fy = y - iy;
+    fx = fx * fx * (3.0f - 2.0f * fx);
+    fy = fy * fy * (3.0f - 2.0f * fy);
+    float a = glm::mix(hash(ix, iy), hash(ix + 1, iy), fx);
+    float b = glm::mix(hash(ix, iy + 1), hash(ix + 1, iy + 1), fx);
+    return glm::mix(a, b, fy);
+}
+
+// Процедурная трава с проплешинами: считается и сжимается в BC1 на пуле,
+// на GPU уходит в 8 раз меньше, чем RGBA8. stop обрывает работу после
+// каждой стадии на пуле
+Task<void> makeNoiseGround(ThreadPool& pool, RenderQueue& renderQueue, TextureManager& textures, TextureId& out,
+                           const std::atomic<bool>& stop)
+{
+    const uint32_t SIZE = 1024;
+    co_await pool.schedule();
+
+    std::vector<uint8_t> rgba((size_t)SIZE * SIZE * 4);
+    pool.parallelFor(SIZE, 16, [&](size_t begin, size_t end)
     {
-        float t = (float)glfwGetTime() - startTime;
+        for (size_t y = begin; y < end; ++y)
+            for (uint32_t x = 0; x < SIZE; ++x)
+            {
+                float n = 0.0f, amp = 0.5f;
+                for (int octave = 0; octave < 5; ++octave)
+                {
+                    int32_t cells = 8 << octave;
+                    float scale = (float)cells / SIZE;
+                    n += amp * valueNoise(x * scale, y * scale, cells, (uint32_t)octave);
+                    amp *= 0.5f;
+                }
+                glm::vec3 grass(0.3f, 0.7f, 0.3f), dirt(0.45f, 0.35f, 0.2f);
+                glm::vec3 c = glm::mix(dirt, grass, glm::smoothstep(0.35f, 0.5f, n)) * (0.8f + 0.4f * n);
+                uint8_t* p = &rgba[((size_t)y * SIZE + x) * 4];
+                p[0] = (uint8_t)(glm::clamp(c.r, 0.0f, 1.0f) * 255.0f);
+                p[1] = (uint8_t)(glm::clamp(c.g, 0.0f, 1.0f) * 255.0f);
+                p[2] = (uint8_t)(glm::clamp(c.b, 0.0f, 1.0f) * 255.0f);
+                p[3] = 255;
+            }
+    });
+    if (stop)
+        co_return;
+
+    co_await renderQueue.schedule();
+    TextureFormat format = textures.supports(TEX_BC1) ? TEX_BC1 : TEX_RGBA8;
+    co_await pool.schedule();
+
+    TextureInfo info;
+    std::vector<char> data = compressTexture(pool, format, rgba.data(), SIZE, SIZE, BC_NORMAL, info);
+    if (stop)
+        co_return;
+
+    co_await renderQueue.schedule();
+    out = textures.create("noise-ground", std::move(info), std::move(data));
+}
 
-        glClearColor(0.6f, 0.85f, 1.0f, 1.0f); 
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+void drawHouse(RenderBackend& r)
+{
+    {
+        glm::mat4 M = glm::scale(glm::mat4(1.0f), glm::vec3(2.0f, 1.0f, 2.0f));
+        r.drawCube(M, glm::vec3(0.65f, 0.45f, 0.25f));
+    }
+    {
+        glm::mat4 M = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.75f, 0.0f));
+        M = glm::scale(M, glm::vec3(2.2f, 0.45f, 2.2f));
+        r.drawCube(M, glm::vec3(0.7f, 0.15f, 0.15f));
+    }
 
-        glm::mat4 P = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 100.0f);
-        glm::mat4 V = glm::lookAt(glm::vec3(4.0f, 3.0f, 6.0f),
-                                  glm::vec3(0.0f, 0.5f, 0.0f),
-                                  glm::vec3(0.0f, 1.0f, 0.0f));
+    {
+        glm::mat4 M = glm::translate(glm::mat4(1.0f), glm::vec3(0.6f, 1.0f, 0.0f));
+        M = glm::scale(M, glm::vec3(0.3f, 0.6f, 0.3f));
+        r.drawCube(M, glm::vec3(0.3f, 0.3f, 0.3f));
+    }
+    {
+        glm::mat4 M = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -0.5f, 0.0f));
+        M = glm::scale(M, glm::vec3(10.0f, 0.05f, 10.0f));
+        r.drawGround(M, glm::vec3(0.3f, 0.7f, 0.3f));
+    }
 
-        glUseProgram(cubeProg);
-        GLint locMVP   = glGetUniformLocation(cubeProg, "uMVP");
-        GLint locColor = glGetUniformLocation(cubeProg, "uColor");
+    {
+        glm::mat4 M = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -0.25f, 1.01f));
+        M = glm::scale(M, glm::vec3(0.4f, 0.6f, 0.05f));
+        r.drawCube(M, glm::vec3(0.35f, 0.23f, 0.12f));
+    }
 
-        glBindVertexArray(cubeVAO);
+    auto drawWindow = [&](float x)
+    {
+        glm::mat4 M = glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.2f, 1.01f));
+        M = glm::scale(M, glm::vec3(0.3f, 0.3f, 0.05f));
+        r.drawCube(M, glm::vec3(0.55f, 0.8f, 1.0f));
+    };
+    drawWindow(-0.6f);
+    drawWindow( 0.6f);
+
+    for (int i = 0; i < 8; ++i) {
+        float angle = i * glm::two_pi<float>() / 8.0f;
+        float radius = 2.8f + ((i % 2) ? 0.3f : -0.3f);
+        float x = cos(angle) * radius;
+        float z = sin(angle) * radius;
+        glm::mat4 M = glm::translate(glm::mat4(1.0f), glm::vec3(x, -0.3f, z));
+        M = glm::scale(M, glm::vec3(0.4f, 0.3f, 0.4f));
+        r.drawCube(M, glm::vec3(0.25f, 0.55f, 0.25f));
+    }
+}
 
+// Рендер-поток: залить очередной проход атласа; при первом — завести
+// текстуру и запомнить коробки, которые GLBackend будет рисовать освещёнными
+void uploadLightmap(SceneGL& scene, const LightmapBaker& baker)
+{
+    const std::vector<uint32_t>& texels = baker.packedLightmap();
+    if (scene.lightmap == 0)
+    {
+        glGenTextures(1, &scene.lightmap);
+        glBindTexture(GL_TEXTURE_2D, scene.lightmap);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB9_E5, baker.width(), baker.height(), 0, GL_RGB, GL_UNSIGNED_INT_5_9_9_9_REV,
+                     texels.data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        for (size_t i = 0; i < baker.boxCount(); ++i)
         {
-            glm::mat4 M = glm::scale(glm::mat4(1.0f), glm::vec3(2.0f, 1.0f, 2.0f));
-            glm::mat4 MVP = P * V * M;
-            glUniformMatrix4fv(locMVP, 1, GL_FALSE, glm::value_ptr(MVP));
-            glUniform3f(locColor, 0.65f, 0.45f, 0.25f);
-            glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+            scene.litModels.push_back(baker.boxModel(i));
+            for (int face = 0; face < 6; ++face)
+                scene.litRects.push_back(baker.faceRect(i, face));
         }
+    }
+    else
+    {
+        glBindTexture(GL_TEXTURE_2D, scene.lightmap);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, baker.width(), baker.height(), GL_RGB, GL_UNSIGNED_INT_5_9_9_9_REV, texels.data());
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// Свет домика запекается на пуле по проходам; после каждого атлас
+// перезаливается, и картинка уточняется прямо в окне. stop при закрытии окна
+// только обрывает запекание: main держит задачу и крутит очередь до её конца
+Task<void> bakeHouseLighting(ThreadPool& pool, RenderQueue& renderQueue, SceneGL& scene,
+                             int maxSamples, const std::atomic<bool>& stop)
+{
+    co_await pool.schedule();
+    SceneCapture capture;
+    drawHouse(capture);
+    LightmapBaker baker(pool, std::move(capture.boxes));
+
+    auto start = std::chrono::steady_clock::now();
+    while (baker.samples() < maxSamples)
+    {
+        baker.pass();
+        if (stop)
+            co_return;
+        co_await renderQueue.schedule();
+        uploadLightmap(scene, baker);
+        co_await pool.schedule();
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Lightmap: " << baker.width() << "x" << baker.height() << ", "
+              << baker.samples() << " samples, " << ms << " ms\n";
+}
+
+// Сетка на GPU: кластеры для отсечения, буферы и матрица модели с
+// деквантованием позиций; ставится рядом с домиком высотой в 1.2 единицы
+void finishMesh(SceneGL& scene, ClusteredMesh clusters, const glm::vec3& boundsMin, const glm::vec3& boundsMax,
+                GLuint vbo, GLuint ebo)
+{
+    glm::vec3 size = boundsMax - boundsMin;
+    float scale = 1.2f / std::max(std::max(size.x, size.y), std::max(size.z, 1e-6f));
+    glm::vec3 base((boundsMin.x + boundsMax.x) * 0.5f, boundsMin.y, (boundsMin.z + boundsMax.z) * 0.5f);
+    scene.meshModel = glm::translate(glm::mat4(1.0f), glm::vec3(-2.3f, -0.5f, 1.6f)) *
+                      glm::scale(glm::mat4(1.0f), glm::vec3(scale)) * glm::translate(glm::mat4(1.0f), -base);
+    scene.meshDequantize = dequantization(boundsMin, boundsMax);
+    scene.mesh = std::move(clusters);
+    scene.meshVBO = vbo;
+    scene.meshEBO = ebo;
+
+    GLuint vao = 0;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    // 0 — позиция и знак битангенса, 1 — нормаль, 2 — касательная, 3 — развёртка
+    const GLsizei stride = sizeof(PackedVertex);
+    glVertexAttribPointer(0, 4, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)offsetof(PackedVertex, position));
+    glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, stride, (void*)offsetof(PackedVertex, normal));
+    glVertexAttribPointer(2, 2, GL_SHORT, GL_TRUE, stride, (void*)offsetof(PackedVertex, tangent));
+    glVertexAttribPointer(3, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(PackedVertex, texcoord));
+    for (GLuint i = 0; i < 4; ++i)
+        glEnableVertexAttribArray(i);
+    glBindVertexArray(0);
+    scene.meshVAO = vao;
+}
+
+// Кэш сетки: чтение через AssetIO в staging, затем пул декодирует вершины
+// и индексы прямо в отображённые буферы, созданные потоком загрузки.
+// false — кэш не годится, нужен повторный импорт
+Task<bool> streamMeshCache(ThreadPool& pool, RenderQueue& renderQueue, UploadWorker& uploader, AssetIO& io,
+                           StagingArena& staging, SceneGL& scene, const std::string& cachePath,
+                           std::chrono::steady_clock::time_point start)
+{
+    StagingSpan span = co_await io.readFile(cachePath, staging);
+    if (!span)
+        co_return false;
+    co_await pool.schedule();
+    MeshCacheView view;
+    if (!parseMeshCache(span.data, span.size, view))
+    {
+        staging.release(span);
+        co_return false;
+    }
+
+    const MeshCacheHeader& h = view.header;
+    size_t vertexSize = (size_t)h.vertexCount * sizeof(PackedVertex), indexSize = (size_t)h.indexCount * sizeof(uint32_t);
+    GLuint vbo = 0, ebo = 0;
+    void* vertices = nullptr;
+    void* indices = nullptr;
+    co_await uploader.run([&]
+    {
+        GLuint buffers[2];
+        glGenBuffers(2, buffers);
+        vbo = buffers[0];
+        ebo = buffers[1];
+        const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;
+        glBindBuffer(GL_COPY_WRITE_BUFFER, vbo);
+        glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)vertexSize, nullptr, GL_STATIC_DRAW);
+        vertices = glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, (GLsizeiptr)vertexSize, access);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, ebo);
+        glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)indexSize, nullptr, GL_STATIC_DRAW);
+        indices = glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, (GLsizeiptr)indexSize, access);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    });
+
+    co_await pool.schedule();
+    bool decoded = vertices && indices &&
+                   decodeVertexBuffer(vertices, h.vertexCount, sizeof(PackedVertex), view.vertexData, (size_t)h.vertexBytes, &pool) &&
+                   decodeIndexBuffer((uint32_t*)indices, h.indexCount, view.indexData, (size_t)h.indexBytes, &pool,
+                                     h.vertexCount);
+    staging.release(span);
+
+    co_await uploader.run([&]
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, vbo);
+        if (vertices)
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, ebo);
+        if (indices)
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        if (!decoded)
         {
-            glm::mat4 M = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.75f, 0.0f));
-            M = glm::scale(M, glm::vec3(2.2f, 0.45f, 2.2f));
-            glm::mat4 MVP = P * V * M;
-            glUniformMatrix4fv(locMVP, 1, GL_FALSE, glm::value_ptr(MVP));
-            glUniform3f(locColor, 0.7f, 0.15f, 0.15f);
-            glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+            GLuint buffers[2] = { vbo, ebo };
+            glDeleteBuffers(2, buffers);
         }
+    });
+    if (!decoded)
+        co_return false;
+
+    co_await renderQueue.schedule();
+    finishMesh(scene, std::move(view.clusters), glm::vec3(h.boundsMin[0], h.boundsMin[1], h.boundsMin[2]),
+               glm::vec3(h.boundsMax[0], h.boundsMax[1], h.boundsMax[2]), vbo, ebo);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Mesh: " << h.indexCount / 3 << " triangles, " << h.meshletCount << " meshlets from cache, "
+              << (span.size >> 10) << " KiB read, " << ((vertexSize + indexSize) >> 10) << " KiB decoded, " << ms << " ms\n";
+    co_return true;
+}
+
+// Импорт сетки. Первый раз OBJ разбирается, получает нормали и касательные
+// и делится на кластеры на пуле, результат пишется в кэш <файл>.midm;
+// дальше грузится только кэш. stop обрывает импорт между стадиями на пуле.
+Task<void> loadMesh(ThreadPool& pool, RenderQueue& renderQueue, UploadWorker& uploader, AssetIO& io,
+                    StagingArena& staging, SceneGL& scene, std::string path, NormalMode normals,
+                    const std::atomic<bool>& stop)
+{
+    co_await pool.schedule();
+    auto start = std::chrono::steady_clock::now();
+    std::string cachePath = path + ".midm";
+    if (meshCacheFresh(cachePath, path, normals))
+    {
+        bool streamed = co_await streamMeshCache(pool, renderQueue, uploader, io, staging, scene, cachePath, start);
+        if (streamed)
+            co_return;
+        std::cerr << "Mesh cache " << cachePath << " is damaged, re-importing\n";
+        co_await pool.schedule();
+    }
+
+    Mesh mesh;
+    if (!loadObj(path, mesh) || stop)
+        co_return;
+    auto attributesStart = std::chrono::steady_clock::now();
+    generateNormals(mesh, normals, &pool);
+    generateTangents(mesh, &pool);
+    if (stop)
+        co_return;
+    double attributesMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - attributesStart).count();
+    ClusteredMesh clusters = buildMeshlets(mesh);
+    std::vector<PackedVertex> vertices = quantizeVertices(mesh);
+    writeMeshCache(cachePath, path, mesh, normals, clusters, vertices);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Mesh: " << mesh.triangleCount() << " triangles, " << mesh.positions.size() << " vertices, "
+              << clusters.size() << " meshlets, " << ms << " ms (normals and tangents " << attributesMs << " ms)\n";
+    if (stop)
+        co_return;
+
+    GLuint vbo = co_await uploader.uploadBuffer(vertices.data(), vertices.size() * sizeof(PackedVertex));
+    GLuint ebo = co_await uploader.uploadBuffer(clusters.indices.data(), clusters.indices.size() * sizeof(uint32_t));
+    co_await renderQueue.schedule();
+    finishMesh(scene, std::move(clusters), mesh.boundsMin, mesh.boundsMax, vbo, ebo);
+}
 
+// Небо: таблицы без солнца строятся один раз, дальше раз в кадр сверяется
+// цель SkyRenderer, и при сдвиге солнца вид неба и перспектива
+// перестраиваются на пуле. Модель живёт в кадре корутины; stop лишь
+// прерывает цикл, а main, как и для bakeHouseLighting, держит задачу и
+// крутит очередь, пока она не закончится
+Task<void> runSky(ThreadPool& pool, RenderQueue& renderQueue, SkyRenderer& sky, const std::atomic<bool>& stop)
+{
+    co_await pool.schedule();
+    AtmosphereModel atmosphere(pool);
+    atmosphere.prepare();
+    SkyTables tables;
+    while (!stop)
+    {
+        co_await renderQueue.schedule();
+        if (!sky.needsUpdate())
         {
-            glm::mat4 M = glm::translate(glm::mat4(1.0f), glm::vec3(0.6f, 1.0f, 0.0f));
-            M = glm::scale(M, glm::vec3(0.3f, 0.6f, 0.3f));
-            glm::mat4 MVP = P * V * M;
-            glUniformMatrix4fv(locMVP, 1, GL_FALSE, glm::value_ptr(MVP));
-            glUniform3f(locColor, 0.3f, 0.3f, 0.3f);
-            glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+            co_await renderQueue.nextFrame();
+            continue;
         }
+        glm::vec3 sun = sky.targetSunDirection();
+        float altitude = sky.targetObserverAltitude();
+        float distance = sky.aerialDistance;
+        co_await pool.schedule();
+        atmosphere.bake(sun, altitude, distance, tables);
+        if (stop)
+            co_return;
+        co_await renderQueue.schedule();
+        sky.upload(tables);
+    }
+}
+
+// Сетка мелких камней на земле: count отдельных вызовов, для замера
+// стоимости отправки при большом числе вызовов
+void drawGravel(RenderBackend& r, int count)
+{
+    if (count <= 0)
+        return;
+    int side = (int)std::ceil(std::sqrt((float)count));
+    float step = 9.0f / (float)side;
+    float size = std::min(0.06f, step * 0.5f);
+    for (int i = 0; i < count; ++i)
+    {
+        float x = -4.5f + ((float)(i % side) + 0.5f) * step;
+        float z = -4.5f + ((float)(i / side) + 0.5f) * step;
+        glm::mat4 M = glm::translate(glm::mat4(1.0f), glm::vec3(x, -0.475f + size * 0.5f, z));
+        M = glm::scale(M, glm::vec3(size));
+        float shade = 0.45f + 0.1f * (float)((i * 7) % 5) / 4.0f;
+        r.drawCube(M, glm::vec3(shade, shade * 0.95f, shade * 0.9f));
+    }
+}
+
+// Ящики для физики: коробки домика — неподвижные тела, count ящиков падает
+// столбиками над двором. Инстансы ящиков идут в том же порядке, что и тела
+std::vector<PackedInstance> addCrates(PhysicsWorld& physics, int count, unsigned seed)
+{
+    SceneCapture capture;
+    drawHouse(capture);
+    for (const SceneCapture::Box& box : capture.boxes)
+        physics.addBox(box.model, 0.0f);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const int side = 12;
+    const float spacing = 0.8f;
+    std::vector<CubeInstance> crates(std::max(count, 0));
+    for (int i = 0; i < count; ++i)
+    {
+        int column = i % (side * side), layer = i / (side * side);
+        float x = ((float)(column % side) - (side - 1) * 0.5f) * spacing;
+        float z = ((float)(column / side) - (side - 1) * 0.5f) * spacing;
+        float size = 0.25f + 0.1f * unit(rng);
+        glm::mat4 M = glm::translate(glm::mat4(1.0f), glm::vec3(x, 2.5f + (float)layer * 0.45f, z));
+        M = glm::rotate(M, unit(rng) * glm::two_pi<float>(), glm::vec3(0.0f, 1.0f, 0.0f));
+        M = glm::rotate(M, (unit(rng) - 0.5f) * 0.4f, glm::vec3(1.0f, 0.0f, 0.0f));
+        M = glm::scale(M, glm::vec3(size));
+        // Плотность дерева — около 500 кг/м³
+        physics.addBox(M, size * size * size * 500.0f);
+
+        float shade = 0.8f + 0.2f * unit(rng);
+        crates[i].model = M;
+        crates[i].color = glm::vec4(0.62f * shade, 0.44f * shade, 0.24f * shade, 1.0f);
+    }
+    return packInstances(crates);
+}
+
+void drawSmoke(const SceneGL& scene, const glm::mat4& P, const glm::mat4& V, float t, const glm::vec3& base)
 {
-    glm::mat4 M = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -0.5f, 0.0f));
-    M = glm::scale(M, glm::vec3(10.0f, 0.05f, 10.0f));
-    glm::mat4 MVP = P * V * M;
-    glUniformMatrix4fv(locMVP, 1, GL_FALSE, glm::value_ptr(MVP));
+    glUseProgram(scene.smokeProg);
+
+    GLint locView  = glGetUniformLocation(scene.smokeProg, "uView");
+    GLint locProj  = glGetUniformLocation(scene.smokeProg, "uProj");
+    GLint locTime  = glGetUniformLocation(scene.smokeProg, "uTime");
 
-    glUniform3f(locColor, 0.3f, 0.7f, 0.3f); 
+    glUniformMatrix4fv(locView, 1, GL_FALSE, glm::value_ptr(V));
+    glUniformMatrix4fv(locProj, 1, GL_FALSE, glm::value_ptr(P));
+    glUniform1f(locTime, t);
+    glUniform3fv(glGetUniformLocation(scene.smokeProg, "uBase"), 1, glm::value_ptr(base));
 
-    glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+    glBindVertexArray(scene.smokeVAO);
+    glDrawArrays(GL_POINTS, 0, NUM_PARTICLES);
+    glBindVertexArray(0);
 }
 
+// Сетка рисуется только видимыми кластерами: отсечение на CPU, затем один
+// glMultiDrawElements по слитым диапазонам индексов
+void drawClusteredMesh(const SceneGL& scene, const glm::mat4& P, const glm::mat4& V, const glm::vec3& eye,
+                       ClusterDrawList& visible)
+{
+    cullClusters(scene.mesh, P * V, scene.meshModel, eye, visible);
+    if (visible.counts.empty())
+        return;
+
+    glUseProgram(scene.meshProg);
+    glm::mat4 model = scene.meshModel * scene.meshDequantize;
+    glUniformMatrix4fv(glGetUniformLocation(scene.meshProg, "uMVP"), 1, GL_FALSE, glm::value_ptr(P * V * model));
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(scene.meshModel)));
+    glUniformMatrix3fv(glGetUniformLocation(scene.meshProg, "uNormalMatrix"), 1, GL_FALSE, glm::value_ptr(normalMatrix));
+    glUniform3f(glGetUniformLocation(scene.meshProg, "uColor"), 0.62f, 0.6f, 0.56f);
+    glBindVertexArray(scene.meshVAO);
+    glMultiDrawElements(GL_TRIANGLES, visible.counts.data(), GL_UNSIGNED_INT, visible.offsets.data(),
+                        (GLsizei)visible.counts.size());
+    glBindVertexArray(0);
+}
+
+// Сцена домика через GL; groundLayer >= 0 — слой массива на юните 0 для земли
+class GLBackend : public RenderBackend
+{
+public:
+    GLBackend(const SceneGL& scene, int groundLayer) : scene(scene), groundLayer(groundLayer) {}
+
+    void setCamera(const glm::mat4& proj, const glm::mat4& view) override
+    {
+        P = proj;
+        V = view;
+    }
+
+    void drawCube(const glm::mat4& model, const glm::vec3& color) override
+    {
+        if (drawLit(model, color, scene.litCubeProg))
+            return;
+        glm::mat4 MVP = P * V * model;
+        glUseProgram(scene.cubeProg);
+        glUniformMatrix4fv(glGetUniformLocation(scene.cubeProg, "uMVP"), 1, GL_FALSE, glm::value_ptr(MVP));
+        glUniform3fv(glGetUniformLocation(scene.cubeProg, "uColor"), 1, glm::value_ptr(color));
+        glBindVertexArray(scene.cubeVAO);
+        glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+        glBindVertexArray(0);
+    }
+
+    void drawGround(const glm::mat4& model, const glm::vec3& color) override
+    {
+        if (groundLayer < 0)
         {
-            glm::mat4 M = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -0.25f, 1.01f));
-            M = glm::scale(M, glm::vec3(0.4f, 0.6f, 0.05f));
-            glm::mat4 MVP = P * V * M;
-            glUniformMatrix4fv(locMVP, 1, GL_FALSE, glm::value_ptr(MVP));
-            glUniform3f(locColor, 0.35f, 0.23f, 0.12f);
-            glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+            drawCube(model, color);
+            return;
         }
+        if (drawLit(model, color, scene.litGroundProg))
+            return;
+        glm::mat4 MVP = P * V * model;
+        glUseProgram(scene.groundProg);
+        glUniformMatrix4fv(glGetUniformLocation(scene.groundProg, "uMVP"), 1, GL_FALSE, glm::value_ptr(MVP));
+        glUniformMatrix4fv(glGetUniformLocation(scene.groundProg, "uModel"), 1, GL_FALSE, glm::value_ptr(model));
+        glUniform1i(glGetUniformLocation(scene.groundProg, "uTex"), 0);
+        glUniform1f(glGetUniformLocation(scene.groundProg, "uLayer"), (float)groundLayer);
+        glBindVertexArray(scene.cubeVAO);
+        glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+        glBindVertexArray(0);
+    }
 
-        auto drawWindow = [&](float x)
-        {
-            glm::mat4 M = glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.2f, 1.01f));
-            M = glm::scale(M, glm::vec3(0.3f, 0.3f, 0.05f));
-            glm::mat4 MVP = P * V * M;
-            glUniformMatrix4fv(locMVP, 1, GL_FALSE, glm::value_ptr(MVP));
-            glUniform3f(locColor, 0.55f, 0.8f, 1.0f);
-            glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
-        };
-        drawWindow(-0.6f);
-        drawWindow( 0.6f);
+    void drawSmoke(const glm::vec3& base, float t) override { ::drawSmoke(scene, P, V, t, base); }
 
-for (int i = 0; i < 8; ++i) {
-    float angle = i * glm::two_pi<float>() / 8.0f;
-    float radius = 2.8f + ((i % 2) ? 0.3f : -0.3f);
-    float x = cos(angle) * radius;
-    float z = sin(angle) * radius;
-    glm::mat4 M = glm::translate(glm::mat4(1.0f), glm::vec3(x, -0.3f, z));
-    M = glm::scale(M, glm::vec3(0.4f, 0.3f, 0.4f));
-    glm::mat4 MVP = P * V * M;
-    glUniformMatrix4fv(locMVP, 1, GL_FALSE, glm::value_ptr(MVP));
-    glUniform3f(locColor, 0.25f, 0.55f, 0.25f);
-    glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+private:
+    // Коробка с запечённым светом узнаётся по номеру вызова и матрице:
+    // drawHouse рисует их в том же порядке, что и при запекании
+    bool drawLit(const glm::mat4& model, const glm::vec3& color, GLuint prog)
+    {
+        size_t index = drawIndex++;
+        if (scene.lightmap == 0 || index >= scene.litModels.size() || scene.litModels[index] != model)
+            return false;
+
+        glm::mat4 MVP = P * V * model;
+        glUseProgram(prog);
+        glUniformMatrix4fv(glGetUniformLocation(prog, "uMVP"), 1, GL_FALSE, glm::value_ptr(MVP));
+        glUniformMatrix4fv(glGetUniformLocation(prog, "uModel"), 1, GL_FALSE, glm::value_ptr(model));
+        glUniform4fv(glGetUniformLocation(prog, "uFaceRects"), 6, glm::value_ptr(scene.litRects[index * 6]));
+        glUniform3fv(glGetUniformLocation(prog, "uColor"), 1, glm::value_ptr(color));
+        glUniform1i(glGetUniformLocation(prog, "uTex"), 0);
+        glUniform1f(glGetUniformLocation(prog, "uLayer"), (float)groundLayer);
+        glUniform1i(glGetUniformLocation(prog, "uLightmap"), LIGHTMAP_UNIT);
+        glActiveTexture(GL_TEXTURE0 + LIGHTMAP_UNIT);
+        glBindTexture(GL_TEXTURE_2D, scene.lightmap);
+        glActiveTexture(GL_TEXTURE0);
+        glBindVertexArray(scene.litCubeVAO);
+        glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+        glBindVertexArray(0);
+        return true;
+    }
+
+    const SceneGL& scene;
+    int groundLayer;
+    size_t drawIndex = 0;
+    glm::mat4 P = glm::mat4(1.0f), V = glm::mat4(1.0f);
+};
+
+const glm::vec3 HOUSE_EYE(4.0f, 3.0f, 6.0f);
+const glm::vec4 SKY_COLOR(0.6f, 0.85f, 1.0f, 1.0f);
+
+// Камера домика — общая для бэкендов и неба
+void houseCamera(glm::mat4& P, glm::mat4& V)
+{
+    P = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 100.0f);
+    V = glm::lookAt(HOUSE_EYE,
+                    glm::vec3(0.0f, 0.5f, 0.0f),
+                    glm::vec3(0.0f, 1.0f, 0.0f));
 }
 
+// Общий для всех бэкендов кадр сцены домика; gravel — число камней drawGravel
+void drawHouseScene(RenderBackend& r, float t, int gravel)
+{
+    glm::mat4 P, V;
+    houseCamera(P, V);
+    r.setCamera(P, V);
+    drawHouse(r);
+    drawGravel(r, gravel);
+    r.drawSmoke(glm::vec3(0.6f, 1.4f, 0.0f), t);
+}
 
-        glBindVertexArray(0);
-        glUseProgram(smokeProg);
+// Без окна и GL: кадры сцены на CPU с шагом 1/60 с, последний — в PPM
+int renderSoftware(const char* outPath, int frames, unsigned seed, int gravel, AOQuality aoQuality)
+{
+    ThreadPool pool;
+    SoftwareRenderer renderer(pool, 800, 600);
+    renderer.setParticles(makeParticles(seed));
+    renderer.ambientOcclusion().setQuality(aoQuality);
+
+    double aoMs = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i)
+    {
+        renderer.beginFrame(SKY_COLOR);
+        drawHouseScene(renderer, (float)i / 60.0f, gravel);
+        renderer.endFrame();
+        aoMs += renderer.ambientOcclusion().lastMs();
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Software: " << frames << " frames, " << ms / frames << " ms/frame, "
+              << aoMs / frames << " ms AO, " << renderer.triangleCount() << " triangles\n";
+    return renderer.writePPM(outPath) ? 0 : -1;
+}
 
-        GLint locView  = glGetUniformLocation(smokeProg, "uView");
-        GLint locProj  = glGetUniformLocation(smokeProg, "uProj");
-        GLint locTime  = glGetUniformLocation(smokeProg, "uTime");
+// То же через Vulkan: работает и на программном драйвере (lavapipe)
+int renderVulkan(const char* outPath, int frames, unsigned seed, int gravel)
+{
+#ifdef MID_WITH_VULKAN
+    ThreadPool pool;
+    VulkanRenderer renderer(pool, 800, 600);
+    if (!renderer.init())
+        return -1;
+    renderer.setParticles(makeParticles(seed));
 
-        glUniformMatrix4fv(locView, 1, GL_FALSE, glm::value_ptr(V));
-        glUniformMatrix4fv(locProj, 1, GL_FALSE, glm::value_ptr(P));
-        glUniform1f(locTime, t);
+    double recordMs = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i)
+    {
+        renderer.beginFrame(SKY_COLOR);
+        drawHouseScene(renderer, (float)i / 60.0f, gravel);
+        renderer.endFrame();
+        recordMs += renderer.lastRecordMs();
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Vulkan (" << renderer.deviceName() << "): " << frames << " frames, " << ms / frames
+              << " ms/frame, " << recordMs / frames << " ms recording, " << renderer.drawCount() << " draws\n";
+    return renderer.writePPM(outPath) ? 0 : -1;
+#else
+    (void)outPath; (void)frames; (void)seed; (void)gravel;
+    std::cerr << "Built without Vulkan headers\n";
+    return -1;
+#endif
+}
 
-        glBindVertexArray(smokeVAO);
-        glDrawArrays(GL_POINTS, 0, NUM_PARTICLES);
-        glBindVertexArray(0);
+// HDR-кадр окна в PFM: строки снизу вверх, как их и хранит формат
+bool writeHDRFrame(PostChain& post, const char* path)
+{
+    std::vector<glm::vec3> pixels;
+    post.readHDR(pixels);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        std::cerr << "Failed to write " << path << "\n";
+        return false;
+    }
+    out << "PF\n" << post.frameWidth() << " " << post.frameHeight() << "\n-1.0\n";
+    out.write((const char*)pixels.data(), (std::streamsize)(pixels.size() * sizeof(glm::vec3)));
+    return (bool)out;
+}
+
+int main(int argc, char** argv)
+{
+    // --world <файл>: потоковый мир вместо одного домика
+    // --village <файл> N: записать деревню из N домов и показать её как --world
+    // --seed S: зерно деревни, раскладки ящиков и дыма (и в окне, и в --software/--vulkan), 1 по умолчанию
+    // --ground <файл.ktx2|.dds>: текстура земли; --noise-ground — сгенерировать
+    // --no-occlusion: рисовать мир без программного буфера перекрытий
+    // --software <файл.ppm> [--frames N]: домик на CPU, без окна и GPU
+    // --vulkan <файл.ppm> [--frames N]: домик через Vulkan, без окна
+    // --gravel N: добавить в сцену домика N камней, по вызову на каждый
+    // --crates N: сбросить во двор домика N ящиков с физикой
+    // --ao 0..3: качество затенения программного пути, 0 — выключено
+    // --no-post: рисовать прямо в окно, без HDR, свечения и тонмаппинга
+    // --hdr-dump <файл.pfm>: при выходе сохранить последний HDR-кадр
+    // --bake-samples N: лучей на тексель запечённого света домика, 0 — без него
+    // --mesh <файл.obj>: поставить рядом с домиком сетку, рисуемую кластерами
+    // --time-of-day H: положение солнца, часы (14 по умолчанию)
+    // --day-length S: сутки за S секунд, 0 — солнце стоит; без постобработки
+    //                 небо остаётся плоским цветом
+    const char* worldPath = nullptr;
+    const char* villagePath = nullptr;
+    uint32_t villageHouses = 0;
+    uint32_t seed = 1;
+    const char* softwarePath = nullptr;
+    const char* vulkanPath = nullptr;
+    int offscreenFrames = 60;
+    int gravel = 0;
+    int crateCount = 0;
+    int bakeSamples = 64;
+    float timeOfDay = 14.0f;
+    float dayLength = 0.0f;
+    AOQuality aoQuality = AO_MEDIUM;
+    bool postProcessing = true;
+    const char* hdrDumpPath = nullptr;
+    const char* groundPath = nullptr;
+    const char* meshPath = nullptr;
+    NormalMode meshNormals = NormalMode::Smooth;
+    bool noiseGround = false;
+    bool occlusionCulling = true;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--world") == 0 && i + 1 < argc)
+            worldPath = argv[++i];
+        else if (std::strcmp(argv[i], "--village") == 0 && i + 2 < argc)
+        {
+            villagePath = argv[++i];
+            villageHouses = (uint32_t)std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--mesh") == 0 && i + 1 < argc)
+            meshPath = argv[++i];
+        else if (std::strcmp(argv[i], "--flat-normals") == 0)
+            meshNormals = NormalMode::Flat;
+        else if (std::strcmp(argv[i], "--ground") == 0 && i + 1 < argc)
+            groundPath = argv[++i];
+        else if (std::strcmp(argv[i], "--noise-ground") == 0)
+            noiseGround = true;
+        else if (std::strcmp(argv[i], "--no-occlusion") == 0)
+            occlusionCulling = false;
+        else if (std::strcmp(argv[i], "--software") == 0 && i + 1 < argc)
+            softwarePath = argv[++i];
+        else if (std::strcmp(argv[i], "--vulkan") == 0 && i + 1 < argc)
+            vulkanPath = argv[++i];
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            offscreenFrames = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--gravel") == 0 && i + 1 < argc)
+            gravel = std::max(0, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--crates") == 0 && i + 1 < argc)
+            crateCount = std::max(0, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--bake-samples") == 0 && i + 1 < argc)
+            bakeSamples = std::max(0, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--time-of-day") == 0 && i + 1 < argc)
+            timeOfDay = (float)std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--day-length") == 0 && i + 1 < argc)
+            dayLength = std::max(0.0f, (float)std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--no-post") == 0)
+            postProcessing = false;
+        else if (std::strcmp(argv[i], "--hdr-dump") == 0 && i + 1 < argc)
+            hdrDumpPath = argv[++i];
+        else if (std::strcmp(argv[i], "--ao") == 0 && i + 1 < argc)
+            aoQuality = (AOQuality)std::clamp(std::atoi(argv[++i]), (int)AO_OFF, (int)AO_HIGH);
+    }
 
-        glfwSwapBuffers(win);
-        glfwPollEvents();
+    if (softwarePath)
+        return renderSoftware(softwarePath, offscreenFrames, seed, gravel, aoQuality);
+    if (vulkanPath)
+        return renderVulkan(vulkanPath, offscreenFrames, seed, gravel);
+
+    if (!glfwInit())
+    {
+        std::cerr << "Failed to init GLFW\n";
+        return -1;
     }
 
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    GLFWwindow* win = glfwCreateWindow(800, 600, "Steam from Chimney - Geometry Shader", nullptr, nullptr);
+    if (!win)
+    {
+        std::cerr << "Failed to create window\n";
+        glfwTerminate();
+        return -1;
+    }
+
+    glfwMakeContextCurrent(win);
+
+    // Таблица функций окна — для рендер-потока; у контекста загрузки своя
+    GladGLContext windowGL;
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)
+        || !gladLoadGLContext(&windowGL, (GLADloadproc)glfwGetProcAddress))
+    {
+        std::cerr << "Failed to init GLAD\n";
+        return -1;
+    }
+    gladSetGLContext(&windowGL);
+
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Все владельцы GL-объектов живут в этом блоке: их деструкторам нужен
+    // текущий контекст, а glfwTerminate() его уничтожает
+    {
+        std::atomic<bool> stopBackground{ false };
+        ThreadPool pool;
+        if (villagePath)
+        {
+            VillageSettings village;
+            village.seed = seed;
+            village.houses = villageHouses;
+            if (writeVillage(pool, villagePath, village))
+                worldPath = villagePath;
+        }
+        RenderQueue renderQueue;
+        UploadWorker uploader(win, renderQueue);
+
+        // Задачи, которые трогают сцену и очереди: при выходе main дожидается
+        // каждую, прокачивая рендер-очередь, и только потом всё разрушает
+        std::vector<Task<void>> background;
+        auto startBackground = [&background](Task<void> task)
+        {
+            background.push_back(std::move(task));
+            background.back().start();
+        };
+
+        SceneGL scene;
+        startBackground(loadScene(pool, renderQueue, uploader, scene, seed));
+        if (!worldPath && bakeSamples > 0)
+            startBackground(bakeHouseLighting(pool, renderQueue, scene, bakeSamples, stopBackground));
+
+        StagingArena staging(64u << 20);
+        AssetIO io(pool, { &staging });
+        OcclusionBuffer occlusion(pool);
+        std::unique_ptr<WorldStreamer> world;
+        if (worldPath)
+        {
+            world = std::make_unique<WorldStreamer>(renderQueue, io, uploader, staging);
+            if (!world->open(worldPath))
+                world.reset();
+            else if (occlusionCulling)
+                world->setOcclusion(&occlusion);
+        }
+        TextureManager textures(renderQueue, io, uploader, staging);
+        TextureId ground = groundPath ? textures.load(groundPath) : NO_TEXTURE;
+        if (!groundPath && noiseGround)
+            startBackground(makeNoiseGround(pool, renderQueue, textures, ground, stopBackground));
+
+        if (!worldPath && meshPath)
+            startBackground(loadMesh(pool, renderQueue, uploader, io, staging, scene, meshPath, meshNormals,
+                                     stopBackground));
+
+        // Ящики: тела после коробок домика, матрицы пишутся прямо в их инстансы
+        PhysicsWorld physics(pool);
+        std::vector<PackedInstance> crates;
+        uint32_t firstCrate = 0;
+        DynamicInstances crateInstances;
+        if (!worldPath && crateCount > 0)
+        {
+            crates = addCrates(physics, crateCount, seed);
+            firstCrate = (uint32_t)(physics.size() - crates.size());
+        }
+        float prevFrame = 0.0f;
+
+        // Материалы мира: 1 — текстура земли, 2 — она же с тёплым оттенком
+        MaterialTable materials(textures);
+        materials.add(Material());
+        materials.add(Material());
+
+        PostChain post;
+        PostSettings postSettings;
+        if (postProcessing)
+        {
+            int fbWidth = 0, fbHeight = 0;
+            glfwGetFramebufferSize(win, &fbWidth, &fbHeight);
+            postProcessing = post.init(fbWidth, fbHeight);
+        }
+        SkyRenderer sky;
+        if (postProcessing)
+            startBackground(runSky(pool, renderQueue, sky, stopBackground));
+
+        glm::vec3 prevEye(0.0f);
+        ClusterDrawList visibleClusters;
+        float prevT = 0.0f;
+
+        float startTime = (float)glfwGetTime();
+        while (!glfwWindowShouldClose(win))
+        {
+            float t = (float)glfwGetTime() - startTime;
+            float frameTime = t - prevFrame;
+            prevFrame = t;
+
+            renderQueue.drain();
+
+            bool postFrame = postProcessing && scene.ready;
+            if (postFrame)
+                post.begin();
+            glClearColor(SKY_COLOR.r, SKY_COLOR.g, SKY_COLOR.b, SKY_COLOR.a);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            if (!scene.ready)
+            {
+                glfwSwapBuffers(win);
+                glfwPollEvents();
+                continue;
+            }
+
+            // Время суток и камера кадра — для неба и воздушной перспективы
+            float hours = timeOfDay + (dayLength > 0.0f ? t / dayLength * 24.0f : 0.0f);
+            glm::mat4 skyViewProj(1.0f);
+            glm::vec3 skyEye(0.0f);
+
+            if (world)
+            {
+                // Облёт мира по кругу; скорость камеры нужна для предсказания загрузки
+                glm::vec3 lo = world->boundsMin(), hi = world->boundsMax();
+                glm::vec3 center = (lo + hi) * 0.5f;
+                float orbit = glm::max(hi.x - lo.x, hi.z - lo.z) * 0.35f + 5.0f;
+                float a = t * 0.05f;
+                glm::vec3 eye = center + glm::vec3(cos(a) * orbit, 6.0f, sin(a) * orbit);
+                glm::vec3 ahead = center + glm::vec3(cos(a + 0.3f) * orbit, 0.0f, sin(a + 0.3f) * orbit);
+                glm::vec3 velocity = t > prevT ? (eye - prevEye) / (t - prevT) : glm::vec3(0.0f);
+                prevEye = eye;
+                prevT = t;
+
+                glm::mat4 P = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 300.0f);
+                glm::mat4 V = glm::lookAt(eye, ahead, glm::vec3(0.0f, 1.0f, 0.0f));
+                skyViewProj = P * V;
+                skyEye = eye;
+                if (postFrame)
+                    sky.draw(scene.sky, skyViewProj);
+
+                materials.set(1, { ground, glm::vec4(1.0f) });
+                materials.set(2, { ground, glm::vec4(1.0f, 0.8f, 0.6f, 1.0f) });
+                materials.update();
+                textures.request(ground, 512.0f);
+
+                world->setMesh(scene.cubeVBO, scene.cubeEBO, 36);
+                world->setProgram(scene.cubeInstProg);
+                world->update(eye, velocity, P * V, glm::radians(45.0f), 600.0f);
+                glUseProgram(scene.cubeInstProg);
+                materials.bind(scene.cubeInstProg);
+                world->draw(P * V);
+
+                for (const glm::vec3& base : world->smokeEmitters(eye, 16))
+                    drawSmoke(scene, P, V, t, base);
+            }
+            else
+            {
+                // Повтор UV земли — 4 единицы; крупнее всего он у ног камеры
+                float projScale = 600.0f / (2.0f * std::tan(glm::radians(45.0f) * 0.5f));
+                textures.request(ground, 4.0f / (HOUSE_EYE.y + 0.5f) * projScale);
+
+                glm::mat4 P, V;
+                houseCamera(P, V);
+                skyViewProj = P * V;
+                skyEye = HOUSE_EYE;
+                if (postFrame)
+                    sky.draw(scene.sky, skyViewProj);
+                if (scene.meshVAO)
+                    drawClusteredMesh(scene, P, V, HOUSE_EYE, visibleClusters);
+
+                if (!crates.empty())
+                {
+                    physics.update(frameTime);
+                    physics.writeModels(firstCrate, crates.size(), &crates[0].model, sizeof(PackedInstance));
+                    crateInstances.setMesh(scene.cubeVBO, scene.cubeEBO, 36);
+                    crateInstances.update(crates);
+                    materials.update();
+                    glUseProgram(scene.cubeInstProg);
+                    materials.bind(scene.cubeInstProg);
+                    crateInstances.draw(scene.cubeInstProg, P * V);
+                }
+
+                GLBackend gl(scene, textures.bind(ground, 0));
+                drawHouseScene(gl, t, gravel);
+            }
+
+            if (postFrame)
+            {
+                sky.setTarget(sunDirection(hours), skyEye.y * sky.kmPerUnit);
+                sky.applyAerialPerspective(scene.sky, post, skyViewProj, skyEye);
+                post.resolve(scene.post, postSettings);
+            }
+
+            textures.update();
+
+            glfwSwapBuffers(win);
+            glfwPollEvents();
+        }
+
+        // Между проверкой stop и переходом в очередь задача может успеть
+        // встать в неё — крутим очередь, пока все не закончатся сами
+        stopBackground = true;
+        auto running = [&background]
+        {
+            return std::any_of(background.begin(), background.end(), [](const Task<void>& t) { return !t.done(); });
+        };
+        while (running())
+        {
+            renderQueue.drain();
+            std::this_thread::yield();
+        }
+
+        if (hdrDumpPath && postProcessing && scene.ready)
+            writeHDRFrame(post, hdrDumpPath);
+        post.release();
+
+        // Ячейки, которые ещё грузятся, ждут контекст загрузки
+        world.reset();
+        uploader.stop();
+    }
     glfwTerminate();
     return 0;
 }
@@ -0,0 +1,411 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define MID_OCCLUSION_AVX2 1
+#endif
+
+#include "tasks.h"
+
+// Программный буфер перекрытий по схеме masked occlusion culling: экран
+// низкого разрешения делится на тайлы 32x8, у тайла — маска покрытия
+// (бит на пиксель) и две дальние глубины. Слой 0 — глубина, за которой
+// тайл гарантированно закрыт; слой 1 копит частично покрытое, пока маска
+// не заполнится. Крупные окклюдеры растеризуются полосами тайлов на пуле,
+// затем рамки объектов проверяются в том же кадре без обращения к GPU.
+// Глубина — NDC z в [0, 1], меньше — ближе.
+class OcclusionBuffer
+{
+public:
+    static constexpr int TILE_W = 32;
+    static constexpr int TILE_H = 8;
+
+    OcclusionBuffer(ThreadPool& pool, int width = 320, int height = 192)
+        : pool(pool),
+          width((width + TILE_W - 1) / TILE_W * TILE_W),
+          height((height + TILE_H - 1) / TILE_H * TILE_H),
+          tilesX(this->width / TILE_W),
+          tilesY(this->height / TILE_H),
+          stride((tilesX + 7) / 8 * 8),
+          masks((size_t)stride * tilesY * TILE_H),
+          zMax0((size_t)stride * tilesY),
+          zMax1((size_t)stride * tilesY)
+    {
+        clear();
+    }
+
+    // Начать кадр: очистить буфер и запомнить матрицу вида-проекции
+    void begin(const glm::mat4& viewProj)
+    {
+        this->viewProj = viewProj;
+#ifdef MID_OCCLUSION_AVX2
+        for (int c = 0; c < 4; ++c)
+            for (int r = 0; r < 4; ++r)
+                matrix[c][r] = _mm256_set1_ps(viewProj[c][r]);
+#endif
+        triangles.clear();
+        clear();
+    }
+
+    // Окклюдер — единичный куб [-0.5, 0.5]^3 с матрицей модели (как у сцены)
+    void addBox(const glm::mat4& model)
+    {
+        static const glm::vec3 corners[8] = {
+            { -0.5f, -0.5f, -0.5f }, { 0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, -0.5f }, { -0.5f, 0.5f, -0.5f },
+            { -0.5f, -0.5f, 0.5f }, { 0.5f, -0.5f, 0.5f }, { 0.5f, 0.5f, 0.5f }, { -0.5f, 0.5f, 0.5f },
+        };
+        static const uint8_t faces[36] = {
+            0, 2, 1, 2, 0, 3,   4, 5, 6, 6, 7, 4,
+            0, 4, 7, 7, 3, 0,   1, 2, 6, 6, 5, 1,
+            0, 1, 5, 5, 4, 0,   3, 7, 6, 6, 2, 3,
+        };
+        glm::mat4 mvp = viewProj * model;
+        glm::vec4 clip[8];
+        for (int i = 0; i < 8; ++i)
+            clip[i] = mvp * glm::vec4(corners[i], 1.0f);
+        for (int t = 0; t < 36; t += 3)
+            addTriangle(clip[faces[t]], clip[faces[t + 1]], clip[faces[t + 2]]);
+    }
+
+    // Треугольник в clip-пространстве, против часовой стрелки — лицевой.
+    // Пересекающие ближнюю плоскость пропускаются: окклюдер можно недорисовать.
+    void addTriangle(const glm::vec4& c0, const glm::vec4& c1, const glm::vec4& c2)
+    {
+        const float NEAR_W = 1e-3f;
+        if (c0.w < NEAR_W || c1.w < NEAR_W || c2.w < NEAR_W)
+            return;
+
+        Triangle t;
+        const glm::vec4* c[3] = { &c0, &c1, &c2 };
+        for (int i = 0; i < 3; ++i)
+        {
+            float invW = 1.0f / c[i]->w;
+            t.x[i] = (c[i]->x * invW * 0.5f + 0.5f) * (float)width;
+            t.y[i] = (c[i]->y * invW * 0.5f + 0.5f) * (float)height;
+            t.z[i] = c[i]->z * invW * 0.5f + 0.5f;
+        }
+
+        float area = (t.x[1] - t.x[0]) * (t.y[2] - t.y[0]) - (t.x[2] - t.x[0]) * (t.y[1] - t.y[0]);
+        if (area <= 0.0f)
+            return;
+
+        float minX = std::min({ t.x[0], t.x[1], t.x[2] }), maxX = std::max({ t.x[0], t.x[1], t.x[2] });
+        float minY = std::min({ t.y[0], t.y[1], t.y[2] }), maxY = std::max({ t.y[0], t.y[1], t.y[2] });
+        if (maxX < 0.0f || maxY < 0.0f || minX >= (float)width || minY >= (float)height)
+            return;
+        t.zMin = std::min({ t.z[0], t.z[1], t.z[2] });
+        t.zMax = std::max({ t.z[0], t.z[1], t.z[2] });
+        if (t.zMin > 1.0f)
+            return;
+
+        t.tileX0 = std::clamp((int)minX / TILE_W, 0, tilesX - 1);
+        t.tileX1 = std::clamp((int)maxX / TILE_W, 0, tilesX - 1);
+        t.tileY0 = std::clamp((int)minY / TILE_H, 0, tilesY - 1);
+        t.tileY1 = std::clamp((int)maxY / TILE_H, 0, tilesY - 1);
+
+        // Плоскость глубины z = zBase + zdx * x + zdy * y
+        float inv = 1.0f / area;
+        float ax = t.x[1] - t.x[0], ay = t.y[1] - t.y[0], bx = t.x[2] - t.x[0], by = t.y[2] - t.y[0];
+        float az = t.z[1] - t.z[0], bz = t.z[2] - t.z[0];
+        t.zdx = (az * by - bz * ay) * inv;
+        t.zdy = (bz * ax - az * bx) * inv;
+        t.zBase = t.z[0] - t.zdx * t.x[0] - t.zdy * t.y[0];
+        triangles.push_back(t);
+    }
+
+    // Растеризовать накопленное: строки тайлов независимы и идут на пул,
+    // внутри строки — в порядке добавления (близкие окклюдеры лучше первыми)
+    void rasterize()
+    {
+        pool.parallelFor((size_t)tilesY, 1, [this](size_t begin, size_t end)
+        {
+            for (size_t row = begin; row < end; ++row)
+                for (const Triangle& t : triangles)
+                    if ((int)row >= t.tileY0 && (int)row <= t.tileY1)
+                        rasterizeRow(t, (int)row);
+        });
+    }
+
+    // Может ли быть видна рамка [mn, mx] в мировых координатах
+    bool testBox(const glm::vec3& mn, const glm::vec3& mx) const
+    {
+        uint8_t visible;
+        testBoxes(&mn, &mx, 1, &visible);
+        return visible != 0;
+    }
+
+    // Пакетная проверка: visible[i] = 0, если рамка i целиком закрыта
+    void testBoxes(const glm::vec3* mins, const glm::vec3* maxs, size_t count, uint8_t* visible) const
+    {
+        pool.parallelFor(count, 1024, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+                visible[i] = testOne(mins[i], maxs[i]) ? 1 : 0;
+        });
+    }
+
+    int triangleCount() const { return (int)triangles.size(); }
+
+private:
+    struct Triangle
+    {
+        float x[3], y[3], z[3];
+        float zBase, zdx, zdy, zMin, zMax;
+        int tileX0, tileX1, tileY0, tileY1;
+    };
+
+    void clear()
+    {
+        std::fill(masks.begin(), masks.end(), 0u);
+        std::fill(zMax0.begin(), zMax0.end(), 1.0f);
+        std::fill(zMax1.begin(), zMax1.end(), 0.0f);
+    }
+
+    // Обновление тайла по правилу MOC: слой 1 сбрасывается, если треугольник
+    // сильно ближе накопленного, и переходит в слой 0, когда маска полна
+    void updateTile(size_t tile, uint32_t* mask, const uint32_t* coverage, float zTri)
+    {
+        float dist1t = zMax1[tile] - zTri;
+        float dist01 = zMax0[tile] - zMax1[tile];
+        if (dist1t > dist01)
+        {
+            zMax1[tile] = 0.0f;
+            std::memset(mask, 0, TILE_H * sizeof(uint32_t));
+        }
+
+        zMax1[tile] = std::max(zMax1[tile], zTri);
+        bool full = true;
+        for (int r = 0; r < TILE_H; ++r)
+        {
+            mask[r] |= coverage[r];
+            full = full && mask[r] == 0xFFFFFFFFu;
+        }
+        if (full)
+        {
+            zMax0[tile] = std::min(zMax0[tile], zMax1[tile]);
+            zMax1[tile] = 0.0f;
+            std::memset(mask, 0, TILE_H * sizeof(uint32_t));
+        }
+    }
+
+    // Дальняя точка треугольника в тайле: плоскость в углах, не дальше вершин
+    static float tileFarDepth(const Triangle& t, float x0, float y0)
+    {
+        float zx = t.zdx * (t.zdx > 0.0f ? x0 + TILE_W : x0);
+        float zy = t.zdy * (t.zdy > 0.0f ? y0 + TILE_H : y0);
+        return std::clamp(t.zBase + zx + zy, t.zMin, t.zMax);
+    }
+
+    void rasterizeRow(const Triangle& t, int row)
+    {
+        // Для каждой из восьми строк пикселей тайла — отрезок [start, end)
+        // по x: пересечение трёх полуплоскостей на высоте центра пикселя
+        alignas(32) int32_t start[TILE_H], end[TILE_H];
+#ifdef MID_OCCLUSION_AVX2
+        __m256 y = _mm256_add_ps(_mm256_set1_ps((float)(row * TILE_H) + 0.5f),
+                                 _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7));
+        __m256 left = _mm256_set1_ps(-1e9f), right = _mm256_set1_ps(1e9f);
+        for (int e = 0; e < 3; ++e)
+        {
+            int n = e == 2 ? 0 : e + 1;
+            float dx = t.x[n] - t.x[e], dy = t.y[n] - t.y[e];
+            __m256 rel = _mm256_sub_ps(y, _mm256_set1_ps(t.y[e]));
+            if (dy == 0.0f)
+            {
+                // Горизонтальное ребро: строка целиком внутри или снаружи
+                __m256 outside = _mm256_cmp_ps(_mm256_mul_ps(_mm256_set1_ps(dx), rel), _mm256_setzero_ps(), _CMP_LE_OQ);
+                left = _mm256_blendv_ps(left, _mm256_set1_ps(1e9f), outside);
+                continue;
+            }
+            __m256 cross = _mm256_fmadd_ps(rel, _mm256_set1_ps(dx / dy), _mm256_set1_ps(t.x[e]));
+            // Внутри при dy * (x - cross) < 0: dy < 0 — левая граница, иначе правая
+            if (dy < 0.0f)
+                left = _mm256_max_ps(left, cross);
+            else
+                right = _mm256_min_ps(right, cross);
+        }
+        __m256 half = _mm256_set1_ps(0.5f);
+        __m256 lo = _mm256_add_ps(_mm256_floor_ps(_mm256_sub_ps(left, half)), _mm256_set1_ps(1.0f));
+        __m256 hi = _mm256_ceil_ps(_mm256_sub_ps(right, half));
+        __m256 limit = _mm256_set1_ps((float)width);
+        lo = _mm256_min_ps(_mm256_max_ps(lo, _mm256_setzero_ps()), limit);
+        hi = _mm256_min_ps(_mm256_max_ps(hi, _mm256_setzero_ps()), limit);
+        __m256i startV = _mm256_cvtps_epi32(lo), endV = _mm256_cvtps_epi32(hi);
+        _mm256_store_si256((__m256i*)start, startV);
+        _mm256_store_si256((__m256i*)end, endV);
+#else
+        for (int r = 0; r < TILE_H; ++r)
+        {
+            float y = (float)(row * TILE_H + r) + 0.5f;
+            float left = -1e9f, right = 1e9f;
+            for (int e = 0; e < 3; ++e)
+            {
+                int n = e == 2 ? 0 : e + 1;
+                float dx = t.x[n] - t.x[e], dy = t.y[n] - t.y[e];
+                if (dy == 0.0f)
+                {
+                    if (dx * (y - t.y[e]) <= 0.0f)
+                        left = 1e9f;
+                    continue;
+                }
+                float cross = t.x[e] + (y - t.y[e]) * (dx / dy);
+                if (dy < 0.0f)
+                    left = std::max(left, cross);
+                else
+                    right = std::min(right, cross);
+            }
+            float lo = std::floor(left - 0.5f) + 1.0f, hi = std::ceil(right - 0.5f);
+            start[r] = (int32_t)std::clamp(lo, 0.0f, (float)width);
+            end[r] = (int32_t)std::clamp(hi, 0.0f, (float)width);
+        }
+#endif
+
+        for (int tx = t.tileX0; tx <= t.tileX1; ++tx)
+        {
+            alignas(32) uint32_t coverage[TILE_H];
+            int base = tx * TILE_W;
+#ifdef MID_OCCLUSION_AVX2
+            __m256i b = _mm256_set1_epi32(base), zero = _mm256_setzero_si256(), full = _mm256_set1_epi32(TILE_W);
+            __m256i s = _mm256_min_epi32(_mm256_max_epi32(_mm256_sub_epi32(_mm256_load_si256((const __m256i*)start), b), zero), full);
+            __m256i e = _mm256_min_epi32(_mm256_max_epi32(_mm256_sub_epi32(_mm256_load_si256((const __m256i*)end), b), zero), full);
+            // Сдвиг на 32 и больше даёт ноль — крайние случаи без ветвлений
+            __m256i ones = _mm256_set1_epi32(-1);
+            __m256i cov = _mm256_andnot_si256(_mm256_sllv_epi32(ones, e), _mm256_sllv_epi32(ones, s));
+            if (_mm256_testz_si256(cov, cov))
+                continue;
+            _mm256_store_si256((__m256i*)coverage, cov);
+#else
+            bool any = false;
+            for (int r = 0; r < TILE_H; ++r)
+            {
+                int s = std::clamp(start[r] - base, 0, TILE_W), e = std::clamp(end[r] - base, 0, TILE_W);
+                uint32_t fromS = s >= TILE_W ? 0u : 0xFFFFFFFFu << s;
+                uint32_t fromE = e >= TILE_W ? 0u : 0xFFFFFFFFu << e;
+                coverage[r] = fromS & ~fromE;
+                any = any || coverage[r];
+            }
+            if (!any)
+                continue;
+#endif
+            size_t tile = (size_t)row * stride + tx;
+            float zTri = tileFarDepth(t, (float)base, (float)(row * TILE_H));
+            updateTile(tile, &masks[tile * TILE_H], coverage, zTri);
+        }
+    }
+
+    bool testOne(const glm::vec3& mn, const glm::vec3& mx) const
+    {
+        // Восемь углов рамки — в clip-пространство
+        float minX, maxX, minY, maxY, minZ;
+#ifdef MID_OCCLUSION_AVX2
+        __m256 cx = _mm256_setr_ps(mn.x, mx.x, mn.x, mx.x, mn.x, mx.x, mn.x, mx.x);
+        __m256 cy = _mm256_setr_ps(mn.y, mn.y, mx.y, mx.y, mn.y, mn.y, mx.y, mx.y);
+        __m256 cz = _mm256_setr_ps(mn.z, mn.z, mn.z, mn.z, mx.z, mx.z, mx.z, mx.z);
+        auto row = [&](int r)
+        {
+            __m256 v = _mm256_fmadd_ps(cx, matrix[0][r], matrix[3][r]);
+            v = _mm256_fmadd_ps(cy, matrix[1][r], v);
+            return _mm256_fmadd_ps(cz, matrix[2][r], v);
+        };
+        __m256 w = row(3);
+        // Угол за ближней плоскостью — считаем видимым
+        if (_mm256_movemask_ps(_mm256_cmp_ps(w, _mm256_set1_ps(1e-3f), _CMP_LT_OQ)))
+            return true;
+        __m256 invW = _mm256_div_ps(_mm256_set1_ps(1.0f), w);
+        __m256 x = _mm256_mul_ps(row(0), invW), y = _mm256_mul_ps(row(1), invW), z = _mm256_mul_ps(row(2), invW);
+
+        auto hmin = [](__m256 v)
+        {
+            __m128 r = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+            r = _mm_min_ps(r, _mm_movehl_ps(r, r));
+            return _mm_cvtss_f32(_mm_min_ss(r, _mm_shuffle_ps(r, r, 1)));
+        };
+        auto hmax = [](__m256 v)
+        {
+            __m128 r = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+            r = _mm_max_ps(r, _mm_movehl_ps(r, r));
+            return _mm_cvtss_f32(_mm_max_ss(r, _mm_shuffle_ps(r, r, 1)));
+        };
+        minX = hmin(x);
+        maxX = hmax(x);
+        minY = hmin(y);
+        maxY = hmax(y);
+        minZ = hmin(z);
+#else
+        minX = minY = minZ = 1e30f;
+        maxX = maxY = -1e30f;
+        for (int i = 0; i < 8; ++i)
+        {
+            glm::vec4 c = viewProj * glm::vec4(i & 1 ? mx.x : mn.x, i & 2 ? mx.y : mn.y, i & 4 ? mx.z : mn.z, 1.0f);
+            if (c.w < 1e-3f)
+                return true;
+            glm::vec3 ndc = glm::vec3(c) / c.w;
+            minX = std::min(minX, ndc.x);
+            maxX = std::max(maxX, ndc.x);
+            minY = std::min(minY, ndc.y);
+            maxY = std::max(maxY, ndc.y);
+            minZ = std::min(minZ, ndc.z);
+        }
+#endif
+        if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f)
+            return false;   // вне экрана — отсечёт и пирамида
+        float depth = minZ * 0.5f + 0.5f;
+
+        int tx0 = std::clamp((int)((minX * 0.5f + 0.5f) * width) / TILE_W, 0, tilesX - 1);
+        int tx1 = std::clamp((int)((maxX * 0.5f + 0.5f) * width) / TILE_W, 0, tilesX - 1);
+        int ty0 = std::clamp((int)((minY * 0.5f + 0.5f) * height) / TILE_H, 0, tilesY - 1);
+        int ty1 = std::clamp((int)((maxY * 0.5f + 0.5f) * height) / TILE_H, 0, tilesY - 1);
+
+#ifdef MID_OCCLUSION_AVX2
+        // Строка тайлов выровнена до восьми: проверяем блоками, лишние дорожки маскируем
+        __m256 d = _mm256_set1_ps(depth);
+        int bx0 = tx0 & ~7;
+        for (int bx = bx0; bx <= tx1; bx += 8)
+        {
+            __m256i lane = _mm256_add_epi32(_mm256_set1_epi32(bx), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            __m256i inside = _mm256_andnot_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(tx0), lane),
+                                                 _mm256_cmpgt_epi32(_mm256_set1_epi32(tx1 + 1), lane));
+            int laneMask = _mm256_movemask_ps(_mm256_castsi256_ps(inside));
+            for (int ty = ty0; ty <= ty1; ++ty)
+            {
+                __m256 z0 = _mm256_loadu_ps(&zMax0[(size_t)ty * stride + bx]);
+                if (_mm256_movemask_ps(_mm256_cmp_ps(d, z0, _CMP_LT_OQ)) & laneMask)
+                    return true;
+            }
+        }
+#else
+        for (int ty = ty0; ty <= ty1; ++ty)
+        {
+            const float* z0 = &zMax0[(size_t)ty * stride];
+            for (int tx = tx0; tx <= tx1; ++tx)
+                if (depth < z0[tx])
+                    return true;
+        }
+#endif
+        return false;
+    }
+
+    ThreadPool& pool;
+    int width, height;
+    int tilesX, tilesY;
+    int stride;                     // тайлов в строке с выравниванием до восьми
+
+#ifdef MID_OCCLUSION_AVX2
+    __m256 matrix[4][4];            // viewProj, каждый элемент на все дорожки
+#endif
+
+    glm::mat4 viewProj = glm::mat4(1.0f);
+    std::vector<Triangle> triangles;
+
+    std::vector<uint32_t> masks;    // TILE_H строк по 32 бита на тайл
+    std::vector<float> zMax0;       // гарантированно закрыто дальше этого
+    std::vector<float> zMax1;       // рабочий слой под маской
+};
@@ -0,0 +1,903 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MID_PHYSICS_SSE2 1
+#endif
+
+#include "tasks.h"
+
+struct PhysicsSettings
+{
+    glm::vec3 gravity = glm::vec3(0.0f, -9.81f, 0.0f);
+    float timeStep = 1.0f / 60.0f;
+    int maxSubsteps = 3;            // больше шагов за кадр не догоняем: медленный кадр замедляет время
+    int iterations = 16;
+    float friction = 0.6f;
+    float contactMargin = 0.02f;    // зазор, при котором контакт уже создаётся (спекулятивный)
+    float slop = 0.005f;            // допустимое проникновение
+    float baumgarte = 0.2f;         // доля проникновения, выталкиваемая за шаг
+    float angularDamping = 0.05f;   // в секунду
+    float sleepLinear = 0.08f;      // м/с
+    float sleepAngular = 0.1f;      // рад/с
+    float sleepTime = 0.5f;         // секунд покоя всего острова до засыпания
+    float killHeight = -20.0f;      // упавшие ниже выключаются
+};
+
+struct PhysicsStats
+{
+    size_t bodies = 0;
+    size_t awake = 0;
+    size_t pairs = 0;               // за последний шаг
+    size_t contacts = 0;            // точек контакта
+    size_t islands = 0;
+    size_t largestIsland = 0;
+};
+
+// Твёрдые тела-коробки: ящики сцены и неподвижные препятствия. Шаг:
+// sweep and prune по x (порядок с прошлого шага досортировывается
+// вставками, проход — кусками на пуле, по четыре соседа за раз на SSE2),
+// затем box-box по теореме о разделяющей оси с отсечением грани и
+// последовательные импульсы с тёплым стартом. Тела, связанные контактами,
+// образуют острова; острова решаются параллельно, остров, простоявший
+// sleepTime, засыпает и не участвует в шагах, пока его не заденут.
+// Коробка — единичный куб [-0.5, 0.5]^3 с матрицей модели, как в
+// RenderBackend и инстансах мира, поэтому матрицы пишутся прямо в
+// инстанс-буфер.
+class PhysicsWorld
+{
+public:
+    explicit PhysicsWorld(ThreadPool& pool, const PhysicsSettings& settings = PhysicsSettings())
+        : settings(settings), pool(pool)
+    {
+    }
+
+    // Матрица — поворот, масштаб и сдвиг без перекоса; mass == 0 — неподвижная коробка.
+    // Возвращает номер тела, номера идут подряд.
+    uint32_t addBox(const glm::mat4& model, float mass, const glm::vec3& velocity = glm::vec3(0.0f))
+    {
+        Body b;
+        glm::mat3 r;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float length = glm::length(glm::vec3(model[axis]));
+            b.halfExtent[axis] = length * 0.5f;
+            r[axis] = glm::vec3(model[axis]) / std::max(length, 1e-12f);
+        }
+        b.position = glm::vec3(model[3]);
+        b.orientation = glm::normalize(glm::quat_cast(r));
+        if (mass > 0.0f)
+        {
+            glm::vec3 h2 = b.halfExtent * b.halfExtent;
+            b.invMass = 1.0f / mass;
+            b.invInertia = 3.0f / (mass * glm::vec3(h2.y + h2.z, h2.x + h2.z, h2.x + h2.y));
+            b.velocity = velocity;
+            b.awake = true;
+        }
+        updateDerived(b);
+        updateBounds(b);
+
+        bodies.push_back(b);
+        order.push_back((uint32_t)(bodies.size() - 1));
+        return (uint32_t)(bodies.size() - 1);
+    }
+
+    // Прошедшее время кадра: целые шаги settings.timeStep, остаток копится
+    void update(float frameTime)
+    {
+        accumulator += std::max(frameTime, 0.0f);
+        int steps = 0;
+        while (accumulator >= settings.timeStep && steps < settings.maxSubsteps)
+        {
+            step();
+            accumulator -= settings.timeStep;
+            ++steps;
+        }
+        if (steps == settings.maxSubsteps)
+            accumulator = 0.0f;
+    }
+
+    void step()
+    {
+        findPairs();
+        collide();
+        buildIslands();
+
+        pool.parallelFor(islands.size(), 4, [this](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+                solveIsland(islands[i]);
+        });
+
+        // Решённые контакты — тёплый старт следующего шага
+        cache.swap(manifolds);
+        manifolds.clear();
+    }
+
+    // Матрицы моделей тел [first, first + count), сдвинувшихся после прошлого вызова;
+    // запись i — по адресу out + i * stride байт (например, поле model в PackedInstance)
+    void writeModels(uint32_t first, size_t count, glm::mat4* out, size_t stride)
+    {
+        pool.parallelFor(count, 1024, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                Body& b = bodies[first + i];
+                if (!b.moved)
+                    continue;
+                *(glm::mat4*)((char*)out + i * stride) = model(b);
+                b.moved = false;
+            }
+        });
+    }
+
+    glm::mat4 model(uint32_t body) const { return model(bodies[body]); }
+    bool awake(uint32_t body) const { return bodies[body].awake; }
+    size_t size() const { return bodies.size(); }
+
+    PhysicsStats stats() const
+    {
+        PhysicsStats s;
+        s.bodies = bodies.size();
+        for (const Body& b : bodies)
+            s.awake += b.awake ? 1 : 0;
+        s.pairs = lastPairs;
+        s.contacts = lastContacts;
+        s.islands = islands.size();
+        for (const Island& island : islands)
+            s.largestIsland = std::max(s.largestIsland, (size_t)island.bodyCount);
+        return s;
+    }
+
+    PhysicsSettings settings;
+
+private:
+    struct Body
+    {
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::quat orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        glm::mat3 rotation = glm::mat3(1.0f);       // из orientation
+        glm::vec3 halfExtent = glm::vec3(0.5f);
+        glm::vec3 velocity = glm::vec3(0.0f);
+        glm::vec3 angularVelocity = glm::vec3(0.0f);
+        glm::vec3 pushVelocity = glm::vec3(0.0f);   // выталкивание из проникновения: только сдвигает,
+        glm::vec3 pushAngular = glm::vec3(0.0f);    // скорость телу не добавляет
+        float invMass = 0.0f;
+        glm::vec3 invInertia = glm::vec3(0.0f);     // в осях коробки
+        glm::mat3 invInertiaWorld = glm::mat3(0.0f);
+        glm::vec3 boundsMin = glm::vec3(0.0f), boundsMax = glm::vec3(0.0f);
+        float sleepTimer = 0.0f;
+        bool awake = false;                         // неподвижные всегда спят
+        bool enabled = true;
+        bool moved = true;                          // для writeModels
+    };
+
+    struct ContactPoint
+    {
+        glm::vec3 localA;                           // точка в осях тела a — узнать её на следующем шаге
+        glm::vec3 rA, rB;
+        float separation = 0.0f;                    // < 0 — проникновение
+        float normalImpulse = 0.0f;
+        float tangentImpulse[2] = {};
+        float normalMass = 0.0f;
+        float tangentMass[2] = {};
+        float target = 0.0f;                        // нужная скорость сближения по нормали
+        float bias = 0.0f;                          // скорость выталкивания
+        float pushImpulse = 0.0f;
+    };
+
+    struct Manifold
+    {
+        uint32_t a = 0, b = 0;                      // a < b
+        int count = 0;
+        glm::vec3 normal = glm::vec3(0.0f);         // от a к b
+        glm::vec3 tangent[2];
+        ContactPoint points[4];
+
+        uint64_t key() const { return (uint64_t)a << 32 | b; }
+    };
+
+    struct Island
+    {
+        uint32_t firstBody = 0, bodyCount = 0;
+        uint32_t firstManifold = 0, manifoldCount = 0;
+    };
+
+    static glm::mat4 model(const Body& b)
+    {
+        glm::mat4 m(1.0f);
+        for (int axis = 0; axis < 3; ++axis)
+            m[axis] = glm::vec4(b.rotation[axis] * (b.halfExtent[axis] * 2.0f), 0.0f);
+        m[3] = glm::vec4(b.position, 1.0f);
+        return m;
+    }
+
+    static void updateDerived(Body& b)
+    {
+        b.rotation = glm::mat3_cast(b.orientation);
+        glm::mat3 scaled = b.rotation;
+        for (int axis = 0; axis < 3; ++axis)
+            scaled[axis] *= b.invInertia[axis];
+        b.invInertiaWorld = scaled * glm::transpose(b.rotation);
+    }
+
+    // Рамка с запасом на зазор контакта и движение за шаг
+    void updateBounds(Body& b) const
+    {
+        glm::vec3 e = glm::abs(b.rotation[0]) * b.halfExtent.x + glm::abs(b.rotation[1]) * b.halfExtent.y
+            + glm::abs(b.rotation[2]) * b.halfExtent.z;
+        float dt = settings.timeStep;
+        float reach = settings.contactMargin;
+        if (b.invMass > 0.0f)
+            reach += (glm::length(b.velocity) + glm::length(settings.gravity) * dt) * dt;
+        b.boundsMin = b.position - e - reach;
+        b.boundsMax = b.position + e + reach;
+    }
+
+    // Sweep and prune: порядок по boundsMin.x живёт между шагами и почти
+    // отсортирован, так что вставки укладываются в линейное время. Пара нужна,
+    // если хоть одно тело не спит; сон и неподвижность сравниваются пакетом.
+    void findPairs()
+    {
+        pool.parallelFor(bodies.size(), 512, [this](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+                if (bodies[i].awake)
+                    updateBounds(bodies[i]);
+        });
+
+        order.erase(std::remove_if(order.begin(), order.end(), [this](uint32_t i) { return !bodies[i].enabled; }),
+                    order.end());
+        for (size_t i = 1; i < order.size(); ++i)
+        {
+            uint32_t index = order[i];
+            float x = bodies[index].boundsMin.x;
+            size_t j = i;
+            for (; j > 0 && bodies[order[j - 1]].boundsMin.x > x; --j)
+                order[j] = order[j - 1];
+            order[j] = index;
+        }
+
+        // Отсортированные рамки столбцами; хвост из четырёх пустых — чтобы
+        // проход читал по четыре без проверки конца
+        size_t n = order.size();
+        const float inf = std::numeric_limits<float>::infinity();
+        sortedMinX.assign(n + 4, inf);
+        sortedMaxX.assign(n + 4, -inf);
+        sortedMinY.assign(n + 4, inf);
+        sortedMaxY.assign(n + 4, -inf);
+        sortedMinZ.assign(n + 4, inf);
+        sortedMaxZ.assign(n + 4, -inf);
+        sortedAwake.assign(n + 4, 0);
+        for (size_t s = 0; s < n; ++s)
+        {
+            const Body& b = bodies[order[s]];
+            sortedMinX[s] = b.boundsMin.x;
+            sortedMaxX[s] = b.boundsMax.x;
+            sortedMinY[s] = b.boundsMin.y;
+            sortedMaxY[s] = b.boundsMax.y;
+            sortedMinZ[s] = b.boundsMin.z;
+            sortedMaxZ[s] = b.boundsMax.z;
+            sortedAwake[s] = b.awake ? ~0u : 0u;
+        }
+
+        const size_t grain = 256;
+        size_t chunks = (n + grain - 1) / grain;
+        chunkPairs.resize(chunks);
+        pool.parallelFor(n, grain, [this, grain](size_t begin, size_t end)
+        {
+            std::vector<std::pair<uint32_t, uint32_t>>& out = chunkPairs[begin / grain];
+            out.clear();
+            for (size_t s = begin; s < end; ++s)
+                sweep(s, out);
+        });
+
+        pairs.clear();
+        for (const auto& chunk : chunkPairs)
+            pairs.insert(pairs.end(), chunk.begin(), chunk.end());
+        lastPairs = pairs.size();
+    }
+
+    // Соседи s справа, пока их рамки начинаются левее конца рамки s
+    void sweep(size_t s, std::vector<std::pair<uint32_t, uint32_t>>& out) const
+    {
+        auto emit = [&](size_t other)
+        {
+            uint32_t a = order[s], b = order[other];
+            out.push_back(a < b ? std::make_pair(a, b) : std::make_pair(b, a));
+        };
+        bool selfAwake = sortedAwake[s] != 0;
+        size_t j = s + 1;
+#ifdef MID_PHYSICS_SSE2
+        __m128 maxX = _mm_set1_ps(sortedMaxX[s]);
+        __m128 minY = _mm_set1_ps(sortedMinY[s]), maxY = _mm_set1_ps(sortedMaxY[s]);
+        __m128 minZ = _mm_set1_ps(sortedMinZ[s]), maxZ = _mm_set1_ps(sortedMaxZ[s]);
+        __m128 self = selfAwake ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : _mm_setzero_ps();
+        for (;; j += 4)
+        {
+            // Порядок по minX: попавшие в диапазон соседи идут подряд с начала
+            int inRange = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(&sortedMinX[j]), maxX));
+            if (inRange == 0)
+                break;
+            __m128 overlap = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&sortedMinY[j]), maxY),
+                                        _mm_cmpge_ps(_mm_loadu_ps(&sortedMaxY[j]), minY));
+            overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&sortedMinZ[j]), maxZ),
+                                                     _mm_cmpge_ps(_mm_loadu_ps(&sortedMaxZ[j]), minZ)));
+            __m128 wanted = _mm_or_ps(self, _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)&sortedAwake[j])));
+            int hits = _mm_movemask_ps(_mm_and_ps(overlap, wanted)) & inRange;
+            for (int lane = 0; hits != 0; ++lane, hits >>= 1)
+                if (hits & 1)
+                    emit(j + lane);
+            if (inRange != 0xF)
+                break;
+        }
+#else
+        for (; sortedMinX[j] <= sortedMaxX[s]; ++j)
+        {
+            if (sortedMinY[j] > sortedMaxY[s] || sortedMaxY[j] < sortedMinY[s]
+                || sortedMinZ[j] > sortedMaxZ[s] || sortedMaxZ[j] < sortedMinZ[s])
+                continue;
+            if (selfAwake || sortedAwake[j] != 0)
+                emit(j);
+        }
+#endif
+    }
+
+    void collide()
+    {
+        manifolds.resize(pairs.size());
+        pool.parallelFor(pairs.size(), 64, [this](size_t begin, size_t end)
+        {
+            for (size_t k = begin; k < end; ++k)
+            {
+                Manifold& m = manifolds[k];
+                m.a = pairs[k].first;
+                m.b = pairs[k].second;
+                const Body& a = bodies[m.a];
+                const Body& b = bodies[m.b];
+                float dt = settings.timeStep;
+                float reach = settings.contactMargin
+                    + (glm::length(b.velocity - a.velocity) + glm::length(settings.gravity) * dt) * dt;
+                m.count = collideBoxes(a, b, reach, m);
+                if (m.count > 0)
+                    warmStart(m);
+            }
+        });
+
+        manifolds.erase(std::remove_if(manifolds.begin(), manifolds.end(), [](const Manifold& m) { return m.count == 0; }),
+                        manifolds.end());
+        std::sort(manifolds.begin(), manifolds.end(), [](const Manifold& x, const Manifold& y) { return x.key() < y.key(); });
+        lastContacts = 0;
+        for (const Manifold& m : manifolds)
+            lastContacts += (size_t)m.count;
+    }
+
+    // Импульсы точек, узнанных по положению в осях тела a, из прошлого шага
+    void warmStart(Manifold& m) const
+    {
+        auto it = std::lower_bound(cache.begin(), cache.end(), m.key(),
+                                   [](const Manifold& c, uint64_t key) { return c.key() < key; });
+        if (it == cache.end() || it->key() != m.key() || glm::dot(it->normal, m.normal) < 0.95f)
+            return;
+        const float match = 0.02f * 0.02f;
+        for (int i = 0; i < m.count; ++i)
+            for (int k = 0; k < it->count; ++k)
+            {
+                glm::vec3 d = m.points[i].localA - it->points[k].localA;
+                if (glm::dot(d, d) > match)
+                    continue;
+                m.points[i].normalImpulse = it->points[k].normalImpulse;
+                m.points[i].tangentImpulse[0] = it->points[k].tangentImpulse[0];
+                m.points[i].tangentImpulse[1] = it->points[k].tangentImpulse[1];
+                break;
+            }
+    }
+
+    static glm::vec3 rotl(const glm::vec3& v) { return glm::vec3(v.y, v.z, v.x); } // [j] = v[(j + 1) % 3]
+    static glm::vec3 rotr(const glm::vec3& v) { return glm::vec3(v.z, v.x, v.y); } // [j] = v[(j + 2) % 3]
+
+    static int maxIndex(const glm::vec3& v)
+    {
+        return v.x >= v.y ? (v.x >= v.z ? 0 : 2) : (v.y >= v.z ? 1 : 2);
+    }
+
+    // Теорема о разделяющей оси для двух коробок: 3 + 3 оси граней и 9
+    // рёберных, каждая тройка — одним выражением над vec3. Предпочтение —
+    // граням (отсечение даёт до четырёх точек), ребро берётся, только если
+    // заметно лучше. Точки с зазором до reach остаются спекулятивными.
+    int collideBoxes(const Body& a, const Body& b, float reach, Manifold& m) const
+    {
+        const glm::mat3& ra = a.rotation;
+        const glm::mat3& rb = b.rotation;
+        glm::vec3 d = b.position - a.position;
+        glm::mat3 c = glm::transpose(ra) * rb;          // c[j][i] = dot(a_i, b_j)
+        glm::mat3 absC;
+        for (int j = 0; j < 3; ++j)
+            absC[j] = glm::abs(c[j]) + 1e-6f;
+        glm::vec3 ta = glm::transpose(ra) * d;          // d в осях a
+        glm::vec3 tb = glm::transpose(rb) * d;          // d в осях b
+
+        glm::vec3 faceA = glm::abs(ta) - (a.halfExtent + absC * b.halfExtent);
+        glm::vec3 faceB = glm::abs(tb) - (b.halfExtent + glm::transpose(absC) * a.halfExtent);
+        int axisA = maxIndex(faceA), axisB = maxIndex(faceB);
+        float sepA = faceA[axisA], sepB = faceB[axisB];
+        if (sepA > reach || sepB > reach)
+            return 0;
+
+        // Оси a_i x b_j: строки c по j для каждого i
+        glm::mat3 rows = glm::transpose(c), absRows = glm::transpose(absC);
+        float sepEdge = -std::numeric_limits<float>::infinity();
+        int edgeI = 0, edgeJ = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+            glm::vec3 dist = glm::abs(ta[i2] * rows[i1] - ta[i1] * rows[i2]);
+            glm::vec3 radiusA = a.halfExtent[i1] * absRows[i2] + a.halfExtent[i2] * absRows[i1];
+            glm::vec3 radiusB = rotl(b.halfExtent) * rotr(absRows[i]) + rotr(b.halfExtent) * rotl(absRows[i]);
+            glm::vec3 lengthSq = glm::max(1.0f - rows[i] * rows[i], glm::vec3(0.0f));
+            glm::vec3 sep = (dist - radiusA - radiusB) / glm::sqrt(glm::max(lengthSq, glm::vec3(1e-12f)));
+            for (int j = 0; j < 3; ++j)
+            {
+                if (lengthSq[j] < 1e-6f)
+                    continue; // почти параллельные рёбра — ось вырождена, её заменяют грани
+                if (sep[j] > reach)
+                    return 0;
+                if (sep[j] > sepEdge)
+                {
+                    sepEdge = sep[j];
+                    edgeI = i;
+                    edgeJ = j;
+                }
+            }
+        }
+
+        const float relative = 0.95f, absolute = 0.01f;
+        bool referenceA = sepB <= relative * sepA + absolute;
+        float sepFace = referenceA ? sepA : sepB;
+        if (sepEdge > relative * sepFace + absolute)
+            return edgeContact(a, b, edgeI, edgeJ, m);
+
+        if (referenceA)
+        {
+            glm::vec3 n = ra[axisA] * (ta[axisA] >= 0.0f ? 1.0f : -1.0f);
+            m.normal = n;
+            return faceContact(a, axisA, n, b, reach, m, false);
+        }
+        glm::vec3 n = rb[axisB] * (tb[axisB] >= 0.0f ? -1.0f : 1.0f);  // от b к a
+        m.normal = -n;
+        return faceContact(b, axisB, n, a, reach, m, true);
+    }
+
+    // Грань ref с нормалью n (наружу, к inc) и самая встречная грань inc:
+    // четырёхугольник inc отсекается боковыми плоскостями грани ref
+    int faceContact(const Body& ref, int axis, const glm::vec3& n, const Body& inc, float reach,
+                    Manifold& m, bool flipped) const
+    {
+        glm::vec3 along = glm::abs(glm::transpose(inc.rotation) * n);
+        int k = maxIndex(along);
+        glm::vec3 incNormal = inc.rotation[k] * (glm::dot(inc.rotation[k], n) > 0.0f ? -1.0f : 1.0f);
+        int k1 = (k + 1) % 3, k2 = (k + 2) % 3;
+        glm::vec3 center = inc.position + incNormal * inc.halfExtent[k];
+        glm::vec3 u = inc.rotation[k1] * inc.halfExtent[k1];
+        glm::vec3 v = inc.rotation[k2] * inc.halfExtent[k2];
+
+        glm::vec3 polygon[8] = { center + u + v, center - u + v, center - u - v, center + u - v };
+        glm::vec3 clipped[8];
+        int count = 4;
+
+        int a1 = (axis + 1) % 3, a2 = (axis + 2) % 3;
+        const glm::vec3 sides[4] = { ref.rotation[a1], -ref.rotation[a1], ref.rotation[a2], -ref.rotation[a2] };
+        const float limits[4] = { ref.halfExtent[a1], ref.halfExtent[a1], ref.halfExtent[a2], ref.halfExtent[a2] };
+        for (int plane = 0; plane < 4 && count > 0; ++plane)
+        {
+            // Sutherland–Hodgman по плоскости dot(side, p - ref.position) <= limit
+            int out = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                const glm::vec3& p = polygon[i];
+                const glm::vec3& q = polygon[(i + 1) % count];
+                float dp = glm::dot(sides[plane], p - ref.position) - limits[plane];
+                float dq = glm::dot(sides[plane], q - ref.position) - limits[plane];
+                if (dp <= 0.0f)
+                    clipped[out++] = p;
+                // Вершина ровно на плоскости уже оставлена — второй раз её не добавляем
+                if (((dp < 0.0f && dq > 0.0f) || (dp > 0.0f && dq < 0.0f)) && out < 8)
+                    clipped[out++] = p + (q - p) * (dp / (dp - dq));
+            }
+            count = out;
+            std::copy(clipped, clipped + count, polygon);
+        }
+
+        glm::vec3 faceCenter = ref.position + n * ref.halfExtent[axis];
+        glm::vec3 points[8];
+        float separations[8];
+        int kept = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            float s = glm::dot(n, polygon[i] - faceCenter);
+            if (s > reach)
+                continue;
+            points[kept] = polygon[i] - n * (s * 0.5f);
+            separations[kept++] = s;
+        }
+        kept = reduceContacts(points, separations, kept);
+
+        const Body& a = flipped ? inc : ref;
+        const Body& b = flipped ? ref : inc;
+        for (int i = 0; i < kept; ++i)
+            setPoint(a, b, points[i], separations[i], m.points[i]);
+        return kept;
+    }
+
+    // Больше четырёх точек не нужно: самая глубокая, самая далёкая от неё,
+    // затем две, дающие наибольшую площадь
+    static int reduceContacts(glm::vec3* points, float* separations, int count)
+    {
+        if (count <= 4)
+            return count;
+        int chosen[4];
+        chosen[0] = 0;
+        for (int i = 1; i < count; ++i)
+            if (separations[i] < separations[chosen[0]])
+                chosen[0] = i;
+
+        auto best = [&](auto score)
+        {
+            int index = -1;
+            float value = -1.0f;
+            for (int i = 0; i < count; ++i)
+            {
+                float s = score(points[i]);
+                if (s > value)
+                {
+                    value = s;
+                    index = i;
+                }
+            }
+            return index;
+        };
+        const glm::vec3 p0 = points[chosen[0]];
+        chosen[1] = best([&](const glm::vec3& p) { return glm::dot(p - p0, p - p0); });
+        const glm::vec3 p1 = points[chosen[1]];
+        chosen[2] = best([&](const glm::vec3& p) { return glm::length(glm::cross(p - p0, p - p1)); });
+        const glm::vec3 p2 = points[chosen[2]];
+        chosen[3] = best([&](const glm::vec3& p)
+        {
+            return glm::length(glm::cross(p - p0, p - p1)) + glm::length(glm::cross(p - p1, p - p2))
+                + glm::length(glm::cross(p - p2, p - p0));
+        });
+
+        glm::vec3 outPoints[4];
+        float outSeparations[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            outPoints[i] = points[chosen[i]];
+            outSeparations[i] = separations[chosen[i]];
+        }
+        std::copy(outPoints, outPoints + 4, points);
+        std::copy(outSeparations, outSeparations + 4, separations);
+        return 4;
+    }
+
+    // Ребро a вдоль a_i и ребро b вдоль b_j, опорные по нормали: одна точка
+    // посередине между ближайшими точками отрезков
+    int edgeContact(const Body& a, const Body& b, int i, int j, Manifold& m) const
+    {
+        glm::vec3 d = b.position - a.position;
+        glm::vec3 n = glm::normalize(glm::cross(a.rotation[i], b.rotation[j]));
+        if (glm::dot(n, d) < 0.0f)
+            n = -n;
+
+        glm::vec3 ca = a.position, cb = b.position;
+        for (int k = 0; k < 3; ++k)
+        {
+            if (k != i)
+                ca += a.rotation[k] * (a.halfExtent[k] * (glm::dot(a.rotation[k], n) >= 0.0f ? 1.0f : -1.0f));
+            if (k != j)
+                cb += b.rotation[k] * (b.halfExtent[k] * (glm::dot(b.rotation[k], n) >= 0.0f ? -1.0f : 1.0f));
+        }
+
+        glm::vec3 ea = a.rotation[i], eb = b.rotation[j];
+        glm::vec3 r = ca - cb;
+        float along = glm::dot(ea, eb);
+        float denom = std::max(1.0f - along * along, 1e-6f);
+        float s = (along * glm::dot(eb, r) - glm::dot(ea, r)) / denom;
+        s = glm::clamp(s, -a.halfExtent[i], a.halfExtent[i]);
+        float t = glm::clamp(glm::dot(eb, ca + ea * s - cb), -b.halfExtent[j], b.halfExtent[j]);
+        glm::vec3 pa = ca + ea * s, pb = cb + eb * t;
+
+        m.normal = n;
+        setPoint(a, b, (pa + pb) * 0.5f, glm::dot(pb - pa, n), m.points[0]);
+        return 1;
+    }
+
+    static void setPoint(const Body& a, const Body& b, const glm::vec3& p, float separation, ContactPoint& c)
+    {
+        c = ContactPoint();
+        c.rA = p - a.position;
+        c.rB = p - b.position;
+        c.localA = glm::transpose(a.rotation) * c.rA;
+        c.separation = separation;
+    }
+
+    // Острова: тела, связанные контактами, через объединение множеств.
+    // Неподвижные тела острова не связывают — их читают все острова сразу.
+    // Спящее тело, которого коснулось бодрствующее, попадает в его остров и просыпается.
+    void buildIslands()
+    {
+        size_t n = bodies.size();
+        parent.resize(n);
+        for (size_t i = 0; i < n; ++i)
+            parent[i] = (uint32_t)i;
+        for (const Manifold& m : manifolds)
+            if (bodies[m.a].invMass > 0.0f && bodies[m.b].invMass > 0.0f)
+                unite(m.a, m.b);
+
+        islandOf.assign(n, ~0u);
+        islands.clear();
+        std::vector<uint32_t>& bodyIsland = islandScratch;
+        bodyIsland.assign(n, ~0u);
+        auto assign = [&](uint32_t body)
+        {
+            if (bodyIsland[body] != ~0u)
+                return;
+            uint32_t root = find(body);
+            if (islandOf[root] == ~0u)
+            {
+                islandOf[root] = (uint32_t)islands.size();
+                islands.push_back(Island());
+            }
+            bodyIsland[body] = islandOf[root];
+            ++islands[bodyIsland[body]].bodyCount;
+        };
+        for (uint32_t i = 0; i < n; ++i)
+            if (bodies[i].awake && bodies[i].enabled)
+                assign(i);
+        for (const Manifold& m : manifolds)
+        {
+            if (bodies[m.a].invMass > 0.0f)
+                assign(m.a);
+            if (bodies[m.b].invMass > 0.0f)
+                assign(m.b);
+        }
+        for (const Manifold& m : manifolds)
+            ++islands[bodyIsland[bodies[m.a].invMass > 0.0f ? m.a : m.b]].manifoldCount;
+
+        // Списки тел и контактов островов подряд, по подсчёту
+        uint32_t bodyOffset = 0, manifoldOffset = 0;
+        for (Island& island : islands)
+        {
+            island.firstBody = bodyOffset;
+            island.firstManifold = manifoldOffset;
+            bodyOffset += island.bodyCount;
+            manifoldOffset += island.manifoldCount;
+            island.bodyCount = 0;
+            island.manifoldCount = 0;
+        }
+        islandBodies.resize(bodyOffset);
+        islandManifolds.resize(manifoldOffset);
+        for (uint32_t i = 0; i < n; ++i)
+            if (bodyIsland[i] != ~0u)
+            {
+                Island& island = islands[bodyIsland[i]];
+                islandBodies[island.firstBody + island.bodyCount++] = i;
+            }
+        for (uint32_t k = 0; k < manifolds.size(); ++k)
+        {
+            const Manifold& m = manifolds[k];
+            Island& island = islands[bodyIsland[bodies[m.a].invMass > 0.0f ? m.a : m.b]];
+            islandManifolds[island.firstManifold + island.manifoldCount++] = k;
+        }
+
+        // Крупные острова — первыми, чтобы не достались последнему потоку
+        std::sort(islands.begin(), islands.end(),
+                  [](const Island& x, const Island& y) { return x.bodyCount > y.bodyCount; });
+    }
+
+    uint32_t find(uint32_t i)
+    {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    }
+
+    void unite(uint32_t x, uint32_t y)
+    {
+        x = find(x);
+        y = find(y);
+        if (x != y)
+            parent[std::max(x, y)] = std::min(x, y);
+    }
+
+    // Остров целиком на одном потоке: тела других островов он не трогает,
+    // неподвижные только читает
+    void solveIsland(const Island& island)
+    {
+        float dt = settings.timeStep;
+        float invDt = 1.0f / dt;
+        const uint32_t* bodyList = &islandBodies[island.firstBody];
+        const uint32_t* manifoldList = island.manifoldCount ? &islandManifolds[island.firstManifold] : nullptr;
+
+        float damping = std::max(0.0f, 1.0f - settings.angularDamping * dt);
+        for (uint32_t k = 0; k < island.bodyCount; ++k)
+        {
+            Body& b = bodies[bodyList[k]];
+            if (!b.awake)
+            {
+                b.awake = true;
+                b.sleepTimer = 0.0f;
+            }
+            b.velocity += settings.gravity * dt;
+            b.angularVelocity *= damping;
+        }
+
+        for (uint32_t k = 0; k < island.manifoldCount; ++k)
+            prepare(manifolds[manifoldList[k]], invDt);
+        for (int iteration = 0; iteration < settings.iterations; ++iteration)
+            for (uint32_t k = 0; k < island.manifoldCount; ++k)
+                solve(manifolds[manifoldList[k]]);
+
+        float linear2 = settings.sleepLinear * settings.sleepLinear;
+        float angular2 = settings.sleepAngular * settings.sleepAngular;
+        float minTimer = std::numeric_limits<float>::max();
+        for (uint32_t k = 0; k < island.bodyCount; ++k)
+        {
+            Body& b = bodies[bodyList[k]];
+            b.position += (b.velocity + b.pushVelocity) * dt;
+            glm::vec3 w = b.angularVelocity + b.pushAngular;
+            glm::quat spin(0.0f, w.x, w.y, w.z);
+            b.orientation = glm::normalize(b.orientation + spin * b.orientation * (0.5f * dt));
+            b.pushVelocity = b.pushAngular = glm::vec3(0.0f);
+            updateDerived(b);
+            b.moved = true;
+
+            if (b.position.y < settings.killHeight)
+            {
+                b.enabled = false;
+                b.awake = false;
+                b.velocity = b.angularVelocity = glm::vec3(0.0f);
+            }
+            if (glm::dot(b.velocity, b.velocity) > linear2 || glm::dot(b.angularVelocity, b.angularVelocity) > angular2)
+                b.sleepTimer = 0.0f;
+            else
+                b.sleepTimer += dt;
+            minTimer = std::min(minTimer, b.enabled ? b.sleepTimer : std::numeric_limits<float>::max());
+        }
+
+        if (minTimer >= settings.sleepTime)
+            for (uint32_t k = 0; k < island.bodyCount; ++k)
+            {
+                Body& b = bodies[bodyList[k]];
+                b.awake = false;
+                b.velocity = b.angularVelocity = glm::vec3(0.0f);
+            }
+    }
+
+    static float effectiveMass(const Body& a, const Body& b, const glm::vec3& rA, const glm::vec3& rB, const glm::vec3& axis)
+    {
+        glm::vec3 ca = glm::cross(rA, axis), cb = glm::cross(rB, axis);
+        float k = a.invMass + b.invMass + glm::dot(ca, a.invInertiaWorld * ca) + glm::dot(cb, b.invInertiaWorld * cb);
+        return k > 0.0f ? 1.0f / k : 0.0f;
+    }
+
+    // Статичные тела общие для островов, решаемых параллельно: в них
+    // только читаем, иначе запись нулей стала бы гонкой
+    static void applyImpulse(Body& a, Body& b, const ContactPoint& c, const glm::vec3& impulse)
+    {
+        if (a.invMass > 0.0f)
+        {
+            a.velocity -= impulse * a.invMass;
+            a.angularVelocity -= a.invInertiaWorld * glm::cross(c.rA, impulse);
+        }
+        if (b.invMass > 0.0f)
+        {
+            b.velocity += impulse * b.invMass;
+            b.angularVelocity += b.invInertiaWorld * glm::cross(c.rB, impulse);
+        }
+    }
+
+    static glm::vec3 relativeVelocity(const Body& a, const Body& b, const ContactPoint& c)
+    {
+        return b.velocity + glm::cross(b.angularVelocity, c.rB) - a.velocity - glm::cross(a.angularVelocity, c.rA);
+    }
+
+    // Массы по направлениям, нужная скорость по нормали и тёплый старт.
+    // Зазор s > 0 разрешает сблизиться ровно на s за шаг (спекулятивный
+    // контакт, без проскоков). Проникновение глубже slop выталкивается
+    // долей baumgarte за шаг отдельным импульсом (split impulse): иначе
+    // в глубокой куче выталкивание превращается в скорость и куча не засыпает.
+    void prepare(Manifold& m, float invDt)
+    {
+        Body& a = bodies[m.a];
+        Body& b = bodies[m.b];
+        glm::vec3 helper = std::fabs(m.normal.x) < 0.57f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        m.tangent[0] = glm::normalize(glm::cross(m.normal, helper));
+        m.tangent[1] = glm::cross(m.normal, m.tangent[0]);
+
+        for (int i = 0; i < m.count; ++i)
+        {
+            ContactPoint& c = m.points[i];
+            c.normalMass = effectiveMass(a, b, c.rA, c.rB, m.normal);
+            c.tangentMass[0] = effectiveMass(a, b, c.rA, c.rB, m.tangent[0]);
+            c.tangentMass[1] = effectiveMass(a, b, c.rA, c.rB, m.tangent[1]);
+            c.target = c.separation > 0.0f ? -c.separation * invDt : 0.0f;
+            c.bias = settings.baumgarte * invDt * std::max(-c.separation - settings.slop, 0.0f);
+            c.pushImpulse = 0.0f;
+            applyImpulse(a, b, c, m.normal * c.normalImpulse + m.tangent[0] * c.tangentImpulse[0]
+                                      + m.tangent[1] * c.tangentImpulse[1]);
+        }
+    }
+
+    void solve(Manifold& m)
+    {
+        Body& a = bodies[m.a];
+        Body& b = bodies[m.b];
+        for (int i = 0; i < m.count; ++i)
+        {
+            ContactPoint& c = m.points[i];
+
+            // Трение — в пределах конуса от текущего нормального импульса
+            float limit = settings.friction * c.normalImpulse;
+            for (int t = 0; t < 2; ++t)
+            {
+                float vt = glm::dot(relativeVelocity(a, b, c), m.tangent[t]);
+                float old = c.tangentImpulse[t];
+                c.tangentImpulse[t] = glm::clamp(old - vt * c.tangentMass[t], -limit, limit);
+                applyImpulse(a, b, c, m.tangent[t] * (c.tangentImpulse[t] - old));
+            }
+
+            float vn = glm::dot(relativeVelocity(a, b, c), m.normal);
+            float old = c.normalImpulse;
+            c.normalImpulse = std::max(old + (c.target - vn) * c.normalMass, 0.0f);
+            applyImpulse(a, b, c, m.normal * (c.normalImpulse - old));
+
+            if (c.bias > 0.0f || c.pushImpulse > 0.0f)
+            {
+                glm::vec3 dv = b.pushVelocity + glm::cross(b.pushAngular, c.rB) - a.pushVelocity - glm::cross(a.pushAngular, c.rA);
+                float oldPush = c.pushImpulse;
+                c.pushImpulse = std::max(oldPush + (c.bias - glm::dot(dv, m.normal)) * c.normalMass, 0.0f);
+                glm::vec3 push = m.normal * (c.pushImpulse - oldPush);
+                if (a.invMass > 0.0f)
+                {
+                    a.pushVelocity -= push * a.invMass;
+                    a.pushAngular -= a.invInertiaWorld * glm::cross(c.rA, push);
+                }
+                if (b.invMass > 0.0f)
+                {
+                    b.pushVelocity += push * b.invMass;
+                    b.pushAngular += b.invInertiaWorld * glm::cross(c.rB, push);
+                }
+            }
+        }
+    }
+
+    ThreadPool& pool;
+    std::vector<Body> bodies;
+    std::vector<uint32_t> order;                    // тела по boundsMin.x
+    float accumulator = 0.0f;
+
+    std::vector<float> sortedMinX, sortedMaxX, sortedMinY, sortedMaxY, sortedMinZ, sortedMaxZ;
+    std::vector<uint32_t> sortedAwake;
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> chunkPairs;
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    std::vector<Manifold> manifolds, cache;         // cache — контакты прошлого шага по key()
+
+    std::vector<uint32_t> parent, islandOf, islandScratch;
+    std::vector<Island> islands;
+    std::vector<uint32_t> islandBodies, islandManifolds;
+
+    size_t lastPairs = 0, lastContacts = 0;
+};
@@ -0,0 +1,383 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// Полноэкранный треугольник без вершинного буфера: вершины из gl_VertexID
+inline const char* POST_VS = R"(#version 330 core
+out vec2 vUV;
+void main()
+{
+    vec2 p = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    vUV = p;
+    gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+// Уменьшение вдвое фильтром из 13 выборок (Jimenez 2014): центральный
+// квадрат и четыре угловых. На первом шаге — мягкий порог и усреднение по
+// Карису, чтобы одиночные яркие пиксели не мерцали пятнами.
+inline const char* BLOOM_DOWNSAMPLE_FS = R"(#version 330 core
+in vec2 vUV;
+out vec3 FragColor;
+uniform sampler2D uSource;
+uniform vec2 uTexel;        // 1 / размер источника
+uniform int uPrefilter;
+uniform vec4 uThreshold;    // порог, порог - колено, 2 * колено, 0.25 / колено
+
+vec3 S(float x, float y) { return texture(uSource, vUV + uTexel * vec2(x, y)).rgb; }
+
+vec3 prefilter(vec3 c)
+{
+    float bright = max(c.r, max(c.g, c.b));
+    float knee = clamp(bright - uThreshold.y, 0.0, uThreshold.z);
+    knee = uThreshold.w * knee * knee;
+    return c * max(knee, bright - uThreshold.x) / max(bright, 1e-4);
+}
+
+void main()
+{
+    vec3 a = S(-2.0, 2.0), b = S(0.0, 2.0), c = S(2.0, 2.0);
+    vec3 d = S(-2.0, 0.0), e = S(0.0, 0.0), f = S(2.0, 0.0);
+    vec3 g = S(-2.0, -2.0), h = S(0.0, -2.0), i = S(2.0, -2.0);
+    vec3 j = S(-1.0, 1.0), k = S(1.0, 1.0), l = S(-1.0, -1.0), m = S(1.0, -1.0);
+
+    vec3 boxes[5] = vec3[5]((j + k + l + m) * 0.25, (a + b + d + e) * 0.25, (b + c + e + f) * 0.25,
+                            (d + e + g + h) * 0.25, (e + f + h + i) * 0.25);
+    float weights[5] = float[5](0.5, 0.125, 0.125, 0.125, 0.125);
+    vec3 sum = vec3(0.0);
+    float total = 0.0;
+    for (int n = 0; n < 5; ++n)
+    {
+        vec3 box = boxes[n];
+        float w = weights[n];
+        if (uPrefilter != 0)
+        {
+            box = prefilter(box);
+            w /= 1.0 + dot(box, vec3(0.2126, 0.7152, 0.0722));
+        }
+        sum += box * w;
+        total += w;
+    }
+    FragColor = sum / total;
+}
+)";
+
+// Увеличение вдвое шатром 3x3; результат добавляется смешиванием ONE, ONE
+// к уже уменьшенному уровню
+inline const char* BLOOM_UPSAMPLE_FS = R"(#version 330 core
+in vec2 vUV;
+out vec3 FragColor;
+uniform sampler2D uSource;
+uniform vec2 uTexel;        // 1 / размер источника
+
+vec3 S(float x, float y) { return texture(uSource, vUV + uTexel * vec2(x, y)).rgb; }
+
+void main()
+{
+    vec3 sum = S(0.0, 0.0) * 4.0;
+    sum += (S(-1.0, 0.0) + S(1.0, 0.0) + S(0.0, -1.0) + S(0.0, 1.0)) * 2.0;
+    sum += S(-1.0, -1.0) + S(1.0, -1.0) + S(-1.0, 1.0) + S(1.0, 1.0);
+    FragColor = sum / 16.0;
+}
+)";
+
+// Свечение, экспозиция, тонмаппинг, цветокоррекция и дизеринг — одним
+// проходом: кадр читается один раз и сразу пишется в 8 бит окна
+inline const char* POST_FINAL_FS = R"(#version 330 core
+in vec2 vUV;
+out vec4 FragColor;
+uniform sampler2D uScene;
+uniform sampler2D uBloom;
+uniform float uBloomIntensity;
+uniform float uExposure;
+uniform float uContrast;
+uniform float uSaturation;
+uniform vec3 uLift;
+uniform vec3 uGamma;
+uniform vec3 uGain;
+uniform float uFrame;
+
+// Кривая ACES (Narkowicz 2015) по наибольшему каналу: цвета сцены заданы
+// сразу для экрана, и поканальная кривая выбеливала бы небо
+vec3 tonemap(vec3 x)
+{
+    float peak = max(x.r, max(x.g, x.b));
+    float mapped = clamp(peak * (2.51 * peak + 0.03) / (peak * (2.43 * peak + 0.59) + 0.14), 0.0, 1.0);
+    return x * (mapped / max(peak, 1e-4));
+}
+
+float hash(vec2 p)
+{
+    vec3 q = fract(vec3(p.xyx) * 0.1031);
+    q += dot(q, q.yzx + 33.33);
+    return fract((q.x + q.y) * q.z);
+}
+
+void main()
+{
+    vec3 c = texture(uScene, vUV).rgb + texture(uBloom, vUV).rgb * uBloomIntensity;
+    c = tonemap(c * uExposure);
+
+    c = uGain * (c + uLift * (1.0 - c));
+    c = pow(max(c, vec3(0.0)), 1.0 / uGamma);
+    float luma = dot(c, vec3(0.2126, 0.7152, 0.0722));
+    c = mix(vec3(luma), c, uSaturation);
+    c = (c - 0.5) * uContrast + 0.5;
+
+    // Треугольный шум в ±1 шаг 8 бит: на небе и в свечении нет полос
+    vec2 p = gl_FragCoord.xy + vec2(47.0, 17.0) * uFrame;
+    c += (hash(p) + hash(p + 71.3) - 1.0) / 255.0;
+    FragColor = vec4(c, 1.0);
+}
+)";
+
+// Программы цепочки; собираются вместе с остальными (makeProgramAsync)
+struct PostPrograms
+{
+    GLuint downsample = 0, upsample = 0, final = 0;
+};
+
+struct PostSettings
+{
+    float bloomThreshold = 1.0f;
+    float bloomKnee = 0.5f;
+    float bloomIntensity = 0.15f;
+    float exposure = 0.8f;
+    float contrast = 1.05f;
+    float saturation = 1.05f;
+    glm::vec3 lift = glm::vec3(0.0f);
+    glm::vec3 gamma = glm::vec3(1.0f);
+    glm::vec3 gain = glm::vec3(1.0f);
+};
+
+// HDR-кадр и свечение. Сцена рисуется в R11G11B10F (4 байта на пиксель
+// против 8 у RGBA16F) с глубиной; свечение — цепочка уровней того же
+// формата от половинного разрешения вниз: уменьшение, затем увеличение с
+// накоплением обратно к первому уровню. Полного разрешения касаются только
+// сама сцена и финальный проход, который пишет прямо в окно.
+class PostChain
+{
+public:
+    static constexpr int MAX_LEVELS = 6;
+    static constexpr int MIN_LEVEL_SIZE = 8;
+
+    PostChain() = default;
+    ~PostChain() { release(); }
+
+    PostChain(const PostChain&) = delete;
+    PostChain& operator=(const PostChain&) = delete;
+
+    // Удалить цели кадра; нужен текущий контекст, поэтому main зовёт его
+    // сам, до glfwTerminate(). Повторный вызов безопасен.
+    void release()
+    {
+        for (const Level& level : levels)
+        {
+            glDeleteFramebuffers(1, &level.fbo);
+            glDeleteTextures(1, &level.texture);
+        }
+        levels.clear();
+        if (sceneFBO) glDeleteFramebuffers(1, &sceneFBO);
+        if (overlayFBO) glDeleteFramebuffers(1, &overlayFBO);
+        if (sceneDepth) glDeleteTextures(1, &sceneDepth);
+        if (sceneColor) glDeleteTextures(1, &sceneColor);
+        if (emptyVAO) glDeleteVertexArrays(1, &emptyVAO);
+        sceneFBO = overlayFBO = sceneDepth = sceneColor = emptyVAO = 0;
+    }
+
+    bool init(int width, int height)
+    {
+        release();
+        this->width = width;
+        this->height = height;
+
+        glGenTextures(1, &sceneColor);
+        setupTarget(sceneColor, width, height);
+        // Глубина — текстурой: её читают полноэкранные проходы поверх кадра
+        glGenTextures(1, &sceneDepth);
+        glBindTexture(GL_TEXTURE_2D, sceneDepth);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, width, height, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glGenFramebuffers(1, &sceneFBO);
+        glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, sceneColor, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, sceneDepth, 0);
+        bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+
+        glGenFramebuffers(1, &overlayFBO);
+        glBindFramebuffer(GL_FRAMEBUFFER, overlayFBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, sceneColor, 0);
+        complete = complete && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+
+        int w = width / 2, h = height / 2;
+        for (int i = 0; i < MAX_LEVELS && complete && std::min(w, h) >= MIN_LEVEL_SIZE; ++i)
+        {
+            Level level;
+            level.width = w;
+            level.height = h;
+            glGenTextures(1, &level.texture);
+            setupTarget(level.texture, w, h);
+            glGenFramebuffers(1, &level.fbo);
+            glBindFramebuffer(GL_FRAMEBUFFER, level.fbo);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, level.texture, 0);
+            complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+            levels.push_back(level);
+            w /= 2;
+            h /= 2;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        if (!complete || levels.empty())
+        {
+            std::cerr << "R11G11B10F render targets are not supported, post-processing disabled\n";
+            release();
+            return false;
+        }
+        glGenVertexArrays(1, &emptyVAO);
+        return true;
+    }
+
+    // Дальнейшее рисование кадра идёт в HDR-цель
+    void begin()
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
+        glViewport(0, 0, width, height);
+    }
+
+    // Тот же цвет без глубины: проходы, читающие depthTexture(), не
+    // образуют петлю обратной связи
+    void beginOverlay()
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, overlayFBO);
+        glViewport(0, 0, width, height);
+    }
+
+    GLuint depthTexture() const { return sceneDepth; }
+
+    // HDR-кадр до тональной компрессии, снизу вверх, как его отдаёт GL.
+    // Читается в родном формате (4 байта на пиксель), разворачивается на CPU
+    void readHDR(std::vector<glm::vec3>& out)
+    {
+        std::vector<uint32_t> packed((size_t)width * height);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, sceneFBO);
+        glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_INT_10F_11F_11F_REV, packed.data());
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        out.resize(packed.size());
+        glm::unpackF2x11_1x10(packed.data(), out.data(), packed.size());
+    }
+
+    int frameWidth() const { return width; }
+    int frameHeight() const { return height; }
+
+    // Свечение и финальный проход в окно; после него привязан кадровый буфер 0
+    void resolve(const PostPrograms& programs, const PostSettings& settings)
+    {
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_BLEND);
+        glBindVertexArray(emptyVAO);
+        glActiveTexture(GL_TEXTURE0);
+
+        // Уменьшение: сцена -> уровень 0 -> ... -> последний
+        glUseProgram(programs.downsample);
+        glUniform1i(glGetUniformLocation(programs.downsample, "uSource"), 0);
+        float knee = std::max(settings.bloomKnee, 1e-4f);
+        glUniform4f(glGetUniformLocation(programs.downsample, "uThreshold"), settings.bloomThreshold,
+                    settings.bloomThreshold - knee, 2.0f * knee, 0.25f / knee);
+        GLuint source = sceneColor;
+        int sourceW = width, sourceH = height;
+        for (size_t i = 0; i < levels.size(); ++i)
+        {
+            glUniform1i(glGetUniformLocation(programs.downsample, "uPrefilter"), i == 0);
+            glUniform2f(glGetUniformLocation(programs.downsample, "uTexel"), 1.0f / sourceW, 1.0f / sourceH);
+            glBindTexture(GL_TEXTURE_2D, source);
+            drawTo(levels[i]);
+            source = levels[i].texture;
+            sourceW = levels[i].width;
+            sourceH = levels[i].height;
+        }
+
+        // Увеличение с накоплением: последний -> ... -> уровень 0
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE);
+        glUseProgram(programs.upsample);
+        glUniform1i(glGetUniformLocation(programs.upsample, "uSource"), 0);
+        for (size_t i = levels.size() - 1; i > 0; --i)
+        {
+            glUniform2f(glGetUniformLocation(programs.upsample, "uTexel"), 1.0f / levels[i].width, 1.0f / levels[i].height);
+            glBindTexture(GL_TEXTURE_2D, levels[i].texture);
+            drawTo(levels[i - 1]);
+        }
+        glDisable(GL_BLEND);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, width, height);
+        glUseProgram(programs.final);
+        glUniform1i(glGetUniformLocation(programs.final, "uScene"), 0);
+        glUniform1i(glGetUniformLocation(programs.final, "uBloom"), 1);
+        glUniform1f(glGetUniformLocation(programs.final, "uBloomIntensity"), settings.bloomIntensity);
+        glUniform1f(glGetUniformLocation(programs.final, "uExposure"), settings.exposure);
+        glUniform1f(glGetUniformLocation(programs.final, "uContrast"), settings.contrast);
+        glUniform1f(glGetUniformLocation(programs.final, "uSaturation"), settings.saturation);
+        glUniform3fv(glGetUniformLocation(programs.final, "uLift"), 1, glm::value_ptr(settings.lift));
+        glUniform3fv(glGetUniformLocation(programs.final, "uGamma"), 1, glm::value_ptr(settings.gamma));
+        glUniform3fv(glGetUniformLocation(programs.final, "uGain"), 1, glm::value_ptr(settings.gain));
+        glUniform1f(glGetUniformLocation(programs.final, "uFrame"), (float)(frame++ % 64));
+        glBindTexture(GL_TEXTURE_2D, sceneColor);
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, levels[0].texture);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindVertexArray(0);
+        glEnable(GL_DEPTH_TEST);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+private:
+    struct Level
+    {
+        GLuint texture = 0, fbo = 0;
+        int width = 0, height = 0;
+    };
+
+    static void setupTarget(GLuint texture, int w, int h)
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R11F_G11F_B10F, w, h, 0, GL_RGB, GL_FLOAT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    void drawTo(const Level& level)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, level.fbo);
+        glViewport(0, 0, level.width, level.height);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+
+    int width = 0, height = 0;
+    GLuint sceneFBO = 0, overlayFBO = 0, sceneColor = 0, sceneDepth = 0;
+    GLuint emptyVAO = 0;
+    std::vector<Level> levels;
+    uint32_t frame = 0;
+};
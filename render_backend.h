@@ -0,0 +1,44 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+
+// То, что рисует сцена домика, без привязки к API: кубы плоского цвета,
+// земля и столб дыма. Реализации — GL (GLBackend в midterm.cpp),
+// Vulkan (VulkanRenderer в vulkan_backend.h) и программная
+// (SoftwareRenderer в soft_raster.h), поэтому код сцены один и тот же для
+// окна и для машин без GPU.
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() = default;
+
+    virtual void setCamera(const glm::mat4& proj, const glm::mat4& view) = 0;
+
+    // Единичный куб [-0.5, 0.5]^3 с матрицей модели
+    virtual void drawCube(const glm::mat4& model, const glm::vec3& color) = 0;
+
+    // Как drawCube, но бэкенд может наложить текстуру земли
+    virtual void drawGround(const glm::mat4& model, const glm::vec3& color) = 0;
+
+    // Дым из трубы: частицы-билборды, анимированные по времени t
+    virtual void drawSmoke(const glm::vec3& base, float t) = 0;
+};
+
+// Повторяет particleVS: позиция и прозрачность частицы дыма в момент t
+inline void smokeParticle(const glm::vec3& offset, const glm::vec3& base, float t, glm::vec3& pos, float& alpha)
+{
+    const float lifetime = 4.0f;
+    float seed = offset.x * 13.37f + offset.z * 7.91f;
+    float x = t + seed;
+    float age = x - lifetime * std::floor(x / lifetime);
+    float factor = age / lifetime;
+
+    float windX = std::sin(t * 0.7f + seed) * 0.05f * factor;
+    float windZ = std::cos(t * 0.9f + seed) * 0.05f * factor;
+    pos = base + glm::vec3(offset.x * (1.0f + factor * 1.5f) + windX,
+                           age * 0.35f,
+                           offset.z * (1.0f + factor * 1.5f) + windZ);
+    alpha = 1.0f - std::pow(factor, 1.6f);
+}
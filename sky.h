@@ -0,0 +1,622 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "post_process.h"
+#include "tasks.h"
+
+// Параметры атмосферы Земли (Hillaire 2020), расстояния в километрах
+struct AtmosphereParams
+{
+    float bottomRadius = 6360.0f;
+    float topRadius = 6460.0f;
+    glm::vec3 rayleighScattering = glm::vec3(5.802f, 13.558f, 33.1f) * 1e-3f;   // 1/км
+    float rayleighHeight = 8.0f;
+    float mieScattering = 3.996e-3f;
+    float mieExtinction = 4.440e-3f;
+    float mieHeight = 1.2f;
+    float mieG = 0.8f;
+    glm::vec3 ozoneAbsorption = glm::vec3(0.650f, 1.881f, 0.085f) * 1e-3f;
+    float ozoneCenter = 25.0f;
+    float ozoneHalfWidth = 15.0f;
+    glm::vec3 groundAlbedo = glm::vec3(0.12f, 0.2f, 0.08f);   // луг
+};
+
+// Таблицы, зависящие от солнца: вид неба и воздушная перспектива. Яркость —
+// на единицу освещённости от солнца.
+struct SkyTables
+{
+    glm::vec3 sun = glm::vec3(0.0f, 1.0f, 0.0f);
+    float altitude = 0.0f;          // км над землёй
+    float aerialDistance = 0.0f;    // км, дальний слой перспективы
+    glm::vec3 sunTransmittance = glm::vec3(1.0f);
+    std::vector<glm::vec4> skyView; // rgb — яркость неба
+    std::vector<glm::vec4> aerial;  // rgb — рассеянный свет, a — пропускание
+};
+
+// Небо с предрасчётом (Hillaire, «A Scalable and Production Ready Sky and
+// Atmosphere Rendering Technique», 2020). Пропускание и многократное
+// рассеяние от солнца не зависят — считаются один раз в prepare(). Вид неба
+// (долгота от азимута солнца и широта, плотнее у горизонта) и объём
+// воздушной перспективы (направление и расстояние) — в bake(), только когда
+// солнце сдвинулось. На кадр остаётся по выборке из таблицы на пиксель.
+class AtmosphereModel
+{
+public:
+    static constexpr int TRANSMITTANCE_WIDTH = 256, TRANSMITTANCE_HEIGHT = 64;
+    static constexpr int MULTI_SCATTERING_SIZE = 32;
+    static constexpr int SKY_VIEW_WIDTH = 128, SKY_VIEW_HEIGHT = 64;   // долгота 0..pi: небо симметрично
+    static constexpr int AERIAL_SIZE = 32, AERIAL_SLICES = 16;
+
+    AtmosphereModel(ThreadPool& pool, const AtmosphereParams& params = AtmosphereParams())
+        : pool(pool), params(params)
+    {
+    }
+
+    // Не зависящие от солнца таблицы; повторный вызов ничего не делает
+    void prepare()
+    {
+        if (prepared)
+            return;
+        transmittanceLUT.resize((size_t)TRANSMITTANCE_WIDTH * TRANSMITTANCE_HEIGHT);
+        pool.parallelFor(TRANSMITTANCE_HEIGHT, 4, [this](size_t begin, size_t end)
+        {
+            for (size_t y = begin; y < end; ++y)
+                for (int x = 0; x < TRANSMITTANCE_WIDTH; ++x)
+                {
+                    float r, mu;
+                    transmittanceParams(((float)x + 0.5f) / TRANSMITTANCE_WIDTH, ((float)y + 0.5f) / TRANSMITTANCE_HEIGHT, r, mu);
+                    transmittanceLUT[y * TRANSMITTANCE_WIDTH + x] = opticalTransmittance(r, mu);
+                }
+        });
+
+        multiScatteringLUT.resize((size_t)MULTI_SCATTERING_SIZE * MULTI_SCATTERING_SIZE);
+        pool.parallelFor(MULTI_SCATTERING_SIZE, 1, [this](size_t begin, size_t end)
+        {
+            for (size_t y = begin; y < end; ++y)
+                for (int x = 0; x < MULTI_SCATTERING_SIZE; ++x)
+                {
+                    float muSun = ((float)x + 0.5f) / MULTI_SCATTERING_SIZE * 2.0f - 1.0f;
+                    float r = params.bottomRadius + ((float)y + 0.5f) / MULTI_SCATTERING_SIZE * (params.topRadius - params.bottomRadius);
+                    multiScatteringLUT[y * MULTI_SCATTERING_SIZE + x] = multiScattering(r, muSun);
+                }
+        });
+        prepared = true;
+    }
+
+    // Таблицы для солнца sun и наблюдателя на высоте altitude (км)
+    void bake(const glm::vec3& sun, float altitude, float aerialDistance, SkyTables& out) const
+    {
+        out.sun = sun;
+        out.altitude = altitude;
+        out.aerialDistance = aerialDistance;
+        float r = params.bottomRadius + std::max(altitude, 0.001f);
+        out.sunTransmittance = transmittance(r, sun.y);
+
+        glm::vec3 sunX, sunZ;
+        sunBasis(sun, sunX, sunZ);
+
+        out.skyView.resize((size_t)SKY_VIEW_WIDTH * SKY_VIEW_HEIGHT);
+        pool.parallelFor(SKY_VIEW_HEIGHT, 2, [&](size_t begin, size_t end)
+        {
+            for (size_t y = begin; y < end; ++y)
+                for (int x = 0; x < SKY_VIEW_WIDTH; ++x)
+                {
+                    glm::vec3 dir = skyViewDirection(((float)x + 0.5f) / SKY_VIEW_WIDTH, ((float)y + 0.5f) / SKY_VIEW_HEIGHT, sunX, sunZ);
+                    float tMax = rayLength(r, dir.y);
+                    glm::vec3 luminance(0.0f), throughput(1.0f);
+                    integrate(r, dir, sun, 0.0f, tMax, SKY_VIEW_STEPS, luminance, throughput);
+                    // Ниже горизонта за краем сцены — освещённая земля сквозь дымку
+                    if (hitsGround(r, dir.y))
+                        luminance += throughput * groundLuminance(glm::vec3(0.0f, r, 0.0f) + dir * tMax, sun);
+                    out.skyView[y * SKY_VIEW_WIDTH + x] = glm::vec4(luminance, 1.0f);
+                }
+        });
+
+        // Перспектива: слой k — на расстоянии k / (SLICES - 1) от дальнего;
+        // луч идёт по слоям, накопленное сохраняется на каждом
+        out.aerial.resize((size_t)AERIAL_SIZE * AERIAL_SIZE * AERIAL_SLICES);
+        pool.parallelFor(AERIAL_SIZE, 2, [&](size_t begin, size_t end)
+        {
+            for (size_t y = begin; y < end; ++y)
+                for (int x = 0; x < AERIAL_SIZE; ++x)
+                {
+                    glm::vec3 dir = skyViewDirection(((float)x + 0.5f) / AERIAL_SIZE, ((float)y + 0.5f) / AERIAL_SIZE, sunX, sunZ);
+                    glm::vec3 luminance(0.0f), throughput(1.0f);
+                    float sliceLength = aerialDistance / (float)(AERIAL_SLICES - 1);
+                    out.aerial[(y * AERIAL_SIZE + x)] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+                    for (int k = 1; k < AERIAL_SLICES; ++k)
+                    {
+                        integrate(r, dir, sun, sliceLength * (float)(k - 1), sliceLength * (float)k, 2, luminance, throughput);
+                        float t = (throughput.r + throughput.g + throughput.b) / 3.0f;
+                        out.aerial[((size_t)k * AERIAL_SIZE + y) * AERIAL_SIZE + x] = glm::vec4(luminance, t);
+                    }
+                }
+        });
+    }
+
+    const AtmosphereParams& parameters() const { return params; }
+
+    // Пропускание от точки на радиусе r вдоль направления с косинусом mu к
+    // зениту до верха атмосферы; 0, если луч упирается в землю
+    glm::vec3 transmittance(float r, float mu) const
+    {
+        if (hitsGround(r, mu))
+            return glm::vec3(0.0f);
+        glm::vec2 uv = transmittanceUV(r, mu);
+        return sample(transmittanceLUT, TRANSMITTANCE_WIDTH, TRANSMITTANCE_HEIGHT, uv);
+    }
+
+private:
+    static constexpr int TRANSMITTANCE_STEPS = 40;
+    static constexpr int MULTI_SCATTERING_STEPS = 20;
+    static constexpr int MULTI_SCATTERING_DIRECTIONS = 8;   // 8x8 направлений по сфере
+    static constexpr int SKY_VIEW_STEPS = 30;
+
+    struct Medium
+    {
+        glm::vec3 rayleigh;
+        float mie;
+        glm::vec3 scattering;
+        glm::vec3 extinction;
+    };
+
+    Medium medium(float height) const
+    {
+        height = std::max(height, 0.0f);
+        Medium m;
+        m.rayleigh = params.rayleighScattering * std::exp(-height / params.rayleighHeight);
+        float mieDensity = std::exp(-height / params.mieHeight);
+        m.mie = params.mieScattering * mieDensity;
+        float ozone = std::max(0.0f, 1.0f - std::abs(height - params.ozoneCenter) / params.ozoneHalfWidth);
+        m.scattering = m.rayleigh + glm::vec3(m.mie);
+        m.extinction = m.rayleigh + glm::vec3(params.mieExtinction * mieDensity) + params.ozoneAbsorption * ozone;
+        return m;
+    }
+
+    // Ближайшее положительное пересечение луча со сферой радиуса R; -1 — мимо
+    static float raySphere(float r, float mu, float R)
+    {
+        float disc = r * r * (mu * mu - 1.0f) + R * R;
+        if (disc < 0.0f)
+            return -1.0f;
+        float s = std::sqrt(disc);
+        float t0 = -r * mu - s, t1 = -r * mu + s;
+        return t0 > 0.0f ? t0 : t1 > 0.0f ? t1 : -1.0f;
+    }
+
+    bool hitsGround(float r, float mu) const
+    {
+        return mu < 0.0f && r * r * (mu * mu - 1.0f) + params.bottomRadius * params.bottomRadius >= 0.0f;
+    }
+
+    // До земли или до верха атмосферы
+    float rayLength(float r, float mu) const
+    {
+        float ground = hitsGround(r, mu) ? raySphere(r, mu, params.bottomRadius) : -1.0f;
+        return ground > 0.0f ? ground : std::max(raySphere(r, mu, params.topRadius), 0.0f);
+    }
+
+    // Параметризация Брюнетона: равномерно по расстоянию до верха атмосферы
+    glm::vec2 transmittanceUV(float r, float mu) const
+    {
+        float H = std::sqrt(params.topRadius * params.topRadius - params.bottomRadius * params.bottomRadius);
+        float rho = std::sqrt(std::max(r * r - params.bottomRadius * params.bottomRadius, 0.0f));
+        float d = std::max(raySphere(r, mu, params.topRadius), 0.0f);
+        float dMin = params.topRadius - r, dMax = rho + H;
+        return glm::vec2((d - dMin) / std::max(dMax - dMin, 1e-6f), rho / H);
+    }
+
+    void transmittanceParams(float u, float v, float& r, float& mu) const
+    {
+        float H = std::sqrt(params.topRadius * params.topRadius - params.bottomRadius * params.bottomRadius);
+        float rho = H * v;
+        r = std::sqrt(rho * rho + params.bottomRadius * params.bottomRadius);
+        float dMin = params.topRadius - r, dMax = rho + H;
+        float d = dMin + u * (dMax - dMin);
+        mu = d == 0.0f ? 1.0f : glm::clamp((H * H - rho * rho - d * d) / (2.0f * r * d), -1.0f, 1.0f);
+    }
+
+    glm::vec3 opticalTransmittance(float r, float mu) const
+    {
+        float tMax = std::max(raySphere(r, mu, params.topRadius), 0.0f);
+        float dt = tMax / TRANSMITTANCE_STEPS;
+        glm::vec3 depth(0.0f);
+        for (int i = 0; i < TRANSMITTANCE_STEPS; ++i)
+        {
+            float t = ((float)i + 0.5f) * dt;
+            float height = std::sqrt(r * r + t * t + 2.0f * r * mu * t) - params.bottomRadius;
+            depth += medium(height).extinction * dt;
+        }
+        return glm::exp(-depth);
+    }
+
+    static glm::vec3 sample(const std::vector<glm::vec3>& lut, int w, int h, glm::vec2 uv)
+    {
+        float fx = glm::clamp(uv.x * w - 0.5f, 0.0f, (float)(w - 1)), fy = glm::clamp(uv.y * h - 0.5f, 0.0f, (float)(h - 1));
+        int x0 = (int)fx, y0 = (int)fy;
+        int x1 = std::min(x0 + 1, w - 1), y1 = std::min(y0 + 1, h - 1);
+        float tx = fx - (float)x0, ty = fy - (float)y0;
+        glm::vec3 a = glm::mix(lut[(size_t)y0 * w + x0], lut[(size_t)y0 * w + x1], tx);
+        glm::vec3 b = glm::mix(lut[(size_t)y1 * w + x0], lut[(size_t)y1 * w + x1], tx);
+        return glm::mix(a, b, ty);
+    }
+
+    glm::vec3 multiScatteringAt(float r, float muSun) const
+    {
+        glm::vec2 uv((muSun * 0.5f + 0.5f), (r - params.bottomRadius) / (params.topRadius - params.bottomRadius));
+        return sample(multiScatteringLUT, MULTI_SCATTERING_SIZE, MULTI_SCATTERING_SIZE, uv);
+    }
+
+    // Ψ_ms: второй порядок рассеяния по сфере направлений и доля f_ms,
+    // возвращающаяся в точку; ряд всех порядков — 1 / (1 - f_ms)
+    glm::vec3 multiScattering(float r, float muSun) const
+    {
+        glm::vec3 sun(std::sqrt(std::max(1.0f - muSun * muSun, 0.0f)), muSun, 0.0f);
+        glm::vec3 origin(0.0f, r, 0.0f);
+        glm::vec3 luminance(0.0f), transfer(0.0f);
+        const int n = MULTI_SCATTERING_DIRECTIONS;
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+            {
+                float z = 1.0f - 2.0f * ((float)i + 0.5f) / n;
+                float phi = glm::two_pi<float>() * ((float)j + 0.5f) / n;
+                float s = std::sqrt(std::max(1.0f - z * z, 0.0f));
+                glm::vec3 dir(s * std::cos(phi), z, s * std::sin(phi));
+
+                float tMax = rayLength(r, dir.y);
+                float dt = tMax / MULTI_SCATTERING_STEPS;
+                glm::vec3 throughput(1.0f);
+                for (int k = 0; k < MULTI_SCATTERING_STEPS; ++k)
+                {
+                    glm::vec3 p = origin + dir * (((float)k + 0.5f) * dt);
+                    float pr = glm::length(p);
+                    Medium m = medium(pr - params.bottomRadius);
+                    glm::vec3 step = glm::exp(-m.extinction * dt);
+                    glm::vec3 sunLight = transmittance(pr, glm::dot(p / pr, sun));
+                    glm::vec3 inScatter = m.scattering * sunLight / (4.0f * glm::pi<float>());
+                    glm::vec3 safe = glm::max(m.extinction, glm::vec3(1e-9f));
+                    luminance += throughput * (inScatter - inScatter * step) / safe;
+                    transfer += throughput * (m.scattering - m.scattering * step) / safe;
+                    throughput *= step;
+                }
+                if (hitsGround(r, dir.y))
+                    luminance += throughput * groundLuminance(origin + dir * tMax, sun);
+            }
+        float count = (float)(n * n);
+        luminance /= count;
+        transfer /= count;
+        return luminance / (glm::vec3(1.0f) - glm::min(transfer, glm::vec3(0.99f)));
+    }
+
+    // Ламбертова земля под солнцем
+    glm::vec3 groundLuminance(const glm::vec3& p, const glm::vec3& sun) const
+    {
+        float cosSun = glm::dot(glm::normalize(p), sun);
+        return transmittance(params.bottomRadius + 1e-3f, cosSun) * std::max(cosSun, 0.0f) *
+               params.groundAlbedo / glm::pi<float>();
+    }
+
+    static float rayleighPhase(float c)
+    {
+        return 3.0f / (16.0f * glm::pi<float>()) * (1.0f + c * c);
+    }
+
+    // Корнетт — Шэнкс
+    float miePhase(float c) const
+    {
+        float g = params.mieG, g2 = g * g;
+        float denom = 1.0f + g2 - 2.0f * g * c;
+        return 3.0f / (8.0f * glm::pi<float>()) * (1.0f - g2) * (1.0f + c * c) / ((2.0f + g2) * denom * std::sqrt(denom));
+    }
+
+    // Однократное рассеяние от солнца плюс многократное из таблицы на отрезке
+    // [t0, t1] луча; luminance и throughput накапливаются
+    void integrate(float r, const glm::vec3& dir, const glm::vec3& sun, float t0, float t1, int steps,
+                   glm::vec3& luminance, glm::vec3& throughput) const
+    {
+        glm::vec3 origin(0.0f, r, 0.0f);
+        float cosTheta = glm::dot(dir, sun);
+        float phaseR = rayleighPhase(cosTheta), phaseM = miePhase(cosTheta);
+        for (int i = 0; i < steps; ++i)
+        {
+            // Шаги гуще у наблюдателя: u^2 по длине отрезка
+            float a = (float)i / steps, b = (float)(i + 1) / steps;
+            float ta = t0 + (t1 - t0) * a * a, tb = t0 + (t1 - t0) * b * b;
+            float dt = tb - ta;
+            glm::vec3 p = origin + dir * ((ta + tb) * 0.5f);
+            float pr = glm::length(p);
+            glm::vec3 up = p / pr;
+            float muSun = glm::dot(up, sun);
+            Medium m = medium(pr - params.bottomRadius);
+
+            glm::vec3 sunLight = transmittance(pr, muSun);
+            glm::vec3 inScatter = sunLight * (m.rayleigh * phaseR + glm::vec3(m.mie * phaseM)) +
+                                  multiScatteringAt(pr, muSun) * m.scattering;
+            glm::vec3 step = glm::exp(-m.extinction * dt);
+            glm::vec3 safe = glm::max(m.extinction, glm::vec3(1e-9f));
+            luminance += throughput * (inScatter - inScatter * step) / safe;
+            throughput *= step;
+        }
+    }
+
+    // Горизонтальный базис: X — к азимуту солнца, Z — поперёк
+    static void sunBasis(const glm::vec3& sun, glm::vec3& x, glm::vec3& z)
+    {
+        glm::vec2 h(sun.x, sun.z);
+        float len = glm::length(h);
+        x = len > 1e-4f ? glm::vec3(h.x / len, 0.0f, h.y / len) : glm::vec3(1.0f, 0.0f, 0.0f);
+        z = glm::vec3(-x.z, 0.0f, x.x);
+    }
+
+    // Обратное к skyViewUV в SKY_FS
+    static glm::vec3 skyViewDirection(float u, float v, const glm::vec3& x, const glm::vec3& z)
+    {
+        float lon = u * glm::pi<float>();
+        float s = v * 2.0f - 1.0f;
+        float lat = (s < 0.0f ? -1.0f : 1.0f) * s * s * glm::half_pi<float>();
+        return std::cos(lat) * (std::cos(lon) * x + std::sin(lon) * z) + glm::vec3(0.0f, std::sin(lat), 0.0f);
+    }
+
+    ThreadPool& pool;
+    AtmosphereParams params;
+    bool prepared = false;
+    std::vector<glm::vec3> transmittanceLUT;
+    std::vector<glm::vec3> multiScatteringLUT;
+};
+
+// Солнце по времени суток в часах: восходит в 6 со стороны -X, заходит в 18
+// на +X; путь наклонён к +Z. В 14 часов — примерно солнце запечённого света.
+inline glm::vec3 sunDirection(float hours)
+{
+    float a = (hours - 6.0f) / 24.0f * glm::two_pi<float>();
+    return glm::normalize(glm::vec3(-std::cos(a), std::sin(a), 0.35f));
+}
+
+// Общее для SKY_FS и AERIAL_FS: направление -> координаты таблицы вида неба
+#define MID_SKY_VIEW_GLSL \
+    "uniform vec3 uSunX;\n" \
+    "uniform vec3 uSunZ;\n" \
+    "vec2 skyViewUV(vec3 dir)\n" \
+    "{\n" \
+    "    float lat = asin(clamp(dir.y, -1.0, 1.0));\n" \
+    "    float lon = atan(abs(dot(dir, uSunZ)), dot(dir, uSunX));\n" \
+    "    float v = 0.5 + 0.5 * sign(lat) * sqrt(abs(lat) / 1.5707963);\n" \
+    "    return vec2(lon / 3.1415927, v);\n" \
+    "}\n"
+
+// Небо вместо цвета очистки: таблица вида неба и диск солнца
+inline const char* SKY_FS = "#version 330 core\n" MID_SKY_VIEW_GLSL R"(
+in vec2 vUV;
+out vec4 FragColor;
+uniform sampler2D uSkyView;
+uniform mat4 uInvViewProj;
+uniform vec3 uSun;
+uniform vec3 uSunColor;         // освещённость солнца с учётом пропускания
+uniform float uIlluminance;
+uniform float uSunCos;          // косинус углового радиуса диска
+void main()
+{
+    vec2 ndc = vUV * 2.0 - 1.0;
+    vec4 nearP = uInvViewProj * vec4(ndc, -1.0, 1.0);
+    vec4 farP = uInvViewProj * vec4(ndc, 1.0, 1.0);
+    vec3 dir = normalize(farP.xyz / farP.w - nearP.xyz / nearP.w);
+
+    vec3 color = texture(uSkyView, skyViewUV(dir)).rgb * uIlluminance;
+    float cosSun = dot(dir, uSun);
+    if (cosSun > uSunCos && dir.y > 0.0)
+        color += uSunColor * smoothstep(uSunCos, mix(uSunCos, 1.0, 0.3), cosSun) * 20.0;
+    FragColor = vec4(color, 1.0);
+}
+)";
+
+// Воздушная перспектива поверх готового кадра: по глубине — расстояние, по
+// нему слой объёма. Смешивание ONE, SRC_ALPHA: кадр * пропускание + свет.
+inline const char* AERIAL_FS = "#version 330 core\n" MID_SKY_VIEW_GLSL R"(
+in vec2 vUV;
+out vec4 FragColor;
+uniform sampler2D uDepth;
+uniform sampler3D uAerial;
+uniform mat4 uInvViewProj;
+uniform vec3 uEye;
+uniform float uKmPerUnit;
+uniform float uAerialDistance;  // км до последнего слоя
+uniform float uSlices;
+uniform float uIlluminance;
+void main()
+{
+    float depth = texture(uDepth, vUV).r;
+    if (depth >= 1.0)
+        discard;
+    vec4 world = uInvViewProj * vec4(vUV * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+    vec3 ray = world.xyz / world.w - uEye;
+    float dist = length(ray);
+    vec3 dir = ray / dist;
+    float slice = clamp(dist * uKmPerUnit / uAerialDistance, 0.0, 1.0) * (uSlices - 1.0);
+    vec4 ap = texture(uAerial, vec3(skyViewUV(dir), (slice + 0.5) / uSlices));
+    FragColor = vec4(ap.rgb * uIlluminance, ap.a);
+}
+)";
+
+struct SkyPrograms
+{
+    GLuint sky = 0, aerial = 0;
+};
+
+// GL-сторона неба: текстуры из SkyTables и два полноэкранных прохода.
+// Пока таблиц нет (ready() == false), кадр очищается прежним цветом.
+class SkyRenderer
+{
+public:
+    float illuminance = 12.0f;       // освещённость от солнца в единицах кадра
+    float kmPerUnit = 0.01f;         // единица мира — 10 м
+    float sunAngularRadius = 0.01f;  // рад; больше настоящего, чтобы диск был заметен
+    float aerialDistance = 4.0f;     // км, дальше перспектива не растёт
+
+    SkyRenderer() = default;
+    ~SkyRenderer()
+    {
+        if (skyView) glDeleteTextures(1, &skyView);
+        if (aerial) glDeleteTextures(1, &aerial);
+        if (emptyVAO) glDeleteVertexArrays(1, &emptyVAO);
+    }
+
+    SkyRenderer(const SkyRenderer&) = delete;
+    SkyRenderer& operator=(const SkyRenderer&) = delete;
+
+    bool ready() const { return skyView != 0; }
+
+    // Солнце и высота наблюдателя (км) на этот кадр
+    void setTarget(const glm::vec3& sun, float altitude)
+    {
+        targetSun = sun;
+        targetAltitude = altitude;
+        hasTarget = true;
+    }
+
+    const glm::vec3& targetSunDirection() const { return targetSun; }
+    float targetObserverAltitude() const { return targetAltitude; }
+
+    // Перестраивать ли таблицы: солнце ушло от запечённого больше чем на
+    // ~0.25° или наблюдатель сместился по высоте на 100 м
+    bool needsUpdate() const
+    {
+        if (!hasTarget)
+            return false;
+        return !ready() || glm::dot(targetSun, sun) < 0.99999f || std::abs(targetAltitude - altitude) > 0.1f;
+    }
+
+    // Рендер-поток: таблицы готовы
+    void upload(const SkyTables& tables)
+    {
+        if (!emptyVAO)
+            glGenVertexArrays(1, &emptyVAO);
+        if (!skyView)
+        {
+            glGenTextures(1, &skyView);
+            glBindTexture(GL_TEXTURE_2D, skyView);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, AtmosphereModel::SKY_VIEW_WIDTH, AtmosphereModel::SKY_VIEW_HEIGHT, 0,
+                         GL_RGBA, GL_FLOAT, tables.skyView.data());
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+            glGenTextures(1, &aerial);
+            glBindTexture(GL_TEXTURE_3D, aerial);
+            glTexImage3D(GL_TEXTURE_3D, 0, GL_RGBA16F, AtmosphereModel::AERIAL_SIZE, AtmosphereModel::AERIAL_SIZE,
+                         AtmosphereModel::AERIAL_SLICES, 0, GL_RGBA, GL_FLOAT, tables.aerial.data());
+            glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        }
+        else
+        {
+            glBindTexture(GL_TEXTURE_2D, skyView);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, AtmosphereModel::SKY_VIEW_WIDTH, AtmosphereModel::SKY_VIEW_HEIGHT,
+                            GL_RGBA, GL_FLOAT, tables.skyView.data());
+            glBindTexture(GL_TEXTURE_3D, aerial);
+            glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, AtmosphereModel::AERIAL_SIZE, AtmosphereModel::AERIAL_SIZE,
+                            AtmosphereModel::AERIAL_SLICES, GL_RGBA, GL_FLOAT, tables.aerial.data());
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindTexture(GL_TEXTURE_3D, 0);
+
+        sun = tables.sun;
+        altitude = tables.altitude;
+        sunColor = tables.sunTransmittance * illuminance;
+        bakedAerialDistance = tables.aerialDistance;
+    }
+
+    // Вместо glClear по цвету; глубину не пишет
+    void draw(const SkyPrograms& programs, const glm::mat4& viewProj)
+    {
+        if (!ready())
+            return;
+        glDisable(GL_DEPTH_TEST);
+        glDepthMask(GL_FALSE);
+        glDisable(GL_BLEND);
+        GLuint prog = programs.sky;
+        glUseProgram(prog);
+        setSunBasis(prog);
+        glUniformMatrix4fv(glGetUniformLocation(prog, "uInvViewProj"), 1, GL_FALSE, glm::value_ptr(glm::inverse(viewProj)));
+        glUniform3fv(glGetUniformLocation(prog, "uSun"), 1, glm::value_ptr(sun));
+        glUniform3fv(glGetUniformLocation(prog, "uSunColor"), 1, glm::value_ptr(sunColor));
+        glUniform1f(glGetUniformLocation(prog, "uIlluminance"), illuminance);
+        glUniform1f(glGetUniformLocation(prog, "uSunCos"), std::cos(sunAngularRadius));
+        glUniform1i(glGetUniformLocation(prog, "uSkyView"), 0);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, skyView);
+        glBindVertexArray(emptyVAO);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glBindVertexArray(0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDepthMask(GL_TRUE);
+        glEnable(GL_DEPTH_TEST);
+        glEnable(GL_BLEND);
+    }
+
+    // После геометрии, до resolve(); нужна глубина цепочки постобработки
+    void applyAerialPerspective(const SkyPrograms& programs, PostChain& post, const glm::mat4& viewProj, const glm::vec3& eye)
+    {
+        if (!ready())
+            return;
+        post.beginOverlay();
+        glDisable(GL_DEPTH_TEST);
+        glBlendFunc(GL_ONE, GL_SRC_ALPHA);
+        GLuint prog = programs.aerial;
+        glUseProgram(prog);
+        setSunBasis(prog);
+        glUniformMatrix4fv(glGetUniformLocation(prog, "uInvViewProj"), 1, GL_FALSE, glm::value_ptr(glm::inverse(viewProj)));
+        glUniform3fv(glGetUniformLocation(prog, "uEye"), 1, glm::value_ptr(eye));
+        glUniform1f(glGetUniformLocation(prog, "uKmPerUnit"), kmPerUnit);
+        glUniform1f(glGetUniformLocation(prog, "uAerialDistance"), bakedAerialDistance);
+        glUniform1f(glGetUniformLocation(prog, "uSlices"), (float)AtmosphereModel::AERIAL_SLICES);
+        glUniform1f(glGetUniformLocation(prog, "uIlluminance"), illuminance);
+        glUniform1i(glGetUniformLocation(prog, "uDepth"), 0);
+        glUniform1i(glGetUniformLocation(prog, "uAerial"), 1);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, post.depthTexture());
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_3D, aerial);
+        glBindVertexArray(emptyVAO);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glBindVertexArray(0);
+        glBindTexture(GL_TEXTURE_3D, 0);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glEnable(GL_DEPTH_TEST);
+    }
+
+private:
+    void setSunBasis(GLuint prog) const
+    {
+        glm::vec2 h(sun.x, sun.z);
+        float len = glm::length(h);
+        glm::vec3 x = len > 1e-4f ? glm::vec3(h.x / len, 0.0f, h.y / len) : glm::vec3(1.0f, 0.0f, 0.0f);
+        glm::vec3 z(-x.z, 0.0f, x.x);
+        glUniform3fv(glGetUniformLocation(prog, "uSunX"), 1, glm::value_ptr(x));
+        glUniform3fv(glGetUniformLocation(prog, "uSunZ"), 1, glm::value_ptr(z));
+    }
+
+    GLuint skyView = 0, aerial = 0, emptyVAO = 0;
+    glm::vec3 sun = glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::vec3 sunColor = glm::vec3(0.0f);
+    float altitude = 0.0f;
+    float bakedAerialDistance = 1.0f;
+
+    bool hasTarget = false;
+    glm::vec3 targetSun = glm::vec3(0.0f, 1.0f, 0.0f);
+    float targetAltitude = 0.0f;
+};
@@ -0,0 +1,553 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MID_RASTER_SSE2 1
+#endif
+
+#include "gtao.h"
+#include "render_backend.h"
+#include "tasks.h"
+
+// Программный растеризатор сцены для машин без GPU. Вызовы рисования только
+// преобразуют и отсекают треугольники; endFrame() раскладывает их по тайлам
+// 64x64 и растеризует тайлы на пуле. Внутри тайла треугольники идут в порядке
+// вызовов, поэтому глубина (GL_LESS) и смешивание (SRC_ALPHA,
+// ONE_MINUS_SRC_ALPHA) дают то же, что GL. Вершины привязаны к сетке 1/256
+// пикселя, как у llvmpipe; функции рёбер — целые, с правилом верхнего левого
+// ребра, так что общие рёбра не закрашиваются дважды. Готовый кадр
+// затеняется GroundTruthAO (gtao.h) по буферу глубины.
+class SoftwareRenderer : public RenderBackend
+{
+public:
+    static constexpr int TILE = 64;
+
+    SoftwareRenderer(ThreadPool& pool, int width, int height)
+        : pool(pool), width(width), height(height),
+          tilesX((width + TILE - 1) / TILE), tilesY((height + TILE - 1) / TILE),
+          color((size_t)width * height), depth((size_t)width * height),
+          translucent((size_t)width * height), opaqueDepth((size_t)width * height), smokeDepth((size_t)width * height),
+          bins((size_t)tilesX * tilesY), ao(pool, width, height)
+    {
+    }
+
+    // Смещения частиц — те же, что в вершинном буфере дыма GL-пути
+    void setParticles(std::vector<glm::vec3> offsets) { particles = std::move(offsets); }
+
+    void beginFrame(const glm::vec4& clearColor)
+    {
+        clearValue = packColor(clearColor);
+        triangles.clear();
+    }
+
+    void setCamera(const glm::mat4& proj, const glm::mat4& view) override
+    {
+        this->proj = proj;
+        this->view = view;
+        viewProj = proj * view;
+    }
+
+    void drawCube(const glm::mat4& model, const glm::vec3& rgb) override
+    {
+        static const glm::vec3 corners[8] = {
+            { -0.5f, -0.5f, -0.5f }, { 0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, -0.5f }, { -0.5f, 0.5f, -0.5f },
+            { -0.5f, -0.5f, 0.5f }, { 0.5f, -0.5f, 0.5f }, { 0.5f, 0.5f, 0.5f }, { -0.5f, 0.5f, 0.5f },
+        };
+        // Тот же порядок индексов, что у cubeIdx
+        static const uint8_t indices[36] = {
+            0, 1, 2, 2, 3, 0,   4, 5, 6, 6, 7, 4,   0, 4, 7, 7, 3, 0,
+            1, 5, 6, 6, 2, 1,   3, 2, 6, 6, 7, 3,   0, 1, 5, 5, 4, 0,
+        };
+        glm::mat4 mvp = viewProj * model;
+        Vertex v[8];
+        for (int i = 0; i < 8; ++i)
+            v[i].clip = mvp * glm::vec4(corners[i], 1.0f);
+
+        Shading s;
+        s.kind = SHADE_FLAT;
+        s.color = packColor(glm::vec4(rgb, 1.0f));
+        for (int i = 0; i < 36; i += 3)
+            submit(v[indices[i]], v[indices[i + 1]], v[indices[i + 2]], s);
+    }
+
+    // Текстур у программного пути нет — земля рисуется цветом
+    void drawGround(const glm::mat4& model, const glm::vec3& rgb) override { drawCube(model, rgb); }
+
+    void drawSmoke(const glm::vec3& base, float t) override
+    {
+        // Повторяет particleGS: квадрат к камере, полоса из двух треугольников
+        glm::vec3 right(view[0][0], view[1][0], view[2][0]);
+        glm::vec3 up(view[0][1], view[1][1], view[2][1]);
+        for (const glm::vec3& offset : particles)
+        {
+            glm::vec3 center;
+            Shading s;
+            s.kind = SHADE_SMOKE;
+            smokeParticle(offset, base, t, center, s.alpha);
+
+            float size = 0.18f * s.alpha;
+            Vertex v[4];
+            const glm::vec2 uv[4] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f } };
+            const glm::vec3 corner[4] = { -right - up, right - up, -right + up, right + up };
+            for (int i = 0; i < 4; ++i)
+            {
+                v[i].clip = viewProj * glm::vec4(center + corner[i] * size, 1.0f);
+                v[i].uv = uv[i];
+            }
+            submit(v[0], v[1], v[2], s);
+            submit(v[2], v[1], v[3], s);
+        }
+    }
+
+    // Растеризовать кадр; очистка буферов идёт тут же, по тайлам
+    void endFrame()
+    {
+        for (std::vector<uint32_t>& bin : bins)
+            bin.clear();
+        for (uint32_t i = 0; i < triangles.size(); ++i)
+        {
+            const Triangle& t = triangles[i];
+            for (int ty = t.minY / TILE; ty <= t.maxY / TILE; ++ty)
+                for (int tx = t.minX / TILE; tx <= t.maxX / TILE; ++tx)
+                {
+                    TileCoverage coverage = classifyTile(t, tx, ty);
+                    if (coverage == TILE_OUTSIDE)
+                        continue;
+                    bins[(size_t)ty * tilesX + tx].push_back(coverage == TILE_FULL ? i | FULL_TILE_BIT : i);
+                }
+        }
+
+        pool.parallelFor(bins.size(), 1, [this](size_t begin, size_t end)
+        {
+            for (size_t tile = begin; tile < end; ++tile)
+                rasterizeTile((int)(tile % tilesX), (int)(tile / tilesX));
+        });
+        ao.apply(depth, proj, view, color, &translucent);
+    }
+
+    size_t triangleCount() const { return triangles.size(); }
+
+    GroundTruthAO& ambientOcclusion() { return ao; }
+
+    // RGBA8, строки снизу вверх — как у glReadPixels
+    const std::vector<uint32_t>& pixels() const { return color; }
+
+    bool writePPM(const std::string& path) const
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            std::cerr << "Failed to write " << path << "\n";
+            return false;
+        }
+        out << "P6\n" << width << " " << height << "\n255\n";
+        std::vector<char> row((size_t)width * 3);
+        for (int y = height - 1; y >= 0; --y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                uint32_t c = color[(size_t)y * width + x];
+                row[x * 3 + 0] = (char)(c & 0xFF);
+                row[x * 3 + 1] = (char)(c >> 8 & 0xFF);
+                row[x * 3 + 2] = (char)(c >> 16 & 0xFF);
+            }
+            out.write(row.data(), (std::streamsize)row.size());
+        }
+        return (bool)out;
+    }
+
+private:
+    enum ShadeKind : uint8_t
+    {
+        SHADE_FLAT,
+        SHADE_SMOKE
+    };
+
+    struct Shading
+    {
+        ShadeKind kind = SHADE_FLAT;
+        uint32_t color = 0;
+        float alpha = 1.0f;
+    };
+
+    struct Vertex
+    {
+        glm::vec4 clip;
+        glm::vec2 uv = glm::vec2(0.0f);
+    };
+
+    // Плоскость a = dx * x + dy * y + c в пиксельных координатах
+    struct Plane
+    {
+        float dx, dy, c;
+        float at(float x, float y) const { return dx * x + dy * y + c; }
+    };
+
+    struct Triangle
+    {
+        int64_t a[3], b[3], c[3];   // E = a * px + b * py + c, px/py — в 1/256 пикселя
+        int minX, maxX, minY, maxY;
+        Plane z, invW, uOverW, vOverW;
+        Shading shading;
+    };
+
+    enum TileCoverage
+    {
+        TILE_OUTSIDE,
+        TILE_PARTIAL,
+        TILE_FULL
+    };
+
+    // Старший бит номера в корзине: треугольник накрывает тайл целиком
+    static constexpr uint32_t FULL_TILE_BIT = 0x80000000u;
+
+    static constexpr int SUBPIXEL_BITS = 8;
+    static constexpr int64_t SUBPIXEL = 1 << SUBPIXEL_BITS;
+    static constexpr float GUARD_BAND = 4.0f;   // x и y отсекаются в четырёх экранах
+
+    static uint32_t packColor(const glm::vec4& c)
+    {
+        glm::uvec4 u = glm::uvec4(glm::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f);
+        return u.r | u.g << 8 | u.b << 16 | u.a << 24;
+    }
+
+    // Отсечь по ближней и дальней плоскостям (как GL) и по защитной полосе
+    // по x/y, чтобы экранные координаты оставались в разумных пределах
+    void submit(const Vertex& v0, const Vertex& v1, const Vertex& v2, const Shading& s)
+    {
+        auto distance = [](const glm::vec4& p, int plane)
+        {
+            switch (plane)
+            {
+            case 0: return p.w + p.z;
+            case 1: return p.w - p.z;
+            case 2: return GUARD_BAND * p.w + p.x;
+            case 3: return GUARD_BAND * p.w - p.x;
+            case 4: return GUARD_BAND * p.w + p.y;
+            default: return GUARD_BAND * p.w - p.y;
+            }
+        };
+
+        Vertex poly[9] = { v0, v1, v2 }, next[9];
+        int count = 3;
+        for (int plane = 0; plane < 6; ++plane)
+        {
+            bool allInside = true;
+            for (int i = 0; i < count; ++i)
+                allInside = allInside && distance(poly[i].clip, plane) >= 0.0f;
+            if (allInside)
+                continue;
+            int out = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                const Vertex& a = poly[i];
+                const Vertex& b = poly[(i + 1) % count];
+                float da = distance(a.clip, plane), db = distance(b.clip, plane);
+                if (da >= 0.0f)
+                    next[out++] = a;
+                if ((da >= 0.0f) != (db >= 0.0f))
+                {
+                    float t = da / (da - db);
+                    next[out].clip = glm::mix(a.clip, b.clip, t);
+                    next[out].uv = glm::mix(a.uv, b.uv, t);
+                    ++out;
+                }
+            }
+            count = out;
+            if (count < 3)
+                return;
+            std::copy(next, next + count, poly);
+        }
+
+        for (int i = 1; i + 1 < count; ++i)
+            setup(poly[0], poly[i], poly[i + 1], s);
+    }
+
+    void setup(const Vertex& v0, const Vertex& v1, const Vertex& v2, const Shading& s)
+    {
+        const Vertex* v[3] = { &v0, &v1, &v2 };
+        int64_t X[3], Y[3];
+        float sx[3], sy[3], sz[3], iw[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            float w = 1.0f / v[i]->clip.w;
+            X[i] = (int64_t)std::llround((v[i]->clip.x * w * 0.5f + 0.5f) * (float)width * (float)SUBPIXEL);
+            Y[i] = (int64_t)std::llround((v[i]->clip.y * w * 0.5f + 0.5f) * (float)height * (float)SUBPIXEL);
+            sx[i] = (float)X[i] / (float)SUBPIXEL;
+            sy[i] = (float)Y[i] / (float)SUBPIXEL;
+            sz[i] = v[i]->clip.z * w * 0.5f + 0.5f;
+            iw[i] = w;
+        }
+
+        int64_t area = (X[1] - X[0]) * (Y[2] - Y[0]) - (X[2] - X[0]) * (Y[1] - Y[0]);
+        if (area == 0)
+            return;
+        // Отбраковки граней нет — обход приводим к положительной площади
+        int order[3] = { 0, 1, 2 };
+        if (area < 0)
+            std::swap(order[1], order[2]);
+
+        Triangle t;
+        t.shading = s;
+        for (int e = 0; e < 3; ++e)
+        {
+            int i = order[e], j = order[(e + 1) % 3];
+            t.a[e] = Y[i] - Y[j];
+            t.b[e] = X[j] - X[i];
+            t.c[e] = -(t.a[e] * X[i] + t.b[e] * Y[i]);
+            // Правило верхнего левого ребра: на «чужих» рёбрах точка снаружи
+            bool topLeft = t.b[e] < 0 || (t.b[e] == 0 && t.a[e] < 0);
+            if (!topLeft)
+                t.c[e] -= 1;
+        }
+
+        int64_t minX = std::min({ X[0], X[1], X[2] }), maxX = std::max({ X[0], X[1], X[2] });
+        int64_t minY = std::min({ Y[0], Y[1], Y[2] }), maxY = std::max({ Y[0], Y[1], Y[2] });
+        t.minX = (int)std::max<int64_t>(minX >> SUBPIXEL_BITS, 0);
+        t.minY = (int)std::max<int64_t>(minY >> SUBPIXEL_BITS, 0);
+        t.maxX = (int)std::min<int64_t>(maxX >> SUBPIXEL_BITS, width - 1);
+        t.maxY = (int)std::min<int64_t>(maxY >> SUBPIXEL_BITS, height - 1);
+        if (t.minX > t.maxX || t.minY > t.maxY)
+            return;
+
+        // Глубина линейна в экране; uv — с перспективной коррекцией, через u/w и 1/w
+        auto plane = [&](float a0, float a1, float a2)
+        {
+            double det = (double)(sx[1] - sx[0]) * (sy[2] - sy[0]) - (double)(sx[2] - sx[0]) * (sy[1] - sy[0]);
+            double dx = ((double)(a1 - a0) * (sy[2] - sy[0]) - (double)(a2 - a0) * (sy[1] - sy[0])) / det;
+            double dy = ((double)(a2 - a0) * (sx[1] - sx[0]) - (double)(a1 - a0) * (sx[2] - sx[0])) / det;
+            return Plane{ (float)dx, (float)dy, (float)(a0 - dx * sx[0] - dy * sy[0]) };
+        };
+        t.z = plane(sz[0], sz[1], sz[2]);
+        t.invW = plane(iw[0], iw[1], iw[2]);
+        t.uOverW = plane(v0.uv.x * iw[0], v1.uv.x * iw[1], v2.uv.x * iw[2]);
+        t.vOverW = plane(v0.uv.y * iw[0], v1.uv.y * iw[1], v2.uv.y * iw[2]);
+        triangles.push_back(t);
+    }
+
+    // Функции рёбер в крайних центрах пикселей тайла: если самый «внутренний»
+    // угол снаружи ребра — тайл пропускаем, если самый «внешний» внутри всех — красим без проверок
+    TileCoverage classifyTile(const Triangle& t, int tx, int ty) const
+    {
+        int64_t x0 = ((int64_t)(tx * TILE) << SUBPIXEL_BITS) + SUBPIXEL / 2;
+        int64_t y0 = ((int64_t)(ty * TILE) << SUBPIXEL_BITS) + SUBPIXEL / 2;
+        int64_t x1 = ((int64_t)(std::min((tx + 1) * TILE, width) - 1) << SUBPIXEL_BITS) + SUBPIXEL / 2;
+        int64_t y1 = ((int64_t)(std::min((ty + 1) * TILE, height) - 1) << SUBPIXEL_BITS) + SUBPIXEL / 2;
+        bool full = true;
+        for (int e = 0; e < 3; ++e)
+        {
+            int64_t inner = t.a[e] * (t.a[e] > 0 ? x1 : x0) + t.b[e] * (t.b[e] > 0 ? y1 : y0) + t.c[e];
+            if (inner < 0)
+                return TILE_OUTSIDE;
+            int64_t outer = t.a[e] * (t.a[e] > 0 ? x0 : x1) + t.b[e] * (t.b[e] > 0 ? y0 : y1) + t.c[e];
+            full = full && outer >= 0;
+        }
+        return full ? TILE_FULL : TILE_PARTIAL;
+    }
+
+    void rasterizeTile(int tx, int ty)
+    {
+        int x0 = tx * TILE, y0 = ty * TILE;
+        int x1 = std::min(x0 + TILE, width) - 1, y1 = std::min(y0 + TILE, height) - 1;
+        for (int y = y0; y <= y1; ++y)
+        {
+            std::fill(&color[(size_t)y * width + x0], &color[(size_t)y * width + x1] + 1, clearValue);
+            std::fill(&depth[(size_t)y * width + x0], &depth[(size_t)y * width + x1] + 1, 1.0f);
+            std::fill(&translucent[(size_t)y * width + x0], &translucent[(size_t)y * width + x1] + 1, 0);
+        }
+
+        for (uint32_t entry : bins[(size_t)ty * tilesX + tx])
+        {
+            const Triangle& t = triangles[entry & ~FULL_TILE_BIT];
+            if (entry & FULL_TILE_BIT)
+            {
+                for (int y = y0; y <= y1; ++y)
+                    shadeRun(t, x0, x1, y);
+                continue;
+            }
+            int minX = std::max(t.minX, x0), maxX = std::min(t.maxX, x1);
+            int minY = std::max(t.minY, y0), maxY = std::min(t.maxY, y1);
+            for (int y = minY; y <= maxY; ++y)
+                rasterizeSpan(t, minX, maxX, x1, y);
+        }
+
+        // Затенению нужна глубина непрозрачного: где поверх остался дым,
+        // глубина возвращается к той, что была под ним
+        for (int y = y0; y <= y1; ++y)
+            for (size_t index = (size_t)y * width + x0; index <= (size_t)y * width + x1; ++index)
+                if (translucent[index])
+                {
+                    if (depth[index] == smokeDepth[index])
+                        depth[index] = opaqueDepth[index];
+                    else
+                        translucent[index] = 0;
+                }
+    }
+
+    // Пиксели [minX, maxX] строки целиком внутри треугольника
+    void shadeRun(const Triangle& t, int minX, int maxX, int y)
+    {
+        int x = minX;
+#ifdef MID_RASTER_SSE2
+        if (t.shading.kind == SHADE_FLAT)
+            for (; x + 3 <= maxX; x += 4)
+                shadeFlat4(t, x, y, 0xF);
+#endif
+        for (; x <= maxX; ++x)
+            shade(t, x, y);
+    }
+
+    // Функции рёбер в центрах пикселей строки; четыре пикселя за шаг.
+    // limitX — правый край тайла: дальше него память соседнего потока.
+    void rasterizeSpan(const Triangle& t, int minX, int maxX, int limitX, int y)
+    {
+        int64_t py = ((int64_t)y << SUBPIXEL_BITS) + SUBPIXEL / 2;
+        int64_t px = ((int64_t)minX << SUBPIXEL_BITS) + SUBPIXEL / 2;
+        int64_t e[3], step[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            e[i] = t.a[i] * px + t.b[i] * py + t.c[i];
+            step[i] = t.a[i] * SUBPIXEL;
+        }
+
+#ifdef MID_RASTER_SSE2
+        __m128i lo[3], hi[3], step4[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            lo[i] = _mm_set_epi64x(e[i] + step[i], e[i]);
+            hi[i] = _mm_set_epi64x(e[i] + 3 * step[i], e[i] + 2 * step[i]);
+            step4[i] = _mm_set1_epi64x(4 * step[i]);
+        }
+        for (int x = minX; x <= maxX; x += 4)
+        {
+            // Знаковый бит ИЛИ трёх функций — пиксель хоть за одним ребром
+            __m128i outLo = _mm_or_si128(_mm_or_si128(lo[0], lo[1]), lo[2]);
+            __m128i outHi = _mm_or_si128(_mm_or_si128(hi[0], hi[1]), hi[2]);
+            int outside = _mm_movemask_pd(_mm_castsi128_pd(outLo)) | _mm_movemask_pd(_mm_castsi128_pd(outHi)) << 2;
+            int inside = ~outside & 0xF;
+            if (maxX - x < 3)
+                inside &= (1 << (maxX - x + 1)) - 1;
+            if (inside && t.shading.kind == SHADE_FLAT && x + 3 <= limitX)
+                shadeFlat4(t, x, y, inside);
+            else
+                for (int k = 0; inside; ++k, inside >>= 1)
+                    if (inside & 1)
+                        shade(t, x + k, y);
+            for (int i = 0; i < 3; ++i)
+            {
+                lo[i] = _mm_add_epi64(lo[i], step4[i]);
+                hi[i] = _mm_add_epi64(hi[i], step4[i]);
+            }
+        }
+#else
+        (void)limitX;
+        for (int x = minX; x <= maxX; ++x)
+        {
+            if ((e[0] | e[1] | e[2]) >= 0)
+                shade(t, x, y);
+            for (int i = 0; i < 3; ++i)
+                e[i] += step[i];
+        }
+#endif
+    }
+
+#ifdef MID_RASTER_SSE2
+    // Плоский цвет для четырёх пикселей подряд; mask — какие из них покрыты.
+    // Глубина считается в том же порядке операций, что в shade().
+    void shadeFlat4(const Triangle& t, int x, int y, int mask)
+    {
+        size_t index = (size_t)y * width + x;
+        __m128 fx = _mm_add_ps(_mm_set1_ps((float)x + 0.5f), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+        __m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(fx, _mm_set1_ps(t.z.dx)),
+                                         _mm_set1_ps(t.z.dy * ((float)y + 0.5f))),
+                              _mm_set1_ps(t.z.c));
+        __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
+        __m128i lanes = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(mask), bits), bits);
+
+        __m128 d = _mm_loadu_ps(&depth[index]);
+        __m128 pass = _mm_and_ps(_mm_cmplt_ps(z, d), _mm_castsi128_ps(lanes));
+        if (!_mm_movemask_ps(pass))
+            return;
+        _mm_storeu_ps(&depth[index], _mm_or_ps(_mm_and_ps(pass, z), _mm_andnot_ps(pass, d)));
+
+        __m128i p = _mm_castps_si128(pass);
+        __m128i c = _mm_loadu_si128((const __m128i*)&color[index]);
+        __m128i src = _mm_set1_epi32((int)t.shading.color);
+        _mm_storeu_si128((__m128i*)&color[index], _mm_or_si128(_mm_and_si128(p, src), _mm_andnot_si128(p, c)));
+    }
+#endif
+
+    void shade(const Triangle& t, int x, int y)
+    {
+        float fx = (float)x + 0.5f, fy = (float)y + 0.5f;
+        size_t index = (size_t)y * width + x;
+        float z = t.z.at(fx, fy);
+        if (!(z < depth[index]))
+            return;
+
+        if (t.shading.kind == SHADE_FLAT)
+        {
+            // Альфа 1: смешивание SRC_ALPHA/ONE_MINUS_SRC_ALPHA оставляет источник
+            color[index] = t.shading.color;
+            depth[index] = z;
+            return;
+        }
+
+        // Повторяет particleFS
+        float w = 1.0f / t.invW.at(fx, fy);
+        float u = t.uOverW.at(fx, fy) * w, v = t.vOverW.at(fx, fy) * w;
+        float d = std::sqrt((u - 0.5f) * (u - 0.5f) + (v - 0.5f) * (v - 0.5f));
+        if (d > 0.5f)
+            return;
+        float edge = glm::smoothstep(0.5f, 0.25f, d);
+        float gAlpha = t.shading.alpha;
+        float alpha = gAlpha * edge * 0.8f;
+        glm::vec3 rgb = glm::mix(glm::vec3(0.85f, 0.88f, 0.92f), glm::vec3(0.9f, 0.9f, 0.95f), 1.0f - gAlpha);
+
+        // Приёмник RGBA8 — как у GL: смешивание в float, округление до ближайшего
+        uint32_t dst = color[index];
+        float src[4] = { rgb.r, rgb.g, rgb.b, alpha };
+        uint32_t out = 0;
+        for (int ch = 0; ch < 4; ++ch)
+        {
+            float v = src[ch] * alpha * 255.0f + (float)(dst >> (ch * 8) & 0xFF) * (1.0f - alpha);
+            out |= (uint32_t)std::min(v + 0.5f, 255.0f) << (ch * 8);
+        }
+        color[index] = out;
+        if (!translucent[index])
+        {
+            translucent[index] = 1;
+            opaqueDepth[index] = depth[index];
+        }
+        depth[index] = z;
+        smokeDepth[index] = z;
+    }
+
+    ThreadPool& pool;
+    int width, height;
+    int tilesX, tilesY;
+
+    std::vector<uint32_t> color;
+    std::vector<float> depth;
+    uint32_t clearValue = 0;
+
+    // Пиксели под дымом: глубина непрозрачного под ним и последнего слоя дыма
+    std::vector<uint8_t> translucent;
+    std::vector<float> opaqueDepth, smokeDepth;
+
+    glm::mat4 proj = glm::mat4(1.0f), view = glm::mat4(1.0f), viewProj = glm::mat4(1.0f);
+    std::vector<glm::vec3> particles;
+    std::vector<Triangle> triangles;
+    std::vector<std::vector<uint32_t>> bins;
+    GroundTruthAO ao;
+};
@@ -0,0 +1,359 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cstddef>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MID_REDUCE_SSE2 1
+#endif
+
+#include "tasks.h"
+
+// Свёртки массивов vec3/vec4: рамка, min/max, сумма, центр и ковариация —
+// замена покомпонентным compMin/compMax/compAdd и
+// pca::computeCovarianceMatrix для больших массивов.
+// Массив режется на куски по CHUNK; куски считаются по четыре точки за раз
+// (SSE2), с пулом — параллельно, и складываются по порядку. Суммы внутри
+// куска идут блоками по BLOCK во float и копятся в double, поэтому результат
+// не зависит от числа потоков и не теряет точность на миллионах точек.
+namespace span_reduce
+{
+constexpr size_t CHUNK = 1 << 15;
+constexpr size_t BLOCK = 256;
+
+// Каждый кусок считает kernel(begin, end) -> Partial, затем combine по порядку
+template <class Partial, class Kernel, class Combine>
+Partial reduceChunks(size_t count, ThreadPool* pool, const Partial& identity, Kernel&& kernel, Combine&& combine)
+{
+    size_t chunks = (count + CHUNK - 1) / CHUNK;
+    if (chunks <= 1 || !pool)
+    {
+        Partial result = identity;
+        for (size_t c = 0; c < chunks; ++c)
+            result = combine(result, kernel(c * CHUNK, std::min(count, (c + 1) * CHUNK)));
+        return result;
+    }
+    std::vector<Partial> partial(chunks, identity);
+    pool->parallelFor(chunks, 1, [&](size_t begin, size_t end)
+    {
+        for (size_t c = begin; c < end; ++c)
+            partial[c] = kernel(c * CHUNK, std::min(count, (c + 1) * CHUNK));
+    });
+    Partial result = identity;
+    for (const Partial& p : partial)
+        result = combine(result, p);
+    return result;
+}
+
+#ifdef MID_REDUCE_SSE2
+// Четыре vec3 подряд (три загрузки) -> x, y, z по четырём точкам
+inline void load3x4(const glm::vec3* p, __m128& x, __m128& y, __m128& z)
+{
+    const float* f = &p[0].x;
+    __m128 v0 = _mm_loadu_ps(f), v1 = _mm_loadu_ps(f + 4), v2 = _mm_loadu_ps(f + 8);
+    __m128 x23 = _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 1, 2, 2));
+    x = _mm_shuffle_ps(v0, x23, _MM_SHUFFLE(2, 0, 3, 0));
+    __m128 y01 = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 1, 1));
+    __m128 y23 = _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 2, 3, 3));
+    y = _mm_shuffle_ps(y01, y23, _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 z01 = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2));
+    __m128 z23 = _mm_shuffle_ps(v2, v2, _MM_SHUFFLE(3, 3, 0, 0));
+    z = _mm_shuffle_ps(z01, z23, _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+inline float laneMin(__m128 v)
+{
+    v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm_cvtss_f32(_mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1))));
+}
+
+inline float laneMax(__m128 v)
+{
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm_cvtss_f32(_mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1))));
+}
+
+inline double laneSum(__m128 v)
+{
+    alignas(16) float f[4];
+    _mm_store_ps(f, v);
+    return ((double)f[0] + f[1]) + ((double)f[2] + f[3]);
+}
+#endif
+
+struct MinMax3
+{
+    glm::vec3 min, max;
+};
+
+inline MinMax3 minMax(const glm::vec3* p, size_t begin, size_t end)
+{
+    MinMax3 r = { glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX) };
+    size_t i = begin;
+#ifdef MID_REDUCE_SSE2
+    if (end - begin >= 4)
+    {
+        __m128 loX = _mm_set1_ps(FLT_MAX), loY = loX, loZ = loX;
+        __m128 hiX = _mm_set1_ps(-FLT_MAX), hiY = hiX, hiZ = hiX;
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 x, y, z;
+            load3x4(p + i, x, y, z);
+            loX = _mm_min_ps(loX, x); hiX = _mm_max_ps(hiX, x);
+            loY = _mm_min_ps(loY, y); hiY = _mm_max_ps(hiY, y);
+            loZ = _mm_min_ps(loZ, z); hiZ = _mm_max_ps(hiZ, z);
+        }
+        r.min = glm::vec3(laneMin(loX), laneMin(loY), laneMin(loZ));
+        r.max = glm::vec3(laneMax(hiX), laneMax(hiY), laneMax(hiZ));
+    }
+#endif
+    for (; i < end; ++i)
+    {
+        r.min = glm::min(r.min, p[i]);
+        r.max = glm::max(r.max, p[i]);
+    }
+    return r;
+}
+
+struct MinMax4
+{
+    glm::vec4 min, max;
+};
+
+inline MinMax4 minMax(const glm::vec4* p, size_t begin, size_t end)
+{
+    MinMax4 r = { glm::vec4(FLT_MAX), glm::vec4(-FLT_MAX) };
+    size_t i = begin;
+#ifdef MID_REDUCE_SSE2
+    __m128 lo = _mm_set1_ps(FLT_MAX), hi = _mm_set1_ps(-FLT_MAX);
+    __m128 lo1 = lo, hi1 = hi;
+    for (; i + 2 <= end; i += 2)
+    {
+        __m128 a = _mm_loadu_ps(&p[i].x), b = _mm_loadu_ps(&p[i + 1].x);
+        lo = _mm_min_ps(lo, a); hi = _mm_max_ps(hi, a);
+        lo1 = _mm_min_ps(lo1, b); hi1 = _mm_max_ps(hi1, b);
+    }
+    _mm_storeu_ps(&r.min.x, _mm_min_ps(lo, lo1));
+    _mm_storeu_ps(&r.max.x, _mm_max_ps(hi, hi1));
+#endif
+    for (; i < end; ++i)
+    {
+        r.min = glm::min(r.min, p[i]);
+        r.max = glm::max(r.max, p[i]);
+    }
+    return r;
+}
+
+inline glm::dvec3 sum(const glm::vec3* p, size_t begin, size_t end)
+{
+    glm::dvec3 r(0.0);
+    size_t i = begin;
+#ifdef MID_REDUCE_SSE2
+    while (end - i >= 4)
+    {
+        size_t blockEnd = std::min(end, i + BLOCK);
+        __m128 sx = _mm_setzero_ps(), sy = sx, sz = sx;
+        for (; i + 4 <= blockEnd; i += 4)
+        {
+            __m128 x, y, z;
+            load3x4(p + i, x, y, z);
+            sx = _mm_add_ps(sx, x);
+            sy = _mm_add_ps(sy, y);
+            sz = _mm_add_ps(sz, z);
+        }
+        r += glm::dvec3(laneSum(sx), laneSum(sy), laneSum(sz));
+    }
+#endif
+    while (i < end)
+    {
+        size_t blockEnd = std::min(end, i + BLOCK);
+        glm::vec3 s(0.0f);
+        for (; i < blockEnd; ++i)
+            s += p[i];
+        r += glm::dvec3(s);
+    }
+    return r;
+}
+
+inline glm::dvec4 sum(const glm::vec4* p, size_t begin, size_t end)
+{
+    glm::dvec4 r(0.0);
+    size_t i = begin;
+    while (i < end)
+    {
+        size_t blockEnd = std::min(end, i + BLOCK);
+#ifdef MID_REDUCE_SSE2
+        __m128 s0 = _mm_setzero_ps(), s1 = s0;
+        for (; i + 2 <= blockEnd; i += 2)
+        {
+            s0 = _mm_add_ps(s0, _mm_loadu_ps(&p[i].x));
+            s1 = _mm_add_ps(s1, _mm_loadu_ps(&p[i + 1].x));
+        }
+        if (i < blockEnd)
+            s0 = _mm_add_ps(s0, _mm_loadu_ps(&p[i++].x));
+        glm::vec4 s;
+        _mm_storeu_ps(&s.x, _mm_add_ps(s0, s1));
+#else
+        glm::vec4 s(0.0f);
+        for (; i < blockEnd; ++i)
+            s += p[i];
+#endif
+        r += glm::dvec4(s);
+    }
+    return r;
+}
+
+// Сумма (p - c)(p - c)^T: xx, yy, zz, xy, xz, yz
+struct Moments
+{
+    double m[6] = {};
+};
+
+inline Moments secondMoments(const glm::vec3* p, size_t begin, size_t end, const glm::vec3& c)
+{
+    Moments r;
+    size_t i = begin;
+#ifdef MID_REDUCE_SSE2
+    __m128 cx = _mm_set1_ps(c.x), cy = _mm_set1_ps(c.y), cz = _mm_set1_ps(c.z);
+    while (end - i >= 4)
+    {
+        size_t blockEnd = std::min(end, i + BLOCK);
+        __m128 s[6] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(),
+                        _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+        for (; i + 4 <= blockEnd; i += 4)
+        {
+            __m128 x, y, z;
+            load3x4(p + i, x, y, z);
+            x = _mm_sub_ps(x, cx);
+            y = _mm_sub_ps(y, cy);
+            z = _mm_sub_ps(z, cz);
+            s[0] = _mm_add_ps(s[0], _mm_mul_ps(x, x));
+            s[1] = _mm_add_ps(s[1], _mm_mul_ps(y, y));
+            s[2] = _mm_add_ps(s[2], _mm_mul_ps(z, z));
+            s[3] = _mm_add_ps(s[3], _mm_mul_ps(x, y));
+            s[4] = _mm_add_ps(s[4], _mm_mul_ps(x, z));
+            s[5] = _mm_add_ps(s[5], _mm_mul_ps(y, z));
+        }
+        for (int k = 0; k < 6; ++k)
+            r.m[k] += laneSum(s[k]);
+    }
+#endif
+    while (i < end)
+    {
+        size_t blockEnd = std::min(end, i + BLOCK);
+        float s[6] = {};
+        for (; i < blockEnd; ++i)
+        {
+            glm::vec3 d = p[i] - c;
+            s[0] += d.x * d.x;
+            s[1] += d.y * d.y;
+            s[2] += d.z * d.z;
+            s[3] += d.x * d.y;
+            s[4] += d.x * d.z;
+            s[5] += d.y * d.z;
+        }
+        for (int k = 0; k < 6; ++k)
+            r.m[k] += s[k];
+    }
+    return r;
+}
+} // namespace span_reduce
+
+// Осевая рамка точек; у пустого массива min = FLT_MAX, max = -FLT_MAX
+struct Bounds
+{
+    glm::vec3 min, max;
+};
+
+inline Bounds reduceBounds(const glm::vec3* points, size_t count, ThreadPool* pool = nullptr)
+{
+    using namespace span_reduce;
+    MinMax3 r = reduceChunks(count, pool, MinMax3{ glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX) },
+                             [points](size_t begin, size_t end) { return minMax(points, begin, end); },
+                             [](const MinMax3& a, const MinMax3& b) { return MinMax3{ glm::min(a.min, b.min), glm::max(a.max, b.max) }; });
+    return { r.min, r.max };
+}
+
+inline glm::vec3 reduceMin(const glm::vec3* values, size_t count, ThreadPool* pool = nullptr)
+{
+    return reduceBounds(values, count, pool).min;
+}
+
+inline glm::vec3 reduceMax(const glm::vec3* values, size_t count, ThreadPool* pool = nullptr)
+{
+    return reduceBounds(values, count, pool).max;
+}
+
+inline void reduceMinMax(const glm::vec4* values, size_t count, glm::vec4& min, glm::vec4& max, ThreadPool* pool = nullptr)
+{
+    using namespace span_reduce;
+    MinMax4 r = reduceChunks(count, pool, MinMax4{ glm::vec4(FLT_MAX), glm::vec4(-FLT_MAX) },
+                             [values](size_t begin, size_t end) { return minMax(values, begin, end); },
+                             [](const MinMax4& a, const MinMax4& b) { return MinMax4{ glm::min(a.min, b.min), glm::max(a.max, b.max) }; });
+    min = r.min;
+    max = r.max;
+}
+
+inline glm::vec4 reduceMin(const glm::vec4* values, size_t count, ThreadPool* pool = nullptr)
+{
+    glm::vec4 min, max;
+    reduceMinMax(values, count, min, max, pool);
+    return min;
+}
+
+inline glm::vec4 reduceMax(const glm::vec4* values, size_t count, ThreadPool* pool = nullptr)
+{
+    glm::vec4 min, max;
+    reduceMinMax(values, count, min, max, pool);
+    return max;
+}
+
+inline glm::dvec3 reduceSum(const glm::vec3* values, size_t count, ThreadPool* pool = nullptr)
+{
+    using namespace span_reduce;
+    return reduceChunks(count, pool, glm::dvec3(0.0), [values](size_t begin, size_t end) { return sum(values, begin, end); },
+                        [](const glm::dvec3& a, const glm::dvec3& b) { return a + b; });
+}
+
+inline glm::dvec4 reduceSum(const glm::vec4* values, size_t count, ThreadPool* pool = nullptr)
+{
+    using namespace span_reduce;
+    return reduceChunks(count, pool, glm::dvec4(0.0), [values](size_t begin, size_t end) { return sum(values, begin, end); },
+                        [](const glm::dvec4& a, const glm::dvec4& b) { return a + b; });
+}
+
+inline glm::vec3 reduceCentroid(const glm::vec3* points, size_t count, ThreadPool* pool = nullptr)
+{
+    return count ? glm::vec3(reduceSum(points, count, pool) / (double)count) : glm::vec3(0.0f);
+}
+
+// Ковариация относительно center, делённая на count — как
+// glm::computeCovarianceMatrix(points, count, center)
+inline glm::mat3 reduceCovariance(const glm::vec3* points, size_t count, const glm::vec3& center, ThreadPool* pool = nullptr)
+{
+    using namespace span_reduce;
+    if (count == 0)
+        return glm::mat3(0.0f);
+    Moments r = reduceChunks(count, pool, Moments(),
+                             [points, center](size_t begin, size_t end) { return secondMoments(points, begin, end, center); },
+                             [](Moments a, const Moments& b)
+                             {
+                                 for (int k = 0; k < 6; ++k)
+                                     a.m[k] += b.m[k];
+                                 return a;
+                             });
+    double n = (double)count;
+    float xx = (float)(r.m[0] / n), yy = (float)(r.m[1] / n), zz = (float)(r.m[2] / n);
+    float xy = (float)(r.m[3] / n), xz = (float)(r.m[4] / n), yz = (float)(r.m[5] / n);
+    return glm::mat3(xx, xy, xz, xy, yy, yz, xz, yz, zz);
+}
+
+inline glm::mat3 reduceCovariance(const glm::vec3* points, size_t count, ThreadPool* pool = nullptr)
+{
+    return reduceCovariance(points, count, reduceCentroid(points, count, pool), pool);
+}
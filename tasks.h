@@ -0,0 +1,556 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Пул потоков с кражей работы: у каждого воркера своя очередь,
+// свободный воркер забирает задачи из чужих очередей.
+class ThreadPool
+{
+public:
+    using Job = std::function<void()>;
+
+    explicit ThreadPool(unsigned threadCount = 0)
+    {
+        if (threadCount == 0)
+        {
+            unsigned hw = std::thread::hardware_concurrency();
+            threadCount = hw > 1 ? hw - 1 : 1; // один поток остаётся рендеру
+        }
+
+        for (unsigned i = 0; i < threadCount; ++i)
+            workers.push_back(std::make_unique<Worker>());
+        for (unsigned i = 0; i < threadCount; ++i)
+            threads.emplace_back([this, i] { run(i); });
+    }
+
+    // Очереди дорабатываются до конца: брошенная задача — это корутина, которая
+    // никогда не продолжится, со всеми ресурсами своего кадра. Задачи, которые
+    // снова ставят себя в пул, должны к этому моменту остановиться сами.
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : threads)
+            t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return (unsigned)workers.size(); }
+
+    void submit(Job job)
+    {
+        // Из воркера кладём в свою очередь (LIFO, тёплый кэш), снаружи — по кругу
+        unsigned index = (currentPool == this)
+            ? currentIndex
+            : next.fetch_add(1, std::memory_order_relaxed) % size();
+
+        // Счётчик — до публикации: иначе воркер успеет взять задачу и уменьшить его первым
+        pending.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(workers[index]->mutex);
+            workers[index]->jobs.push_back(std::move(job));
+        }
+
+        if (sleeping.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            wake.notify_one();
+        }
+    }
+
+    // Делит [0, count) на куски по grain и выполняет body(begin, end) параллельно.
+    // Вызывающий поток тоже берёт куски, поэтому вызов из воркера не блокирует пул.
+    template <class F>
+    void parallelFor(size_t count, size_t grain, F&& body)
+    {
+        if (count == 0)
+            return;
+        if (grain == 0)
+            grain = 1;
+
+        size_t chunks = (count + grain - 1) / grain;
+        if (chunks == 1)
+        {
+            body(size_t(0), count);
+            return;
+        }
+
+        struct Shared
+        {
+            std::atomic<size_t> nextChunk{ 0 };
+            std::atomic<size_t> doneChunks{ 0 };
+            std::mutex mutex;
+            std::condition_variable done;
+        };
+        auto shared = std::make_shared<Shared>();
+
+        auto work = [shared, chunks, grain, count, &body]
+        {
+            size_t c;
+            while ((c = shared->nextChunk.fetch_add(1)) < chunks)
+            {
+                size_t begin = c * grain;
+                size_t end = begin + grain < count ? begin + grain : count;
+                body(begin, end);
+                if (shared->doneChunks.fetch_add(1) + 1 == chunks)
+                {
+                    std::lock_guard<std::mutex> lock(shared->mutex);
+                    shared->done.notify_all();
+                }
+            }
+        };
+
+        size_t helpers = std::min<size_t>(chunks - 1, size());
+        for (size_t i = 0; i < helpers; ++i)
+            submit(work);
+        work();
+
+        std::unique_lock<std::mutex> lock(shared->mutex);
+        shared->done.wait(lock, [&] { return shared->doneChunks.load() == chunks; });
+    }
+
+    // co_await pool.schedule() — продолжить корутину на одном из воркеров
+    auto schedule()
+    {
+        struct Awaiter
+        {
+            ThreadPool* pool;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { pool->submit([h] { h.resume(); }); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{ this };
+    }
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    bool popLocal(unsigned index, Job& out)
+    {
+        Worker& w = *workers[index];
+        std::lock_guard<std::mutex> lock(w.mutex);
+        if (w.jobs.empty())
+            return false;
+        out = std::move(w.jobs.back());
+        w.jobs.pop_back();
+        return true;
+    }
+
+    bool steal(unsigned thief, Job& out)
+    {
+        unsigned n = size();
+        for (unsigned k = 1; k < n; ++k)
+        {
+            Worker& w = *workers[(thief + k) % n];
+            std::lock_guard<std::mutex> lock(w.mutex);
+            if (w.jobs.empty())
+                continue;
+            out = std::move(w.jobs.front());
+            w.jobs.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void run(unsigned index)
+    {
+        currentPool = this;
+        currentIndex = index;
+
+        Job job;
+        for (;;)
+        {
+            if (popLocal(index, job) || steal(index, job))
+            {
+                pending.fetch_sub(1);
+                job();
+                job = nullptr;
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleeping.fetch_add(1);
+            wake.wait(lock, [this] { return stopping || pending.load() > 0; });
+            sleeping.fetch_sub(1);
+            if (stopping && pending.load() == 0)
+                return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<size_t> pending{ 0 };
+    std::atomic<unsigned> sleeping{ 0 };
+    std::atomic<unsigned> next{ 0 };
+    bool stopping = false;
+
+    inline static thread_local ThreadPool* currentPool = nullptr;
+    inline static thread_local unsigned currentIndex = 0;
+};
+
+// Очередь рендер-потока: корутины, которым нужен GL-контекст,
+// продолжаются здесь, когда главный цикл вызывает drain().
+class RenderQueue
+{
+public:
+    auto schedule()
+    {
+        struct Awaiter
+        {
+            RenderQueue* queue;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { queue->push(h, nullptr); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{ this };
+    }
+
+    // Продолжить корутину, когда ready() вернёт true; опрашивается в drain()
+    auto until(std::function<bool()> ready)
+    {
+        struct Awaiter
+        {
+            RenderQueue* queue;
+            std::function<bool()> ready;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { queue->push(h, std::move(ready)); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{ this, std::move(ready) };
+    }
+
+    // Отдать остаток кадра: продолжить на следующем drain()
+    auto nextFrame() { return schedule(); }
+
+    // Для собственных awaiter'ов, которые приостанавливаются в другом потоке
+    void resumeWhen(std::coroutine_handle<> h, std::function<bool()> ready) { push(h, std::move(ready)); }
+
+    // Вызывается раз в кадр на рендер-потоке. Что не уложилось в бюджет — ждёт следующего кадра.
+    void drain(std::chrono::microseconds budget = std::chrono::microseconds(2000))
+    {
+        auto deadline = std::chrono::steady_clock::now() + budget;
+
+        std::vector<Entry> batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            batch.swap(entries);
+        }
+
+        std::vector<Entry> deferred;
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            Entry& e = batch[i];
+            if (std::chrono::steady_clock::now() > deadline || (e.ready && !e.ready()))
+            {
+                deferred.push_back(std::move(e));
+                continue;
+            }
+            e.handle.resume();
+        }
+
+        if (!deferred.empty())
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            entries.insert(entries.begin(),
+                std::make_move_iterator(deferred.begin()),
+                std::make_move_iterator(deferred.end()));
+        }
+    }
+
+private:
+    struct Entry
+    {
+        std::coroutine_handle<> handle;
+        std::function<bool()> ready;
+    };
+
+    void push(std::coroutine_handle<> h, std::function<bool()> ready)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.push_back({ h, std::move(ready) });
+    }
+
+    std::mutex mutex;
+    std::vector<Entry> entries;
+};
+
+template <class T = void>
+class Task;
+
+namespace detail
+{
+    struct TaskPromiseBase
+    {
+        std::coroutine_handle<> continuation;
+        std::exception_ptr error;
+        std::atomic<bool> finished{ false }; // для Task::done() из другого потока
+
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+
+            template <class P>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept
+            {
+                std::coroutine_handle<> c = h.promise().continuation;
+                h.promise().finished.store(true, std::memory_order_release);
+                return c ? c : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    template <class T>
+    struct TaskPromise : TaskPromiseBase
+    {
+        std::optional<T> value;
+
+        Task<T> get_return_object();
+        void return_value(T v) { value.emplace(std::move(v)); }
+
+        T result()
+        {
+            if (error)
+                std::rethrow_exception(error);
+            return std::move(*value);
+        }
+    };
+
+    template <>
+    struct TaskPromise<void> : TaskPromiseBase
+    {
+        Task<void> get_return_object();
+        void return_void() const noexcept {}
+
+        void result()
+        {
+            if (error)
+                std::rethrow_exception(error);
+        }
+    };
+}
+
+// Ленивая задача: начинает выполняться при co_await,
+// по завершении продолжает ожидающую корутину.
+template <class T>
+class Task
+{
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    Task() = default;
+    explicit Task(std::coroutine_handle<promise_type> h) : handle(h) {}
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (handle)
+                handle.destroy();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    ~Task()
+    {
+        if (handle)
+            handle.destroy();
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    // Запустить без ожидающей корутины; владелец сам дожидается done(),
+    // прокачивая очереди, в которых задача может стоять
+    void start()
+    {
+        if (handle && !handle.done())
+            handle.resume();
+    }
+
+    bool done() const { return !handle || handle.promise().finished.load(std::memory_order_acquire); }
+
+    auto operator co_await() && noexcept
+    {
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept { return !handle || handle.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            T await_resume() { return handle.promise().result(); }
+        };
+        return Awaiter{ handle };
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle;
+};
+
+namespace detail
+{
+    template <class T>
+    Task<T> TaskPromise<T>::get_return_object()
+    {
+        return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+    }
+
+    inline Task<void> TaskPromise<void>::get_return_object()
+    {
+        return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+    }
+
+    // Корутина без владельца: стартует сразу и сама себя уничтожает
+    struct DetachedTask
+    {
+        struct promise_type
+        {
+            DetachedTask get_return_object() const noexcept { return {}; }
+            std::suspend_never initial_suspend() const noexcept { return {}; }
+            std::suspend_never final_suspend() const noexcept { return {}; }
+            void return_void() const noexcept {}
+            void unhandled_exception() const noexcept { std::terminate(); }
+        };
+    };
+
+    struct WhenAllState
+    {
+        std::atomic<size_t> remaining;
+        std::coroutine_handle<> waiter;
+        std::exception_ptr error;
+        std::mutex errorMutex;
+    };
+
+    inline DetachedTask runAndSignal(Task<void> task, std::shared_ptr<WhenAllState> state)
+    {
+        try
+        {
+            co_await std::move(task);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(state->errorMutex);
+            if (!state->error)
+                state->error = std::current_exception();
+        }
+        if (state->remaining.fetch_sub(1) == 1)
+            state->waiter.resume();
+    }
+}
+
+// Запустить задачу «в фоне» без ожидания результата
+inline detail::DetachedTask spawn(Task<void> task)
+{
+    try
+    {
+        co_await std::move(task);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Task error: " << e.what() << "\n";
+    }
+}
+
+// Дождаться всех зависимостей; задачи стартуют одновременно
+inline Task<void> whenAll(std::vector<Task<void>> tasks)
+{
+    if (tasks.empty())
+        co_return;
+
+    auto state = std::make_shared<detail::WhenAllState>();
+    state->remaining = tasks.size() + 1;
+
+    // Указатели, а не владение: временный awaiter должен быть тривиальным
+    struct Awaiter
+    {
+        std::vector<Task<void>>* tasks;
+        const std::shared_ptr<detail::WhenAllState>* state;
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> h)
+        {
+            detail::WhenAllState* s = state->get();
+            s->waiter = h;
+            for (Task<void>& t : *tasks)
+                detail::runAndSignal(std::move(t), *state);
+            // Лишняя единица в счётчике — наша; если все уже закончили, не засыпаем
+            return s->remaining.fetch_sub(1) != 1;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    co_await Awaiter{ &tasks, &state };
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
+
+template <class... Ts>
+Task<void> whenAll(Task<void> first, Ts... rest)
+{
+    std::vector<Task<void>> tasks;
+    tasks.push_back(std::move(first));
+    (tasks.push_back(std::move(rest)), ...);
+    return whenAll(std::move(tasks));
+}
+
+// Чтение файла на воркере; при ошибке — пустой буфер
+inline Task<std::vector<char>> readFileAsync(ThreadPool& pool, std::string path)
+{
+    co_await pool.schedule();
+
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in)
+    {
+        std::cerr << "Failed to open " << path << "\n";
+        co_return std::vector<char>();
+    }
+
+    std::vector<char> data((size_t)in.tellg());
+    in.seekg(0);
+    in.read(data.data(), (std::streamsize)data.size());
+    co_return data;
+}
+
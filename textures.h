@@ -0,0 +1,823 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "asset_io.h"
+#include "tasks.h"
+#include "upload_worker.h"
+
+// Сжатые форматы из расширений: glad сгенерирован только для ядра 3.3
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM 0x8E8D
+#endif
+
+enum TextureFormat
+{
+    TEX_RGBA8,
+    TEX_RGBA8_SRGB,
+    TEX_BC1,
+    TEX_BC1_SRGB,
+    TEX_BC3,
+    TEX_BC3_SRGB,
+    TEX_BC4,
+    TEX_BC5,
+    TEX_BC7,
+    TEX_BC7_SRGB,
+    TEX_FORMAT_COUNT
+};
+
+struct TextureFormatInfo
+{
+    GLenum internalFormat;
+    uint32_t blockBytes;   // байт на блок 4x4, для несжатых — на пиксель
+    bool compressed;
+    const char* name;
+};
+
+inline const TextureFormatInfo& formatInfo(TextureFormat f)
+{
+    static const TextureFormatInfo table[TEX_FORMAT_COUNT] = {
+        { GL_RGBA8, 4, false, "RGBA8" },
+        { GL_SRGB8_ALPHA8, 4, false, "RGBA8_SRGB" },
+        { GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 8, true, "BC1" },
+        { GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT, 8, true, "BC1_SRGB" },
+        { GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 16, true, "BC3" },
+        { GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, 16, true, "BC3_SRGB" },
+        { GL_COMPRESSED_RED_RGTC1, 8, true, "BC4" },
+        { GL_COMPRESSED_RG_RGTC2, 16, true, "BC5" },
+        { GL_COMPRESSED_RGBA_BPTC_UNORM, 16, true, "BC7" },
+        { GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM, 16, true, "BC7_SRGB" },
+    };
+    return table[f];
+}
+
+inline size_t levelBytes(TextureFormat f, uint32_t width, uint32_t height)
+{
+    const TextureFormatInfo& info = formatInfo(f);
+    if (!info.compressed)
+        return (size_t)width * height * info.blockBytes;
+    return (size_t)((width + 3) / 4) * ((height + 3) / 4) * info.blockBytes;
+}
+
+struct TextureLevel
+{
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
+// Описание файла текстуры; levels[0] — самый крупный мип
+struct TextureInfo
+{
+    TextureFormat format = TEX_RGBA8;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<TextureLevel> levels;
+
+    uint32_t levelWidth(uint32_t level) const { return std::max(width >> level, 1u); }
+    uint32_t levelHeight(uint32_t level) const { return std::max(height >> level, 1u); }
+};
+
+namespace detail
+{
+    template<class T>
+    T readAt(const char* data, size_t offset)
+    {
+        T v;
+        std::memcpy(&v, data + offset, sizeof(T));
+        return v;
+    }
+
+    inline bool ktx2Format(uint32_t vkFormat, TextureFormat& out)
+    {
+        switch (vkFormat)
+        {
+        case 37:  out = TEX_RGBA8; return true;        // R8G8B8A8_UNORM
+        case 43:  out = TEX_RGBA8_SRGB; return true;   // R8G8B8A8_SRGB
+        case 131: case 133: out = TEX_BC1; return true;
+        case 132: case 134: out = TEX_BC1_SRGB; return true;
+        case 137: out = TEX_BC3; return true;
+        case 138: out = TEX_BC3_SRGB; return true;
+        case 139: out = TEX_BC4; return true;
+        case 141: out = TEX_BC5; return true;
+        case 145: out = TEX_BC7; return true;
+        case 146: out = TEX_BC7_SRGB; return true;
+        default:  return false;
+        }
+    }
+
+    inline bool dxgiFormat(uint32_t dxgi, TextureFormat& out)
+    {
+        switch (dxgi)
+        {
+        case 28: out = TEX_RGBA8; return true;
+        case 29: out = TEX_RGBA8_SRGB; return true;
+        case 71: out = TEX_BC1; return true;
+        case 72: out = TEX_BC1_SRGB; return true;
+        case 77: out = TEX_BC3; return true;
+        case 78: out = TEX_BC3_SRGB; return true;
+        case 80: out = TEX_BC4; return true;
+        case 83: out = TEX_BC5; return true;
+        case 98: out = TEX_BC7; return true;
+        case 99: out = TEX_BC7_SRGB; return true;
+        default: return false;
+        }
+    }
+
+    inline uint32_t fourCC(const char* s)
+    {
+        return (uint32_t)(uint8_t)s[0] | (uint32_t)(uint8_t)s[1] << 8
+            | (uint32_t)(uint8_t)s[2] << 16 | (uint32_t)(uint8_t)s[3] << 24;
+    }
+}
+
+// KTX2 без суперсжатия: одна 2D-картинка с готовыми мипами
+inline bool parseKTX2(const char* data, size_t size, uint64_t fileSize, TextureInfo& out)
+{
+    static const unsigned char id[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+    if (size < 80 || std::memcmp(data, id, sizeof(id)) != 0)
+        return false;
+
+    uint32_t vkFormat = detail::readAt<uint32_t>(data, 12);
+    uint32_t width = detail::readAt<uint32_t>(data, 20);
+    uint32_t height = detail::readAt<uint32_t>(data, 24);
+    uint32_t depth = detail::readAt<uint32_t>(data, 28);
+    uint32_t layers = detail::readAt<uint32_t>(data, 32);
+    uint32_t faces = detail::readAt<uint32_t>(data, 36);
+    uint32_t levelCount = std::max(detail::readAt<uint32_t>(data, 40), 1u);
+    uint32_t scheme = detail::readAt<uint32_t>(data, 44);
+
+    if (!detail::ktx2Format(vkFormat, out.format) || width == 0 || height == 0
+        || depth > 1 || layers > 1 || faces != 1 || scheme != 0)
+        return false;
+    if (size < 80 + (size_t)levelCount * 24)
+        return false;
+
+    out.width = width;
+    out.height = height;
+    out.levels.resize(levelCount);
+    for (uint32_t l = 0; l < levelCount; ++l)
+    {
+        out.levels[l].offset = detail::readAt<uint64_t>(data, 80 + l * 24);
+        out.levels[l].size = detail::readAt<uint64_t>(data, 80 + l * 24 + 8);
+    }
+    for (uint32_t l = 0; l < levelCount; ++l)
+        if (out.levels[l].offset + out.levels[l].size > fileSize
+            || out.levels[l].size != levelBytes(out.format, out.levelWidth(l), out.levelHeight(l)))
+            return false;
+    return true;
+}
+
+// DDS: DXT1/DXT5/ATI1/ATI2, 32-битный RGBA или заголовок DX10
+inline bool parseDDS(const char* data, size_t size, uint64_t fileSize, TextureInfo& out)
+{
+    if (size < 128 || std::memcmp(data, "DDS ", 4) != 0 || detail::readAt<uint32_t>(data, 4) != 124)
+        return false;
+
+    uint32_t height = detail::readAt<uint32_t>(data, 12);
+    uint32_t width = detail::readAt<uint32_t>(data, 16);
+    uint32_t levelCount = std::max(detail::readAt<uint32_t>(data, 28), 1u);
+    uint32_t pfFlags = detail::readAt<uint32_t>(data, 80);
+    uint32_t code = detail::readAt<uint32_t>(data, 84);
+    uint32_t bitCount = detail::readAt<uint32_t>(data, 88);
+    uint32_t redMask = detail::readAt<uint32_t>(data, 92);
+    uint32_t caps2 = detail::readAt<uint32_t>(data, 112);
+
+    if (width == 0 || height == 0 || (caps2 & 0x200))   // кубы не поддерживаем
+        return false;
+
+    uint64_t offset = 128;
+    if ((pfFlags & 0x4) && code == detail::fourCC("DX10"))
+    {
+        if (size < 148)
+            return false;
+        uint32_t dimension = detail::readAt<uint32_t>(data, 132);
+        uint32_t arraySize = detail::readAt<uint32_t>(data, 140);
+        if (!detail::dxgiFormat(detail::readAt<uint32_t>(data, 128), out.format) || dimension != 3 || arraySize > 1)
+            return false;
+        offset = 148;
+    }
+    else if (pfFlags & 0x4)
+    {
+        if (code == detail::fourCC("DXT1"))
+            out.format = TEX_BC1;
+        else if (code == detail::fourCC("DXT5"))
+            out.format = TEX_BC3;
+        else if (code == detail::fourCC("ATI1") || code == detail::fourCC("BC4U"))
+            out.format = TEX_BC4;
+        else if (code == detail::fourCC("ATI2") || code == detail::fourCC("BC5U"))
+            out.format = TEX_BC5;
+        else
+            return false;
+    }
+    else if ((pfFlags & 0x40) && bitCount == 32 && redMask == 0x000000FF)
+    {
+        out.format = TEX_RGBA8;
+    }
+    else
+    {
+        return false;
+    }
+
+    out.width = width;
+    out.height = height;
+    out.levels.resize(levelCount);
+    for (uint32_t l = 0; l < levelCount; ++l)
+    {
+        out.levels[l].offset = offset;
+        out.levels[l].size = levelBytes(out.format, out.levelWidth(l), out.levelHeight(l));
+        offset += out.levels[l].size;
+    }
+    return offset <= fileSize;
+}
+
+inline bool parseTextureHeader(const char* data, size_t size, uint64_t fileSize, TextureInfo& out)
+{
+    return parseKTX2(data, size, fileSize, out) || parseDDS(data, size, fileSize, out);
+}
+
+using TextureId = uint32_t;
+constexpr TextureId NO_TEXTURE = UINT32_MAX;
+
+struct TextureBudget
+{
+    size_t gpuBytes = 256u << 20;   // все массивы текстур вместе
+    int maxLoadsInFlight = 4;
+    uint32_t initialSize = 64;      // стартовый верхний мип: сцена появляется сразу
+};
+
+// Текстуры из KTX2/DDS с готовыми мипами. Одинаковые по формату и размеру
+// верхнего загруженного мипа лежат слоями в общих GL_TEXTURE_2D_ARRAY — меньше
+// переключений. Сначала читаются только мелкие мипы; крупные подгружаются,
+// когда request() сообщает, что на экране нужно больше текселей, и выгружаются
+// обратно, когда не нужны или не хватает бюджета. Чтение — через AssetIO,
+// заливка — через PBO в контексте UploadWorker. Вызовы — на рендер-потоке.
+class TextureManager
+{
+public:
+    TextureManager(RenderQueue& renderQueue, AssetIO& io, UploadWorker& uploader, StagingArena& staging)
+        : renderQueue(renderQueue), io(io), uploader(uploader), staging(staging)
+    {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i)
+        {
+            std::string ext = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+            if (ext == "GL_EXT_texture_compression_s3tc")
+                s3tc = true;
+            else if (ext == "GL_EXT_texture_sRGB" || ext == "GL_EXT_texture_compression_s3tc_srgb")
+                s3tcSrgb = true;
+            else if (ext == "GL_ARB_texture_compression_bptc")
+                bptc = true;
+        }
+        glGenBuffers(1, &pbo);
+    }
+
+    ~TextureManager()
+    {
+        for (TextureArray& a : arrays)
+            if (a.texture)
+                deleteArray(a);
+        glDeleteBuffers(1, &pbo);
+    }
+
+    TextureManager(const TextureManager&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+
+    // Не блокирует: текстура появится в bind(), когда загрузятся мелкие мипы
+    TextureId load(const std::string& path)
+    {
+        auto it = byPath.find(path);
+        if (it != byPath.end())
+            return it->second;
+
+        TextureId id = (TextureId)textures.size();
+        textures.emplace_back();
+        textures.back().path = path;
+        byPath[path] = id;
+        spawn(loadHeader(id));
+        return id;
+    }
+
+    // Текстура из памяти (например, сгенерированная и сжатая на лету):
+    // data — мипы по смещениям из info.levels. Данные остаются в ОЗУ,
+    // на GPU мипы ходят так же, как из файла.
+    TextureId create(const std::string& name, TextureInfo info, std::vector<char> data)
+    {
+        TextureId id = (TextureId)textures.size();
+        textures.emplace_back();
+        Texture& t = textures.back();
+        t.path = name;
+
+        bool valid = !info.levels.empty();
+        for (const TextureLevel& l : info.levels)
+            valid = valid && l.offset + l.size <= data.size();
+        if (!valid || !supports(info.format))
+        {
+            std::cerr << "Cannot create texture " << name << "\n";
+            t.state = TEX_FAILED;
+            return id;
+        }
+
+        t.info = std::move(info);
+        t.memory = std::make_shared<const std::vector<char>>(std::move(data));
+        t.state = TEX_READY;
+        t.residentLevel = (uint32_t)t.info.levels.size();
+        spawn(streamLevels(id, tailLevel(t)));
+        return id;
+    }
+
+    // Сколько текселей верхнего мипа нужно на экране (например, экранный
+    // размер поверхности в пикселях, умноженный на повтор UV). Раз в кадр.
+    void request(TextureId id, float texels)
+    {
+        if (id < textures.size())
+            textures[id].demand = std::max(textures[id].demand, texels);
+    }
+
+    // Раз в кадр после request(): решить, какие мипы догрузить или выгрузить
+    void update()
+    {
+        std::vector<TextureId> wanted;
+        for (TextureId id = 0; id < textures.size(); ++id)
+        {
+            Texture& t = textures[id];
+            t.lastDemand = t.demand;
+            t.demand = 0.0f;
+            if (t.state != TEX_READY || t.loading)
+                continue;
+
+            uint32_t desired = desiredLevel(t);
+            // Гистерезис: вниз — только если нужен мип на два уровня мельче
+            if (desired < t.residentLevel || desired > t.residentLevel + 1)
+                wanted.push_back(id);
+        }
+
+        // Сначала самые недогруженные: у них меньше всего текселей на пиксель
+        std::sort(wanted.begin(), wanted.end(), [this](TextureId a, TextureId b)
+        {
+            return texelRatio(textures[a]) < texelRatio(textures[b]);
+        });
+
+        for (TextureId id : wanted)
+        {
+            if (loadsInFlight >= budget.maxLoadsInFlight)
+                break;
+            Texture& t = textures[id];
+            // Не влезает нужный мип — берём самый крупный из влезающих
+            uint32_t level = desiredLevel(t);
+            while (level < t.residentLevel && !makeRoom(t, level))
+                ++level;
+            if (level != t.residentLevel)
+                spawn(streamLevels(id, level));
+        }
+
+        // Перерасход (бюджет уменьшили или массивы наполовину пусты) —
+        // по одному мипу с самой «перекормленной» текстуры за кадр
+        if (gpuBytes > budget.gpuBytes && loadsInFlight < budget.maxLoadsInFlight)
+        {
+            TextureId victim = NO_TEXTURE;
+            for (TextureId id = 0; id < textures.size(); ++id)
+            {
+                const Texture& t = textures[id];
+                if (t.state == TEX_READY && !t.loading && t.residentLevel < tailLevel(t)
+                    && (victim == NO_TEXTURE || texelRatio(t) > texelRatio(textures[victim])))
+                    victim = id;
+            }
+            if (victim != NO_TEXTURE)
+                spawn(streamLevels(victim, textures[victim].residentLevel + 1));
+        }
+    }
+
+    // Привязать массив текстуры к юниту; вернуть слой или -1, если ещё не загружена
+    int bind(TextureId id, GLuint unit) const
+    {
+        if (id >= textures.size() || textures[id].array == NO_ARRAY)
+            return -1;
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, arrays[textures[id].array].texture);
+        return (int)textures[id].layer;
+    }
+
+    bool supports(TextureFormat f) const
+    {
+        switch (f)
+        {
+        case TEX_BC1: case TEX_BC3: return s3tc;
+        case TEX_BC1_SRGB: case TEX_BC3_SRGB: return s3tc && s3tcSrgb;
+        case TEX_BC7: case TEX_BC7_SRGB: return bptc;
+        default: return true;
+        }
+    }
+
+    // Где сейчас лежит текстура. serial не переиспользуется, в отличие от имён GL,
+    // поэтому по нему можно кэшировать то, что привязано к массиву (хэндлы)
+    struct Location
+    {
+        GLuint array = 0;
+        uint64_t serial = 0;
+        uint32_t layer = 0;
+    };
+
+    bool locate(TextureId id, Location& out) const
+    {
+        if (id >= textures.size() || textures[id].array == NO_ARRAY)
+            return false;
+        const TextureArray& a = arrays[textures[id].array];
+        out.array = a.texture;
+        out.serial = a.serial;
+        out.layer = textures[id].layer;
+        return true;
+    }
+
+    // Вызывается перед удалением массива: serial из Location и его имя GL
+    std::function<void(uint64_t serial, GLuint array)> onArrayRelease;
+
+    bool resident(TextureId id) const { return id < textures.size() && textures[id].array != NO_ARRAY; }
+    size_t allocatedBytes() const { return gpuBytes; }
+
+    TextureBudget budget;
+
+private:
+    static constexpr uint32_t LAYERS_PER_ARRAY = 8;
+    static constexpr uint32_t NO_ARRAY = UINT32_MAX;
+
+    enum TextureState
+    {
+        TEX_PENDING,
+        TEX_READY,
+        TEX_FAILED
+    };
+
+    struct Texture
+    {
+        std::string path;
+        TextureInfo info;
+        std::shared_ptr<const std::vector<char>> memory;   // вместо файла
+        TextureState state = TEX_PENDING;
+        bool loading = false;
+        uint32_t residentLevel = 0;
+        uint32_t array = NO_ARRAY;
+        uint32_t layer = 0;
+        float demand = 0.0f;
+        float lastDemand = 0.0f;
+    };
+
+    struct TextureArray
+    {
+        GLuint texture = 0;
+        uint64_t serial = 0;
+        TextureFormat format = TEX_RGBA8;
+        uint32_t width = 0, height = 0, levels = 0;
+        size_t bytes = 0;
+        std::vector<uint32_t> freeLayers;
+    };
+
+    // Самый крупный мип, не больше initialSize
+    uint32_t tailLevel(const Texture& t) const
+    {
+        uint32_t level = 0;
+        uint32_t last = (uint32_t)t.info.levels.size() - 1;
+        while (level < last && std::max(t.info.levelWidth(level), t.info.levelHeight(level)) > budget.initialSize)
+            ++level;
+        return level;
+    }
+
+    uint32_t desiredLevel(const Texture& t) const
+    {
+        uint32_t tail = tailLevel(t);
+        if (t.lastDemand <= 0.0f)
+            return tail;
+        float size = (float)std::max(t.info.width, t.info.height);
+        float level = std::floor(std::log2(std::max(size / t.lastDemand, 1.0f)));
+        return std::min((uint32_t)level, tail);
+    }
+
+    // Текселей загруженного мипа на требуемый тексель
+    float texelRatio(const Texture& t) const
+    {
+        float size = (float)std::max(t.info.levelWidth(t.residentLevel), t.info.levelHeight(t.residentLevel));
+        return size / std::max(t.lastDemand, 1.0f);
+    }
+
+    size_t arrayBytes(const TextureInfo& info, uint32_t level) const
+    {
+        size_t bytes = 0;
+        for (uint32_t l = level; l < info.levels.size(); ++l)
+            bytes += levelBytes(info.format, info.levelWidth(l), info.levelHeight(l));
+        return bytes * LAYERS_PER_ARRAY;
+    }
+
+    bool hasFreeLayer(const TextureInfo& info, uint32_t level) const
+    {
+        for (const TextureArray& a : arrays)
+            if (a.texture && a.format == info.format && a.width == info.levelWidth(level)
+                && a.height == info.levelHeight(level) && !a.freeLayers.empty())
+                return true;
+        return false;
+    }
+
+    // Места под новый массив не хватает — ужать текстуры, которым крупные мипы
+    // нужны меньше, чем этой
+    bool makeRoom(const Texture& t, uint32_t level)
+    {
+        if (hasFreeLayer(t.info, level))
+            return true;
+        size_t need = arrayBytes(t.info, level);
+        if (gpuBytes + need <= budget.gpuBytes)
+            return true;
+
+        float ratio = texelRatio(t);
+        for (TextureId id = 0; id < textures.size() && loadsInFlight < budget.maxLoadsInFlight; ++id)
+        {
+            Texture& other = textures[id];
+            if (&other != &t && other.state == TEX_READY && !other.loading
+                && other.residentLevel < tailLevel(other) && texelRatio(other) > ratio * 2.0f)
+                spawn(streamLevels(id, other.residentLevel + 1));
+        }
+        return false;
+    }
+
+    std::pair<uint32_t, uint32_t> allocateLayer(const TextureInfo& info, uint32_t level)
+    {
+        uint32_t width = info.levelWidth(level);
+        uint32_t height = info.levelHeight(level);
+        uint32_t levels = (uint32_t)info.levels.size() - level;
+
+        uint32_t index = NO_ARRAY;
+        for (uint32_t i = 0; i < arrays.size(); ++i)
+        {
+            const TextureArray& a = arrays[i];
+            if (a.texture && a.format == info.format && a.width == width && a.height == height
+                && a.levels == levels && !a.freeLayers.empty())
+            {
+                index = i;
+                break;
+            }
+        }
+
+        if (index == NO_ARRAY)
+        {
+            for (uint32_t i = 0; i < arrays.size() && index == NO_ARRAY; ++i)
+                if (!arrays[i].texture)
+                    index = i;
+            if (index == NO_ARRAY)
+            {
+                index = (uint32_t)arrays.size();
+                arrays.emplace_back();
+            }
+
+            TextureArray& a = arrays[index];
+            a.serial = ++nextSerial;
+            a.format = info.format;
+            a.width = width;
+            a.height = height;
+            a.levels = levels;
+            a.bytes = arrayBytes(info, level);
+            a.freeLayers.clear();
+            for (uint32_t l = LAYERS_PER_ARRAY; l > 0; --l)
+                a.freeLayers.push_back(l - 1);
+
+            const TextureFormatInfo& fmt = formatInfo(info.format);
+            glGenTextures(1, &a.texture);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, a.texture);
+            for (uint32_t l = 0; l < levels; ++l)
+            {
+                GLsizei w = (GLsizei)std::max(width >> l, 1u);
+                GLsizei h = (GLsizei)std::max(height >> l, 1u);
+                if (fmt.compressed)
+                    glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, (GLint)l, fmt.internalFormat, w, h, LAYERS_PER_ARRAY, 0,
+                                           (GLsizei)(levelBytes(info.format, w, h) * LAYERS_PER_ARRAY), nullptr);
+                else
+                    glTexImage3D(GL_TEXTURE_2D_ARRAY, (GLint)l, (GLint)fmt.internalFormat, w, h, LAYERS_PER_ARRAY, 0,
+                                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            }
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, (GLint)levels - 1);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+            // Контекст загрузки должен увидеть новый объект
+            glFlush();
+            gpuBytes += a.bytes;
+        }
+
+        TextureArray& a = arrays[index];
+        uint32_t layer = a.freeLayers.back();
+        a.freeLayers.pop_back();
+        return { index, layer };
+    }
+
+    void freeLayer(uint32_t index, uint32_t layer)
+    {
+        TextureArray& a = arrays[index];
+        a.freeLayers.push_back(layer);
+        if (a.freeLayers.size() == LAYERS_PER_ARRAY)
+        {
+            deleteArray(a);
+            gpuBytes -= a.bytes;
+        }
+    }
+
+    void deleteArray(TextureArray& a)
+    {
+        if (onArrayRelease)
+            onArrayRelease(a.serial, a.texture);
+        glDeleteTextures(1, &a.texture);
+        a.texture = 0;
+    }
+
+    Task<void> loadHeader(TextureId id)
+    {
+        AssetFile f = io.open(textures[id].path);
+        StagingSpan span = f ? staging.allocate(IO_ALIGNMENT) : StagingSpan();
+        int64_t got = span ? co_await io.read(f, 0, IO_ALIGNMENT, span.data) : -1;
+
+        TextureInfo info;
+        bool valid = got > 0 && parseTextureHeader(span.data, (size_t)got, f.size, info);
+
+        co_await renderQueue.schedule();
+        bool opened = (bool)f;
+        if (span)
+            staging.release(span);
+        if (opened)
+            io.close(f);
+
+        Texture& t = textures[id];
+        if (!valid || !supports(info.format))
+        {
+            if (!valid && opened)
+                std::cerr << "Unsupported texture file: " << t.path << "\n";
+            else if (valid)
+                std::cerr << "No GPU support for " << formatInfo(info.format).name << ": " << t.path << "\n";
+            t.state = TEX_FAILED;
+            co_return;
+        }
+
+        t.info = std::move(info);
+        t.state = TEX_READY;
+        t.residentLevel = (uint32_t)t.info.levels.size();
+        spawn(streamLevels(id, tailLevel(t)));
+    }
+
+    // Прочитать мипы [level, n) одним запросом и залить в новый слой
+    Task<void> streamLevels(TextureId id, uint32_t level)
+    {
+        Texture& t = textures[id];
+        const TextureInfo& info = t.info;
+        uint32_t levelCount = (uint32_t)info.levels.size();
+
+        uint64_t begin = UINT64_MAX, end = 0;
+        for (uint32_t l = level; l < levelCount; ++l)
+        {
+            begin = std::min(begin, info.levels[l].offset);
+            end = std::max(end, info.levels[l].offset + info.levels[l].size);
+        }
+        uint64_t alignedBegin = begin / IO_ALIGNMENT * IO_ALIGNMENT;
+        size_t readBytes = (size_t)((end - alignedBegin + IO_ALIGNMENT - 1) / IO_ALIGNMENT * IO_ALIGNMENT);
+
+        std::shared_ptr<const std::vector<char>> memory = t.memory;
+        AssetFile f;
+        StagingSpan span;
+        if (!memory)
+        {
+            f = io.open(t.path);
+            span = f ? staging.allocate(readBytes) : StagingSpan();
+            if (!span)
+            {
+                // Нет места в staging — попробуем в следующих кадрах
+                if (f)
+                    io.close(f);
+                co_return;
+            }
+        }
+
+        t.loading = true;
+        ++loadsInFlight;
+        uint32_t array, layer;
+        std::tie(array, layer) = allocateLayer(info, level);
+        GLuint texture = arrays[array].texture;
+        TextureFormat format = info.format;
+        std::vector<TextureLevel> levels(info.levels.begin() + level, info.levels.end());
+        uint32_t width = info.levelWidth(level), height = info.levelHeight(level);
+
+        bool valid = true;
+        const char* base = nullptr;
+        if (memory)
+        {
+            base = memory->data();
+        }
+        else
+        {
+            int64_t got = co_await io.read(f, alignedBegin, readBytes, span.data);
+            valid = got >= (int64_t)(end - alignedBegin);
+            base = span.data - alignedBegin;
+        }
+
+        if (valid)
+        {
+            GLuint unpack = pbo;
+            // levels — по ссылке: живёт в кадре корутины до возобновления
+            co_await uploader.run([&levels, base, unpack, texture, format, layer, width, height]
+            {
+                size_t total = 0;
+                for (const TextureLevel& l : levels)
+                    total += (size_t)l.size;
+
+                // Через PBO драйвер копирует в текстуру асинхронно, не в вызове
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpack);
+                glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)total, nullptr, GL_STREAM_DRAW);
+                char* dst = (char*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)total,
+                                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+                if (dst)
+                {
+                    size_t offset = 0;
+                    for (const TextureLevel& l : levels)
+                    {
+                        std::memcpy(dst + offset, base + l.offset, (size_t)l.size);
+                        offset += (size_t)l.size;
+                    }
+                    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+                    const TextureFormatInfo& fmt = formatInfo(format);
+                    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+                    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+                    offset = 0;
+                    for (uint32_t l = 0; l < levels.size(); ++l)
+                    {
+                        GLsizei w = (GLsizei)std::max(width >> l, 1u);
+                        GLsizei h = (GLsizei)std::max(height >> l, 1u);
+                        if (fmt.compressed)
+                            glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, (GLint)l, 0, 0, (GLint)layer, w, h, 1,
+                                                      fmt.internalFormat, (GLsizei)levels[l].size, (const void*)offset);
+                        else
+                            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, (GLint)l, 0, 0, (GLint)layer, w, h, 1,
+                                            GL_RGBA, GL_UNSIGNED_BYTE, (const void*)offset);
+                        offset += (size_t)levels[l].size;
+                    }
+                    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+                }
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            });
+        }
+
+        co_await renderQueue.schedule();
+        if (span)
+        {
+            staging.release(span);
+            io.close(f);
+        }
+        --loadsInFlight;
+
+        Texture& done = textures[id];
+        done.loading = false;
+        if (!valid)
+        {
+            std::cerr << "Failed to read mips of " << done.path << "\n";
+            freeLayer(array, layer);
+            co_return;
+        }
+
+        if (done.array != NO_ARRAY)
+            freeLayer(done.array, done.layer);
+        done.array = array;
+        done.layer = layer;
+        done.residentLevel = level;
+    }
+
+    RenderQueue& renderQueue;
+    AssetIO& io;
+    UploadWorker& uploader;
+    StagingArena& staging;
+
+    std::vector<Texture> textures;
+    std::unordered_map<std::string, TextureId> byPath;
+    std::vector<TextureArray> arrays;
+    GLuint pbo = 0;
+
+    bool s3tc = false, s3tcSrgb = false, bptc = false;
+    size_t gpuBytes = 0;
+    int loadsInFlight = 0;
+    uint64_t nextSerial = 0;
+};
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include "tasks.h"
+
+// Дождаться, пока GPU выполнит всё отправленное до этого момента.
+// Вызывать на рендер-потоке; ожидание не блокирует кадр.
+inline Task<void> gpuFence(RenderQueue& renderQueue)
+{
+    GLsync sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+
+    co_await renderQueue.until([sync]
+    {
+        GLenum r = glClientWaitSync(sync, 0, 0);
+        return r != GL_TIMEOUT_EXPIRED;
+    });
+
+    glDeleteSync(sync);
+}
+
+// Поток загрузки со своим скрытым GL-контекстом, разделяющим объекты с основным,
+// и своей таблицей функций glad (сборка с GLAD_GL_CONTEXT_DISPATCH вызывает
+// через неё; указатели другого контекста годятся не на всех драйверах).
+// Буферы и текстуры заливаются там, после чего ставится fence; рендер-поток
+// опрашивает его в RenderQueue::drain(), и корутина получает объект только
+// когда загрузка завершена — кадр не ждёт glBufferData.
+class UploadWorker
+{
+public:
+    UploadWorker(GLFWwindow* mainWindow, RenderQueue& renderQueue)
+        : renderQueue(renderQueue)
+    {
+        // Окна GLFW создаются только в главном потоке
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        context = glfwCreateWindow(1, 1, "upload", nullptr, mainWindow);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+
+        if (!context)
+        {
+            std::cerr << "Shared upload context unavailable, uploading on the render thread\n";
+            return;
+        }
+
+        // Таблица грузится здесь, пока поток не запущен; потом основной контекст возвращается
+        glfwMakeContextCurrent(context);
+        bool loaded = gladLoadGLContext(&gl, (GLADloadproc)glfwGetProcAddress) != 0;
+        glfwMakeContextCurrent(mainWindow);
+        if (!loaded)
+        {
+            std::cerr << "Failed to load upload context functions, uploading on the render thread\n";
+            glfwDestroyWindow(context);
+            context = nullptr;
+            return;
+        }
+        accepting = true;
+        thread = std::thread([this] { loop(); });
+    }
+
+    ~UploadWorker() { stop(); }
+
+    UploadWorker(const UploadWorker&) = delete;
+    UploadWorker& operator=(const UploadWorker&) = delete;
+
+    // Вызвать до glfwTerminate() на рендер-потоке. Поток загрузки сначала
+    // выполняет всё, что уже в очереди, а stop() прокачивает рендер-очередь,
+    // пока не продолжится каждый ожидающий. run() после stop() недопустим:
+    // его продолжение встанет в очередь, которую уже никто не крутит.
+    void stop()
+    {
+        if (thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                accepting = false;
+            }
+            wake.notify_one();
+            thread.join();
+            while (waiting.load() > 0)
+            {
+                renderQueue.drain();
+                std::this_thread::yield();
+            }
+        }
+        if (context)
+        {
+            glfwDestroyWindow(context);
+            context = nullptr;
+        }
+    }
+
+    // Выполнить GL-работу в контексте загрузки; продолжение — на рендер-потоке,
+    // когда GPU закончил. work должна ссылаться только на живые данные (staging).
+    Task<void> run(std::function<void()> work)
+    {
+        struct Awaiter
+        {
+            UploadWorker* worker;
+            std::function<void()>* work;
+            bool queued = false;
+
+            bool await_ready() const noexcept { return false; }
+            bool await_suspend(std::coroutine_handle<> h)
+            {
+                queued = worker->push(*work, h);
+                return queued;
+            }
+            bool await_resume() const noexcept { return queued; }
+        };
+        if (co_await Awaiter{ this, &work })
+            co_return;
+
+        // Потока нет или он останавливается — работа идёт в контексте окна
+        co_await renderQueue.schedule();
+        work();
+        co_await gpuFence(renderQueue);
+    }
+
+    Task<GLuint> uploadBuffer(const void* data, size_t size, GLenum usage = GL_STATIC_DRAW)
+    {
+        GLuint buffer = 0;
+        // COPY_WRITE — чтобы не зависеть от VAO: они между контекстами не разделяются
+        co_await run([&buffer, data, size, usage]
+        {
+            glGenBuffers(1, &buffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)size, data, usage);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        });
+        co_return buffer;
+    }
+
+    Task<void> updateBuffer(GLuint buffer, size_t offset, const void* data, size_t size)
+    {
+        co_await run([buffer, offset, data, size]
+        {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)offset, (GLsizeiptr)size, data);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        });
+    }
+
+    Task<GLuint> uploadTexture2D(GLenum internalFormat, int width, int height,
+                                 GLenum format, GLenum type, const void* pixels, bool mipmaps)
+    {
+        GLuint tex = 0;
+        co_await run([&tex, internalFormat, width, height, format, type, pixels, mipmaps]
+        {
+            glGenTextures(1, &tex);
+            glBindTexture(GL_TEXTURE_2D, tex);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTexImage2D(GL_TEXTURE_2D, 0, (GLint)internalFormat, width, height, 0, format, type, pixels);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            if (mipmaps)
+                glGenerateMipmap(GL_TEXTURE_2D);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        });
+        co_return tex;
+    }
+
+    bool threaded() const { return thread.joinable(); }
+
+private:
+    struct Job
+    {
+        std::function<void()> work;
+        std::coroutine_handle<> waiter;
+    };
+
+    // false — поток работу не принимает, work не тронута
+    bool push(std::function<void()>& work, std::coroutine_handle<> waiter)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!accepting)
+                return false;
+            waiting.fetch_add(1);
+            jobs.push_back({ std::move(work), waiter });
+        }
+        wake.notify_one();
+        return true;
+    }
+
+    void loop()
+    {
+        glfwMakeContextCurrent(context);
+        gladSetGLContext(&gl);
+
+        for (;;)
+        {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return !accepting || !jobs.empty(); });
+                if (jobs.empty())
+                    break;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+
+            job.work();
+
+            GLsync sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+
+            renderQueue.resumeWhen(job.waiter, [this, sync]
+            {
+                if (glClientWaitSync(sync, 0, 0) == GL_TIMEOUT_EXPIRED)
+                    return false;
+                glDeleteSync(sync);
+                waiting.fetch_sub(1);
+                return true;
+            });
+        }
+
+        gladSetGLContext(nullptr);
+        glfwMakeContextCurrent(nullptr);
+    }
+
+    RenderQueue& renderQueue;
+    GLFWwindow* context = nullptr;
+    GladGLContext gl = {};
+    std::thread thread;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Job> jobs;
+    bool accepting = false; // false — без потока или после stop()
+    std::atomic<size_t> waiting{ 0 }; // задачи, чьи ожидающие ещё не продолжены
+};
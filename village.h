@@ -0,0 +1,259 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "world_stream.h"
+#include "tasks.h"
+
+// Деревня для замеров: N домиков как в drawHouse (стены, крыша, труба,
+// дверь, два окна), кусты вокруг, ступенчатый рельеф из плит и дым из
+// части труб. Одинаковые настройки дают те же кубы в том же порядке при
+// любом числе потоков: у каждого дома свой генератор от (seed, номер), а
+// места в массивах считаются заранее.
+struct VillageSettings
+{
+    uint32_t seed = 1;
+    uint32_t houses = 100;
+    float spacing = 8.0f;           // шаг сетки домов
+    float jitter = 0.25f;           // сдвиг дома в долях шага
+    uint32_t bushesMin = 4;         // кустов на дом; у домика в drawHouse их 8
+    uint32_t bushesMax = 10;
+    float smokeShare = 0.6f;        // доля домов с дымом из трубы
+    float tileSize = 8.0f;          // плиты рельефа
+    float hillHeight = 1.5f;        // перепад высот
+    float hillSize = 48.0f;         // размер холма
+};
+
+// Кубы и объекты в виде, который принимает writeWorld; рельеф — инстансы без объекта
+struct Village
+{
+    std::vector<CubeInstance> instances;
+    std::vector<WorldObject> objects;
+};
+
+namespace village_detail
+{
+    struct Random
+    {
+        uint32_t state;
+
+        explicit Random(uint32_t seed) : state(seed * 0x9E3779B9u + 0x7F4A7C15u) { next(); }
+
+        uint32_t next()
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        float uniform() { return (float)(next() >> 8) * (1.0f / 16777216.0f); }
+    };
+
+    inline uint32_t hashSeed(uint32_t a, uint32_t b)
+    {
+        uint32_t h = a * 0x8da6b343u ^ b * 0xd8163841u;
+        h ^= h >> 13;
+        h *= 0x5bd1e995u;
+        h ^= h >> 15;
+        return h | 1u;
+    }
+
+    // Высота плиты (ix, iz): гладкий шум по решётке холмов, одна высота на плиту
+    inline float tileHeight(const VillageSettings& s, int32_t ix, int32_t iz)
+    {
+        float x = ((float)ix + 0.5f) * s.tileSize / s.hillSize;
+        float z = ((float)iz + 0.5f) * s.tileSize / s.hillSize;
+        auto corner = [&](int32_t cx, int32_t cz)
+        {
+            return (float)(hashSeed((uint32_t)cx ^ s.seed * 0x27d4eb2du, (uint32_t)cz) >> 8) * (1.0f / 16777216.0f);
+        };
+        int32_t cx = (int32_t)std::floor(x), cz = (int32_t)std::floor(z);
+        float fx = x - (float)cx, fz = z - (float)cz;
+        fx = fx * fx * (3.0f - 2.0f * fx);
+        fz = fz * fz * (3.0f - 2.0f * fz);
+        float a = glm::mix(corner(cx, cz), corner(cx + 1, cz), fx);
+        float b = glm::mix(corner(cx, cz + 1), corner(cx + 1, cz + 1), fx);
+        return (glm::mix(a, b, fz) - 0.5f) * s.hillHeight;
+    }
+
+    inline float groundAt(const VillageSettings& s, float x, float z)
+    {
+        return tileHeight(s, (int32_t)std::floor(x / s.tileSize), (int32_t)std::floor(z / s.tileSize));
+    }
+
+    // Первые выборки генератора дома: от них зависят места дома в массивах
+    struct HousePlan
+    {
+        Random rng;
+        uint32_t bushes;
+        bool smoke;
+    };
+
+    inline HousePlan planHouse(const VillageSettings& s, uint32_t house)
+    {
+        HousePlan p{ Random(hashSeed(s.seed, house)), 0, false };
+        uint32_t range = std::max(s.bushesMax, s.bushesMin) - s.bushesMin + 1;
+        p.bushes = s.bushesMin + p.rng.next() % range;
+        p.smoke = p.rng.uniform() < s.smokeShare;
+        return p;
+    }
+
+    inline glm::mat4 box(const glm::mat4& base, const glm::vec3& offset, const glm::vec3& size)
+    {
+        return glm::scale(glm::translate(base, offset), size);
+    }
+}
+
+inline Village generateVillage(ThreadPool& pool, const VillageSettings& settings)
+{
+    using namespace village_detail;
+    const VillageSettings& s = settings;
+    const uint32_t HOUSE_CUBES = 6;
+    uint32_t side = (uint32_t)std::ceil(std::sqrt((double)s.houses));
+    float extent = (float)side * s.spacing;
+
+    // Рельеф: плиты толщиной в перепад высот, чтобы между ступенями не было щелей
+    int32_t tiles = std::max(1, (int32_t)std::ceil((extent + 2.0f * s.spacing) / s.tileSize));
+    int32_t tileOrigin = (int32_t)std::floor(-s.spacing / s.tileSize);
+    size_t tileCount = (size_t)tiles * (size_t)tiles;
+
+    // Места домов: подсчёт, затем префиксные суммы
+    std::vector<uint32_t> firstInstance(s.houses + 1), firstObject(s.houses + 1);
+    pool.parallelFor(s.houses, 4096, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            HousePlan p = planHouse(s, (uint32_t)i);
+            firstInstance[i + 1] = HOUSE_CUBES + p.bushes;
+            firstObject[i + 1] = 1 + p.bushes + (p.smoke ? 1u : 0u);
+        }
+    });
+    firstInstance[0] = (uint32_t)tileCount;
+    firstObject[0] = 0;
+    for (uint32_t i = 0; i < s.houses; ++i)
+    {
+        firstInstance[i + 1] += firstInstance[i];
+        firstObject[i + 1] += firstObject[i];
+    }
+
+    Village v;
+    v.instances.resize(firstInstance[s.houses]);
+    v.objects.resize(firstObject[s.houses]);
+
+    pool.parallelFor(tileCount, 4096, [&](size_t begin, size_t end)
+    {
+        for (size_t t = begin; t < end; ++t)
+        {
+            int32_t ix = tileOrigin + (int32_t)(t % (size_t)tiles), iz = tileOrigin + (int32_t)(t / (size_t)tiles);
+            float top = tileHeight(s, ix, iz);
+            float thickness = s.hillHeight + 0.1f;
+            glm::vec3 center(((float)ix + 0.5f) * s.tileSize, top - thickness * 0.5f, ((float)iz + 0.5f) * s.tileSize);
+            float shade = 0.9f + 0.2f * (top / std::max(s.hillHeight, 1e-3f));
+            CubeInstance& c = v.instances[t];
+            c.model = box(glm::mat4(1.0f), center, glm::vec3(s.tileSize, thickness, s.tileSize));
+            c.color = glm::vec4(0.3f * shade, 0.7f * shade, 0.3f * shade, 1.0f);
+        }
+    });
+
+    const glm::vec3 ROOFS[4] = { { 0.7f, 0.15f, 0.15f }, { 0.45f, 0.25f, 0.15f },
+                                 { 0.35f, 0.35f, 0.4f }, { 0.2f, 0.35f, 0.5f } };
+    pool.parallelFor(s.houses, 256, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            HousePlan p = planHouse(s, (uint32_t)i);
+            Random& rng = p.rng;
+            CubeInstance* cube = &v.instances[firstInstance[i]];
+            WorldObject* obj = &v.objects[firstObject[i]];
+
+            float x = ((float)(i % side) + 0.5f + (rng.uniform() - 0.5f) * 2.0f * s.jitter) * s.spacing;
+            float z = ((float)(i / side) + 0.5f + (rng.uniform() - 0.5f) * 2.0f * s.jitter) * s.spacing;
+            float scale = 0.8f + 0.5f * rng.uniform();
+            float yaw = rng.uniform() * glm::two_pi<float>();
+            // Низ стен — на самой низкой плите под домом: над ступенью он не висит, а врастает в неё
+            float reach = 1.6f * scale;
+            float ground = std::min(std::min(groundAt(s, x - reach, z - reach), groundAt(s, x + reach, z - reach)),
+                                    std::min(groundAt(s, x - reach, z + reach), groundAt(s, x + reach, z + reach)));
+            glm::mat4 base = glm::translate(glm::mat4(1.0f), glm::vec3(x, ground + 0.5f * scale, z));
+            base = glm::scale(glm::rotate(base, yaw, glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(scale));
+
+            float wall = 0.85f + 0.3f * rng.uniform();
+            glm::vec3 roof = ROOFS[rng.next() % 4];
+            auto put = [&](const glm::mat4& m, const glm::vec3& color)
+            {
+                cube->model = m;
+                cube->color = glm::vec4(color, 1.0f);
+                ++cube;
+            };
+            put(box(base, glm::vec3(0.0f), glm::vec3(2.0f, 1.0f, 2.0f)), glm::vec3(0.65f, 0.45f, 0.25f) * wall);
+            put(box(base, glm::vec3(0.0f, 0.75f, 0.0f), glm::vec3(2.2f, 0.45f, 2.2f)), roof);
+            put(box(base, glm::vec3(0.6f, 1.0f, 0.0f), glm::vec3(0.3f, 0.6f, 0.3f)), glm::vec3(0.3f));
+            put(box(base, glm::vec3(0.0f, -0.25f, 1.01f), glm::vec3(0.4f, 0.6f, 0.05f)), glm::vec3(0.35f, 0.23f, 0.12f));
+            put(box(base, glm::vec3(-0.6f, 0.2f, 1.01f), glm::vec3(0.3f, 0.3f, 0.05f)), glm::vec3(0.55f, 0.8f, 1.0f));
+            put(box(base, glm::vec3(0.6f, 0.2f, 1.01f), glm::vec3(0.3f, 0.3f, 0.05f)), glm::vec3(0.55f, 0.8f, 1.0f));
+
+            obj->kind = OBJECT_PROP;
+            obj->firstInstance = firstInstance[i];
+            obj->instanceCount = HOUSE_CUBES;
+            obj->seed = hashSeed(s.seed, (uint32_t)i);
+            obj->sphere = glm::vec4(glm::vec3(base * glm::vec4(0.0f, 0.4f, 0.0f, 1.0f)), 1.8f * scale);
+            ++obj;
+
+            // Кусты кольцом, как в drawHouse; каждый стоит на своей плите
+            for (uint32_t b = 0; b < p.bushes; ++b)
+            {
+                float angle = ((float)b + 0.3f * (rng.uniform() - 0.5f)) * glm::two_pi<float>() / (float)p.bushes + yaw;
+                float radius = (2.8f + ((b % 2) ? 0.3f : -0.3f)) * scale;
+                float bx = x + std::cos(angle) * radius, bz = z + std::sin(angle) * radius;
+                float size = 0.7f + 0.6f * rng.uniform();
+                glm::vec3 half = glm::vec3(0.2f, 0.15f, 0.2f) * size;
+                glm::vec3 center(bx, groundAt(s, bx, bz) + half.y, bz);
+
+                uint32_t index = (uint32_t)(cube - v.instances.data());
+                put(box(glm::mat4(1.0f), center, half * 2.0f), glm::vec3(0.25f, 0.55f, 0.25f) * (0.8f + 0.4f * rng.uniform()));
+                obj->kind = OBJECT_PROP;
+                obj->firstInstance = index;
+                obj->instanceCount = 1;
+                obj->seed = rng.next();
+                obj->sphere = glm::vec4(center, glm::length(half));
+                ++obj;
+            }
+
+            if (p.smoke)
+            {
+                obj->kind = OBJECT_SMOKE;
+                obj->seed = rng.next();
+                obj->sphere = glm::vec4(glm::vec3(base * glm::vec4(0.6f, 1.4f, 0.0f, 1.0f)), 0.5f);
+                ++obj;
+            }
+        }
+    });
+    return v;
+}
+
+// Сгенерировать и записать файл мира для WorldStreamer
+inline bool writeVillage(ThreadPool& pool, const std::string& path, const VillageSettings& settings,
+                         float cellSize = 32.0f)
+{
+    auto start = std::chrono::steady_clock::now();
+    Village v = generateVillage(pool, settings);
+    double generateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (!writeWorld(path, cellSize, v.instances, v.objects))
+        return false;
+    double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Village: " << settings.houses << " houses, " << v.objects.size() << " objects, "
+              << v.instances.size() << " cubes; generated in " << generateMs << " ms, written in "
+              << totalMs - generateMs << " ms\n";
+    return true;
+}
@@ -0,0 +1,1088 @@
+#pragma once
+
+// Бэкенд собирается, только если есть заголовки Vulkan SDK. Сам загрузчик
+// (libvulkan.so.1 / vulkan-1.dll) открывается во время работы, так что
+// линковать его не нужно и без Vulkan в системе программа запускается.
+#if !defined(MID_NO_VULKAN) && __has_include(<vulkan/vulkan.h>)
+#define MID_WITH_VULKAN 1
+
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+#include <vulkan/vulkan.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include "render_backend.h"
+#include "tasks.h"
+
+// Функции Vulkan, которые нужны бэкенду. Функции устройства берутся через
+// vkGetDeviceProcAddr — вызов идёт прямо в драйвер, минуя диспетчер загрузчика.
+#define MID_VK_INSTANCE_FUNCTIONS(X) \
+    X(vkDestroyInstance) \
+    X(vkEnumeratePhysicalDevices) \
+    X(vkGetPhysicalDeviceProperties) \
+    X(vkGetPhysicalDeviceQueueFamilyProperties) \
+    X(vkGetPhysicalDeviceMemoryProperties) \
+    X(vkCreateDevice) \
+    X(vkGetDeviceProcAddr)
+
+#define MID_VK_DEVICE_FUNCTIONS(X) \
+    X(vkDestroyDevice) \
+    X(vkGetDeviceQueue) \
+    X(vkDeviceWaitIdle) \
+    X(vkAllocateMemory) \
+    X(vkFreeMemory) \
+    X(vkMapMemory) \
+    X(vkBindBufferMemory) \
+    X(vkBindImageMemory) \
+    X(vkGetBufferMemoryRequirements) \
+    X(vkGetImageMemoryRequirements) \
+    X(vkCreateBuffer) \
+    X(vkDestroyBuffer) \
+    X(vkCreateImage) \
+    X(vkDestroyImage) \
+    X(vkCreateImageView) \
+    X(vkDestroyImageView) \
+    X(vkCreateRenderPass) \
+    X(vkDestroyRenderPass) \
+    X(vkCreateFramebuffer) \
+    X(vkDestroyFramebuffer) \
+    X(vkCreateShaderModule) \
+    X(vkDestroyShaderModule) \
+    X(vkCreateDescriptorSetLayout) \
+    X(vkDestroyDescriptorSetLayout) \
+    X(vkCreateDescriptorPool) \
+    X(vkDestroyDescriptorPool) \
+    X(vkAllocateDescriptorSets) \
+    X(vkUpdateDescriptorSets) \
+    X(vkCreatePipelineLayout) \
+    X(vkDestroyPipelineLayout) \
+    X(vkCreateGraphicsPipelines) \
+    X(vkDestroyPipeline) \
+    X(vkCreateCommandPool) \
+    X(vkDestroyCommandPool) \
+    X(vkResetCommandPool) \
+    X(vkAllocateCommandBuffers) \
+    X(vkBeginCommandBuffer) \
+    X(vkEndCommandBuffer) \
+    X(vkCreateFence) \
+    X(vkDestroyFence) \
+    X(vkWaitForFences) \
+    X(vkResetFences) \
+    X(vkQueueSubmit) \
+    X(vkCmdBeginRenderPass) \
+    X(vkCmdEndRenderPass) \
+    X(vkCmdExecuteCommands) \
+    X(vkCmdBindPipeline) \
+    X(vkCmdBindDescriptorSets) \
+    X(vkCmdBindVertexBuffers) \
+    X(vkCmdBindIndexBuffer) \
+    X(vkCmdDraw) \
+    X(vkCmdDrawIndexed) \
+    X(vkCmdCopyImageToBuffer) \
+    X(vkCmdPipelineBarrier)
+
+struct VulkanFunctions
+{
+#define MID_VK_DECLARE(name) PFN_##name name = nullptr;
+    MID_VK_DECLARE(vkGetInstanceProcAddr)
+    MID_VK_DECLARE(vkCreateInstance)
+    MID_VK_INSTANCE_FUNCTIONS(MID_VK_DECLARE)
+    MID_VK_DEVICE_FUNCTIONS(MID_VK_DECLARE)
+#undef MID_VK_DECLARE
+};
+
+// Загрузчик открывается один раз и не выгружается до конца процесса
+inline PFN_vkGetInstanceProcAddr vulkanLoader()
+{
+    static const PFN_vkGetInstanceProcAddr getProc = []() -> PFN_vkGetInstanceProcAddr
+    {
+#if defined(_WIN32)
+        HMODULE lib = LoadLibraryA("vulkan-1.dll");
+        return lib ? (PFN_vkGetInstanceProcAddr)(void*)GetProcAddress(lib, "vkGetInstanceProcAddr") : nullptr;
+#else
+        void* lib = dlopen("libvulkan.so.1", RTLD_NOW | RTLD_LOCAL);
+        return lib ? (PFN_vkGetInstanceProcAddr)dlsym(lib, "vkGetInstanceProcAddr") : nullptr;
+#endif
+    }();
+    return getProc;
+}
+
+// SPIR-V шейдеров бэкенда; исходник на GLSL — в комментарии над каждым.
+// Данные кубов лежат в storage-буфере, индекс — gl_InstanceIndex, то есть
+// firstInstance вызова: между вызовами не меняется ничего, кроме него.
+// #version 450
+// layout(location = 0) in vec3 aPos;
+// struct Draw { mat4 mvp; vec4 color; };
+// layout(std430, set = 0, binding = 0) readonly buffer Draws { Draw draws[]; };
+// layout(location = 0) flat out vec4 vColor;
+// void main()
+// {
+//     gl_Position = draws[gl_InstanceIndex].mvp * vec4(aPos, 1.0);
+//     vColor = draws[gl_InstanceIndex].color;
+// }
+const uint32_t CUBE_VS_SPIRV[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x00000023, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+    0x00000000, 0x00000001, 0x0009000f, 0x00000000, 0x00000001, 0x6e69616d, 0x00000000, 0x00000002,
+    0x00000003, 0x00000004, 0x00000005, 0x00040047, 0x00000002, 0x0000001e, 0x00000000, 0x00040047,
+    0x00000003, 0x0000000b, 0x0000002b, 0x00040047, 0x00000004, 0x0000000b, 0x00000000, 0x00040047,
+    0x00000005, 0x0000001e, 0x00000000, 0x00030047, 0x00000005, 0x0000000e, 0x00040048, 0x00000006,
+    0x00000000, 0x00000005, 0x00050048, 0x00000006, 0x00000000, 0x00000023, 0x00000000, 0x00050048,
+    0x00000006, 0x00000000, 0x00000007, 0x00000010, 0x00050048, 0x00000006, 0x00000001, 0x00000023,
+    0x00000040, 0x00040047, 0x00000007, 0x00000006, 0x00000050, 0x00040048, 0x00000008, 0x00000000,
+    0x00000018, 0x00050048, 0x00000008, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x00000008,
+    0x00000003, 0x00040047, 0x00000009, 0x00000022, 0x00000000, 0x00040047, 0x00000009, 0x00000021,
+    0x00000000, 0x00020013, 0x0000000a, 0x00030021, 0x0000000b, 0x0000000a, 0x00030016, 0x0000000c,
+    0x00000020, 0x00040015, 0x0000000d, 0x00000020, 0x00000001, 0x00040017, 0x0000000e, 0x0000000c,
+    0x00000003, 0x00040017, 0x0000000f, 0x0000000c, 0x00000004, 0x00040018, 0x00000010, 0x0000000f,
+    0x00000004, 0x0004001e, 0x00000006, 0x00000010, 0x0000000f, 0x0003001d, 0x00000007, 0x00000006,
+    0x0003001e, 0x00000008, 0x00000007, 0x00040020, 0x00000011, 0x00000002, 0x00000008, 0x00040020,
+    0x00000012, 0x00000002, 0x00000010, 0x00040020, 0x00000013, 0x00000002, 0x0000000f, 0x00040020,
+    0x00000014, 0x00000001, 0x0000000e, 0x00040020, 0x00000015, 0x00000001, 0x0000000d, 0x00040020,
+    0x00000016, 0x00000003, 0x0000000f, 0x0004003b, 0x00000011, 0x00000009, 0x00000002, 0x0004003b,
+    0x00000014, 0x00000002, 0x00000001, 0x0004003b, 0x00000015, 0x00000003, 0x00000001, 0x0004003b,
+    0x00000016, 0x00000004, 0x00000003, 0x0004003b, 0x00000016, 0x00000005, 0x00000003, 0x0004002b,
+    0x0000000d, 0x00000017, 0x00000000, 0x0004002b, 0x0000000d, 0x00000018, 0x00000001, 0x0004002b,
+    0x0000000c, 0x00000019, 0x3f800000, 0x00050036, 0x0000000a, 0x00000001, 0x00000000, 0x0000000b,
+    0x000200f8, 0x0000001a, 0x0004003d, 0x0000000d, 0x0000001b, 0x00000003, 0x00070041, 0x00000012,
+    0x0000001c, 0x00000009, 0x00000017, 0x0000001b, 0x00000017, 0x0004003d, 0x00000010, 0x0000001d,
+    0x0000001c, 0x00070041, 0x00000013, 0x0000001e, 0x00000009, 0x00000017, 0x0000001b, 0x00000018,
+    0x0004003d, 0x0000000f, 0x0000001f, 0x0000001e, 0x0004003d, 0x0000000e, 0x00000020, 0x00000002,
+    0x00050050, 0x0000000f, 0x00000021, 0x00000020, 0x00000019, 0x00050091, 0x0000000f, 0x00000022,
+    0x0000001d, 0x00000021, 0x0003003e, 0x00000004, 0x00000022, 0x0003003e, 0x00000005, 0x0000001f,
+    0x000100fd, 0x00010038,
+};
+
+// #version 450
+// layout(location = 0) flat in vec4 vColor;
+// layout(location = 0) out vec4 FragColor;
+// void main() { FragColor = vColor; }
+const uint32_t CUBE_FS_SPIRV[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x0000000c, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+    0x00000000, 0x00000001, 0x0007000f, 0x00000004, 0x00000001, 0x6e69616d, 0x00000000, 0x00000002,
+    0x00000003, 0x00030010, 0x00000001, 0x00000007, 0x00040047, 0x00000002, 0x0000001e, 0x00000000,
+    0x00030047, 0x00000002, 0x0000000e, 0x00040047, 0x00000003, 0x0000001e, 0x00000000, 0x00020013,
+    0x00000004, 0x00030021, 0x00000005, 0x00000004, 0x00030016, 0x00000006, 0x00000020, 0x00040017,
+    0x00000007, 0x00000006, 0x00000004, 0x00040020, 0x00000008, 0x00000001, 0x00000007, 0x00040020,
+    0x00000009, 0x00000003, 0x00000007, 0x0004003b, 0x00000008, 0x00000002, 0x00000001, 0x0004003b,
+    0x00000009, 0x00000003, 0x00000003, 0x00050036, 0x00000004, 0x00000001, 0x00000000, 0x00000005,
+    0x000200f8, 0x0000000a, 0x0004003d, 0x00000007, 0x0000000b, 0x00000002, 0x0003003e, 0x00000003,
+    0x0000000b, 0x000100fd, 0x00010038,
+};
+
+// #version 450
+// layout(location = 0) in vec4 aClip;
+// layout(location = 1) in vec2 aUV;
+// layout(location = 2) in float aAlpha;
+// layout(location = 0) out vec2 vUV;
+// layout(location = 1) flat out float vAlpha;
+// void main() { gl_Position = aClip; vUV = aUV; vAlpha = aAlpha; }
+const uint32_t SMOKE_VS_SPIRV[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x00000017, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+    0x00000000, 0x00000001, 0x000b000f, 0x00000000, 0x00000001, 0x6e69616d, 0x00000000, 0x00000002,
+    0x00000003, 0x00000004, 0x00000005, 0x00000006, 0x00000007, 0x00040047, 0x00000002, 0x0000001e,
+    0x00000000, 0x00040047, 0x00000003, 0x0000001e, 0x00000001, 0x00040047, 0x00000004, 0x0000001e,
+    0x00000002, 0x00040047, 0x00000005, 0x0000000b, 0x00000000, 0x00040047, 0x00000006, 0x0000001e,
+    0x00000000, 0x00040047, 0x00000007, 0x0000001e, 0x00000001, 0x00030047, 0x00000007, 0x0000000e,
+    0x00020013, 0x00000008, 0x00030021, 0x00000009, 0x00000008, 0x00030016, 0x0000000a, 0x00000020,
+    0x00040017, 0x0000000b, 0x0000000a, 0x00000002, 0x00040017, 0x0000000c, 0x0000000a, 0x00000004,
+    0x00040020, 0x0000000d, 0x00000001, 0x0000000c, 0x00040020, 0x0000000e, 0x00000001, 0x0000000b,
+    0x00040020, 0x0000000f, 0x00000001, 0x0000000a, 0x00040020, 0x00000010, 0x00000003, 0x0000000c,
+    0x00040020, 0x00000011, 0x00000003, 0x0000000b, 0x00040020, 0x00000012, 0x00000003, 0x0000000a,
+    0x0004003b, 0x0000000d, 0x00000002, 0x00000001, 0x0004003b, 0x0000000e, 0x00000003, 0x00000001,
+    0x0004003b, 0x0000000f, 0x00000004, 0x00000001, 0x0004003b, 0x00000010, 0x00000005, 0x00000003,
+    0x0004003b, 0x00000011, 0x00000006, 0x00000003, 0x0004003b, 0x00000012, 0x00000007, 0x00000003,
+    0x00050036, 0x00000008, 0x00000001, 0x00000000, 0x00000009, 0x000200f8, 0x00000013, 0x0004003d,
+    0x0000000c, 0x00000014, 0x00000002, 0x0003003e, 0x00000005, 0x00000014, 0x0004003d, 0x0000000b,
+    0x00000015, 0x00000003, 0x0003003e, 0x00000006, 0x00000015, 0x0004003d, 0x0000000a, 0x00000016,
+    0x00000004, 0x0003003e, 0x00000007, 0x00000016, 0x000100fd, 0x00010038,
+};
+
+// #version 450 — particleFS
+// layout(location = 0) in vec2 vUV;
+// layout(location = 1) flat in float vAlpha;
+// layout(location = 0) out vec4 FragColor;
+// void main()
+// {
+//     float d = distance(vUV, vec2(0.5));
+//     if (d > 0.5) discard;
+//     float edge = smoothstep(0.5, 0.25, d);
+//     vec3 color = mix(vec3(0.85, 0.88, 0.92), vec3(0.9, 0.9, 0.95), 1.0 - vAlpha);
+//     FragColor = vec4(color, vAlpha * edge * 0.8);
+// }
+const uint32_t SMOKE_FS_SPIRV[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x0000002a, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+    0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+    0x0008000f, 0x00000004, 0x00000002, 0x6e69616d, 0x00000000, 0x00000003, 0x00000004, 0x00000005,
+    0x00030010, 0x00000002, 0x00000007, 0x00040047, 0x00000003, 0x0000001e, 0x00000000, 0x00040047,
+    0x00000004, 0x0000001e, 0x00000001, 0x00030047, 0x00000004, 0x0000000e, 0x00040047, 0x00000005,
+    0x0000001e, 0x00000000, 0x00020013, 0x00000006, 0x00030021, 0x00000007, 0x00000006, 0x00020014,
+    0x00000008, 0x00030016, 0x00000009, 0x00000020, 0x00040017, 0x0000000a, 0x00000009, 0x00000002,
+    0x00040017, 0x0000000b, 0x00000009, 0x00000003, 0x00040017, 0x0000000c, 0x00000009, 0x00000004,
+    0x00040020, 0x0000000d, 0x00000001, 0x0000000a, 0x00040020, 0x0000000e, 0x00000001, 0x00000009,
+    0x00040020, 0x0000000f, 0x00000003, 0x0000000c, 0x0004003b, 0x0000000d, 0x00000003, 0x00000001,
+    0x0004003b, 0x0000000e, 0x00000004, 0x00000001, 0x0004003b, 0x0000000f, 0x00000005, 0x00000003,
+    0x0004002b, 0x00000009, 0x00000010, 0x3f000000, 0x0004002b, 0x00000009, 0x00000011, 0x3e800000,
+    0x0004002b, 0x00000009, 0x00000012, 0x3f4ccccd, 0x0004002b, 0x00000009, 0x00000013, 0x3f800000,
+    0x0004002b, 0x00000009, 0x00000014, 0x3f59999a, 0x0004002b, 0x00000009, 0x00000015, 0x3f6147ae,
+    0x0004002b, 0x00000009, 0x00000016, 0x3f6b851f, 0x0004002b, 0x00000009, 0x00000017, 0x3f666666,
+    0x0004002b, 0x00000009, 0x00000018, 0x3f733333, 0x0005002c, 0x0000000a, 0x00000019, 0x00000010,
+    0x00000010, 0x0006002c, 0x0000000b, 0x0000001a, 0x00000014, 0x00000015, 0x00000016, 0x0006002c,
+    0x0000000b, 0x0000001b, 0x00000017, 0x00000017, 0x00000018, 0x00050036, 0x00000006, 0x00000002,
+    0x00000000, 0x00000007, 0x000200f8, 0x0000001c, 0x0004003d, 0x0000000a, 0x0000001d, 0x00000003,
+    0x0007000c, 0x00000009, 0x0000001e, 0x00000001, 0x00000043, 0x0000001d, 0x00000019, 0x000500ba,
+    0x00000008, 0x0000001f, 0x0000001e, 0x00000010, 0x000300f7, 0x00000020, 0x00000000, 0x000400fa,
+    0x0000001f, 0x00000021, 0x00000020, 0x000200f8, 0x00000021, 0x000100fc, 0x000200f8, 0x00000020,
+    0x0008000c, 0x00000009, 0x00000022, 0x00000001, 0x00000031, 0x00000010, 0x00000011, 0x0000001e,
+    0x0004003d, 0x00000009, 0x00000023, 0x00000004, 0x00050085, 0x00000009, 0x00000024, 0x00000023,
+    0x00000022, 0x00050085, 0x00000009, 0x00000025, 0x00000024, 0x00000012, 0x00050083, 0x00000009,
+    0x00000026, 0x00000013, 0x00000023, 0x00060050, 0x0000000b, 0x00000027, 0x00000026, 0x00000026,
+    0x00000026, 0x0008000c, 0x0000000b, 0x00000028, 0x00000001, 0x0000002e, 0x0000001a, 0x0000001b,
+    0x00000027, 0x00050050, 0x0000000c, 0x00000029, 0x00000028, 0x00000025, 0x0003003e, 0x00000005,
+    0x00000029, 0x000100fd, 0x00010038,
+};
+
+// Сцена домика через Vulkan, без окна: кадр рисуется во внеэкранный буфер и
+// копируется в память хоста (строки снизу вверх, как у SoftwareRenderer).
+// Конвейеры собираются в init(), дескрипторный набор с буфером данных
+// вызовов живёт всё время и обновляется только при росте буфера. В endFrame()
+// вызовы записываются параллельно на пуле: у каждого потока свой пул команд и
+// вторичный буфер команд, первичный только исполняет их внутри прохода.
+// Работает и на программных драйверах (lavapipe, SwiftShader).
+class VulkanRenderer : public RenderBackend
+{
+public:
+    // Меньше вызовов на вторичный буфер не дробим — запись дешевле запуска задачи
+    static constexpr size_t MIN_RECORD_GRAIN = 1024;
+
+    VulkanRenderer(ThreadPool& pool, int width, int height)
+        : pool(pool), width(width), height(height)
+    {
+    }
+
+    ~VulkanRenderer()
+    {
+        if (device)
+        {
+            vk.vkDeviceWaitIdle(device);
+            destroyBuffer(drawBuffer);
+            destroyBuffer(smokeBuffer);
+            destroyBuffer(cubeBuffer);
+            destroyBuffer(readback);
+            if (fence) vk.vkDestroyFence(device, fence, nullptr);
+            for (Recorder& r : recorders)
+                vk.vkDestroyCommandPool(device, r.commandPool, nullptr);
+            if (primaryPool) vk.vkDestroyCommandPool(device, primaryPool, nullptr);
+            if (cubePipeline) vk.vkDestroyPipeline(device, cubePipeline, nullptr);
+            if (smokePipeline) vk.vkDestroyPipeline(device, smokePipeline, nullptr);
+            if (pipelineLayout) vk.vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+            if (descriptorPool) vk.vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+            if (setLayout) vk.vkDestroyDescriptorSetLayout(device, setLayout, nullptr);
+            if (framebuffer) vk.vkDestroyFramebuffer(device, framebuffer, nullptr);
+            if (renderPass) vk.vkDestroyRenderPass(device, renderPass, nullptr);
+            destroyImage(colorImage);
+            destroyImage(depthImage);
+            vk.vkDestroyDevice(device, nullptr);
+        }
+        if (instance)
+            vk.vkDestroyInstance(instance, nullptr);
+    }
+
+    VulkanRenderer(const VulkanRenderer&) = delete;
+    VulkanRenderer& operator=(const VulkanRenderer&) = delete;
+
+    // Загрузчик, устройство, цели рендера и конвейеры. false — Vulkan недоступен
+    bool init()
+    {
+        vk.vkGetInstanceProcAddr = vulkanLoader();
+        if (!vk.vkGetInstanceProcAddr)
+        {
+            std::cerr << "Vulkan loader not found\n";
+            return false;
+        }
+        vk.vkCreateInstance = (PFN_vkCreateInstance)vk.vkGetInstanceProcAddr(nullptr, "vkCreateInstance");
+        if (!vk.vkCreateInstance)
+            return false;
+
+        VkApplicationInfo app = {};
+        app.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        app.pApplicationName = "Steam from Chimney";
+        app.apiVersion = VK_API_VERSION_1_0;
+        VkInstanceCreateInfo instanceInfo = {};
+        instanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        instanceInfo.pApplicationInfo = &app;
+        if (!check(vk.vkCreateInstance(&instanceInfo, nullptr, &instance), "vkCreateInstance"))
+            return false;
+#define MID_VK_LOAD_INSTANCE(name) vk.name = (PFN_##name)vk.vkGetInstanceProcAddr(instance, #name);
+        MID_VK_INSTANCE_FUNCTIONS(MID_VK_LOAD_INSTANCE)
+#undef MID_VK_LOAD_INSTANCE
+
+        if (!pickDevice())
+            return false;
+
+        float priority = 1.0f;
+        VkDeviceQueueCreateInfo queueInfo = {};
+        queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queueInfo.queueFamilyIndex = queueFamily;
+        queueInfo.queueCount = 1;
+        queueInfo.pQueuePriorities = &priority;
+        VkDeviceCreateInfo deviceInfo = {};
+        deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        deviceInfo.queueCreateInfoCount = 1;
+        deviceInfo.pQueueCreateInfos = &queueInfo;
+        if (!check(vk.vkCreateDevice(physicalDevice, &deviceInfo, nullptr, &device), "vkCreateDevice"))
+            return false;
+#define MID_VK_LOAD_DEVICE(name) vk.name = (PFN_##name)vk.vkGetDeviceProcAddr(device, #name);
+        MID_VK_DEVICE_FUNCTIONS(MID_VK_LOAD_DEVICE)
+#undef MID_VK_LOAD_DEVICE
+        vk.vkGetDeviceQueue(device, queueFamily, 0, &queue);
+
+        return createTargets() && createPipelines() && createCommands();
+    }
+
+    const std::string& deviceName() const { return name; }
+
+    // Смещения частиц — те же, что в вершинном буфере дыма GL-пути
+    void setParticles(std::vector<glm::vec3> offsets) { particles = std::move(offsets); }
+
+    void beginFrame(const glm::vec4& clearColor)
+    {
+        clear = clearColor;
+        draws.clear();
+        smokeVertices.clear();
+        items.clear();
+    }
+
+    void setCamera(const glm::mat4& proj, const glm::mat4& view) override
+    {
+        // Клип-пространство Vulkan: z в [0, w] вместо [-w, w]
+        const glm::mat4 depthFix(1.0f, 0.0f, 0.0f, 0.0f,
+                                 0.0f, 1.0f, 0.0f, 0.0f,
+                                 0.0f, 0.0f, 0.5f, 0.0f,
+                                 0.0f, 0.0f, 0.5f, 1.0f);
+        this->view = view;
+        viewProj = depthFix * proj * view;
+    }
+
+    void drawCube(const glm::mat4& model, const glm::vec3& rgb) override
+    {
+        items.push_back({ ITEM_CUBE, (uint32_t)draws.size(), 1 });
+        draws.push_back({ viewProj * model, glm::vec4(rgb, 1.0f) });
+    }
+
+    // Текстур у этого пути пока нет — земля рисуется цветом
+    void drawGround(const glm::mat4& model, const glm::vec3& rgb) override { drawCube(model, rgb); }
+
+    void drawSmoke(const glm::vec3& base, float t) override
+    {
+        // Повторяет particleGS, как и программный путь: квадрат к камере
+        glm::vec3 right(view[0][0], view[1][0], view[2][0]);
+        glm::vec3 up(view[0][1], view[1][1], view[2][1]);
+        const glm::vec2 uv[4] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f } };
+        const glm::vec3 corner[4] = { -right - up, right - up, -right + up, right + up };
+        const int strip[6] = { 0, 1, 2, 2, 1, 3 };
+
+        uint32_t first = (uint32_t)smokeVertices.size();
+        for (const glm::vec3& offset : particles)
+        {
+            glm::vec3 center;
+            float alpha;
+            smokeParticle(offset, base, t, center, alpha);
+            float size = 0.18f * alpha;
+            for (int i : strip)
+                smokeVertices.push_back({ viewProj * glm::vec4(center + corner[i] * size, 1.0f), uv[i], alpha, 0.0f });
+        }
+        items.push_back({ ITEM_SMOKE, first, (uint32_t)smokeVertices.size() - first });
+    }
+
+    // Записать, отправить и дождаться кадра
+    void endFrame()
+    {
+        auto start = std::chrono::steady_clock::now();
+        if (!reserve(drawBuffer, draws.size() * sizeof(DrawData), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+            || !reserve(smokeBuffer, smokeVertices.size() * sizeof(SmokeVertex), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT))
+            return;
+        if (drawBuffer.buffer != boundDrawBuffer)
+            bindDrawBuffer();
+        if (!smokeVertices.empty())
+            std::memcpy(smokeBuffer.mapped, smokeVertices.data(), smokeVertices.size() * sizeof(SmokeVertex));
+
+        // Кусков не больше, чем рекордеров: номер куска и есть номер рекордера
+        size_t grain = std::max(MIN_RECORD_GRAIN, (items.size() + recorders.size() - 1) / recorders.size());
+        size_t chunks = (items.size() + grain - 1) / grain;
+        pool.parallelFor(items.size(), grain, [this, grain](size_t begin, size_t end)
+        {
+            record(recorders[begin / grain], begin, end);
+        });
+
+        vk.vkResetCommandPool(device, primaryPool, 0);
+        VkCommandBufferBeginInfo beginInfo = {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vk.vkBeginCommandBuffer(primary, &beginInfo);
+
+        VkClearValue clearValues[2] = {};
+        std::memcpy(clearValues[0].color.float32, &clear[0], sizeof(float) * 4);
+        clearValues[1].depthStencil.depth = 1.0f;
+        VkRenderPassBeginInfo passInfo = {};
+        passInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        passInfo.renderPass = renderPass;
+        passInfo.framebuffer = framebuffer;
+        passInfo.renderArea.extent = { (uint32_t)width, (uint32_t)height };
+        passInfo.clearValueCount = 2;
+        passInfo.pClearValues = clearValues;
+        vk.vkCmdBeginRenderPass(primary, &passInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        std::vector<VkCommandBuffer> secondaries;
+        for (size_t i = 0; i < chunks; ++i)
+            secondaries.push_back(recorders[i].commands);
+        if (!secondaries.empty())
+            vk.vkCmdExecuteCommands(primary, (uint32_t)secondaries.size(), secondaries.data());
+        vk.vkCmdEndRenderPass(primary);
+
+        VkBufferImageCopy copy = {};
+        copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copy.imageSubresource.layerCount = 1;
+        copy.imageExtent = { (uint32_t)width, (uint32_t)height, 1 };
+        vk.vkCmdCopyImageToBuffer(primary, colorImage.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readback.buffer, 1, &copy);
+        VkMemoryBarrier toHost = {};
+        toHost.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        toHost.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toHost.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vk.vkCmdPipelineBarrier(primary, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+                                1, &toHost, 0, nullptr, 0, nullptr);
+        vk.vkEndCommandBuffer(primary);
+
+        VkSubmitInfo submit = {};
+        submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit.commandBufferCount = 1;
+        submit.pCommandBuffers = &primary;
+        check(vk.vkQueueSubmit(queue, 1, &submit, fence), "vkQueueSubmit");
+        recordMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        // Буферы данных общие для всех кадров, поэтому кадр в полёте один
+        vk.vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
+        vk.vkResetFences(device, 1, &fence);
+    }
+
+    size_t drawCount() const { return items.size(); }
+
+    // Время записи и отправки последнего кадра, без ожидания GPU
+    double lastRecordMs() const { return recordMs; }
+
+    bool writePPM(const std::string& path) const
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            std::cerr << "Failed to write " << path << "\n";
+            return false;
+        }
+        out << "P6\n" << width << " " << height << "\n255\n";
+        const uint8_t* pixels = (const uint8_t*)readback.mapped;
+        std::vector<char> row((size_t)width * 3);
+        for (int y = height - 1; y >= 0; --y)
+        {
+            const uint8_t* src = pixels + (size_t)y * width * 4;
+            for (int x = 0; x < width; ++x)
+            {
+                row[x * 3 + 0] = (char)src[x * 4 + 0];
+                row[x * 3 + 1] = (char)src[x * 4 + 1];
+                row[x * 3 + 2] = (char)src[x * 4 + 2];
+            }
+            out.write(row.data(), (std::streamsize)row.size());
+        }
+        return (bool)out;
+    }
+
+private:
+    enum ItemKind : uint8_t
+    {
+        ITEM_CUBE,
+        ITEM_SMOKE
+    };
+
+    // Вызов в порядке сцены: куб — номер в drawBuffer, дым — диапазон вершин
+    struct Item
+    {
+        ItemKind kind;
+        uint32_t first, count;
+    };
+
+    // Раскладка std430 структуры Draw в CUBE_VS_SPIRV
+    struct DrawData
+    {
+        glm::mat4 mvp;
+        glm::vec4 color;
+    };
+
+    struct SmokeVertex
+    {
+        glm::vec4 clip;
+        glm::vec2 uv;
+        float alpha, pad;
+    };
+
+    // Буфер в памяти хоста, отображён всё время жизни
+    struct Buffer
+    {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        void* mapped = nullptr;
+        VkDeviceSize size = 0;
+    };
+
+    struct Image
+    {
+        VkImage image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+    };
+
+    // Пул команд и вторичный буфер одного потока записи
+    struct Recorder
+    {
+        VkCommandPool commandPool = VK_NULL_HANDLE;
+        VkCommandBuffer commands = VK_NULL_HANDLE;
+    };
+
+    static bool check(VkResult result, const char* what)
+    {
+        if (result == VK_SUCCESS)
+            return true;
+        std::cerr << what << " failed: VkResult " << (int)result << "\n";
+        return false;
+    }
+
+    bool pickDevice()
+    {
+        uint32_t count = 0;
+        vk.vkEnumeratePhysicalDevices(instance, &count, nullptr);
+        std::vector<VkPhysicalDevice> devices(count);
+        if (count)
+            vk.vkEnumeratePhysicalDevices(instance, &count, devices.data());
+        for (VkPhysicalDevice d : devices)
+        {
+            uint32_t familyCount = 0;
+            vk.vkGetPhysicalDeviceQueueFamilyProperties(d, &familyCount, nullptr);
+            std::vector<VkQueueFamilyProperties> families(familyCount);
+            vk.vkGetPhysicalDeviceQueueFamilyProperties(d, &familyCount, families.data());
+            for (uint32_t f = 0; f < familyCount; ++f)
+            {
+                if (!(families[f].queueFlags & VK_QUEUE_GRAPHICS_BIT))
+                    continue;
+                physicalDevice = d;
+                queueFamily = f;
+                VkPhysicalDeviceProperties props;
+                vk.vkGetPhysicalDeviceProperties(d, &props);
+                name = props.deviceName;
+                vk.vkGetPhysicalDeviceMemoryProperties(d, &memoryProps);
+                return true;
+            }
+        }
+        std::cerr << "No Vulkan device with a graphics queue\n";
+        return false;
+    }
+
+    // Тип памяти с нужными свойствами; preferred — желательные сверх них
+    bool memoryType(uint32_t typeBits, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred, uint32_t& out) const
+    {
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            VkMemoryPropertyFlags want = pass == 0 ? required | preferred : required;
+            for (uint32_t i = 0; i < memoryProps.memoryTypeCount; ++i)
+                if ((typeBits & (1u << i)) && (memoryProps.memoryTypes[i].propertyFlags & want) == want)
+                {
+                    out = i;
+                    return true;
+                }
+        }
+        std::cerr << "No suitable Vulkan memory type\n";
+        return false;
+    }
+
+    bool allocate(const VkMemoryRequirements& req, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred,
+                  VkDeviceMemory& out)
+    {
+        VkMemoryAllocateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        info.allocationSize = req.size;
+        return memoryType(req.memoryTypeBits, required, preferred, info.memoryTypeIndex)
+            && check(vk.vkAllocateMemory(device, &info, nullptr, &out), "vkAllocateMemory");
+    }
+
+    bool createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, Buffer& out)
+    {
+        VkBufferCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        info.size = size;
+        info.usage = usage;
+        info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (!check(vk.vkCreateBuffer(device, &info, nullptr, &out.buffer), "vkCreateBuffer"))
+            return false;
+        VkMemoryRequirements req;
+        vk.vkGetBufferMemoryRequirements(device, out.buffer, &req);
+        if (!allocate(req, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 0, out.memory))
+            return false;
+        out.size = size;
+        return check(vk.vkBindBufferMemory(device, out.buffer, out.memory, 0), "vkBindBufferMemory")
+            && check(vk.vkMapMemory(device, out.memory, 0, VK_WHOLE_SIZE, 0, &out.mapped), "vkMapMemory");
+    }
+
+    void destroyBuffer(Buffer& b)
+    {
+        if (b.buffer) vk.vkDestroyBuffer(device, b.buffer, nullptr);
+        if (b.memory) vk.vkFreeMemory(device, b.memory, nullptr);
+        b = Buffer();
+    }
+
+    // Растёт вдвое; прошлый кадр уже дождались, так что старый буфер свободен
+    bool reserve(Buffer& b, size_t bytes, VkBufferUsageFlags usage)
+    {
+        if (bytes <= b.size)
+            return true;
+        VkDeviceSize size = std::max<VkDeviceSize>(b.size * 2, std::max<size_t>(bytes, 4096));
+        destroyBuffer(b);
+        return createBuffer(size, usage, b);
+    }
+
+    bool createImage(VkFormat format, VkImageUsageFlags usage, VkImageAspectFlags aspect, Image& out)
+    {
+        VkImageCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        info.imageType = VK_IMAGE_TYPE_2D;
+        info.format = format;
+        info.extent = { (uint32_t)width, (uint32_t)height, 1 };
+        info.mipLevels = 1;
+        info.arrayLayers = 1;
+        info.samples = VK_SAMPLE_COUNT_1_BIT;
+        info.tiling = VK_IMAGE_TILING_OPTIMAL;
+        info.usage = usage;
+        info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        if (!check(vk.vkCreateImage(device, &info, nullptr, &out.image), "vkCreateImage"))
+            return false;
+        VkMemoryRequirements req;
+        vk.vkGetImageMemoryRequirements(device, out.image, &req);
+        if (!allocate(req, 0, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, out.memory)
+            || !check(vk.vkBindImageMemory(device, out.image, out.memory, 0), "vkBindImageMemory"))
+            return false;
+
+        VkImageViewCreateInfo viewInfo = {};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = out.image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = format;
+        viewInfo.subresourceRange.aspectMask = aspect;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.layerCount = 1;
+        return check(vk.vkCreateImageView(device, &viewInfo, nullptr, &out.view), "vkCreateImageView");
+    }
+
+    void destroyImage(Image& img)
+    {
+        if (img.view) vk.vkDestroyImageView(device, img.view, nullptr);
+        if (img.image) vk.vkDestroyImage(device, img.image, nullptr);
+        if (img.memory) vk.vkFreeMemory(device, img.memory, nullptr);
+        img = Image();
+    }
+
+    bool createTargets()
+    {
+        if (!createImage(VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                         VK_IMAGE_ASPECT_COLOR_BIT, colorImage)
+            || !createImage(VK_FORMAT_D32_SFLOAT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+                            VK_IMAGE_ASPECT_DEPTH_BIT, depthImage))
+            return false;
+
+        VkAttachmentDescription attachments[2] = {};
+        attachments[0].format = VK_FORMAT_R8G8B8A8_UNORM;
+        attachments[0].samples = VK_SAMPLE_COUNT_1_BIT;
+        attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        attachments[0].finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        attachments[1] = attachments[0];
+        attachments[1].format = VK_FORMAT_D32_SFLOAT;
+        attachments[1].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachments[1].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        VkAttachmentReference colorRef = { 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+        VkAttachmentReference depthRef = { 1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+        VkSubpassDescription subpass = {};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = 1;
+        subpass.pColorAttachments = &colorRef;
+        subpass.pDepthStencilAttachment = &depthRef;
+
+        // Вход: копия прошлого кадра и его глубина; выход: копия в readback
+        VkSubpassDependency deps[2] = {};
+        deps[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+        deps[0].dstSubpass = 0;
+        deps[0].srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        deps[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+        deps[0].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        deps[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        deps[1].srcSubpass = 0;
+        deps[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+        deps[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        deps[1].dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        deps[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        deps[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+        VkRenderPassCreateInfo passInfo = {};
+        passInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        passInfo.attachmentCount = 2;
+        passInfo.pAttachments = attachments;
+        passInfo.subpassCount = 1;
+        passInfo.pSubpasses = &subpass;
+        passInfo.dependencyCount = 2;
+        passInfo.pDependencies = deps;
+        if (!check(vk.vkCreateRenderPass(device, &passInfo, nullptr, &renderPass), "vkCreateRenderPass"))
+            return false;
+
+        VkImageView views[2] = { colorImage.view, depthImage.view };
+        VkFramebufferCreateInfo fbInfo = {};
+        fbInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        fbInfo.renderPass = renderPass;
+        fbInfo.attachmentCount = 2;
+        fbInfo.pAttachments = views;
+        fbInfo.width = (uint32_t)width;
+        fbInfo.height = (uint32_t)height;
+        fbInfo.layers = 1;
+        return check(vk.vkCreateFramebuffer(device, &fbInfo, nullptr, &framebuffer), "vkCreateFramebuffer")
+            && createBuffer((VkDeviceSize)width * height * 4, VK_BUFFER_USAGE_TRANSFER_DST_BIT, readback);
+    }
+
+    VkShaderModule shaderModule(const uint32_t* code, size_t bytes)
+    {
+        VkShaderModuleCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        info.codeSize = bytes;
+        info.pCode = code;
+        VkShaderModule module = VK_NULL_HANDLE;
+        check(vk.vkCreateShaderModule(device, &info, nullptr, &module), "vkCreateShaderModule");
+        return module;
+    }
+
+    bool createPipeline(const uint32_t* vs, size_t vsBytes, const uint32_t* fs, size_t fsBytes,
+                        const VkVertexInputBindingDescription& binding,
+                        const VkVertexInputAttributeDescription* attributes, uint32_t attributeCount, VkPipeline& out)
+    {
+        VkShaderModule vsModule = shaderModule(vs, vsBytes);
+        VkShaderModule fsModule = shaderModule(fs, fsBytes);
+        VkPipelineShaderStageCreateInfo stages[2] = {};
+        stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+        stages[0].module = vsModule;
+        stages[0].pName = "main";
+        stages[1] = stages[0];
+        stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+        stages[1].module = fsModule;
+
+        VkPipelineVertexInputStateCreateInfo vertexInput = {};
+        vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        vertexInput.vertexBindingDescriptionCount = 1;
+        vertexInput.pVertexBindingDescriptions = &binding;
+        vertexInput.vertexAttributeDescriptionCount = attributeCount;
+        vertexInput.pVertexAttributeDescriptions = attributes;
+
+        VkPipelineInputAssemblyStateCreateInfo assembly = {};
+        assembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        assembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        // Размер цели постоянный — вьюпорт зашит в конвейер, динамики нет
+        VkViewport viewport = { 0.0f, 0.0f, (float)width, (float)height, 0.0f, 1.0f };
+        VkRect2D scissor = { { 0, 0 }, { (uint32_t)width, (uint32_t)height } };
+        VkPipelineViewportStateCreateInfo viewportState = {};
+        viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.viewportCount = 1;
+        viewportState.pViewports = &viewport;
+        viewportState.scissorCount = 1;
+        viewportState.pScissors = &scissor;
+
+        VkPipelineRasterizationStateCreateInfo raster = {};
+        raster.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        raster.polygonMode = VK_POLYGON_MODE_FILL;
+        raster.cullMode = VK_CULL_MODE_NONE;
+        raster.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        raster.lineWidth = 1.0f;
+
+        VkPipelineMultisampleStateCreateInfo multisample = {};
+        multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+        VkPipelineDepthStencilStateCreateInfo depthState = {};
+        depthState.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthState.depthTestEnable = VK_TRUE;
+        depthState.depthWriteEnable = VK_TRUE;
+        depthState.depthCompareOp = VK_COMPARE_OP_LESS;
+        depthState.maxDepthBounds = 1.0f;
+
+        // Как glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA) в GL-пути
+        VkPipelineColorBlendAttachmentState blend = {};
+        blend.blendEnable = VK_TRUE;
+        blend.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+        blend.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        blend.colorBlendOp = VK_BLEND_OP_ADD;
+        blend.srcAlphaBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+        blend.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        blend.alphaBlendOp = VK_BLEND_OP_ADD;
+        blend.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
+            | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        VkPipelineColorBlendStateCreateInfo blendState = {};
+        blendState.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        blendState.attachmentCount = 1;
+        blendState.pAttachments = &blend;
+
+        VkGraphicsPipelineCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        info.stageCount = 2;
+        info.pStages = stages;
+        info.pVertexInputState = &vertexInput;
+        info.pInputAssemblyState = &assembly;
+        info.pViewportState = &viewportState;
+        info.pRasterizationState = &raster;
+        info.pMultisampleState = &multisample;
+        info.pDepthStencilState = &depthState;
+        info.pColorBlendState = &blendState;
+        info.layout = pipelineLayout;
+        info.renderPass = renderPass;
+        info.basePipelineIndex = -1;
+        bool ok = vsModule && fsModule
+            && check(vk.vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &info, nullptr, &out),
+                     "vkCreateGraphicsPipelines");
+        if (vsModule) vk.vkDestroyShaderModule(device, vsModule, nullptr);
+        if (fsModule) vk.vkDestroyShaderModule(device, fsModule, nullptr);
+        return ok;
+    }
+
+    bool createPipelines()
+    {
+        VkDescriptorSetLayoutBinding drawsBinding = {};
+        drawsBinding.binding = 0;
+        drawsBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        drawsBinding.descriptorCount = 1;
+        drawsBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        VkDescriptorSetLayoutCreateInfo setInfo = {};
+        setInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        setInfo.bindingCount = 1;
+        setInfo.pBindings = &drawsBinding;
+        if (!check(vk.vkCreateDescriptorSetLayout(device, &setInfo, nullptr, &setLayout), "vkCreateDescriptorSetLayout"))
+            return false;
+
+        VkDescriptorPoolSize poolSize = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1 };
+        VkDescriptorPoolCreateInfo poolInfo = {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = 1;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+        if (!check(vk.vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool), "vkCreateDescriptorPool"))
+            return false;
+        VkDescriptorSetAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &setLayout;
+        if (!check(vk.vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet), "vkAllocateDescriptorSets"))
+            return false;
+
+        VkPipelineLayoutCreateInfo layoutInfo = {};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &setLayout;
+        if (!check(vk.vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayout), "vkCreatePipelineLayout"))
+            return false;
+
+        VkVertexInputBindingDescription cubeBinding = { 0, sizeof(glm::vec3), VK_VERTEX_INPUT_RATE_VERTEX };
+        VkVertexInputAttributeDescription cubeAttribute = { 0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0 };
+        VkVertexInputBindingDescription smokeBinding = { 0, sizeof(SmokeVertex), VK_VERTEX_INPUT_RATE_VERTEX };
+        VkVertexInputAttributeDescription smokeAttributes[3] = {
+            { 0, 0, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(SmokeVertex, clip) },
+            { 1, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(SmokeVertex, uv) },
+            { 2, 0, VK_FORMAT_R32_SFLOAT, offsetof(SmokeVertex, alpha) },
+        };
+        return createPipeline(CUBE_VS_SPIRV, sizeof(CUBE_VS_SPIRV), CUBE_FS_SPIRV, sizeof(CUBE_FS_SPIRV),
+                              cubeBinding, &cubeAttribute, 1, cubePipeline)
+            && createPipeline(SMOKE_VS_SPIRV, sizeof(SMOKE_VS_SPIRV), SMOKE_FS_SPIRV, sizeof(SMOKE_FS_SPIRV),
+                              smokeBinding, smokeAttributes, 3, smokePipeline)
+            && createCubeMesh();
+    }
+
+    // Вершины и индексы единичного куба, в порядке cubeIdx; индексы — после вершин
+    bool createCubeMesh()
+    {
+        static const glm::vec3 corners[8] = {
+            { -0.5f, -0.5f, -0.5f }, { 0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, -0.5f }, { -0.5f, 0.5f, -0.5f },
+            { -0.5f, -0.5f, 0.5f }, { 0.5f, -0.5f, 0.5f }, { 0.5f, 0.5f, 0.5f }, { -0.5f, 0.5f, 0.5f },
+        };
+        static const uint16_t indices[36] = {
+            0, 1, 2, 2, 3, 0,   4, 5, 6, 6, 7, 4,   0, 4, 7, 7, 3, 0,
+            1, 5, 6, 6, 2, 1,   3, 2, 6, 6, 7, 3,   0, 1, 5, 5, 4, 0,
+        };
+        if (!createBuffer(sizeof(corners) + sizeof(indices),
+                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, cubeBuffer))
+            return false;
+        std::memcpy(cubeBuffer.mapped, corners, sizeof(corners));
+        std::memcpy((char*)cubeBuffer.mapped + sizeof(corners), indices, sizeof(indices));
+        return true;
+    }
+
+    bool createCommands()
+    {
+        VkCommandPoolCreateInfo poolInfo = {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        poolInfo.queueFamilyIndex = queueFamily;
+        VkCommandBufferAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+        if (!check(vk.vkCreateCommandPool(device, &poolInfo, nullptr, &primaryPool), "vkCreateCommandPool"))
+            return false;
+        allocInfo.commandPool = primaryPool;
+        if (!check(vk.vkAllocateCommandBuffers(device, &allocInfo, &primary), "vkAllocateCommandBuffers"))
+            return false;
+
+        // Воркеры пула и вызывающий поток: parallelFor отдаёт куски и ему
+        recorders.resize(pool.size() + 1);
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        for (Recorder& r : recorders)
+        {
+            if (!check(vk.vkCreateCommandPool(device, &poolInfo, nullptr, &r.commandPool), "vkCreateCommandPool"))
+                return false;
+            allocInfo.commandPool = r.commandPool;
+            if (!check(vk.vkAllocateCommandBuffers(device, &allocInfo, &r.commands), "vkAllocateCommandBuffers"))
+                return false;
+        }
+
+        VkFenceCreateInfo fenceInfo = {};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        return check(vk.vkCreateFence(device, &fenceInfo, nullptr, &fence), "vkCreateFence");
+    }
+
+    void bindDrawBuffer()
+    {
+        VkDescriptorBufferInfo bufferInfo = { drawBuffer.buffer, 0, VK_WHOLE_SIZE };
+        VkWriteDescriptorSet write = {};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = descriptorSet;
+        write.dstBinding = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.pBufferInfo = &bufferInfo;
+        vk.vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+        boundDrawBuffer = drawBuffer.buffer;
+    }
+
+    // Вызовы [begin, end) во вторичный буфер; данные своих кубов копирует сам
+    void record(Recorder& r, size_t begin, size_t end)
+    {
+        vk.vkResetCommandPool(device, r.commandPool, 0);
+        VkCommandBufferInheritanceInfo inheritance = {};
+        inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritance.renderPass = renderPass;
+        inheritance.subpass = 0;
+        inheritance.framebuffer = framebuffer;
+        VkCommandBufferBeginInfo beginInfo = {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        beginInfo.pInheritanceInfo = &inheritance;
+        VkCommandBuffer cmd = r.commands;
+        vk.vkBeginCommandBuffer(cmd, &beginInfo);
+        vk.vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+        vk.vkCmdBindIndexBuffer(cmd, cubeBuffer.buffer, sizeof(glm::vec3) * 8, VK_INDEX_TYPE_UINT16);
+
+        const VkDeviceSize zero = 0;
+        int bound = -1;
+        uint32_t firstDraw = UINT32_MAX, lastDraw = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            const Item& item = items[i];
+            if (item.kind != bound)
+            {
+                bool cube = item.kind == ITEM_CUBE;
+                vk.vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, cube ? cubePipeline : smokePipeline);
+                vk.vkCmdBindVertexBuffers(cmd, 0, 1, cube ? &cubeBuffer.buffer : &smokeBuffer.buffer, &zero);
+                bound = item.kind;
+            }
+            if (item.kind == ITEM_CUBE)
+            {
+                vk.vkCmdDrawIndexed(cmd, 36, 1, 0, 0, item.first);
+                firstDraw = std::min(firstDraw, item.first);
+                lastDraw = item.first;
+            }
+            else
+                vk.vkCmdDraw(cmd, item.count, 1, item.first, 0);
+        }
+        vk.vkEndCommandBuffer(cmd);
+
+        if (firstDraw <= lastDraw)
+            std::memcpy((DrawData*)drawBuffer.mapped + firstDraw, draws.data() + firstDraw,
+                        (lastDraw - firstDraw + 1) * sizeof(DrawData));
+    }
+
+    ThreadPool& pool;
+    int width, height;
+    VulkanFunctions vk;
+
+    VkInstance instance = VK_NULL_HANDLE;
+    VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+    VkPhysicalDeviceMemoryProperties memoryProps = {};
+    VkDevice device = VK_NULL_HANDLE;
+    VkQueue queue = VK_NULL_HANDLE;
+    uint32_t queueFamily = 0;
+    std::string name;
+
+    Image colorImage, depthImage;
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    VkFramebuffer framebuffer = VK_NULL_HANDLE;
+    Buffer readback;
+
+    VkDescriptorSetLayout setLayout = VK_NULL_HANDLE;
+    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+    VkPipeline cubePipeline = VK_NULL_HANDLE, smokePipeline = VK_NULL_HANDLE;
+    Buffer cubeBuffer, drawBuffer, smokeBuffer;
+    VkBuffer boundDrawBuffer = VK_NULL_HANDLE;
+
+    VkCommandPool primaryPool = VK_NULL_HANDLE;
+    VkCommandBuffer primary = VK_NULL_HANDLE;
+    std::vector<Recorder> recorders;
+    VkFence fence = VK_NULL_HANDLE;
+    double recordMs = 0.0;
+
+    glm::vec4 clear = glm::vec4(0.0f);
+    glm::mat4 view = glm::mat4(1.0f), viewProj = glm::mat4(1.0f);
+    std::vector<glm::vec3> particles;
+    std::vector<DrawData> draws;
+    std::vector<SmokeVertex> smokeVertices;
+    std::vector<Item> items;
+};
+
+#endif
@@ -0,0 +1,894 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "asset_io.h"
+#include "occlusion.h"
+#include "tasks.h"
+#include "upload_worker.h"
+
+// Один куб сцены: матрица модели, цвет и номер материала (см. MaterialTable;
+// 0 — без текстуры). Из таких writeWorld собирает мир.
+struct CubeInstance
+{
+    glm::mat4 model;
+    glm::vec4 color;
+    uint32_t material = 0;
+    uint32_t reserved[3] = {};
+};
+static_assert(sizeof(CubeInstance) == 96, "CubeInstance must stay tightly packed");
+
+// Тот же куб в файле мира и в инстанс-буфере: цвет сжат в RGB10A2, альфа
+// не нужна и остаётся нулём. Шейдер читает инстанс через текстурный буфер
+// RGBA32UI как пять текселей: цвет и материал — целыми словами, матрицу —
+// через uintBitsToFloat. Через float-вид слово цвета не прочитать: при синем
+// меньше 8/1023 это денормал, который GL вправе обнулить.
+struct PackedInstance
+{
+    glm::mat4 model;
+    uint32_t color = 0;
+    uint32_t material = 0;
+    uint32_t reserved[2] = {};
+};
+static_assert(sizeof(PackedInstance) == 80, "PackedInstance must stay tightly packed");
+
+inline std::vector<PackedInstance> packInstances(const std::vector<CubeInstance>& instances)
+{
+    std::vector<glm::vec4> colors(instances.size());
+    for (size_t i = 0; i < instances.size(); ++i)
+        colors[i] = glm::vec4(glm::vec3(instances[i].color), 0.0f);
+    std::vector<uint32_t> packed(instances.size());
+    glm::packUnorm3x10_1x2(colors.data(), packed.data(), colors.size());
+
+    std::vector<PackedInstance> out(instances.size());
+    for (size_t i = 0; i < instances.size(); ++i)
+    {
+        out[i].model = instances[i].model;
+        out[i].color = packed[i];
+        out[i].material = instances[i].material;
+    }
+    return out;
+}
+
+enum WorldObjectKind : uint32_t
+{
+    OBJECT_PROP = 0,
+    OBJECT_SMOKE = 1
+};
+
+// Логический объект (дом, куст, источник дыма) — диапазон инстансов своей ячейки
+struct WorldObject
+{
+    uint32_t kind = OBJECT_PROP;
+    uint32_t firstInstance = 0;
+    uint32_t instanceCount = 0;
+    uint32_t seed = 0;
+    glm::vec4 sphere = glm::vec4(0.0f); // центр и радиус
+};
+static_assert(sizeof(WorldObject) == 32, "WorldObject must stay tightly packed");
+
+// Формат файла мира: заголовок, таблица ячеек, затем сами ячейки,
+// выровненные на IO_ALIGNMENT, чтобы читать их через O_DIRECT.
+struct WorldHeader
+{
+    char magic[4];
+    uint32_t version;
+    float cellSize;
+    uint32_t cellCount;
+    glm::vec2 origin;
+    uint32_t reserved[2];
+};
+
+struct WorldCellEntry
+{
+    int32_t cx, cz;
+    uint64_t offset;
+    uint32_t size;
+    uint32_t instanceCount;
+    uint32_t objectCount;
+    uint32_t reserved;
+    glm::vec3 boundsMin;
+    glm::vec3 boundsMax;
+};
+
+struct CellHeader
+{
+    char magic[4];
+    uint32_t objectCount;
+    uint32_t instanceCount;
+    uint32_t reserved;
+};
+
+const uint32_t WORLD_VERSION = 3;
+
+inline glm::vec3 instanceHalfExtent(const glm::mat4& m)
+{
+    // Полуразмер AABB единичного куба после преобразования
+    glm::vec3 e(0.0f);
+    for (int axis = 0; axis < 3; ++axis)
+        e += glm::abs(glm::vec3(m[axis])) * 0.5f;
+    return e;
+}
+
+// Разбить сцену на ячейки и записать в один файл
+inline bool writeWorld(const std::string& path, float cellSize,
+                       const std::vector<CubeInstance>& instances,
+                       const std::vector<WorldObject>& objects)
+{
+    if (instances.empty())
+        return false;
+
+    glm::vec2 lo(1e30f);
+    for (const CubeInstance& inst : instances)
+        lo = glm::min(lo, glm::vec2(inst.model[3].x, inst.model[3].z));
+
+    auto cellOf = [&](const glm::vec3& p)
+    {
+        return std::make_pair((int32_t)std::floor((p.x - lo.x) / cellSize),
+                              (int32_t)std::floor((p.z - lo.y) / cellSize));
+    };
+
+    // Объект попадает в ячейку по своему центру вместе со всеми своими инстансами
+    struct CellBuild
+    {
+        std::vector<WorldObject> objects;
+        std::vector<CubeInstance> instances;
+    };
+    std::map<std::pair<int32_t, int32_t>, CellBuild> cells;
+
+    std::vector<bool> owned(instances.size(), false);
+    for (const WorldObject& obj : objects)
+    {
+        CellBuild& c = cells[cellOf(glm::vec3(obj.sphere))];
+        WorldObject o = obj;
+        o.firstInstance = (uint32_t)c.instances.size();
+        for (uint32_t i = 0; i < obj.instanceCount; ++i)
+        {
+            c.instances.push_back(instances[obj.firstInstance + i]);
+            owned[obj.firstInstance + i] = true;
+        }
+        c.objects.push_back(o);
+    }
+    for (size_t i = 0; i < instances.size(); ++i)
+        if (!owned[i])
+            cells[cellOf(glm::vec3(instances[i].model[3]))].instances.push_back(instances[i]);
+
+    auto alignUp = [](uint64_t v) { return (v + IO_ALIGNMENT - 1) / IO_ALIGNMENT * IO_ALIGNMENT; };
+
+    WorldHeader header = {};
+    std::memcpy(header.magic, "MIDW", 4);
+    header.version = WORLD_VERSION;
+    header.cellSize = cellSize;
+    header.cellCount = (uint32_t)cells.size();
+    header.origin = lo;
+
+    std::vector<WorldCellEntry> table;
+    uint64_t offset = alignUp(sizeof(WorldHeader) + cells.size() * sizeof(WorldCellEntry));
+    for (auto& [key, c] : cells)
+    {
+        WorldCellEntry e = {};
+        e.cx = key.first;
+        e.cz = key.second;
+        e.offset = offset;
+        e.size = (uint32_t)(sizeof(CellHeader) + c.objects.size() * sizeof(WorldObject)
+                            + c.instances.size() * sizeof(PackedInstance));
+        e.instanceCount = (uint32_t)c.instances.size();
+        e.objectCount = (uint32_t)c.objects.size();
+        e.boundsMin = glm::vec3(1e30f);
+        e.boundsMax = glm::vec3(-1e30f);
+        for (const CubeInstance& inst : c.instances)
+        {
+            glm::vec3 center(inst.model[3]);
+            glm::vec3 ext = instanceHalfExtent(inst.model);
+            e.boundsMin = glm::min(e.boundsMin, center - ext);
+            e.boundsMax = glm::max(e.boundsMax, center + ext);
+        }
+        table.push_back(e);
+        offset = alignUp(offset + e.size);
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        std::cerr << "Failed to write " << path << "\n";
+        return false;
+    }
+
+    static const char zeros[IO_ALIGNMENT] = {};
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)table.data(), (std::streamsize)(table.size() * sizeof(WorldCellEntry)));
+
+    size_t index = 0;
+    for (auto& [key, c] : cells)
+    {
+        const WorldCellEntry& e = table[index++];
+        out.write(zeros, (std::streamsize)(e.offset - (uint64_t)out.tellp()));
+
+        CellHeader ch = {};
+        std::memcpy(ch.magic, "MIDC", 4);
+        ch.objectCount = e.objectCount;
+        ch.instanceCount = e.instanceCount;
+        out.write((const char*)&ch, sizeof(ch));
+        std::vector<PackedInstance> packed = packInstances(c.instances);
+        out.write((const char*)c.objects.data(), (std::streamsize)(c.objects.size() * sizeof(WorldObject)));
+        out.write((const char*)packed.data(), (std::streamsize)(packed.size() * sizeof(PackedInstance)));
+    }
+    out.write(zeros, (std::streamsize)(alignUp((uint64_t)out.tellp()) - (uint64_t)out.tellp()));
+    return (bool)out;
+}
+
+struct Frustum
+{
+    glm::vec4 planes[6];
+
+    static Frustum fromMatrix(const glm::mat4& m)
+    {
+        glm::vec4 r0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        glm::vec4 r1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        glm::vec4 r2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        glm::vec4 r3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+        Frustum f;
+        f.planes[0] = r3 + r0;
+        f.planes[1] = r3 - r0;
+        f.planes[2] = r3 + r1;
+        f.planes[3] = r3 - r1;
+        f.planes[4] = r3 + r2;
+        f.planes[5] = r3 - r2;
+        for (glm::vec4& p : f.planes)
+            p /= glm::length(glm::vec3(p));
+        return f;
+    }
+
+    bool sphereVisible(const glm::vec3& c, float r) const
+    {
+        for (const glm::vec4& p : planes)
+            if (glm::dot(glm::vec3(p), c) + p.w < -r)
+                return false;
+        return true;
+    }
+};
+
+struct StreamBudget
+{
+    size_t cpuBytes = 128u << 20;   // staging под чтение + объекты ячеек
+    size_t gpuBytes = 256u << 20;   // инстанс-буферы
+    int maxLoadsInFlight = 8;
+    float minImportance = 2.0f;     // в пикселях: мельче — не грузим
+    float lookahead = 1.5f;         // секунд предсказанного движения
+    int maxOccluders = 256;         // ближайших кубов в буфер перекрытий
+    float occluderMinSize = 0.7f;   // в метрах: тоньше — не окклюдер
+};
+
+// Юнит текстурного буфера с инстансами ячейки (uniform uInstances). Вид —
+// RGBA32UI: слова приходят в шейдер как есть, а через float-вид целые вроде
+// номера материала оказались бы денормалами, которые GL вправе обнулить
+constexpr GLuint WORLD_INSTANCE_UNIT = 3;
+
+struct StreamStats
+{
+    int resident = 0;
+    int loading = 0;
+    size_t cpuBytes = 0;
+    size_t gpuBytes = 0;
+    size_t instances = 0;
+    size_t objectsTested = 0;       // за последний кадр
+    size_t objectsCulled = 0;
+};
+
+// Потоковая загрузка мира по ячейкам. Приоритет — экранный размер ячейки
+// с текущей и предсказанной позиции камеры; загрузка и выгрузка держат
+// CPU- и GPU-память в бюджете. С буфером перекрытий крупные кубы ближних
+// ячеек рисуются в него как окклюдеры, и закрытые объекты не попадают в
+// отрисовку: ячейка рисуется по списку индексов видимых инстансов.
+// Все GL-вызовы — на рендер-потоке.
+class WorldStreamer
+{
+public:
+    WorldStreamer(RenderQueue& renderQueue, AssetIO& io, UploadWorker& uploader, StagingArena& staging)
+        : renderQueue(renderQueue), io(io), uploader(uploader), staging(staging)
+    {
+    }
+
+    ~WorldStreamer()
+    {
+        // Загружаемые ячейки освободят себя сами по evictRequested, но их
+        // корутины держат this — крутим очередь, пока все не вернутся
+        for (Cell& c : cells)
+            unload(c);
+        while (loadsInFlight > 0)
+        {
+            renderQueue.drain();
+            std::this_thread::yield();
+        }
+
+        if (file)
+            io.close(file);
+        if (vao)
+        {
+            glDeleteVertexArrays(1, &vao);
+            glDeleteBuffers(1, &indexVBO);
+        }
+    }
+
+    bool open(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        WorldHeader header = {};
+        if (!in.read((char*)&header, sizeof(header)) || std::memcmp(header.magic, "MIDW", 4) != 0
+            || header.version != WORLD_VERSION)
+        {
+            std::cerr << "Not a world file: " << path << "\n";
+            return false;
+        }
+
+        std::vector<WorldCellEntry> table(header.cellCount);
+        in.read((char*)table.data(), (std::streamsize)(table.size() * sizeof(WorldCellEntry)));
+        if (!in)
+        {
+            std::cerr << "Truncated world file: " << path << "\n";
+            return false;
+        }
+
+        cells.clear();
+        cells.reserve(table.size());
+        worldMin = glm::vec3(1e30f);
+        worldMax = glm::vec3(-1e30f);
+        for (const WorldCellEntry& e : table)
+        {
+            worldMin = glm::min(worldMin, e.boundsMin);
+            worldMax = glm::max(worldMax, e.boundsMax);
+            Cell c;
+            c.entry = e;
+            c.center = (e.boundsMin + e.boundsMax) * 0.5f;
+            c.radius = glm::length(e.boundsMax - e.boundsMin) * 0.5f;
+            cells.push_back(c);
+        }
+
+        file = io.open(path);
+        return (bool)file;
+    }
+
+    void setMesh(GLuint vbo, GLuint ebo, GLsizei indices)
+    {
+        meshVBO = vbo;
+        meshEBO = ebo;
+        indexCount = indices;
+    }
+
+    // Раз в кадр на рендер-потоке
+    void update(const glm::vec3& camPos, const glm::vec3& camVel, const glm::mat4& viewProj,
+                float fovY, float screenHeight)
+    {
+        frustum = Frustum::fromMatrix(viewProj);
+        eye = camPos;
+        float projScale = screenHeight / (2.0f * std::tan(fovY * 0.5f));
+        glm::vec3 predicted = camPos + camVel * budget.lookahead;
+
+        for (Cell& c : cells)
+        {
+            float now = importance(c, camPos, projScale);
+            float ahead = importance(c, predicted, projScale);
+            // За пределами пирамиды — ниже, но не ноль: камера может повернуться
+            float visibility = frustum.sphereVisible(c.center, c.radius) ? 1.0f : 0.25f;
+            c.priority = std::max(now, ahead) * visibility;
+        }
+
+        order.resize(cells.size());
+        for (size_t i = 0; i < cells.size(); ++i)
+            order[i] = (uint32_t)i;
+        std::sort(order.begin(), order.end(),
+                  [this](uint32_t a, uint32_t b) { return cells[a].priority > cells[b].priority; });
+
+        for (uint32_t index : order)
+        {
+            Cell& c = cells[index];
+            if (c.state != CELL_UNLOADED)
+                continue;
+            if (loadsInFlight >= budget.maxLoadsInFlight || c.priority < budget.minImportance)
+                break;
+
+            size_t cpu = readSize(c);
+            size_t gpu = (size_t)c.entry.instanceCount * sizeof(PackedInstance);
+            if (!makeRoom(cpu, gpu, c.priority))
+                break;
+
+            StagingSpan span = staging.allocate(cpu);
+            if (!span)
+                break;
+
+            c.state = CELL_LOADING;
+            cpuBytes += cpu;
+            gpuBytes += gpu;
+            ++loadsInFlight;
+            spawn(loadCell(index, span));
+        }
+
+        // Совсем невидимые ячейки выгружаются и без давления бюджета
+        for (Cell& c : cells)
+            if (c.state == CELL_RESIDENT && c.priority < budget.minImportance * 0.5f)
+                unload(c);
+    }
+
+    void draw(const glm::mat4& viewProj)
+    {
+        if (!program || !meshVBO)
+            return;
+        if (!vao)
+            makeVAO();
+
+        visible.clear();
+        for (uint32_t i = 0; i < cells.size(); ++i)
+            if (cells[i].state == CELL_RESIDENT && frustum.sphereVisible(cells[i].center, cells[i].radius))
+                visible.push_back(i);
+        if (occlusion)
+        {
+            cullObjects(viewProj);
+        }
+        else
+        {
+            objectVisible.clear();
+            objectsCulled = 0;
+        }
+
+        // Индексы видимых инстансов всех ячеек — одним буфером на кадр.
+        // Закрытый объект вырезает свой диапазон (объекты ячейки идут по
+        // возрастанию firstInstance, как их пишет writeWorld); инстансы без
+        // объекта рисуются всегда.
+        indices.clear();
+        drawRanges.clear();
+        size_t objectIndex = 0;
+        for (uint32_t index : visible)
+        {
+            const Cell& c = cells[index];
+            size_t first = indices.size();
+            uint32_t cursor = 0;
+            for (const WorldObject& o : c.objects)
+            {
+                bool shown = !occlusion || objectVisible[objectIndex++];
+                if (shown)
+                    continue;
+                for (uint32_t i = cursor; i < o.firstInstance; ++i)
+                    indices.push_back(i);
+                cursor = o.firstInstance + o.instanceCount;
+            }
+            for (uint32_t i = cursor; i < c.entry.instanceCount; ++i)
+                indices.push_back(i);
+            if (indices.size() > first)
+                drawRanges.push_back({ index, (uint32_t)first, (uint32_t)(indices.size() - first) });
+        }
+        if (indices.empty())
+            return;
+
+        glBindBuffer(GL_ARRAY_BUFFER, indexVBO);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(indices.size() * sizeof(uint32_t)), indices.data(), GL_STREAM_DRAW);
+
+        glUseProgram(program);
+        glUniformMatrix4fv(glGetUniformLocation(program, "uViewProj"), 1, GL_FALSE, &viewProj[0][0]);
+        glUniform1i(glGetUniformLocation(program, "uInstances"), (GLint)WORLD_INSTANCE_UNIT);
+        glActiveTexture(GL_TEXTURE0 + WORLD_INSTANCE_UNIT);
+        glBindVertexArray(vao);
+        for (const DrawRange& r : drawRanges)
+        {
+            glBindTexture(GL_TEXTURE_BUFFER, cells[r.cell].instanceTexture);
+            glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void*)(r.first * sizeof(uint32_t)));
+            glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, (GLsizei)r.count);
+        }
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    // Источники дыма в загруженных ячейках, ближние первыми
+    std::vector<glm::vec3> smokeEmitters(const glm::vec3& camPos, size_t maxCount) const
+    {
+        std::vector<glm::vec3> out;
+        for (const Cell& c : cells)
+            if (c.state == CELL_RESIDENT)
+                for (const WorldObject& o : c.objects)
+                    if (o.kind == OBJECT_SMOKE)
+                        out.push_back(glm::vec3(o.sphere));
+
+        std::sort(out.begin(), out.end(), [&](const glm::vec3& a, const glm::vec3& b)
+        {
+            return glm::dot(a - camPos, a - camPos) < glm::dot(b - camPos, b - camPos);
+        });
+        if (out.size() > maxCount)
+            out.resize(maxCount);
+        return out;
+    }
+
+    void setProgram(GLuint prog) { program = prog; }
+
+    // nullptr — без отсечения перекрытых объектов
+    void setOcclusion(OcclusionBuffer* buffer) { occlusion = buffer; }
+
+    glm::vec3 boundsMin() const { return worldMin; }
+    glm::vec3 boundsMax() const { return worldMax; }
+
+    StreamBudget budget;
+
+    StreamStats stats() const
+    {
+        StreamStats s;
+        for (const Cell& c : cells)
+        {
+            if (c.state == CELL_RESIDENT)
+            {
+                ++s.resident;
+                s.instances += c.entry.instanceCount;
+            }
+            else if (c.state == CELL_LOADING)
+            {
+                ++s.loading;
+            }
+        }
+        s.cpuBytes = cpuBytes;
+        s.gpuBytes = gpuBytes;
+        s.objectsTested = objectVisible.size();
+        s.objectsCulled = objectsCulled;
+        return s;
+    }
+
+private:
+    enum CellState
+    {
+        CELL_UNLOADED,
+        CELL_LOADING,
+        CELL_RESIDENT
+    };
+
+    struct Cell
+    {
+        WorldCellEntry entry;
+        glm::vec3 center;
+        float radius = 0.0f;
+        float priority = 0.0f;
+        CellState state = CELL_UNLOADED;
+        bool evictRequested = false;
+        GLuint instanceVBO = 0;
+        GLuint instanceTexture = 0;
+        std::vector<WorldObject> objects;
+        std::vector<glm::mat4> occluders;
+    };
+
+    struct DrawRange
+    {
+        uint32_t cell;
+        uint32_t first;
+        uint32_t count;
+    };
+
+    static float importance(const Cell& c, const glm::vec3& eye, float projScale)
+    {
+        float d = glm::length(c.center - eye);
+        return c.radius / std::max(d, c.radius * 0.5f + 0.01f) * projScale;
+    }
+
+    static size_t readSize(const Cell& c)
+    {
+        return (c.entry.size + IO_ALIGNMENT - 1) / IO_ALIGNMENT * IO_ALIGNMENT;
+    }
+
+    size_t objectBytes(const Cell& c) const
+    {
+        return c.objects.size() * sizeof(WorldObject) + c.occluders.size() * sizeof(glm::mat4);
+    }
+
+    // Ближние крупные кубы — в буфер перекрытий, затем рамки всех объектов
+    // видимых ячеек проверяются пакетом
+    void cullObjects(const glm::mat4& viewProj)
+    {
+        occluderQueue.clear();
+        for (uint32_t index : visible)
+            for (const glm::mat4& m : cells[index].occluders)
+            {
+                glm::vec3 d = glm::vec3(m[3]) - eye;
+                occluderQueue.push_back({ glm::dot(d, d), &m });
+            }
+        size_t count = std::min(occluderQueue.size(), (size_t)std::max(budget.maxOccluders, 0));
+        std::partial_sort(occluderQueue.begin(), occluderQueue.begin() + count, occluderQueue.end(),
+                          [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        occlusion->begin(viewProj);
+        for (size_t i = 0; i < count; ++i)
+            occlusion->addBox(*occluderQueue[i].second);
+        occlusion->rasterize();
+
+        boxMin.clear();
+        boxMax.clear();
+        for (uint32_t index : visible)
+            for (const WorldObject& o : cells[index].objects)
+            {
+                glm::vec3 center(o.sphere);
+                boxMin.push_back(center - o.sphere.w);
+                boxMax.push_back(center + o.sphere.w);
+            }
+        objectVisible.resize(boxMin.size());
+        occlusion->testBoxes(boxMin.data(), boxMax.data(), boxMin.size(), objectVisible.data());
+        objectsCulled = (size_t)std::count(objectVisible.begin(), objectVisible.end(), 0);
+    }
+
+    // Освободить место под ячейку, выгружая менее важные
+    bool makeRoom(size_t cpu, size_t gpu, float priority)
+    {
+        while (cpuBytes + cpu > budget.cpuBytes || gpuBytes + gpu > budget.gpuBytes)
+        {
+            Cell* victim = nullptr;
+            for (auto it = order.rbegin(); it != order.rend(); ++it)
+            {
+                Cell& c = cells[*it];
+                if (c.state == CELL_RESIDENT)
+                {
+                    victim = &c;
+                    break;
+                }
+            }
+            if (!victim || victim->priority >= priority)
+                return false;
+            unload(*victim);
+        }
+        return true;
+    }
+
+    void unload(Cell& c)
+    {
+        if (c.state == CELL_LOADING)
+        {
+            c.evictRequested = true;
+            return;
+        }
+        if (c.state != CELL_RESIDENT)
+            return;
+
+        glDeleteTextures(1, &c.instanceTexture);
+        glDeleteBuffers(1, &c.instanceVBO);
+        c.instanceTexture = 0;
+        c.instanceVBO = 0;
+        gpuBytes -= (size_t)c.entry.instanceCount * sizeof(PackedInstance);
+        cpuBytes -= objectBytes(c);
+        c.objects.clear();
+        c.objects.shrink_to_fit();
+        c.occluders.clear();
+        c.occluders.shrink_to_fit();
+        c.state = CELL_UNLOADED;
+    }
+
+    Task<void> loadCell(uint32_t index, StagingSpan span)
+    {
+        WorldCellEntry entry = cells[index].entry;
+        size_t readBytes = readSize(cells[index]);
+        float occluderMinSize = budget.occluderMinSize;
+
+        int64_t got = co_await io.read(file, entry.offset, readBytes, span.data);
+
+        // Разбор — на пуле (после read мы уже там)
+        bool valid = got >= (int64_t)entry.size;
+        const CellHeader* header = (const CellHeader*)span.data;
+        valid = valid && std::memcmp(header->magic, "MIDC", 4) == 0
+            && header->instanceCount == entry.instanceCount
+            && header->objectCount == entry.objectCount;
+
+        std::vector<WorldObject> objects;
+        std::vector<glm::mat4> occluders;
+        const PackedInstance* instances = nullptr;
+        if (valid)
+        {
+            const WorldObject* objs = (const WorldObject*)(span.data + sizeof(CellHeader));
+            objects.assign(objs, objs + header->objectCount);
+            instances = (const PackedInstance*)(objs + header->objectCount);
+            for (uint32_t i = 0; i < entry.instanceCount; ++i)
+            {
+                glm::vec3 ext = instanceHalfExtent(instances[i].model);
+                if (std::min({ ext.x, ext.y, ext.z }) * 2.0f >= occluderMinSize)
+                    occluders.push_back(instances[i].model);
+            }
+        }
+
+        GLuint buffer = 0;
+        if (valid && entry.instanceCount > 0)
+            buffer = co_await uploader.uploadBuffer(instances, entry.instanceCount * sizeof(PackedInstance));
+
+        co_await renderQueue.schedule();
+        staging.release(span);
+        --loadsInFlight;
+
+        Cell& c = cells[index];
+        cpuBytes -= readBytes;
+        if (!valid || c.evictRequested)
+        {
+            if (!valid)
+                std::cerr << "Bad world cell " << entry.cx << "," << entry.cz << "\n";
+            if (buffer)
+                glDeleteBuffers(1, &buffer);
+            gpuBytes -= (size_t)entry.instanceCount * sizeof(PackedInstance);
+            c.evictRequested = false;
+            c.state = CELL_UNLOADED;
+            co_return;
+        }
+
+        c.objects = std::move(objects);
+        c.occluders = std::move(occluders);
+        cpuBytes += objectBytes(c);
+        c.instanceVBO = buffer;
+        if (buffer)
+        {
+            // Минимум GL_MAX_TEXTURE_BUFFER_SIZE — 65536 текселей, около 13 тысяч кубов на ячейку
+            glGenTextures(1, &c.instanceTexture);
+            glBindTexture(GL_TEXTURE_BUFFER, c.instanceTexture);
+            glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32UI, buffer);
+            glBindTexture(GL_TEXTURE_BUFFER, 0);
+        }
+        c.state = CELL_RESIDENT;
+    }
+
+    // Общий VAO: меш и индекс инстанса; смещение индексов меняется на каждую ячейку
+    void makeVAO()
+    {
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &indexVBO);
+        glBindVertexArray(vao);
+
+        glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshEBO);
+
+        glBindBuffer(GL_ARRAY_BUFFER, indexVBO);
+        glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void*)0);
+        glEnableVertexAttribArray(1);
+        glVertexAttribDivisor(1, 1);
+
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    RenderQueue& renderQueue;
+    AssetIO& io;
+    UploadWorker& uploader;
+    StagingArena& staging;
+
+    AssetFile file;
+    std::vector<Cell> cells;
+    std::vector<uint32_t> order;
+    Frustum frustum = {};
+    glm::vec3 worldMin = glm::vec3(0.0f), worldMax = glm::vec3(0.0f);
+
+    GLuint program = 0;
+    GLuint meshVBO = 0, meshEBO = 0;
+    GLsizei indexCount = 0;
+    GLuint vao = 0, indexVBO = 0;
+    glm::vec3 eye = glm::vec3(0.0f);
+
+    OcclusionBuffer* occlusion = nullptr;
+    std::vector<uint32_t> visible;
+    std::vector<std::pair<float, const glm::mat4*>> occluderQueue;
+    std::vector<glm::vec3> boxMin, boxMax;
+    std::vector<uint8_t> objectVisible;
+    size_t objectsCulled = 0;
+    std::vector<uint32_t> indices;
+    std::vector<DrawRange> drawRanges;
+
+    size_t cpuBytes = 0;
+    size_t gpuBytes = 0;
+    int loadsInFlight = 0;
+};
+
+// Инстансы, которые меняются каждый кадр (например, тела физики): буфер
+// заливается целиком и рисуется одним вызовом той же программой, что и
+// ячейки мира. Все GL-вызовы — на рендер-потоке.
+class DynamicInstances
+{
+public:
+    ~DynamicInstances()
+    {
+        if (vao)
+        {
+            glDeleteVertexArrays(1, &vao);
+            glDeleteBuffers(1, &indexVBO);
+            glDeleteBuffers(1, &instanceVBO);
+            glDeleteTextures(1, &instanceTexture);
+        }
+    }
+
+    void setMesh(GLuint vbo, GLuint ebo, GLsizei indices)
+    {
+        meshVBO = vbo;
+        meshEBO = ebo;
+        indexCount = indices;
+    }
+
+    void update(const std::vector<PackedInstance>& instances)
+    {
+        if (!meshVBO)
+            return;
+        if (!vao)
+            makeVAO();
+
+        // Индексы 0..N-1 меняются только с числом инстансов
+        if (instances.size() != count)
+        {
+            count = instances.size();
+            std::vector<uint32_t> indices(count);
+            for (size_t i = 0; i < count; ++i)
+                indices[i] = (uint32_t)i;
+            glBindBuffer(GL_ARRAY_BUFFER, indexVBO);
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(count * sizeof(uint32_t)), indices.data(), GL_STATIC_DRAW);
+        }
+
+        // glBufferData без ожидания прошлого кадра: драйвер отдаёт новую память
+        glBindBuffer(GL_TEXTURE_BUFFER, instanceVBO);
+        glBufferData(GL_TEXTURE_BUFFER, (GLsizeiptr)(count * sizeof(PackedInstance)), instances.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    // Программа — cubeInstVS; материалы уже привязаны вызывающим
+    void draw(GLuint program, const glm::mat4& viewProj)
+    {
+        if (!vao || count == 0)
+            return;
+        glUseProgram(program);
+        glUniformMatrix4fv(glGetUniformLocation(program, "uViewProj"), 1, GL_FALSE, &viewProj[0][0]);
+        glUniform1i(glGetUniformLocation(program, "uInstances"), (GLint)WORLD_INSTANCE_UNIT);
+        glActiveTexture(GL_TEXTURE0 + WORLD_INSTANCE_UNIT);
+        glBindTexture(GL_TEXTURE_BUFFER, instanceTexture);
+        glBindVertexArray(vao);
+        glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, (GLsizei)count);
+        glBindVertexArray(0);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+private:
+    void makeVAO()
+    {
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &indexVBO);
+        glGenBuffers(1, &instanceVBO);
+        glBindVertexArray(vao);
+
+        glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshEBO);
+
+        glBindBuffer(GL_ARRAY_BUFFER, indexVBO);
+        glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void*)0);
+        glEnableVertexAttribArray(1);
+        glVertexAttribDivisor(1, 1);
+
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        glBindBuffer(GL_TEXTURE_BUFFER, instanceVBO);
+        glBufferData(GL_TEXTURE_BUFFER, 0, nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        glGenTextures(1, &instanceTexture);
+        glBindTexture(GL_TEXTURE_BUFFER, instanceTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32UI, instanceVBO);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    }
+
+    GLuint meshVBO = 0, meshEBO = 0;
+    GLsizei indexCount = 0;
+    GLuint vao = 0, indexVBO = 0, instanceVBO = 0, instanceTexture = 0;
+    size_t count = 0;
+};